@@ -51,6 +51,12 @@
 #define LV_LIMITS_INCLUDE       <limits.h>
 #define LV_STDARG_INCLUDE       <stdarg.h>
 
+#if LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN
+    /*Use SSE2/AVX2 or NEON in `lv_memcpy()` and `lv_memset()` if the compiler targets them
+     *(e.g. `-msse2`, `-mavx2`, `-mfpu=neon`). Otherwise word copies are used.*/
+    #define LV_STRING_USE_SIMD 1
+#endif
+
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
     /*Size of the memory available for `lv_malloc()` in bytes (>= 2kB)*/
     #define LV_MEM_SIZE (64 * 1024U)          /*[bytes]*/
@@ -65,6 +71,17 @@
         #undef LV_MEM_POOL_INCLUDE
         #undef LV_MEM_POOL_ALLOC
     #endif
+
+    /*Serve small allocations from slabs of equally sized slots in front of the TLSF heap.
+     *It reduces fragmentation and makes allocating and freeing small objects faster.*/
+    #define LV_MEM_USE_SLAB 0
+    #if LV_MEM_USE_SLAB
+        /*Allocations up to this size are served from slabs. Size classes are multiples of 8 bytes.*/
+        #define LV_MEM_SLAB_MAX_SIZE 128    /*[bytes]*/
+
+        /*Size of one slab allocated from the heap. Must be a power of 2.*/
+        #define LV_MEM_SLAB_SIZE 2048       /*[bytes]*/
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -95,6 +112,10 @@
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
 #endif
 
+/*Number of calls which can be queued by `lv_async_call_from_thread()` between two `lv_timer_handler()` calls.
+ *Must be a power of 2.*/
+#define LV_ASYNC_QUEUE_SIZE 32
+
 /*========================
  * RENDERING CONFIGURATION
  *========================*/
@@ -113,6 +134,11 @@
 /*The target buffer size for simple layer chunks.*/
 #define LV_DRAW_LAYER_SIMPLE_BUF_SIZE    (24 * 1024)   /*[bytes]*/
 
+/* Max. memory used to retain the rendered image of the widgets with `LV_OBJ_FLAG_CACHE_AS_BITMAP`.
+ * If the budget is exceeded the least recently used images are freed.
+ * 0: disable the feature */
+#define LV_OBJ_BITMAP_CACHE_SIZE        0   /*[bytes]*/
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -148,6 +174,12 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
+    /* Downscale the images with a box filter first if they are scaled to 50% or less.
+     * It avoids the aliasing of heavily downscaled images (e.g. thumbnails).
+     * The downscaled copies are stored with the cached decoded images (see `LV_CACHE_DEF_SIZE`).
+     * Images which are not cached (e.g. used directly from a C array) are not downscaled this way. */
+    #define LV_DRAW_SW_MIPMAP           0
+
     #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
@@ -318,6 +350,16 @@
  *The main logic is like `LV_CACHE_DEF_SIZE` but for image headers.*/
 #define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
 
+/*Cache the blocks read by `lv_fs_read()` and share them between all the files opened for reading.
+ *The blocks are kept after closing the files so reopened files (e.g. fonts and images) are not read again.
+ *If a file is read sequentially the next blocks are read in advance without seeking in the file.*/
+#define LV_USE_FS_BLOCK_CACHE 0
+#if LV_USE_FS_BLOCK_CACHE
+    #define LV_FS_BLOCK_CACHE_BLOCK_SIZE 4096   /*[bytes]*/
+    #define LV_FS_BLOCK_CACHE_BLOCK_CNT 16      /*Number of blocks to cache. Can be changed by `lv_fs_block_cache_resize()`*/
+    #define LV_FS_BLOCK_CACHE_READ_AHEAD 2      /*Number of blocks to read in advance*/
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS   2
@@ -329,6 +371,10 @@
 /* Add 2 x 32 bit variables to each lv_obj_t to speed up getting style properties */
 #define LV_OBJ_STYLE_CACHE      0
 
+/* Cache the resolved value of the style properties per object part, so getting them becomes an array lookup.
+ * Needs about 150 bytes + 8 bytes per used property for each part of the objects whose style is read */
+#define LV_OBJ_STYLE_RESOLVED_CACHE     0
+
 /* Add `id` field to `lv_obj_t` */
 #define LV_USE_OBJ_ID           0
 
@@ -717,6 +763,9 @@
 #if LV_USE_GIF
 /*GIF decoder accelerate*/
 #define LV_GIF_CACHE_DECODE_DATA 0
+/*Decode this many frames in advance on a background thread. 0: decode the frames in an `lv_timer`.
+ *Needs `LV_USE_OS` and uses an extra width x height x 4 bytes RAM per frame*/
+#define LV_GIF_DECODE_AHEAD_CNT 0
 #endif
 
 
@@ -748,6 +797,8 @@
 #if LV_USE_TINY_TTF
     /* Enable loading TTF data from files */
     #define LV_TINY_TTF_FILE_SUPPORT 0
+    /* Default number of glyph metrics cached per font if 0 is passed as `cache_size` */
+    #define LV_TINY_TTF_CACHE_GLYPH_CNT 256
 #endif
 
 /*Rlottie library*/
@@ -774,6 +825,9 @@
 #if LV_USE_FFMPEG
     /*Dump input information to stderr*/
     #define LV_FFMPEG_DUMP_FORMAT 0
+    /*Decode this many frames in advance on a background thread in the player. 0: decode the frames in an `lv_timer`.
+     *Needs `LV_USE_OS` and uses an extra frame buffer per frame*/
+    #define LV_FFMPEG_DECODE_AHEAD_CNT 0
 #endif
 
 /*==================
@@ -835,6 +889,18 @@
     #define LV_PROFILER_END_TAG   LV_PROFILER_BUILTIN_END_TAG
 #endif
 
+/*1: Record the call site, size and lifetime of the allocations made by `lv_malloc()` and `lv_realloc()`.
+ *The live memory is aggregated per call site and per widget class. See `lv_mem_track_dump()`.
+ *Each allocation gets a few dozen bytes of header.*/
+#define LV_USE_MEM_TRACK 0
+#if LV_USE_MEM_TRACK
+    /*Max number of different call sites to track. The rest are aggregated together.*/
+    #define LV_MEM_TRACK_SITE_CNT 512
+
+    /*Max number of different tags (widget classes) to track. The rest are aggregated together.*/
+    #define LV_MEM_TRACK_TAG_CNT 64
+#endif
+
 /*1: Enable Monkey test*/
 #define LV_USE_MONKEY 0
 
@@ -912,6 +978,9 @@
     #define LV_LINUX_FBDEV_RENDER_MODE   LV_DISPLAY_RENDER_MODE_PARTIAL
     #define LV_LINUX_FBDEV_BUFFER_COUNT  0
     #define LV_LINUX_FBDEV_BUFFER_SIZE   60
+    /*Render directly into 2 pages of the framebuffer and switch them with FBIOPAN_DISPLAY
+     *if the virtual screen can hold 2 pages. The render mode and buffer settings are ignored then.*/
+    #define LV_LINUX_FBDEV_PAN_FLIP      0
 #endif
 
 /*Use Nuttx to open window and handle touchscreen*/
@@ -937,6 +1006,11 @@
 
 /*Driver for /dev/dri/card*/
 #define LV_USE_LINUX_DRM        0
+#if LV_USE_LINUX_DRM
+    /*2: double buffering
+     *3: triple buffering to render the next frame while the previous one is waiting for the page flip*/
+    #define LV_LINUX_DRM_BUFFER_COUNT   2
+#endif
 
 /*Interface for TFT_eSPI*/
 #define LV_USE_TFT_ESPI         0
@@ -21,6 +21,7 @@ extern "C" {
 #include "src/lv_init.h"
 
 #include "src/stdlib/lv_mem.h"
+#include "src/stdlib/lv_mem_track.h"
 #include "src/stdlib/lv_string.h"
 #include "src/stdlib/lv_sprintf.h"
 
@@ -22,6 +22,7 @@ extern "C" {
 #endif
 #include "../misc/lv_anim.h"
 #include "../misc/lv_area.h"
+#include "../misc/lv_async.h"
 #include "../misc/lv_color_op.h"
 #include "../misc/lv_ll.h"
 #include "../misc/lv_log.h"
@@ -29,6 +30,7 @@ extern "C" {
 #include "../misc/lv_timer.h"
 #include "../others/sysmon/lv_sysmon.h"
 #include "../stdlib/builtin/lv_tlsf.h"
+#include "../stdlib/lv_mem_track.h"
 
 #if LV_USE_FONT_COMPRESSED
 #include "../font/lv_font_fmt_txt.h"
@@ -72,6 +74,12 @@ typedef struct _lv_global_t {
     lv_display_t * disp_refresh;
     lv_display_t * disp_default;
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    lv_ll_t bitmap_cache_ll;
+    uint32_t bitmap_cache_used;
+    uint32_t bitmap_cache_stamp;
+#endif
+
     lv_ll_t style_trans_ll;
     bool style_refresh;
     uint32_t style_custom_table_size;
@@ -96,6 +104,7 @@ typedef struct _lv_global_t {
     uint32_t event_last_register_id;
 
     lv_timer_state_t timer_state;
+    lv_async_state_t async_state;
     lv_anim_state_t anim_state;
     lv_tick_state_t tick_state;
 
@@ -139,7 +148,20 @@ typedef struct _lv_global_t {
     lv_tlsf_state_t tlsf_state;
 #endif
 
+#if LV_USE_MEM_TRACK
+    lv_mem_track_state_t mem_track_state;
+#endif
+
+#if LV_USE_OBSERVER
+    lv_ll_t subject_deferred_ll;
+    volatile uint32_t subject_post_pending;
+#endif
+
     lv_ll_t fsdrv_ll;
+#if LV_USE_FS_BLOCK_CACHE
+    lv_cache_t * fs_block_cache;
+    lv_ll_t fs_block_file_ll;
+#endif
 #if LV_USE_FS_STDIO != '\0'
     lv_fs_drv_t stdio_fs_drv;
 #endif
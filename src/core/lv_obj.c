@@ -173,6 +173,9 @@ void lv_obj_remove_flag(lv_obj_t * obj, lv_obj_flag_t f)
         lv_obj_mark_layout_as_dirty(lv_obj_get_parent(obj));
     }
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    if(f & LV_OBJ_FLAG_CACHE_AS_BITMAP) _lv_refr_bitmap_cache_free(obj);
+#endif
 }
 
 void lv_obj_update_flag(lv_obj_t * obj, lv_obj_flag_t f, bool v)
@@ -372,6 +375,10 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             obj->spec_attr->children = NULL;
         }
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+        _lv_refr_bitmap_cache_free(obj);
+#endif
+
         lv_event_remove_all(&obj->spec_attr->event_list);
 
         lv_free(obj->spec_attr);
@@ -381,6 +388,8 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 #if LV_USE_OBJ_ID
     lv_obj_free_id(obj);
 #endif
+
+    _lv_obj_style_resolved_free(obj);
 }
 
 static void lv_obj_draw(lv_event_t * e)
@@ -745,6 +754,8 @@ static void update_obj_state(lv_obj_t * obj, lv_state_t new_state)
     lv_obj_invalidate(obj);
 
     obj->state = new_state;
+    /*The children might inherit the changed properties*/
+    _lv_obj_style_resolved_invalidate(obj, true);
     _lv_obj_update_layer_type(obj);
     _lv_obj_style_transition_dsc_t * ts = lv_malloc_zeroed(sizeof(_lv_obj_style_transition_dsc_t) * STYLE_TRANSITION_MAX);
     uint32_t tsi = 0;
@@ -11,6 +11,7 @@
 #include "../display/lv_display.h"
 #include "../display/lv_display_private.h"
 #include "../stdlib/lv_string.h"
+#include "../stdlib/lv_mem_track.h"
 
 /*********************
  *      DEFINES
@@ -47,7 +48,13 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 {
     LV_TRACE_OBJ_CREATE("Creating object with %p class on %p parent", (void *)class_p, (void *)parent);
     uint32_t s = get_instance_size(class_p);
+#if LV_USE_MEM_TRACK
+    const char * tag_prev = lv_mem_track_set_tag(class_p->name);
     lv_obj_t * obj = lv_malloc_zeroed(s);
+    lv_mem_track_set_tag(tag_prev);
+#else
+    lv_obj_t * obj = lv_malloc_zeroed(s);
+#endif
     if(obj == NULL) return NULL;
     obj->class_p = class_p;
     obj->parent = parent;
@@ -95,6 +102,11 @@ lv_obj_t * lv_obj_class_create_obj(const lv_obj_class_t * class_p, lv_obj_t * pa
 
 void lv_obj_class_init_obj(lv_obj_t * obj)
 {
+#if LV_USE_MEM_TRACK
+    /*Attribute the memory allocated by the constructors to the widget's class*/
+    const char * tag_prev = lv_mem_track_set_tag(obj->class_p->name);
+#endif
+
     lv_obj_mark_layout_as_dirty(obj);
     lv_obj_enable_style_refresh(false);
 
@@ -121,6 +133,10 @@ void lv_obj_class_init_obj(lv_obj_t * obj)
         /*Invalidate the area if not screen created*/
         lv_obj_invalidate(obj);
     }
+
+#if LV_USE_MEM_TRACK
+    lv_mem_track_set_tag(tag_prev);
+#endif
 }
 
 void _lv_obj_destruct(lv_obj_t * obj)
@@ -24,6 +24,8 @@
  **********************/
 static lv_result_t event_send_core(lv_event_t * e);
 static bool event_is_bubbled(lv_event_t * e);
+static uint32_t event_code_to_mask(uint32_t filter);
+static void update_event_listen_mask(lv_obj_t * obj);
 
 /**********************
  *  STATIC VARIABLES
@@ -97,9 +99,29 @@ lv_event_dsc_t * lv_obj_add_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb, lv_
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_obj_allocate_spec_attr(obj);
 
+    obj->spec_attr->event_listen_mask |= event_code_to_mask(filter);
     return lv_event_add(&obj->spec_attr->event_list, event_cb, filter, user_data);
 }
 
+bool _lv_obj_event_can_skip(const lv_obj_t * obj, lv_event_code_t code)
+{
+    /*Only these events are ignored by `lv_obj_class` and they don't bubble*/
+    if(code != LV_EVENT_DRAW_MAIN_BEGIN && code != LV_EVENT_DRAW_MAIN_END &&
+       code != LV_EVENT_DRAW_POST_BEGIN && code != LV_EVENT_DRAW_POST_END) {
+        return false;
+    }
+
+    if(obj->spec_attr && (obj->spec_attr->event_listen_mask & event_code_to_mask(code))) return false;
+
+    /*Widgets having their own event handler might react to any events*/
+    const lv_obj_class_t * class_p;
+    for(class_p = obj->class_p; class_p; class_p = class_p->base_class) {
+        if(class_p->event_cb && class_p->event_cb != lv_obj_class.event_cb) return false;
+    }
+
+    return true;
+}
+
 uint32_t lv_obj_get_event_count(lv_obj_t * obj)
 {
     LV_ASSERT_NULL(obj);
@@ -118,7 +140,9 @@ bool lv_obj_remove_event(lv_obj_t * obj, uint32_t index)
 {
     LV_ASSERT_NULL(obj);
     if(obj->spec_attr == NULL) return false;
-    return lv_event_remove(&obj->spec_attr->event_list, index);
+    bool res = lv_event_remove(&obj->spec_attr->event_list, index);
+    update_event_listen_mask(obj);
+    return res;
 }
 
 bool lv_obj_remove_event_cb(lv_obj_t * obj, lv_event_cb_t event_cb)
@@ -143,7 +167,9 @@ bool lv_obj_remove_event_dsc(lv_obj_t * obj, lv_event_dsc_t * dsc)
     LV_ASSERT_NULL(obj);
     LV_ASSERT_NULL(dsc);
     if(obj->spec_attr == NULL) return false;
-    return lv_event_remove_dsc(&obj->spec_attr->event_list, dsc);
+    bool res = lv_event_remove_dsc(&obj->spec_attr->event_list, dsc);
+    update_event_listen_mask(obj);
+    return res;
 }
 
 uint32_t lv_obj_remove_event_cb_with_user_data(lv_obj_t * obj, lv_event_cb_t event_cb, void * user_data)
@@ -414,3 +440,27 @@ static bool event_is_bubbled(lv_event_t * e)
             return true;
     }
 }
+
+static uint32_t event_code_to_mask(uint32_t filter)
+{
+    filter &= ~LV_EVENT_PREPROCESS;
+    if(filter == LV_EVENT_ALL) return UINT32_MAX;
+
+    /*The higher codes are not tracked, they are always sent*/
+    if(filter >= 32) return 0;
+
+    return (uint32_t)1 << filter;
+}
+
+static void update_event_listen_mask(lv_obj_t * obj)
+{
+    uint32_t mask = 0;
+    uint32_t event_cnt = lv_obj_get_event_count(obj);
+    uint32_t i;
+    for(i = 0; i < event_cnt; i++) {
+        lv_event_dsc_t * dsc = lv_obj_get_event_dsc(obj, i);
+        mask |= event_code_to_mask(dsc->filter);
+    }
+
+    obj->spec_attr->event_listen_mask = mask;
+}
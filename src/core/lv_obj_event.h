@@ -75,6 +75,16 @@ lv_result_t lv_obj_send_event(lv_obj_t * obj, lv_event_code_t event_code, void *
  */
 lv_result_t lv_obj_event_base(const lv_obj_class_t * class_p, lv_event_t * e);
 
+/**
+ * Used internally to check if sending an event to an object can be skipped because
+ * neither its class nor its event handlers can react to it.
+ * Only the draw events which are ignored by `lv_obj_class` are considered.
+ * @param obj       pointer to an object
+ * @param code      an event code
+ * @return          true: the event doesn't need to be sent
+ */
+bool _lv_obj_event_can_skip(const lv_obj_t * obj, lv_event_code_t code);
+
 /**
  * Get the current target of the event. It's the object which event handler being called.
  * If the event is not bubbled it's the same as "original" target.
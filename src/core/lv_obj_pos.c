@@ -807,6 +807,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    /*The retained images are outdated even if the change is not visible now*/
+    _lv_refr_bitmap_cache_invalidate(obj);
+#endif
+
     lv_display_t * disp   = lv_obj_get_display(obj);
     if(!lv_display_is_invalidation_enabled(disp)) return;
 
@@ -1133,10 +1138,12 @@ static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p
     int32_t angle = lv_obj_get_style_transform_rotation(obj, 0);
     int32_t scale_x = lv_obj_get_style_transform_scale_x_safe(obj, 0);
     int32_t scale_y = lv_obj_get_style_transform_scale_y_safe(obj, 0);
+    int32_t skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+    int32_t skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
     if(scale_x == 0) scale_x = 1;
     if(scale_y == 0) scale_y = 1;
 
-    if(angle == 0 && scale_x == LV_SCALE_NONE && scale_y == LV_SCALE_NONE) return;
+    if(angle == 0 && scale_x == LV_SCALE_NONE && scale_y == LV_SCALE_NONE && skew_x == 0 && skew_y == 0) return;
 
     lv_point_t pivot = {
         .x = lv_obj_get_style_transform_pivot_x(obj, 0),
@@ -1153,11 +1160,16 @@ static void transform_point_array(const lv_obj_t * obj, lv_point_t * p, size_t p
     pivot.x = obj->coords.x1 + pivot.x;
     pivot.y = obj->coords.y1 + pivot.y;
 
+    /*The object is skewed first, scaled after that and rotated last*/
     if(inv) {
         angle = -angle;
         scale_x = (256 * 256 + scale_x - 1) / scale_x;
         scale_y = (256 * 256 + scale_y - 1) / scale_y;
+        lv_point_array_transform(p, p_count, angle, scale_x, scale_y, &pivot, false);
+        lv_point_array_skew(p, p_count, skew_x, skew_y, &pivot, true);
+    }
+    else {
+        lv_point_array_skew(p, p_count, skew_x, skew_y, &pivot, false);
+        lv_point_array_transform(p, p_count, angle, scale_x, scale_y, &pivot, true);
     }
-
-    lv_point_array_transform(p, p_count, angle, scale_x, scale_y, &pivot, !inv);
 }
@@ -65,6 +65,10 @@ static void fade_in_anim_completed(lv_anim_t * a);
 static bool style_has_flag(const lv_style_t * style, uint32_t flag);
 static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop,
                                               lv_style_value_t * value_act);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    static _lv_obj_style_resolved_t * get_resolved(lv_obj_t * obj, lv_part_t part);
+    static void resolved_add(_lv_obj_style_resolved_t * resolved, lv_style_prop_t prop, lv_style_value_t value);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -273,6 +277,10 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*Drop the cached values even if refreshing is disabled as they are not valid anymore*/
+    _lv_obj_style_resolved_invalidate(obj, prop == LV_STYLE_PROP_ANY ||
+                                      lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -324,14 +332,27 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
 {
     LV_ASSERT_NULL(obj)
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    /*The transitions are skipped only temporarily, so don't use the cache meanwhile*/
+    _lv_obj_style_resolved_t * resolved = NULL;
+    if(prop < _LV_STYLE_NUM_BUILT_IN_PROPS && !obj->skip_trans) {
+        resolved = get_resolved((lv_obj_t *)obj, part);
+        if(resolved && resolved->index[prop]) return resolved->values[resolved->index[prop] - 1];
+    }
+#endif
+
     lv_style_selector_t selector = part | obj->state;
     lv_style_value_t value_act = { .ptr = NULL };
     lv_style_res_t found;
 
     found = get_selector_style_prop(obj, selector, prop, &value_act);
-    if(found == LV_STYLE_RES_FOUND) return value_act;
+    if(found != LV_STYLE_RES_FOUND) value_act = lv_style_prop_get_default(prop);
 
-    return lv_style_prop_get_default(prop);
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    if(resolved) resolved_add(resolved, prop, value_act);
+#endif
+
+    return value_act;
 }
 
 bool lv_obj_has_style_prop(const lv_obj_t * obj, lv_style_selector_t selector, lv_style_prop_t prop)
@@ -602,6 +623,44 @@ lv_opa_t lv_obj_get_style_opa_recursive(const lv_obj_t * obj, lv_part_t part)
     return opa_final;
 }
 
+void _lv_obj_style_resolved_invalidate(lv_obj_t * obj, bool recursive)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    _lv_obj_style_resolved_t * resolved;
+    for(resolved = obj->style_resolved; resolved; resolved = resolved->next) {
+        lv_memzero(resolved->index, sizeof(resolved->index));
+        resolved->value_cnt = 0;
+    }
+
+    if(recursive) {
+        uint32_t i;
+        uint32_t child_cnt = lv_obj_get_child_count(obj);
+        for(i = 0; i < child_cnt; i++) {
+            _lv_obj_style_resolved_invalidate(obj->spec_attr->children[i], true);
+        }
+    }
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(recursive);
+#endif
+}
+
+void _lv_obj_style_resolved_free(lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+    _lv_obj_style_resolved_t * resolved = obj->style_resolved;
+    while(resolved) {
+        _lv_obj_style_resolved_t * next = resolved->next;
+        lv_free(resolved->values);
+        lv_free(resolved);
+        resolved = next;
+    }
+    obj->style_resolved = NULL;
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 void _lv_obj_update_layer_type(lv_obj_t * obj)
 {
     lv_layer_type_t layer_type = calculate_layer_type(obj);
@@ -819,6 +878,7 @@ static bool trans_delete(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, t
             _lv_ll_remove(style_trans_ll_p, tr);
             lv_free(tr);
             removed = true;
+            _lv_obj_style_resolved_invalidate(obj, true);
 
         }
         tr = tr_prev;
@@ -940,6 +1000,7 @@ static void trans_anim_completed_cb(lv_anim_t * a)
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
                 lv_style_remove_prop((lv_style_t *)obj_style->style, prop);
+                _lv_obj_style_resolved_invalidate(obj, lv_style_prop_has_flag(prop, LV_STYLE_PROP_FLAG_INHERITABLE));
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, (lv_style_t *)obj_style->style, obj_style->selector);
@@ -1118,3 +1179,56 @@ static lv_style_res_t get_selector_style_prop(const lv_obj_t * obj, lv_style_sel
 
     return LV_STYLE_RES_NOT_FOUND;
 }
+
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * Get the cache of the resolved properties of an object's part. Create it if not exists yet
+ * and drop its content if it was created in an other state.
+ * @param obj       pointer to an object
+ * @param part      the part whose cache should be get
+ * @return          the cache or NULL if it couldn't be allocated
+ */
+static _lv_obj_style_resolved_t * get_resolved(lv_obj_t * obj, lv_part_t part)
+{
+    _lv_obj_style_resolved_t * resolved;
+    for(resolved = obj->style_resolved; resolved; resolved = resolved->next) {
+        if(resolved->part == part) break;
+    }
+
+    if(resolved == NULL) {
+        resolved = lv_malloc(sizeof(_lv_obj_style_resolved_t));
+        if(resolved == NULL) return NULL;
+
+        lv_memzero(resolved, sizeof(_lv_obj_style_resolved_t));
+        resolved->part = part;
+        resolved->state = obj->state;
+        resolved->next = obj->style_resolved;
+        obj->style_resolved = resolved;
+    }
+    else if(resolved->state != obj->state) {
+        lv_memzero(resolved->index, sizeof(resolved->index));
+        resolved->value_cnt = 0;
+        resolved->state = obj->state;
+    }
+
+    return resolved;
+}
+
+static void resolved_add(_lv_obj_style_resolved_t * resolved, lv_style_prop_t prop, lv_style_value_t value)
+{
+    if(resolved->value_cnt == resolved->value_size) {
+        uint32_t new_size = resolved->value_size ? resolved->value_size * 2 : 16;
+        if(new_size > _LV_STYLE_NUM_BUILT_IN_PROPS) new_size = _LV_STYLE_NUM_BUILT_IN_PROPS;
+
+        lv_style_value_t * new_values = lv_realloc(resolved->values, new_size * sizeof(lv_style_value_t));
+        if(new_values == NULL) return;
+
+        resolved->values = new_values;
+        resolved->value_size = (uint8_t)new_size;
+    }
+
+    resolved->values[resolved->value_cnt] = value;
+    resolved->value_cnt++;
+    resolved->index[prop] = resolved->value_cnt;
+}
+#endif
@@ -62,6 +62,22 @@ typedef struct {
     void * user_data;
 } _lv_obj_style_transition_dsc_t;
 
+#if LV_OBJ_STYLE_RESOLVED_CACHE
+/**
+ * The resolved values of the style properties of an object's part in a given state.
+ * The values are filled lazily, `index[prop]` is the 1-based index of the property's value in `values`.
+ */
+typedef struct _lv_obj_style_resolved_t {
+    struct _lv_obj_style_resolved_t * next;
+    lv_style_value_t * values;
+    lv_part_t part;
+    lv_state_t state;
+    uint8_t value_cnt;
+    uint8_t value_size;
+    uint8_t index[_LV_STYLE_NUM_BUILT_IN_PROPS];
+} _lv_obj_style_resolved_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -358,6 +374,20 @@ lv_opa_t lv_obj_get_style_opa_recursive(const lv_obj_t * obj, lv_part_t part);
  */
 void _lv_obj_update_layer_type(lv_obj_t * obj);
 
+/**
+ * Drop the cached resolved style properties of an object.
+ * Used internally when something changed which can affect the resolved style, e.g. the parent.
+ * @param obj       pointer to an object
+ * @param recursive true: drop the cache of the children too as they might inherit the changed properties
+ */
+void _lv_obj_style_resolved_invalidate(lv_obj_t * obj, bool recursive);
+
+/**
+ * Free the cached resolved style properties of an object. Called when the object is deleted.
+ * @param obj       pointer to an object
+ */
+void _lv_obj_style_resolved_free(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -17,6 +17,8 @@
 #include "../draw/lv_draw.h"
 #include "../font/lv_font_fmt_txt.h"
 #include "../stdlib/lv_string.h"
+#include "../misc/cache/lv_image_cache.h"
+#include "../others/observer/lv_observer.h"
 #include "lv_global.h"
 
 /*********************
@@ -26,10 +28,26 @@
 /*Display being refreshed*/
 #define disp_refr LV_GLOBAL_DEFAULT()->disp_refresh
 
+#define bitmap_cache_ll_p &(LV_GLOBAL_DEFAULT()->bitmap_cache_ll)
+
+/*Only the software renderer can clip the rounded corners while blending*/
+#define CLIP_CORNER_IN_BLEND    (LV_USE_DRAW_SW && LV_DRAW_SW_COMPLEX && !LV_USE_DRAW_VGLITE && !LV_USE_DRAW_PXP && \
+                                 !LV_USE_DRAW_VG_LITE && !LV_USE_DRAW_SDL && !LV_USE_DRAW_DAVE2D)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+struct _lv_obj_bitmap_cache_t {
+    lv_obj_t * obj;
+    lv_draw_buf_t * draw_buf;
+    uint32_t stamp;         /**< Value of `bitmap_cache_stamp` when it was drawn last time*/
+    uint8_t valid : 1;      /**< 0: the object or its children has changed since rendering*/
+};
+typedef struct _lv_obj_bitmap_cache_t lv_obj_bitmap_cache_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -45,6 +63,13 @@ static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 static void draw_buf_flush(lv_display_t * disp);
 static void call_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 static void wait_for_flushing(lv_display_t * disp);
+static void obj_send_draw_event(lv_obj_t * obj, lv_event_code_t code, lv_layer_t * layer);
+static void layer_draw_dsc_init(lv_obj_t * obj, lv_draw_image_dsc_t * dsc, lv_opa_t opa, const lv_area_t * buf_area);
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    static lv_result_t bitmap_cache_draw(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type);
+    static lv_obj_bitmap_cache_t * bitmap_cache_get(lv_obj_t * obj, const lv_area_t * draw_area);
+    static void bitmap_cache_render(lv_obj_t * obj, lv_draw_buf_t * draw_buf, const lv_area_t * draw_area);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -68,10 +93,19 @@ static void wait_for_flushing(lv_display_t * disp);
  */
 void _lv_refr_init(void)
 {
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    _lv_ll_init(bitmap_cache_ll_p, sizeof(lv_obj_bitmap_cache_t));
+#endif
 }
 
 void _lv_refr_deinit(void)
 {
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    lv_obj_bitmap_cache_t * cache;
+    while((cache = _lv_ll_get_head(bitmap_cache_ll_p)) != NULL) {
+        _lv_refr_bitmap_cache_free(cache->obj);
+    }
+#endif
 }
 
 void lv_refr_now(lv_display_t * disp)
@@ -106,9 +140,9 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
     /*If the object is visible on the current clip area*/
     layer->_clip_area = clip_coords_for_obj;
 
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN, layer);
-    lv_obj_send_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
+    obj_send_draw_event(obj, LV_EVENT_DRAW_MAIN_BEGIN, layer);
+    obj_send_draw_event(obj, LV_EVENT_DRAW_MAIN, layer);
+    obj_send_draw_event(obj, LV_EVENT_DRAW_MAIN_END, layer);
 #if LV_USE_REFR_DEBUG
     lv_color_t debug_color = lv_color_make(lv_rand(0, 0xFF), lv_rand(0, 0xFF), lv_rand(0, 0xFF));
     lv_draw_rect_dsc_t draw_dsc;
@@ -141,9 +175,9 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
             /*If the object was visible on the clip area call the post draw events too*/
             layer->_clip_area = clip_coords_for_obj;
             /*If all the children are redrawn make 'post draw' draw*/
-            lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
-            lv_obj_send_event(obj, LV_EVENT_DRAW_POST, layer);
-            lv_obj_send_event(obj, LV_EVENT_DRAW_POST_END, layer);
+            obj_send_draw_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
+            obj_send_draw_event(obj, LV_EVENT_DRAW_POST, layer);
+            obj_send_draw_event(obj, LV_EVENT_DRAW_POST_END, layer);
         }
         else {
             layer->_clip_area = clip_coords_for_children;
@@ -155,7 +189,15 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 if(radius == 0) clip_corner = false;
             }
 
-            if(clip_corner == false) {
+            /*Draw the children only once and clip the corners while blending.
+             *If a parent has already set a rounded clip area, use layers for the inner one.*/
+            bool clip_corner_in_blend = clip_corner && CLIP_CORNER_IN_BLEND && layer->_clip_corner_radius == 0;
+            if(clip_corner_in_blend) {
+                layer->_clip_corner_area = obj->coords;
+                layer->_clip_corner_radius = radius;
+            }
+
+            if(clip_corner == false || clip_corner_in_blend) {
                 for(i = 0; i < child_cnt; i++) {
                     lv_obj_t * child = obj->spec_attr->children[i];
                     refr_obj(layer, child);
@@ -164,9 +206,11 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                 /*If the object was visible on the clip area call the post draw events too*/
                 layer->_clip_area = clip_coords_for_obj;
                 /*If all the children are redrawn make 'post draw' draw*/
-                lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
-                lv_obj_send_event(obj, LV_EVENT_DRAW_POST, layer);
-                lv_obj_send_event(obj, LV_EVENT_DRAW_POST_END, layer);
+                obj_send_draw_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
+                obj_send_draw_event(obj, LV_EVENT_DRAW_POST, layer);
+                obj_send_draw_event(obj, LV_EVENT_DRAW_POST_END, layer);
+
+                layer->_clip_corner_radius = 0;
             }
             else {
                 lv_layer_t * layer_children;
@@ -192,9 +236,9 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                     }
 
                     /*If all the children are redrawn send 'post draw' draw*/
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST, layer_children);
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST_END, layer_children);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST, layer_children);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST_END, layer_children);
 
                     lv_draw_mask_rect(layer_children, &mask_draw_dsc);
 
@@ -213,9 +257,9 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                     }
 
                     /*If all the children are redrawn send 'post draw' draw*/
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST, layer_children);
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST_END, layer_children);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer_children);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST, layer_children);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST_END, layer_children);
 
                     lv_draw_mask_rect(layer_children, &mask_draw_dsc);
 
@@ -235,9 +279,9 @@ void lv_obj_redraw(lv_layer_t * layer, lv_obj_t * obj)
                     }
 
                     /*If all the children are redrawn make 'post draw' draw*/
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST, layer);
-                    lv_obj_send_event(obj, LV_EVENT_DRAW_POST_END, layer);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST_BEGIN, layer);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST, layer);
+                    obj_send_draw_event(obj, LV_EVENT_DRAW_POST_END, layer);
 
                 }
 
@@ -321,6 +365,37 @@ void _lv_refr_set_disp_refreshing(lv_display_t * disp)
     disp_refr = disp;
 }
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+
+void _lv_refr_bitmap_cache_invalidate(const lv_obj_t * obj)
+{
+    if(_lv_ll_get_head(bitmap_cache_ll_p) == NULL) return;
+
+    /*Changing an object changes the look of its cached parents too*/
+    while(obj) {
+        if(obj->spec_attr && obj->spec_attr->bitmap_cache) {
+            obj->spec_attr->bitmap_cache->valid = 0;
+        }
+        obj = obj->parent;
+    }
+}
+
+void _lv_refr_bitmap_cache_free(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->bitmap_cache == NULL) return;
+
+    lv_obj_bitmap_cache_t * cache = obj->spec_attr->bitmap_cache;
+    LV_GLOBAL_DEFAULT()->bitmap_cache_used -= cache->draw_buf->data_size;
+    lv_image_cache_drop(cache->draw_buf);
+    lv_draw_buf_destroy(cache->draw_buf);
+
+    _lv_ll_remove(bitmap_cache_ll_p, cache);
+    lv_free(cache);
+    obj->spec_attr->bitmap_cache = NULL;
+}
+
+#endif /*LV_OBJ_BITMAP_CACHE_SIZE*/
+
 void _lv_display_refr_timer(lv_timer_t * tmr)
 {
     LV_PROFILER_BEGIN;
@@ -350,6 +425,11 @@ void _lv_display_refr_timer(lv_timer_t * tmr)
         return;
     }
 
+#if LV_USE_OBSERVER
+    /*Send the deferred notifications first as the observers might invalidate and change widgets*/
+    _lv_subject_notify_deferred();
+#endif
+
     lv_display_send_event(disp_refr, LV_EVENT_REFR_START, NULL);
 
     /*Refresh the screen's layout if required*/
@@ -556,6 +636,7 @@ static void refr_invalid_areas(void)
     disp_refr->last_area = 0;
     disp_refr->last_part = 0;
     disp_refr->rendering_in_progress = true;
+    disp_refr->skipped_draw_event_cnt = 0;
 
     for(i = 0; i < (int32_t)disp_refr->inv_p; i++) {
         /*Refresh the unjoined areas*/
@@ -672,6 +753,11 @@ static void refr_area_part(lv_layer_t * layer)
     LV_PROFILER_BEGIN;
     disp_refr->refreshed_area = layer->_clip_area;
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    /*All the draw tasks of the previous area are finished so their retained images can be freed*/
+    LV_GLOBAL_DEFAULT()->bitmap_cache_stamp++;
+#endif
+
     /* In single buffered mode wait here until the buffer is freed.
      * Else we would draw into the buffer while it's still being transferred to the display*/
     if(!lv_display_is_double_buffered(disp_refr)) {
@@ -812,9 +898,9 @@ static void refr_obj_and_children(lv_layer_t * layer, lv_obj_t * top_obj)
         }
 
         /*Call the post draw draw function of the parents of the to object*/
-        lv_obj_send_event(parent, LV_EVENT_DRAW_POST_BEGIN, (void *)layer);
-        lv_obj_send_event(parent, LV_EVENT_DRAW_POST, (void *)layer);
-        lv_obj_send_event(parent, LV_EVENT_DRAW_POST_END, (void *)layer);
+        obj_send_draw_event(parent, LV_EVENT_DRAW_POST_BEGIN, (void *)layer);
+        obj_send_draw_event(parent, LV_EVENT_DRAW_POST, (void *)layer);
+        obj_send_draw_event(parent, LV_EVENT_DRAW_POST_END, (void *)layer);
 
         /*The new border will be the last parents,
          *so the 'younger' brothers of parent will be refreshed*/
@@ -883,11 +969,50 @@ static bool alpha_test_area_on_obj(lv_obj_t * obj, const lv_area_t * area)
     else return true;
 }
 
+static void layer_draw_dsc_init(lv_obj_t * obj, lv_draw_image_dsc_t * dsc, lv_opa_t opa, const lv_area_t * buf_area)
+{
+    lv_point_t pivot = {
+        .x = lv_obj_get_style_transform_pivot_x(obj, 0),
+        .y = lv_obj_get_style_transform_pivot_y(obj, 0)
+    };
+
+    if(LV_COORD_IS_PCT(pivot.x)) {
+        pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
+    }
+    if(LV_COORD_IS_PCT(pivot.y)) {
+        pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
+    }
+
+    lv_draw_image_dsc_init(dsc);
+    dsc->pivot.x = obj->coords.x1 + pivot.x - buf_area->x1;
+    dsc->pivot.y = obj->coords.y1 + pivot.y - buf_area->y1;
+
+    dsc->opa = opa;
+    dsc->rotation = lv_obj_get_style_transform_rotation(obj, 0);
+    while(dsc->rotation > 3600) dsc->rotation -= 3600;
+    while(dsc->rotation < 0) dsc->rotation += 3600;
+    dsc->scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
+    dsc->scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
+    dsc->skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
+    dsc->skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
+    dsc->blend_mode = lv_obj_get_style_blend_mode(obj, 0);
+    dsc->antialias = disp_refr->antialiasing;
+    dsc->bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
+}
+
 void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
 {
     if(lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
 
     lv_layer_type_t layer_type = _lv_obj_get_layer_type(obj);
+
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    /*Draw the retained image if possible, else draw the object normally*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP)) {
+        if(bitmap_cache_draw(layer, obj, layer_type) == LV_RESULT_OK) return;
+    }
+#endif
+
     if(layer_type == LV_LAYER_TYPE_NONE) {
         lv_obj_redraw(layer, obj);
     }
@@ -931,34 +1056,8 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
                                                           area_need_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE, &layer_area_act);
             lv_obj_redraw(new_layer, obj);
 
-            lv_point_t pivot = {
-                .x = lv_obj_get_style_transform_pivot_x(obj, 0),
-                .y = lv_obj_get_style_transform_pivot_y(obj, 0)
-            };
-
-            if(LV_COORD_IS_PCT(pivot.x)) {
-                pivot.x = (LV_COORD_GET_PCT(pivot.x) * lv_area_get_width(&obj->coords)) / 100;
-            }
-            if(LV_COORD_IS_PCT(pivot.y)) {
-                pivot.y = (LV_COORD_GET_PCT(pivot.y) * lv_area_get_height(&obj->coords)) / 100;
-            }
-
             lv_draw_image_dsc_t layer_draw_dsc;
-            lv_draw_image_dsc_init(&layer_draw_dsc);
-            layer_draw_dsc.pivot.x = obj->coords.x1 + pivot.x - new_layer->buf_area.x1;
-            layer_draw_dsc.pivot.y = obj->coords.y1 + pivot.y - new_layer->buf_area.y1;
-
-            layer_draw_dsc.opa = opa;
-            layer_draw_dsc.rotation = lv_obj_get_style_transform_rotation(obj, 0);
-            while(layer_draw_dsc.rotation > 3600) layer_draw_dsc.rotation -= 3600;
-            while(layer_draw_dsc.rotation < 0) layer_draw_dsc.rotation += 3600;
-            layer_draw_dsc.scale_x = lv_obj_get_style_transform_scale_x(obj, 0);
-            layer_draw_dsc.scale_y = lv_obj_get_style_transform_scale_y(obj, 0);
-            layer_draw_dsc.skew_x = lv_obj_get_style_transform_skew_x(obj, 0);
-            layer_draw_dsc.skew_y = lv_obj_get_style_transform_skew_y(obj, 0);
-            layer_draw_dsc.blend_mode = lv_obj_get_style_blend_mode(obj, 0);
-            layer_draw_dsc.antialias = disp_refr->antialiasing;
-            layer_draw_dsc.bitmap_mask_src = lv_obj_get_style_bitmap_mask_src(obj, 0);
+            layer_draw_dsc_init(obj, &layer_draw_dsc, opa, &new_layer->buf_area);
             layer_draw_dsc.image_area = obj_draw_size;
             layer_draw_dsc.src = new_layer;
 
@@ -969,6 +1068,155 @@ void refr_obj(lv_layer_t * layer, lv_obj_t * obj)
     }
 }
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+
+/**
+ * Draw an object and its children from their retained image.
+ * @param layer         the layer to draw to
+ * @param obj           an object with `LV_OBJ_FLAG_CACHE_AS_BITMAP`
+ * @param layer_type    the layer type of the object
+ * @return              LV_RESULT_OK: handled (drawn or not visible);
+ *                      LV_RESULT_INVALID: there is no image, the object needs to be drawn normally
+ */
+static lv_result_t bitmap_cache_draw(lv_layer_t * layer, lv_obj_t * obj, lv_layer_type_t layer_type)
+{
+    lv_opa_t opa = LV_OPA_COVER;
+    if(layer_type != LV_LAYER_TYPE_NONE) {
+        opa = lv_obj_get_style_opa_layered(obj, 0);
+        if(opa < LV_OPA_MIN) return LV_RESULT_OK;
+    }
+
+    lv_area_t draw_area;
+    int32_t ext_draw_size = _lv_obj_get_ext_draw_size(obj);
+    lv_obj_get_coords(obj, &draw_area);
+    lv_area_increase(&draw_area, ext_draw_size, ext_draw_size);
+
+    /*Don't render the image of objects which are not visible*/
+    if(layer_type == LV_LAYER_TYPE_TRANSFORM) {
+        lv_area_t tranf_area = draw_area;
+        lv_obj_get_transformed_area(obj, &tranf_area, LV_OBJ_POINT_TRANSFORM_FLAG_NONE);
+        if(!_lv_area_is_on(&layer->_clip_area, &tranf_area)) return LV_RESULT_OK;
+    }
+    else if(!_lv_area_is_on(&layer->_clip_area, &draw_area)) {
+        return LV_RESULT_OK;
+    }
+
+    lv_obj_bitmap_cache_t * cache = bitmap_cache_get(obj, &draw_area);
+    if(cache == NULL) return LV_RESULT_INVALID;
+
+    /*Apply the layer's opacity and transformation on the image directly*/
+    lv_draw_image_dsc_t draw_dsc;
+    if(layer_type != LV_LAYER_TYPE_NONE) layer_draw_dsc_init(obj, &draw_dsc, opa, &draw_area);
+    else lv_draw_image_dsc_init(&draw_dsc);
+    draw_dsc.src = cache->draw_buf;
+    lv_draw_image(layer, &draw_dsc, &draw_area);
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Get the retained image of an object. Render it if it's missing or outdated.
+ * @param obj           an object with `LV_OBJ_FLAG_CACHE_AS_BITMAP`
+ * @param draw_area     the area of the object including its extra draw size
+ * @return              the cache entry or NULL if the image can't be retained now
+ */
+static lv_obj_bitmap_cache_t * bitmap_cache_get(lv_obj_t * obj, const lv_area_t * draw_area)
+{
+    lv_global_t * global = LV_GLOBAL_DEFAULT();
+    int32_t w = lv_area_get_width(draw_area);
+    int32_t h = lv_area_get_height(draw_area);
+
+    lv_obj_bitmap_cache_t * cache = obj->spec_attr ? obj->spec_attr->bitmap_cache : NULL;
+    if(cache) {
+        /*Moving the object (e.g. by scrolling its parent) doesn't change its look, only its size matters*/
+        if(cache->valid && cache->draw_buf->header.w == w && cache->draw_buf->header.h == h) {
+            cache->stamp = global->bitmap_cache_stamp;
+            _lv_ll_move_before(bitmap_cache_ll_p, cache, _lv_ll_get_head(bitmap_cache_ll_p));
+            return cache;
+        }
+
+        /*The image might be still waiting to be drawn. Can't render into it now.*/
+        if(cache->stamp == global->bitmap_cache_stamp) return NULL;
+
+        _lv_refr_bitmap_cache_free(obj);
+    }
+
+    lv_color_format_t cf = alpha_test_area_on_obj(obj, draw_area) ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE;
+    uint32_t size = h * lv_draw_buf_width_to_stride(w, cf);
+    if(size > LV_OBJ_BITMAP_CACHE_SIZE) return NULL;
+
+    /*Free the least recently drawn images to fit into the budget.
+     *The images drawn in the current area might be still in use, so keep them.*/
+    while(global->bitmap_cache_used + size > LV_OBJ_BITMAP_CACHE_SIZE) {
+        lv_obj_bitmap_cache_t * lru = _lv_ll_get_tail(bitmap_cache_ll_p);
+        if(lru == NULL || lru->stamp == global->bitmap_cache_stamp) return NULL;
+        _lv_refr_bitmap_cache_free(lru->obj);
+    }
+
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(w, h, cf, 0);
+    if(draw_buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate the image of the object");
+        return NULL;
+    }
+
+    lv_obj_allocate_spec_attr(obj);
+    cache = _lv_ll_ins_head(bitmap_cache_ll_p);
+    LV_ASSERT_MALLOC(cache);
+    if(cache == NULL) {
+        lv_draw_buf_destroy(draw_buf);
+        return NULL;
+    }
+
+    cache->obj = obj;
+    cache->draw_buf = draw_buf;
+    cache->stamp = global->bitmap_cache_stamp;
+    cache->valid = 1;
+    obj->spec_attr->bitmap_cache = cache;
+    global->bitmap_cache_used += draw_buf->data_size;
+
+    bitmap_cache_render(obj, draw_buf, draw_area);
+
+    return cache;
+}
+
+/**
+ * Render an object and its children into a draw buffer and wait until it's ready
+ * @param obj           pointer to an object
+ * @param draw_buf      the draw buffer to render to. Its size should be the size of `draw_area`.
+ * @param draw_area     the area of the object including its extra draw size
+ */
+static void bitmap_cache_render(lv_obj_t * obj, lv_draw_buf_t * draw_buf, const lv_area_t * draw_area)
+{
+    LV_PROFILER_BEGIN;
+    if(lv_color_format_has_alpha(draw_buf->header.cf)) {
+        lv_draw_buf_clear(draw_buf, NULL);
+    }
+
+    lv_layer_t layer;
+    lv_memzero(&layer, sizeof(layer));
+    layer.draw_buf = draw_buf;
+    layer.color_format = draw_buf->header.cf;
+    layer.buf_area = *draw_area;
+    layer._clip_area = *draw_area;
+
+    /*Dispatch only the tasks of this layer (and its child layers) until it's ready.
+     *The tasks of the display's layers will continue later.*/
+    lv_layer_t * layer_head_ori = disp_refr->layer_head;
+    disp_refr->layer_head = &layer;
+
+    lv_obj_redraw(&layer, obj);
+
+    while(layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+
+    disp_refr->layer_head = layer_head_ori;
+    LV_PROFILER_END;
+}
+
+#endif /*LV_OBJ_BITMAP_CACHE_SIZE*/
+
 static uint32_t get_max_row(lv_display_t * disp, int32_t area_w, int32_t area_h)
 {
     bool has_alpha = lv_color_format_has_alpha(disp->color_format);
@@ -1090,3 +1338,19 @@ static void wait_for_flushing(lv_display_t * disp)
     LV_LOG_TRACE("end");
     LV_PROFILER_END;
 }
+
+/**
+ * Send a draw event to an object unless it's known that no one can react to it
+ * @param obj       pointer to an object
+ * @param code      a draw event code
+ * @param layer     the layer to draw to
+ */
+static void obj_send_draw_event(lv_obj_t * obj, lv_event_code_t code, lv_layer_t * layer)
+{
+    if(_lv_obj_event_can_skip(obj, code)) {
+        if(disp_refr) disp_refr->skipped_draw_event_cnt++;
+        return;
+    }
+
+    lv_obj_send_event(obj, code, layer);
+}
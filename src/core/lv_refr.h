@@ -87,6 +87,23 @@ lv_display_t * _lv_refr_get_disp_refreshing(void);
  */
 void _lv_refr_set_disp_refreshing(lv_display_t * disp);
 
+#if LV_OBJ_BITMAP_CACHE_SIZE
+
+/**
+ * Mark the retained image of an object and its parents as outdated.
+ * Called when the object is invalidated.
+ * @param obj   pointer to an object
+ */
+void _lv_refr_bitmap_cache_invalidate(const lv_obj_t * obj);
+
+/**
+ * Free the retained image of an object
+ * @param obj   pointer to an object
+ */
+void _lv_refr_bitmap_cache_free(lv_obj_t * obj);
+
+#endif /*LV_OBJ_BITMAP_CACHE_SIZE*/
+
 /**
  * Called periodically to handle the refreshing
  * @param timer pointer to the timer itself
@@ -850,6 +850,14 @@ void lv_display_trigger_activity(lv_display_t * disp)
     disp->last_activity_time = lv_tick_get();
 }
 
+uint32_t lv_display_get_skipped_draw_event_count(lv_display_t * disp)
+{
+    if(!disp) disp = lv_display_get_default();
+    if(!disp) return 0;
+
+    return disp->skipped_draw_event_cnt;
+}
+
 void lv_display_enable_invalidation(lv_display_t * disp, bool en)
 {
     if(!disp) disp = lv_display_get_default();
@@ -502,6 +502,14 @@ uint32_t lv_display_get_inactive_time(const lv_display_t * disp);
  */
 void lv_display_trigger_activity(lv_display_t * disp);
 
+/**
+ * Get how many draw events were not sent in the last refresh because neither the widgets' classes
+ * nor their event handlers could react to them.
+ * @param disp      pointer to a display (NULL to use the default display)
+ * @return          number of skipped draw events
+ */
+uint32_t lv_display_get_skipped_draw_event_count(lv_display_t * disp);
+
 /**
  * Temporarily enable and disable the invalidation of the display.
  * @param disp      pointer to a display (NULL to use the default display)
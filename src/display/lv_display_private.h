@@ -146,6 +146,9 @@ struct _lv_display_t {
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
 
+    /** Number of draw events not sent in the last refresh as no one could react to them*/
+    uint32_t skipped_draw_event_cnt;
+
     /** The area being refreshed*/
     lv_area_t refreshed_area;
 };
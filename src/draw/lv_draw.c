@@ -89,6 +89,8 @@ lv_draw_task_t * lv_draw_add_task(lv_layer_t * layer, const lv_area_t * coords)
     new_task->area = *coords;
     new_task->_real_area = *coords;
     new_task->clip_area = layer->_clip_area;
+    new_task->clip_corner_area = layer->_clip_corner_area;
+    new_task->clip_corner_radius = layer->_clip_corner_radius;
     new_task->state = LV_DRAW_TASK_STATE_QUEUED;
 
     /*Find the tail*/
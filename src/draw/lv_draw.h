@@ -79,6 +79,14 @@ struct _lv_draw_task_t {
      */
     lv_area_t clip_area;
 
+    /**
+     * The rounded clip area of the layer saved when the draw task was created.
+     * Used only if `clip_corner_radius > 0`.
+     */
+    lv_area_t clip_corner_area;
+
+    int32_t clip_corner_radius;
+
     volatile int state;              /*int instead of lv_draw_task_state_t to be sure its atomic*/
 
     void * draw_dsc;
@@ -112,6 +120,14 @@ struct _lv_draw_unit_t {
 
     const lv_area_t * clip_area;
 
+    /**
+     * Besides `clip_area` clip the rounded corners of this area too.
+     * Used only if `clip_corner_radius > 0`.
+     */
+    const lv_area_t * clip_corner_area;
+
+    int32_t clip_corner_radius;
+
     /**
      * Called to try to assign a draw task to itself.
      * `lv_draw_get_next_available_task` can be used to get an independent draw task.
@@ -165,6 +181,15 @@ struct _lv_layer_t  {
      */
     lv_area_t _clip_area;
 
+    /**
+     * NEVER USE IT DRAW UNITS. USED INTERNALLY DURING DRAW TASK CREATION.
+     * If `_clip_corner_radius > 0` the draw tasks are clipped to this area with rounded corners too.
+     * Saved in the new draw tasks similarly to `_clip_area`.
+     */
+    lv_area_t _clip_corner_area;
+
+    int32_t _clip_corner_radius;
+
     /** Linked list of draw tasks */
     lv_draw_task_t * draw_task_head;
 
@@ -193,6 +218,8 @@ typedef struct {
     int dispatch_req;
 #endif
     lv_mutex_t circle_cache_mutex;
+    lv_mutex_t mipmap_mutex;
+    bool mipmap_disabled;   /**< Set by `lv_draw_sw_enable_mipmap()`*/
     bool task_running;
 } lv_draw_global_info_t;
 
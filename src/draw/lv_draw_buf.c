@@ -164,16 +164,10 @@ void lv_draw_buf_clear(lv_draw_buf_t * draw_buf, const lv_area_t * a)
     else {
         uint8_t * bufc;
         uint32_t line_length;
-        int32_t start_y, end_y;
         uint8_t px_size = lv_color_format_get_size(header->cf);
         bufc = lv_draw_buf_goto_xy(draw_buf, a->x1, a->y1);
         line_length = lv_area_get_width(a) * px_size;
-        start_y = a->y1;
-        end_y = a->y2;
-        for(; start_y <= end_y; start_y++) {
-            lv_memzero(bufc, line_length);
-            bufc += stride;
-        }
+        lv_memset_2d(bufc, stride, 0x00, line_length, lv_area_get_height(a));
     }
 }
 
@@ -211,25 +205,15 @@ void lv_draw_buf_copy(lv_draw_buf_t * dest, const lv_area_t * dest_area,
     if(dest_area) dest_bufc = lv_draw_buf_goto_xy(dest, dest_area->x1, dest_area->y1);
     else dest_bufc = lv_draw_buf_goto_xy(dest, 0, 0);
 
-    int32_t start_y, end_y;
-    if(dest_area) {
-        start_y = dest_area->y1;
-        end_y = dest_area->y2;
-    }
-    else {
-        start_y = 0;
-        end_y = dest->header.h - 1;
-    }
+    int32_t line_cnt;
+    if(dest_area) line_cnt = lv_area_get_height(dest_area);
+    else line_cnt = dest->header.h;
 
     uint32_t dest_stride = dest->header.stride;
     uint32_t src_stride = src->header.stride;
     uint32_t line_bytes = (line_width * lv_color_format_get_bpp(dest->header.cf) + 7) >> 3;
 
-    for(; start_y <= end_y; start_y++) {
-        lv_memcpy(dest_bufc, src_bufc, line_bytes);
-        dest_bufc += dest_stride;
-        src_bufc += src_stride;
-    }
+    lv_memcpy_2d(dest_bufc, dest_stride, src_bufc, src_stride, line_bytes, line_cnt);
 }
 
 lv_result_t lv_draw_buf_init(lv_draw_buf_t * draw_buf, uint32_t w, uint32_t h, lv_color_format_t cf, uint32_t stride,
@@ -30,6 +30,11 @@ static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
                                 lv_draw_image_core_cb draw_core_cb);
+static void get_decoder_args(lv_image_decoder_args_t * args, const lv_draw_image_dsc_t * draw_dsc);
+static lv_draw_buf_t * decode_whole(lv_image_decoder_dsc_t * decoder_dsc);
+static void get_downscaled_dsc(lv_draw_image_dsc_t * res, lv_area_t * res_coords,
+                               const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * coords,
+                               const lv_image_header_t * orig_header, const lv_image_header_t * header);
 
 /**********************
  *  STATIC VARIABLES
@@ -69,9 +74,7 @@ void lv_draw_layer(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
     t->type = LV_DRAW_TASK_TYPE_LAYER;
     t->state = LV_DRAW_TASK_STATE_WAITING;
 
-    _lv_image_buf_get_transformed_area(&t->_real_area, lv_area_get_width(coords), lv_area_get_height(coords),
-                                       dsc->rotation, dsc->scale_x, dsc->scale_y, &dsc->pivot);
-    lv_area_move(&t->_real_area, coords->x1, coords->y1);
+    _lv_draw_image_get_transformed_area(&t->_real_area, coords, dsc);
 
     lv_layer_t * layer_to_draw = (lv_layer_t *)dsc->src;
     layer_to_draw->all_tasks_added = true;
@@ -102,9 +105,7 @@ void lv_draw_image(lv_layer_t * layer, const lv_draw_image_dsc_t * dsc, const lv
     t->draw_dsc = new_image_dsc;
     t->type = LV_DRAW_TASK_TYPE_IMAGE;
 
-    _lv_image_buf_get_transformed_area(&t->_real_area, lv_area_get_width(coords), lv_area_get_height(coords),
-                                       dsc->rotation, dsc->scale_x, dsc->scale_y, &dsc->pivot);
-    lv_area_move(&t->_real_area, coords->x1, coords->y1);
+    _lv_draw_image_get_transformed_area(&t->_real_area, coords, dsc);
 
     lv_draw_finalize_task_creation(layer, t);
     LV_PROFILER_END;
@@ -136,33 +137,61 @@ void _lv_draw_image_normal_helper(lv_draw_unit_t * draw_unit, const lv_draw_imag
     }
 
     lv_area_t draw_area;
-    lv_area_copy(&draw_area, coords);
-    if(draw_dsc->rotation || draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) {
-        int32_t w = lv_area_get_width(coords);
-        int32_t h = lv_area_get_height(coords);
-
-        _lv_image_buf_get_transformed_area(&draw_area, w, h, draw_dsc->rotation, draw_dsc->scale_x, draw_dsc->scale_y,
-                                           &draw_dsc->pivot);
-
-        draw_area.x1 += coords->x1;
-        draw_area.y1 += coords->y1;
-        draw_area.x2 += coords->x1;
-        draw_area.y2 += coords->y1;
-    }
+    _lv_draw_image_get_transformed_area(&draw_area, coords, draw_dsc);
 
     lv_area_t clipped_img_area;
     if(!_lv_area_intersect(&clipped_img_area, &draw_area, draw_unit->clip_area)) {
         return;
     }
 
+    lv_image_decoder_args_t args;
+    get_decoder_args(&args, draw_dsc);
+
     lv_image_decoder_dsc_t decoder_dsc;
-    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, NULL);
+    lv_result_t res = lv_image_decoder_open(&decoder_dsc, draw_dsc->src, &args);
     if(res != LV_RESULT_OK) {
         LV_LOG_ERROR("Failed to open image");
         return;
     }
 
-    img_decode_and_draw(draw_unit, draw_dsc, &decoder_dsc, NULL, coords, &clipped_img_area, draw_core_cb);
+    /*Transformations need the whole image, not only pieces of it*/
+    lv_draw_buf_t * whole = NULL;
+    const lv_draw_buf_t * piece = NULL;
+    if(decoder_dsc.decoded == NULL && (draw_dsc->rotation != 0 || draw_dsc->scale_x != LV_SCALE_NONE ||
+                                       draw_dsc->scale_y != LV_SCALE_NONE || draw_dsc->skew_x != 0 ||
+                                       draw_dsc->skew_y != 0)) {
+        whole = decode_whole(&decoder_dsc);
+        if(whole == NULL) {
+            LV_LOG_WARN("Failed to decode the whole image");
+            lv_image_decoder_close(&decoder_dsc);
+            return;
+        }
+        /*Keep the decoder's buffer of the pieces to free it on close*/
+        piece = decoder_dsc.decoded;
+        decoder_dsc.decoded = whole;
+    }
+
+    /*The decoder might have returned a smaller image than the original.
+     *Draw it with an adjusted transformation to get the same result on the screen.
+     *(The header is not set if the image was found in the cache but cached images are never smaller.)*/
+    const lv_draw_buf_t * decoded = decoder_dsc.decoded;
+    const lv_image_header_t * orig_header = &decoder_dsc.header;
+    if(decoded && orig_header->w > 0 && orig_header->h > 0 &&
+       (decoded->header.w != orig_header->w || decoded->header.h != orig_header->h)) {
+        lv_draw_image_dsc_t scaled_dsc;
+        lv_area_t scaled_coords;
+        get_downscaled_dsc(&scaled_dsc, &scaled_coords, draw_dsc, coords, orig_header, &decoded->header);
+        img_decode_and_draw(draw_unit, &scaled_dsc, &decoder_dsc, NULL, &scaled_coords, &clipped_img_area,
+                            draw_core_cb);
+    }
+    else {
+        img_decode_and_draw(draw_unit, draw_dsc, &decoder_dsc, NULL, coords, &clipped_img_area, draw_core_cb);
+    }
+
+    if(whole) {
+        decoder_dsc.decoded = piece;
+        lv_draw_buf_destroy(whole);
+    }
 
     lv_image_decoder_close(&decoder_dsc);
 }
@@ -247,10 +276,128 @@ void _lv_image_buf_get_transformed_area(lv_area_t * res, int32_t w, int32_t h, i
     res->y2 = LV_MAX4(p[0].y, p[1].y, p[2].y, p[3].y) - 1;
 }
 
+void _lv_draw_image_get_transformed_area(lv_area_t * res, const lv_area_t * coords, const lv_draw_image_dsc_t * dsc)
+{
+    int32_t w = lv_area_get_width(coords);
+    int32_t h = lv_area_get_height(coords);
+
+    if(dsc->skew_x == 0 && dsc->skew_y == 0) {
+        _lv_image_buf_get_transformed_area(res, w, h, dsc->rotation, dsc->scale_x, dsc->scale_y, &dsc->pivot);
+    }
+    else {
+        /*Skew first, and scale and rotate the skewed corners*/
+        lv_point_t p[4] = {
+            {0, 0},
+            {w, 0},
+            {0, h},
+            {w, h},
+        };
+        lv_point_array_skew(p, 4, dsc->skew_x, dsc->skew_y, &dsc->pivot, false);
+        lv_point_array_transform(p, 4, dsc->rotation, dsc->scale_x, dsc->scale_y, &dsc->pivot, true);
+        res->x1 = LV_MIN4(p[0].x, p[1].x, p[2].x, p[3].x);
+        res->x2 = LV_MAX4(p[0].x, p[1].x, p[2].x, p[3].x) - 1;
+        res->y1 = LV_MIN4(p[0].y, p[1].y, p[2].y, p[3].y);
+        res->y2 = LV_MAX4(p[0].y, p[1].y, p[2].y, p[3].y) - 1;
+    }
+
+    lv_area_move(res, coords->x1, coords->y1);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the default decoder arguments with the size the image is drawn at as target size.
+ * @param args      store the arguments here
+ * @param draw_dsc  the draw descriptor of the image
+ */
+static void get_decoder_args(lv_image_decoder_args_t * args, const lv_draw_image_dsc_t * draw_dsc)
+{
+    lv_memzero(args, sizeof(lv_image_decoder_args_t));
+    args->stride_align = LV_DRAW_BUF_STRIDE_ALIGN != 1;
+
+    /*Only downscaled images can be decoded at a smaller size.
+     *Skewing isn't supported by `get_downscaled_dsc` so decode the whole image then.*/
+    if(draw_dsc->header.w == 0 || draw_dsc->header.h == 0) return;
+    if(draw_dsc->skew_x != 0 || draw_dsc->skew_y != 0) return;
+    if(draw_dsc->scale_x >= LV_SCALE_NONE && draw_dsc->scale_y >= LV_SCALE_NONE) return;
+
+    args->target_w = LV_MAX(1, (draw_dsc->header.w * LV_MIN(draw_dsc->scale_x, LV_SCALE_NONE)) >> 8);
+    args->target_h = LV_MAX(1, (draw_dsc->header.h * LV_MIN(draw_dsc->scale_y, LV_SCALE_NONE)) >> 8);
+}
+
+/**
+ * Collect the whole image from the pieces returned by `get_area_cb`.
+ * @param decoder_dsc   an opened image without `decoded` image. `decoded` is left as the decoder set it
+ *                      to let the decoder free its buffer on close.
+ * @return              the whole image or NULL on error. Destroy it with `lv_draw_buf_destroy()`.
+ */
+static lv_draw_buf_t * decode_whole(lv_image_decoder_dsc_t * decoder_dsc)
+{
+    int32_t w = decoder_dsc->header.w;
+    int32_t h = decoder_dsc->header.h;
+    lv_area_t full_area = {0, 0, w - 1, h - 1};
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    lv_draw_buf_t * whole = NULL;
+    bool complete = false;
+
+    while(lv_image_decoder_get_area(decoder_dsc, &full_area, &decoded_area) == LV_RESULT_OK) {
+        const lv_draw_buf_t * part = decoder_dsc->decoded;
+        if(whole == NULL) {
+            whole = lv_draw_buf_create(w, h, part->header.cf, LV_STRIDE_AUTO);
+            if(whole == NULL) break;
+        }
+
+        /*The pieces can be larger than the image, e.g. the blocks of JPEG images*/
+        lv_area_t dest_area;
+        if(!_lv_area_intersect(&dest_area, &decoded_area, &full_area)) continue;
+        lv_area_t src_area = dest_area;
+        lv_area_move(&src_area, -decoded_area.x1, -decoded_area.y1);
+        lv_draw_buf_copy(whole, &dest_area, part, &src_area);
+
+        /*The pieces are returned from top-left to bottom-right*/
+        if(dest_area.x2 == w - 1 && dest_area.y2 == h - 1) complete = true;
+    }
+
+    if(whole && !complete) {
+        lv_draw_buf_destroy(whole);
+        whole = NULL;
+    }
+
+    return whole;
+}
+
+/**
+ * Adjust the transformation of an image to draw a smaller decoded version of it at the same place and size.
+ * @param res           store the adjusted draw descriptor here
+ * @param res_coords    store the coordinates of the decoded image here
+ * @param draw_dsc      the original draw descriptor
+ * @param coords        the original coordinates of the image
+ * @param orig_header   header of the original image
+ * @param header        header of the decoded image
+ */
+static void get_downscaled_dsc(lv_draw_image_dsc_t * res, lv_area_t * res_coords,
+                               const lv_draw_image_dsc_t * draw_dsc, const lv_area_t * coords,
+                               const lv_image_header_t * orig_header, const lv_image_header_t * header)
+{
+    int32_t orig_w = orig_header->w;
+    int32_t orig_h = orig_header->h;
+
+    *res = *draw_dsc;
+    res->header = *header;
+    res->scale_x = (draw_dsc->scale_x * orig_w + header->w / 2) / header->w;
+    res->scale_y = (draw_dsc->scale_y * orig_h + header->h / 2) / header->h;
+    res->pivot.x = (draw_dsc->pivot.x * header->w) / orig_w;
+    res->pivot.y = (draw_dsc->pivot.y * header->h) / orig_h;
+
+    /*Keep the pivot at the same place on the screen*/
+    res_coords->x1 = coords->x1 + draw_dsc->pivot.x - res->pivot.x;
+    res_coords->y1 = coords->y1 + draw_dsc->pivot.y - res->pivot.y;
+    res_coords->x2 = res_coords->x1 + header->w - 1;
+    res_coords->y2 = res_coords->y1 + header->h - 1;
+}
+
 static void img_decode_and_draw(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * draw_dsc,
                                 lv_image_decoder_dsc_t * decoder_dsc, lv_area_t * relative_decoded_area,
                                 const lv_area_t * img_area, const lv_area_t * clipped_img_area,
@@ -164,6 +164,14 @@ void _lv_draw_image_tiled_helper(lv_draw_unit_t * draw_unit, const lv_draw_image
 void _lv_image_buf_get_transformed_area(lv_area_t * res, int32_t w, int32_t h, int32_t angle,
                                         uint16_t scale_x, uint16_t scale_y, const lv_point_t * pivot);
 
+/**
+ * Get the area of an image or layer if it's rotated, scaled and skewed
+ * @param res store the coordinates here
+ * @param coords the coordinates of the image or layer without transformation
+ * @param dsc pointer to an image draw descriptor with the transformation
+ */
+void _lv_draw_image_get_transformed_area(lv_area_t * res, const lv_area_t * coords, const lv_draw_image_dsc_t * dsc);
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
@@ -50,7 +50,8 @@ void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_mask_rect_dsc_init(lv_draw_mask_rect_ds
 lv_draw_mask_rect_dsc_t * lv_draw_task_get_mask_rect_dsc(lv_draw_task_t * task);
 
 /**
- * Create a draw task to mask a rectangle from the buffer
+ * Create a draw task to mask a rectangle from the buffer.
+ * The rounded corners of a parent's `clip_corner` are not applied to it.
  * @param layer     pointer to a layer
  * @param dsc       pointer to a draw descriptor
  */
@@ -63,6 +63,12 @@ typedef struct _lv_image_decoder_args_t {
     bool no_cache;          /*When set, decoded image won't be put to cache, and decoder open will also ignore cache.*/
     bool use_indexed;       /*Decoded indexed image as is. Convert to ARGB8888 if false.*/
     bool flush_cache;       /*Whether to flush the data cache after decoding*/
+
+    /*Hint: the image will be shown at most this large. 0: unknown.
+     *Decoders may return a smaller `decoded` image which is still at least this large,
+     *so check the size of `decoded` instead of `header`. Such images are not cached.*/
+    int32_t target_w;
+    int32_t target_h;
 } lv_image_decoder_args_t;
 
 /**
@@ -109,11 +115,23 @@ struct _lv_image_decoder_t {
     lv_image_decoder_get_area_cb_t get_area_cb;
     lv_image_decoder_close_f_t close_cb;
 
+    /**Free the decoded image of the cache entries added by this decoder. If NULL the decoded
+     * draw buffer is destroyed if it's allocated.*/
+    lv_cache_free_cb_t cache_free_cb;
+
     const char * name;
 
     void * user_data;
 };
 
+/**A downscaled copy of a decoded image created by a draw unit, e.g. a mipmap level*/
+typedef struct _lv_image_cache_mipmap_t {
+    struct _lv_image_cache_mipmap_t * next;
+    lv_draw_buf_t * decoded;
+    uint8_t level_x;    /**< The image is downscaled by 2^level_x horizontally*/
+    uint8_t level_y;    /**< The image is downscaled by 2^level_y vertically*/
+} lv_image_cache_mipmap_t;
+
 typedef struct _lv_image_decoder_cache_data_t {
     lv_cache_slot_size_t slot;
 
@@ -123,6 +141,9 @@ typedef struct _lv_image_decoder_cache_data_t {
     const lv_draw_buf_t * decoded;
     const lv_image_decoder_t * decoder;
     void * user_data;
+
+    /**Downscaled copies of `decoded`. They are freed with the cache entry.*/
+    lv_image_cache_mipmap_t * mipmaps;
 } lv_image_cache_data_t;
 
 typedef struct _lv_image_decoder_header_cache_data_t {
@@ -281,6 +302,14 @@ void lv_image_decoder_set_get_area_cb(lv_image_decoder_t * decoder, lv_image_dec
  */
 void lv_image_decoder_set_close_cb(lv_image_decoder_t * decoder, lv_image_decoder_close_f_t close_cb);
 
+/**
+ * Set a callback to free the decoded image of the cache entries added by the decoder.
+ * Needed if the decoded image is not (only) an allocated draw buffer, e.g. it points to a mapped file.
+ * @param decoder       pointer to an image decoder
+ * @param cache_free_cb a function which gets the `lv_image_cache_data_t` being freed
+ */
+void lv_image_decoder_set_cache_free_cb(lv_image_decoder_t * decoder, lv_cache_free_cb_t cache_free_cb);
+
 lv_cache_entry_t * lv_image_decoder_add_to_cache(lv_image_decoder_t * decoder,
                                                  lv_image_cache_data_t * search_key,
                                                  const lv_draw_buf_t * decoded, void * user_data);
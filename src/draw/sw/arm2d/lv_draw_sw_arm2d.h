@@ -194,6 +194,9 @@ static inline lv_result_t _lv_draw_sw_image_helium(
         if(draw_dsc->scale_x != draw_dsc->scale_y) {
             break;
         }
+        if(draw_dsc->skew_x != 0 || draw_dsc->skew_y != 0) {
+            break;
+        }
         /* filter the unsupported colour format combination */
         if((LV_COLOR_FORMAT_RGB565 == des_cf)
         && !(  (LV_COLOR_FORMAT_RGB565 == src_cf)
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "../lv_draw_sw.h"
+#include "../lv_draw_sw_mask.h"
 #include "lv_draw_sw_blend_to_l8.h"
 #include "lv_draw_sw_blend_to_al88.h"
 #include "lv_draw_sw_blend_to_rgb565.h"
@@ -18,6 +19,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Size of the mask buffer on the stack used to clip the rounded corners*/
+#define CORNER_MASK_BUF_SIZE    256
 
 /**********************
  *      TYPEDEFS
@@ -26,6 +29,15 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * blend_area_p);
+
+#if LV_DRAW_SW_COMPLEX
+    static void blend_clip_corner(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                                  const lv_area_t * blend_area);
+    static void blend_with_radius_mask(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                                       const lv_area_t * blend_area, lv_draw_sw_mask_radius_param_t * param);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -48,6 +60,22 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
     if(!_lv_area_intersect(&blend_area, blend_dsc->blend_area, draw_unit->clip_area)) return;
 
     LV_PROFILER_BEGIN;
+#if LV_DRAW_SW_COMPLEX
+    if(draw_unit->clip_corner_radius > 0) blend_clip_corner(draw_unit, blend_dsc, &blend_area);
+    else blend(draw_unit, blend_dsc, &blend_area);
+#else
+    blend(draw_unit, blend_dsc, &blend_area);
+#endif
+    LV_PROFILER_END;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc, const lv_area_t * blend_area_p)
+{
+    lv_area_t blend_area = *blend_area_p;
     lv_layer_t * layer = draw_unit->target_layer;
     uint32_t layer_stride_byte = lv_draw_buf_width_to_stride(lv_area_get_width(&layer->buf_area), layer->color_format);
 
@@ -96,15 +124,8 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
         }
     }
     else {
-        if(!_lv_area_intersect(&blend_area, &blend_area, blend_dsc->src_area)) {
-            LV_PROFILER_END;
-            return;
-        }
-
-        if(blend_dsc->mask_area && !_lv_area_intersect(&blend_area, &blend_area, blend_dsc->mask_area)) {
-            LV_PROFILER_END;
-            return;
-        }
+        if(!_lv_area_intersect(&blend_area, &blend_area, blend_dsc->src_area)) return;
+        if(blend_dsc->mask_area && !_lv_area_intersect(&blend_area, &blend_area, blend_dsc->mask_area)) return;
 
         _lv_draw_sw_blend_image_dsc_t image_dsc;
         image_dsc.dest_w = lv_area_get_width(&blend_area);
@@ -160,11 +181,128 @@ void lv_draw_sw_blend(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t *
                 break;
         }
     }
-    LV_PROFILER_END;
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+#if LV_DRAW_SW_COMPLEX
+
+/**
+ * Blend only inside the rounded `clip_corner_area` of the draw unit.
+ * Only the corners need masking, the rest is blended as it is.
+ */
+static void blend_clip_corner(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                              const lv_area_t * blend_area)
+{
+    const lv_area_t * corner_area = draw_unit->clip_corner_area;
+    lv_area_t area;
+    if(!_lv_area_intersect(&area, blend_area, corner_area)) return;
+
+    /*The corners are masked with a new mask buffer which should cover the original mask*/
+    if(blend_dsc->mask_buf && blend_dsc->mask_res != LV_DRAW_SW_MASK_RES_FULL_COVER && blend_dsc->mask_area) {
+        if(!_lv_area_intersect(&area, &area, blend_dsc->mask_area)) return;
+    }
+
+    int32_t short_side = LV_MIN(lv_area_get_width(corner_area), lv_area_get_height(corner_area));
+    int32_t rout = LV_MIN(draw_unit->clip_corner_radius, short_side >> 1);
+
+    /*The rows between the top and bottom corners*/
+    lv_area_t part = area;
+    part.y1 = LV_MAX(area.y1, corner_area->y1 + rout);
+    part.y2 = LV_MIN(area.y2, corner_area->y2 - rout);
+    if(part.y1 <= part.y2) blend(draw_unit, blend_dsc, &part);
+
+    lv_area_t bands[2];
+    bands[0] = area;
+    bands[0].y2 = LV_MIN(area.y2, corner_area->y1 + rout - 1);
+    bands[1] = area;
+    bands[1].y1 = LV_MAX(area.y1, corner_area->y2 - rout + 1);
+
+    lv_draw_sw_mask_radius_param_t param;
+    bool param_inited = false;
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        lv_area_t * band = &bands[i];
+        if(band->y1 > band->y2) continue;
+
+        /*Between the left and right corners*/
+        part = *band;
+        part.x1 = LV_MAX(band->x1, corner_area->x1 + rout);
+        part.x2 = LV_MIN(band->x2, corner_area->x2 - rout);
+        if(part.x1 <= part.x2) blend(draw_unit, blend_dsc, &part);
+
+        lv_area_t corners[2];
+        corners[0] = *band;
+        corners[0].x2 = LV_MIN(band->x2, corner_area->x1 + rout - 1);
+        corners[1] = *band;
+        corners[1].x1 = LV_MAX(band->x1, corner_area->x2 - rout + 1);
+
+        uint32_t j;
+        for(j = 0; j < 2; j++) {
+            if(corners[j].x1 > corners[j].x2) continue;
+            if(!param_inited) {
+                lv_draw_sw_mask_radius_init(&param, corner_area, draw_unit->clip_corner_radius, false);
+                param_inited = true;
+            }
+            blend_with_radius_mask(draw_unit, blend_dsc, &corners[j], &param);
+        }
+    }
+
+    if(param_inited) lv_draw_sw_mask_free_param(&param);
+}
+
+/**
+ * Blend an area with the product of the original mask and a radius mask.
+ * The mask is built in a small buffer on the stack for a few lines (or a part of a line) at once.
+ */
+static void blend_with_radius_mask(lv_draw_unit_t * draw_unit, const lv_draw_sw_blend_dsc_t * blend_dsc,
+                                   const lv_area_t * blend_area, lv_draw_sw_mask_radius_param_t * param)
+{
+    lv_opa_t mask_buf[CORNER_MASK_BUF_SIZE];
+
+    const lv_opa_t * mask_ori = NULL;
+    int32_t mask_ori_stride = 0;
+    if(blend_dsc->mask_buf && blend_dsc->mask_res != LV_DRAW_SW_MASK_RES_FULL_COVER) {
+        mask_ori = blend_dsc->mask_buf;
+        mask_ori_stride = blend_dsc->mask_stride ? blend_dsc->mask_stride : lv_area_get_width(blend_dsc->mask_area);
+    }
+
+    void * masks[2] = {param, NULL};
+    int32_t chunk_w = LV_MIN(lv_area_get_width(blend_area), CORNER_MASK_BUF_SIZE);
+    int32_t chunk_h = CORNER_MASK_BUF_SIZE / chunk_w;
+
+    lv_draw_sw_blend_dsc_t dsc = *blend_dsc;
+    dsc.mask_buf = mask_buf;
+    dsc.mask_res = LV_DRAW_SW_MASK_RES_CHANGED;
+
+    lv_area_t chunk;
+    for(chunk.y1 = blend_area->y1; chunk.y1 <= blend_area->y2; chunk.y1 += chunk_h) {
+        chunk.y2 = LV_MIN(chunk.y1 + chunk_h - 1, blend_area->y2);
+        for(chunk.x1 = blend_area->x1; chunk.x1 <= blend_area->x2; chunk.x1 += chunk_w) {
+            chunk.x2 = LV_MIN(chunk.x1 + chunk_w - 1, blend_area->x2);
+            int32_t w = lv_area_get_width(&chunk);
+
+            lv_opa_t * mask_row = mask_buf;
+            int32_t y;
+            for(y = chunk.y1; y <= chunk.y2; y++) {
+                if(mask_ori) {
+                    lv_memcpy(mask_row, mask_ori + mask_ori_stride * (y - blend_dsc->mask_area->y1) +
+                              (chunk.x1 - blend_dsc->mask_area->x1), w);
+                }
+                else {
+                    lv_memset(mask_row, 0xff, w);
+                }
+
+                lv_draw_sw_mask_res_t res = lv_draw_sw_mask_apply(masks, mask_row, chunk.x1, y, w);
+                if(res == LV_DRAW_SW_MASK_RES_TRANSP) lv_memzero(mask_row, w);
+                mask_row += w;
+            }
+
+            dsc.mask_area = &chunk;
+            dsc.mask_stride = w;
+            blend(draw_unit, &dsc, &chunk);
+        }
+    }
+}
+
+#endif /*LV_DRAW_SW_COMPLEX*/
 
 #endif
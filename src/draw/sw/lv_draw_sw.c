@@ -29,11 +29,23 @@
     #include LV_DRAW_SW_ASM_CUSTOM_INCLUDE
 #endif
 
+/*Transpose the full tiles of the rotated buffers with vector instructions if the compiler targets them*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define ROTATE_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define ROTATE_NEON 1
+#endif
+
 /*********************
  *      DEFINES
  *********************/
 #define DRAW_UNIT_ID_SW     1
 
+/*Rotate by 90 and 270 degrees in square tiles to keep the touched source and destination lines in the cache*/
+#define ROTATE_TILE_SIZE    16
+
 #ifndef LV_DRAW_SW_RGB565_SWAP
     #define LV_DRAW_SW_RGB565_SWAP(...) LV_RESULT_INVALID
 #endif
@@ -113,6 +125,12 @@ static void rotate180_rgb565(const uint16_t * src, uint16_t * dst, int32_t width
 static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWidth, int32_t srcHeight,
                              int32_t srcStride,
                              int32_t dstStride);
+static void transpose_u32(const uint32_t * src, uint32_t * dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                          int32_t dst_stride);
+static void transpose_u24(const uint8_t * src, uint8_t * dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                          int32_t dst_stride);
+static void transpose_u16(const uint16_t * src, uint16_t * dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                          int32_t dst_stride);
 
 /**********************
  *  STATIC VARIABLES
@@ -134,6 +152,10 @@ void lv_draw_sw_init(void)
     lv_draw_sw_mask_init();
 #endif
 
+#if LV_DRAW_SW_MIPMAP
+    lv_mutex_init(&_draw_info.mipmap_mutex);
+#endif
+
     uint32_t i;
     for(i = 0; i < LV_DRAW_SW_DRAW_UNIT_CNT; i++) {
         lv_draw_sw_unit_t * draw_sw_unit = lv_draw_create_unit(sizeof(lv_draw_sw_unit_t));
@@ -161,6 +183,10 @@ void lv_draw_sw_deinit(void)
 #if LV_DRAW_SW_COMPLEX == 1
     lv_draw_sw_mask_deinit();
 #endif
+
+#if LV_DRAW_SW_MIPMAP
+    lv_mutex_delete(&_draw_info.mipmap_mutex);
+#endif
 }
 
 static int32_t lv_draw_sw_delete(lv_draw_unit_t * draw_unit)
@@ -300,13 +326,9 @@ static int32_t evaluate(lv_draw_unit_t * draw_unit, lv_draw_task_t * task)
         case LV_DRAW_TASK_TYPE_LAYER: {
                 lv_draw_image_dsc_t * draw_dsc = task->draw_dsc;
 
-                /* not support skew */
-                if(draw_dsc->skew_x != 0 || draw_dsc->skew_y != 0) {
-                    return 0;
-                }
-
                 bool transformed = draw_dsc->rotation != 0 || draw_dsc->scale_x != LV_SCALE_NONE ||
-                                   draw_dsc->scale_y != LV_SCALE_NONE ? true : false;
+                                   draw_dsc->scale_y != LV_SCALE_NONE || draw_dsc->skew_x != 0 ||
+                                   draw_dsc->skew_y != 0 ? true : false;
 
                 bool masked = draw_dsc->bitmap_mask_src != NULL;
                 if(masked && transformed)  return 0;
@@ -356,6 +378,8 @@ static int32_t dispatch(lv_draw_unit_t * draw_unit, lv_layer_t * layer)
     t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
     draw_sw_unit->base_unit.target_layer = layer;
     draw_sw_unit->base_unit.clip_area = &t->clip_area;
+    draw_sw_unit->base_unit.clip_corner_area = &t->clip_corner_area;
+    draw_sw_unit->base_unit.clip_corner_radius = t->clip_corner_radius;
     draw_sw_unit->task_act = t;
 
 #if LV_USE_OS
@@ -489,6 +513,9 @@ static void execute_drawing(lv_draw_sw_unit_t * u)
     LV_PROFILER_END;
 }
 
+/* Rotating by 90 or 270 degrees is a transposition where either the destination or the source rows are
+ * iterated backwards. So both are done by the same `transpose_...` functions with negative strides.*/
+
 static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t srcWidth, int32_t srcHeight,
                                int32_t srcStride,
                                int32_t dstStride)
@@ -500,28 +527,22 @@ static void rotate270_argb8888(const uint32_t * src, uint32_t * dst, int32_t src
     srcStride /= sizeof(uint32_t);
     dstStride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = x * dstStride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
-            srcIndex += srcStride;
-        }
-    }
+    /*dst[x][srcHeight - 1 - y] = src[y][x]*/
+    transpose_u32(src + (srcHeight - 1) * srcStride, dst, srcWidth, srcHeight, -srcStride, dstStride);
 }
 
 static void rotate180_argb8888(const uint32_t * src, uint32_t * dst, int32_t width, int32_t height, int32_t src_stride,
                                int32_t dest_stride)
 {
-    LV_UNUSED(dest_stride);
     if(LV_RESULT_OK == LV_DRAW_SW_ROTATE180_ARGB8888(src, dst, srcWidth, srcHeight, srcStride, dstStride)) {
         return ;
     }
 
     src_stride /= sizeof(uint32_t);
+    dest_stride /= sizeof(uint32_t);
 
     for(int32_t y = 0; y < height; ++y) {
-        int32_t dstIndex = (height - y - 1) * src_stride;
+        int32_t dstIndex = (height - y - 1) * dest_stride;
         int32_t srcIndex = y * src_stride;
         for(int32_t x = 0; x < width; ++x) {
             dst[dstIndex + width - x - 1] = src[srcIndex + x];
@@ -540,14 +561,8 @@ static void rotate90_argb8888(const uint32_t * src, uint32_t * dst, int32_t srcW
     srcStride /= sizeof(uint32_t);
     dstStride /= sizeof(uint32_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = (srcWidth - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex * dstStride + y] = src[srcIndex];
-            srcIndex += srcStride;
-        }
-    }
+    /*dst[srcWidth - 1 - x][y] = src[y][x]*/
+    transpose_u32(src, dst + (srcWidth - 1) * dstStride, srcWidth, srcHeight, srcStride, -dstStride);
 }
 
 static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t srcWidth, int32_t srcHeight, int32_t srcStride,
@@ -557,15 +572,8 @@ static void rotate270_rgb888(const uint8_t * src, uint8_t * dst, int32_t srcWidt
         return ;
     }
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            int32_t srcIndex = y * srcStride + x * 3;
-            int32_t dstIndex = (srcWidth - x - 1) * dstStride + y * 3;
-            dst[dstIndex] = src[srcIndex];       /*Red*/
-            dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
-            dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
-        }
-    }
+    /*dst[srcWidth - 1 - x][y] = src[y][x]*/
+    transpose_u24(src, dst + (srcWidth - 1) * dstStride, srcWidth, srcHeight, srcStride, -dstStride);
 }
 
 static void rotate180_rgb888(const uint8_t * src, uint8_t * dst, int32_t width, int32_t height, int32_t src_stride,
@@ -593,15 +601,8 @@ static void rotate90_rgb888(const uint8_t * src, uint8_t * dst, int32_t width, i
         return ;
     }
 
-    for(int32_t x = 0; x < width; ++x) {
-        for(int32_t y = 0; y < height; ++y) {
-            int32_t srcIndex = y * srcStride + x * 3;
-            int32_t dstIndex = x * dstStride + (height - y - 1) * 3;
-            dst[dstIndex] = src[srcIndex];       /*Red*/
-            dst[dstIndex + 1] = src[srcIndex + 1]; /*Green*/
-            dst[dstIndex + 2] = src[srcIndex + 2]; /*Blue*/
-        }
-    }
+    /*dst[x][height - 1 - y] = src[y][x]*/
+    transpose_u24(src + (height - 1) * srcStride, dst, width, height, -srcStride, dstStride);
 }
 
 static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWidth, int32_t srcHeight,
@@ -615,14 +616,7 @@ static void rotate270_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWi
     srcStride /= sizeof(uint16_t);
     dstStride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = x * dstStride;
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex + (srcHeight - y - 1)] = src[srcIndex];
-            srcIndex += srcStride;
-        }
-    }
+    transpose_u16(src + (srcHeight - 1) * srcStride, dst, srcWidth, srcHeight, -srcStride, dstStride);
 }
 
 static void rotate180_rgb565(const uint16_t * src, uint16_t * dst, int32_t width, int32_t height, int32_t src_stride,
@@ -655,12 +649,214 @@ static void rotate90_rgb565(const uint16_t * src, uint16_t * dst, int32_t srcWid
     srcStride /= sizeof(uint16_t);
     dstStride /= sizeof(uint16_t);
 
-    for(int32_t x = 0; x < srcWidth; ++x) {
-        int32_t dstIndex = (srcWidth - x - 1);
-        int32_t srcIndex = x;
-        for(int32_t y = 0; y < srcHeight; ++y) {
-            dst[dstIndex * dstStride + y] = src[srcIndex];
-            srcIndex += srcStride;
+    transpose_u16(src, dst + (srcWidth - 1) * dstStride, srcWidth, srcHeight, srcStride, -dstStride);
+}
+
+#if defined(ROTATE_SSE2) || defined(ROTATE_NEON)
+
+/**
+ * Transpose a 4x4 block of 32 bit pixels
+ * @param src           the top left pixel of the block
+ * @param dst           store the column of the first source pixel here
+ * @param src_stride    source stride in pixels
+ * @param dst_stride    destination stride in pixels
+ */
+static inline void transpose_4x4_u32(const uint32_t * src, uint32_t * dst, int32_t src_stride, int32_t dst_stride)
+{
+#ifdef ROTATE_SSE2
+    __m128i r0 = _mm_loadu_si128((const __m128i *)src);
+    __m128i r1 = _mm_loadu_si128((const __m128i *)(src + src_stride));
+    __m128i r2 = _mm_loadu_si128((const __m128i *)(src + 2 * src_stride));
+    __m128i r3 = _mm_loadu_si128((const __m128i *)(src + 3 * src_stride));
+
+    __m128i t0 = _mm_unpacklo_epi32(r0, r1);    /*r0[0] r1[0] r0[1] r1[1]*/
+    __m128i t1 = _mm_unpacklo_epi32(r2, r3);    /*r2[0] r3[0] r2[1] r3[1]*/
+    __m128i t2 = _mm_unpackhi_epi32(r0, r1);    /*r0[2] r1[2] r0[3] r1[3]*/
+    __m128i t3 = _mm_unpackhi_epi32(r2, r3);    /*r2[2] r3[2] r2[3] r3[3]*/
+
+    _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi64(t0, t1));
+    _mm_storeu_si128((__m128i *)(dst + dst_stride), _mm_unpackhi_epi64(t0, t1));
+    _mm_storeu_si128((__m128i *)(dst + 2 * dst_stride), _mm_unpacklo_epi64(t2, t3));
+    _mm_storeu_si128((__m128i *)(dst + 3 * dst_stride), _mm_unpackhi_epi64(t2, t3));
+#else
+    uint32x4x2_t t01 = vtrnq_u32(vld1q_u32(src), vld1q_u32(src + src_stride));
+    uint32x4x2_t t23 = vtrnq_u32(vld1q_u32(src + 2 * src_stride), vld1q_u32(src + 3 * src_stride));
+
+    vst1q_u32(dst, vcombine_u32(vget_low_u32(t01.val[0]), vget_low_u32(t23.val[0])));
+    vst1q_u32(dst + dst_stride, vcombine_u32(vget_low_u32(t01.val[1]), vget_low_u32(t23.val[1])));
+    vst1q_u32(dst + 2 * dst_stride, vcombine_u32(vget_high_u32(t01.val[0]), vget_high_u32(t23.val[0])));
+    vst1q_u32(dst + 3 * dst_stride, vcombine_u32(vget_high_u32(t01.val[1]), vget_high_u32(t23.val[1])));
+#endif
+}
+
+/**
+ * Transpose an 8x8 block of 16 bit pixels
+ * @param src           the top left pixel of the block
+ * @param dst           store the column of the first source pixel here
+ * @param src_stride    source stride in pixels
+ * @param dst_stride    destination stride in pixels
+ */
+static inline void transpose_8x8_u16(const uint16_t * src, uint16_t * dst, int32_t src_stride, int32_t dst_stride)
+{
+#ifdef ROTATE_SSE2
+    __m128i r[8];
+    for(int32_t i = 0; i < 8; i++) r[i] = _mm_loadu_si128((const __m128i *)(src + i * src_stride));
+
+    /*Interleave the pixels of row pairs, then pairs of pixels and finally quads of pixels*/
+    __m128i a[8];
+    for(int32_t i = 0; i < 4; i++) {
+        a[2 * i] = _mm_unpacklo_epi16(r[2 * i], r[2 * i + 1]);      /*Columns 0..3 of 2 rows*/
+        a[2 * i + 1] = _mm_unpackhi_epi16(r[2 * i], r[2 * i + 1]);  /*Columns 4..7 of 2 rows*/
+    }
+
+    __m128i b[8];
+    for(int32_t i = 0; i < 2; i++) {
+        b[4 * i] = _mm_unpacklo_epi32(a[4 * i], a[4 * i + 2]);          /*Columns 0, 1 of 4 rows*/
+        b[4 * i + 1] = _mm_unpackhi_epi32(a[4 * i], a[4 * i + 2]);      /*Columns 2, 3 of 4 rows*/
+        b[4 * i + 2] = _mm_unpacklo_epi32(a[4 * i + 1], a[4 * i + 3]);  /*Columns 4, 5 of 4 rows*/
+        b[4 * i + 3] = _mm_unpackhi_epi32(a[4 * i + 1], a[4 * i + 3]);  /*Columns 6, 7 of 4 rows*/
+    }
+
+    for(int32_t i = 0; i < 4; i++) {
+        _mm_storeu_si128((__m128i *)(dst + (2 * i) * dst_stride), _mm_unpacklo_epi64(b[i], b[i + 4]));
+        _mm_storeu_si128((__m128i *)(dst + (2 * i + 1) * dst_stride), _mm_unpackhi_epi64(b[i], b[i + 4]));
+    }
+#else
+    uint16x8x2_t t01 = vtrnq_u16(vld1q_u16(src), vld1q_u16(src + src_stride));
+    uint16x8x2_t t23 = vtrnq_u16(vld1q_u16(src + 2 * src_stride), vld1q_u16(src + 3 * src_stride));
+    uint16x8x2_t t45 = vtrnq_u16(vld1q_u16(src + 4 * src_stride), vld1q_u16(src + 5 * src_stride));
+    uint16x8x2_t t67 = vtrnq_u16(vld1q_u16(src + 6 * src_stride), vld1q_u16(src + 7 * src_stride));
+
+    /*Columns 0, 4 in `val[0]` and 2, 6 in `val[1]` of the first 4 and last 4 rows*/
+    uint32x4x2_t u02 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[0]), vreinterpretq_u32_u16(t23.val[0]));
+    uint32x4x2_t u46 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[0]), vreinterpretq_u32_u16(t67.val[0]));
+    /*Columns 1, 5 in `val[0]` and 3, 7 in `val[1]`*/
+    uint32x4x2_t u13 = vtrnq_u32(vreinterpretq_u32_u16(t01.val[1]), vreinterpretq_u32_u16(t23.val[1]));
+    uint32x4x2_t u57 = vtrnq_u32(vreinterpretq_u32_u16(t45.val[1]), vreinterpretq_u32_u16(t67.val[1]));
+
+    uint32x4_t top[4] = {u02.val[0], u13.val[0], u02.val[1], u13.val[1]};
+    uint32x4_t bottom[4] = {u46.val[0], u57.val[0], u46.val[1], u57.val[1]};
+    for(int32_t i = 0; i < 4; i++) {
+        uint16x8_t t = vreinterpretq_u16_u32(top[i]);
+        uint16x8_t b = vreinterpretq_u16_u32(bottom[i]);
+        vst1q_u16(dst + i * dst_stride, vcombine_u16(vget_low_u16(t), vget_low_u16(b)));
+        vst1q_u16(dst + (i + 4) * dst_stride, vcombine_u16(vget_high_u16(t), vget_high_u16(b)));
+    }
+#endif
+}
+
+#endif /*defined(ROTATE_SSE2) || defined(ROTATE_NEON)*/
+
+/**
+ * Transpose a buffer of 32 bit pixels: dst[x][y] = src[y][x]
+ * @param src           the source buffer
+ * @param dst           the destination buffer
+ * @param src_w         source width in pixels
+ * @param src_h         source height in pixels
+ * @param src_stride    source stride in pixels, can be negative
+ * @param dst_stride    destination stride in pixels, can be negative
+ */
+static void transpose_u32(const uint32_t * src, uint32_t * dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                          int32_t dst_stride)
+{
+    for(int32_t by = 0; by < src_h; by += ROTATE_TILE_SIZE) {
+        int32_t tile_h = LV_MIN(ROTATE_TILE_SIZE, src_h - by);
+        for(int32_t bx = 0; bx < src_w; bx += ROTATE_TILE_SIZE) {
+            int32_t tile_w = LV_MIN(ROTATE_TILE_SIZE, src_w - bx);
+            const uint32_t * src_tile = src + by * src_stride + bx;
+            uint32_t * dst_tile = dst + bx * dst_stride + by;
+
+#if defined(ROTATE_SSE2) || defined(ROTATE_NEON)
+            if(tile_w == ROTATE_TILE_SIZE && tile_h == ROTATE_TILE_SIZE) {
+                for(int32_t y = 0; y < ROTATE_TILE_SIZE; y += 4) {
+                    for(int32_t x = 0; x < ROTATE_TILE_SIZE; x += 4) {
+                        transpose_4x4_u32(src_tile + y * src_stride + x, dst_tile + x * dst_stride + y, src_stride, dst_stride);
+                    }
+                }
+                continue;
+            }
+#endif
+            for(int32_t x = 0; x < tile_w; x++) {
+                const uint32_t * src_col = src_tile + x;
+                uint32_t * dst_row = dst_tile + x * dst_stride;
+                for(int32_t y = 0; y < tile_h; y++) {
+                    dst_row[y] = src_col[y * src_stride];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Transpose a buffer of 24 bit pixels: dst[x][y] = src[y][x]
+ * @param src           the source buffer
+ * @param dst           the destination buffer
+ * @param src_w         source width in pixels
+ * @param src_h         source height in pixels
+ * @param src_stride    source stride in bytes, can be negative
+ * @param dst_stride    destination stride in bytes, can be negative
+ */
+static void transpose_u24(const uint8_t * src, uint8_t * dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                          int32_t dst_stride)
+{
+    for(int32_t by = 0; by < src_h; by += ROTATE_TILE_SIZE) {
+        int32_t tile_h = LV_MIN(ROTATE_TILE_SIZE, src_h - by);
+        for(int32_t bx = 0; bx < src_w; bx += ROTATE_TILE_SIZE) {
+            int32_t tile_w = LV_MIN(ROTATE_TILE_SIZE, src_w - bx);
+            const uint8_t * src_tile = src + by * src_stride + bx * 3;
+            uint8_t * dst_tile = dst + bx * dst_stride + by * 3;
+
+            for(int32_t x = 0; x < tile_w; x++) {
+                const uint8_t * src_px = src_tile + x * 3;
+                uint8_t * dst_px = dst_tile + x * dst_stride;
+                for(int32_t y = 0; y < tile_h; y++) {
+                    dst_px[0] = src_px[0];
+                    dst_px[1] = src_px[1];
+                    dst_px[2] = src_px[2];
+                    dst_px += 3;
+                    src_px += src_stride;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Transpose a buffer of 16 bit pixels: dst[x][y] = src[y][x]
+ * @param src           the source buffer
+ * @param dst           the destination buffer
+ * @param src_w         source width in pixels
+ * @param src_h         source height in pixels
+ * @param src_stride    source stride in pixels, can be negative
+ * @param dst_stride    destination stride in pixels, can be negative
+ */
+static void transpose_u16(const uint16_t * src, uint16_t * dst, int32_t src_w, int32_t src_h, int32_t src_stride,
+                          int32_t dst_stride)
+{
+    for(int32_t by = 0; by < src_h; by += ROTATE_TILE_SIZE) {
+        int32_t tile_h = LV_MIN(ROTATE_TILE_SIZE, src_h - by);
+        for(int32_t bx = 0; bx < src_w; bx += ROTATE_TILE_SIZE) {
+            int32_t tile_w = LV_MIN(ROTATE_TILE_SIZE, src_w - bx);
+            const uint16_t * src_tile = src + by * src_stride + bx;
+            uint16_t * dst_tile = dst + bx * dst_stride + by;
+
+#if defined(ROTATE_SSE2) || defined(ROTATE_NEON)
+            if(tile_w == ROTATE_TILE_SIZE && tile_h == ROTATE_TILE_SIZE) {
+                for(int32_t y = 0; y < ROTATE_TILE_SIZE; y += 8) {
+                    for(int32_t x = 0; x < ROTATE_TILE_SIZE; x += 8) {
+                        transpose_8x8_u16(src_tile + y * src_stride + x, dst_tile + x * dst_stride + y, src_stride, dst_stride);
+                    }
+                }
+                continue;
+            }
+#endif
+            for(int32_t x = 0; x < tile_w; x++) {
+                const uint16_t * src_col = src_tile + x;
+                uint16_t * dst_row = dst_tile + x * dst_stride;
+                for(int32_t y = 0; y < tile_h; y++) {
+                    dst_row[y] = src_col[y * src_stride];
+                }
+            }
         }
     }
 }
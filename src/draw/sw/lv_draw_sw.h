@@ -162,6 +162,46 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
                           int32_t src_w, int32_t src_h, int32_t src_stride,
                           const lv_draw_image_dsc_t * draw_dsc, const lv_draw_image_sup_t * sup, lv_color_format_t cf, void * dest_buf);
 
+#if LV_DRAW_SW_MIPMAP
+/**
+ * Enable or disable downscaling the images with a box filter before transforming them.
+ * It's enabled by default.
+ * @param en        true: enable; false: transform the original images as they are
+ */
+void lv_draw_sw_enable_mipmap(bool en);
+
+/**
+ * Check if the images are downscaled with a box filter before transforming them
+ * @return          true: enabled
+ */
+bool lv_draw_sw_is_mipmap_enabled(void);
+
+/**
+ * Used internally to downscale an image with a box filter
+ * @param src           the image to downscale
+ * @param level_x       downscale the width by 2^level_x
+ * @param level_y       downscale the height by 2^level_y
+ * @return              the downscaled image with the same color format or NULL if the color format is not supported
+ */
+lv_draw_buf_t * lv_draw_sw_mipmap_create(const lv_draw_buf_t * src, uint32_t level_x, uint32_t level_y);
+
+/**
+ * Used internally to get a transformed area of an image from its downscaled copy
+ * @param draw_unit     pointer to a draw unit
+ * @param dest_area     the area to calculate, i.e. get this area from the transformed image
+ * @param mipmap        the image downscaled by `lv_draw_sw_mipmap_create()`
+ * @param level_x       the width of the original image was downscaled by 2^level_x
+ * @param level_y       the height of the original image was downscaled by 2^level_y
+ * @param dsc           the draw descriptor of the original image
+ * @param sup           supplementary data
+ * @param cf            color format of the source buffer
+ * @param dest_buf      the destination buffer
+ */
+void lv_draw_sw_transform_mipmap(lv_draw_unit_t * draw_unit, const lv_area_t * dest_area, const lv_draw_buf_t * mipmap,
+                                 uint32_t level_x, uint32_t level_y,
+                                 const lv_draw_image_dsc_t * draw_dsc, const lv_draw_image_sup_t * sup, lv_color_format_t cf, void * dest_buf);
+#endif
+
 #if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
 /**
  * Draw vector graphics with SW render.
@@ -42,6 +42,9 @@
     #define LV_DRAW_SW_RGB888_RECOLOR(...)  LV_RESULT_INVALID
 #endif
 
+/*Max. 1/64 downscale with the box filter. The rest is done by the transformation.*/
+#define MIPMAP_LEVEL_MAX    6
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -54,6 +57,12 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
                           const lv_image_decoder_dsc_t * decoder_dsc, lv_draw_image_sup_t * sup,
                           const lv_area_t * img_coords, const lv_area_t * clipped_img_area);
 
+#if LV_DRAW_SW_MIPMAP
+static uint32_t mipmap_get_level(int32_t scale);
+static const lv_draw_buf_t * mipmap_get(const lv_image_decoder_dsc_t * decoder_dsc, uint32_t level_x,
+                                        uint32_t level_y);
+#endif
+
 /**********************
  *  STATIC VARIABLES
  **********************/
@@ -80,19 +89,7 @@ void lv_draw_sw_layer(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dr
     lv_draw_sw_image(draw_unit, &new_draw_dsc, coords);
 #if LV_USE_LAYER_DEBUG || LV_USE_PARALLEL_DRAW_DEBUG
     lv_area_t area_rot;
-    lv_area_copy(&area_rot, coords);
-    if(draw_dsc->rotation || draw_dsc->scale_x != LV_SCALE_NONE || draw_dsc->scale_y != LV_SCALE_NONE) {
-        int32_t w = lv_area_get_width(coords);
-        int32_t h = lv_area_get_height(coords);
-
-        _lv_image_buf_get_transformed_area(&area_rot, w, h, draw_dsc->rotation, draw_dsc->scale_x, draw_dsc->scale_y,
-                                           &draw_dsc->pivot);
-
-        area_rot.x1 += coords->x1;
-        area_rot.y1 += coords->y1;
-        area_rot.x2 += coords->x1;
-        area_rot.y2 += coords->y1;
-    }
+    _lv_draw_image_get_transformed_area(&area_rot, coords, draw_dsc);
     lv_area_t draw_area;
     if(!_lv_area_intersect(&draw_area, &area_rot, draw_unit->clip_area)) return;
 #endif
@@ -168,6 +165,20 @@ void lv_draw_sw_image(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t * dr
     }
 }
 
+#if LV_DRAW_SW_MIPMAP
+
+void lv_draw_sw_enable_mipmap(bool en)
+{
+    _draw_info.mipmap_disabled = !en;
+}
+
+bool lv_draw_sw_is_mipmap_enabled(void)
+{
+    return !_draw_info.mipmap_disabled;
+}
+
+#endif /*LV_DRAW_SW_MIPMAP*/
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -177,7 +188,8 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
                           const lv_area_t * img_coords, const lv_area_t * clipped_img_area)
 {
     bool transformed = draw_dsc->rotation != 0 || draw_dsc->scale_x != LV_SCALE_NONE ||
-                       draw_dsc->scale_y != LV_SCALE_NONE ? true : false;
+                       draw_dsc->scale_y != LV_SCALE_NONE || draw_dsc->skew_x != 0 ||
+                       draw_dsc->skew_y != 0 ? true : false;
 
     bool masked = draw_dsc->bitmap_mask_src != NULL;
 
@@ -315,6 +327,23 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
         }
         LV_ASSERT_MALLOC(tmp_buf);
 
+#if LV_DRAW_SW_MIPMAP
+        /*Use a downscaled copy of the image if it's heavily downscaled to avoid aliasing.
+         *The copy is stored in the image cache, so only cached images are used which are always decoded
+         *as a whole (not a part of them by `get_area_cb`).*/
+        const lv_draw_buf_t * mipmap = NULL;
+        uint32_t mipmap_level_x = 0;
+        uint32_t mipmap_level_y = 0;
+        if(transformed && !_draw_info.mipmap_disabled && decoder_dsc->cache_entry &&
+           header->w == src_w && header->h == src_h) {
+            mipmap_level_x = mipmap_get_level(draw_dsc->scale_x);
+            mipmap_level_y = mipmap_get_level(draw_dsc->scale_y);
+            if(mipmap_level_x || mipmap_level_y) {
+                mipmap = mipmap_get(decoder_dsc, mipmap_level_x, mipmap_level_y);
+            }
+        }
+#endif
+
         blend_dsc.src_buf = tmp_buf;
         blend_dsc.src_color_format = cf_final;
         int32_t y_last = blend_area.y2;
@@ -348,6 +377,13 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
             lv_area_t relative_area;
             lv_area_copy(&relative_area, &blend_area);
             lv_area_move(&relative_area, -img_coords->x1, -img_coords->y1);
+#if LV_DRAW_SW_MIPMAP
+            if(mipmap) {
+                lv_draw_sw_transform_mipmap(draw_unit, &relative_area, mipmap, mipmap_level_x, mipmap_level_y,
+                                            draw_dsc, sup, cf, tmp_buf);
+            }
+            else
+#endif
             if(transformed) {
                 lv_draw_sw_transform(draw_unit, &relative_area, src_buf, src_w, src_h, img_stride,
                                      draw_dsc, sup, cf, tmp_buf);
@@ -456,4 +492,64 @@ static void img_draw_core(lv_draw_unit_t * draw_unit, const lv_draw_image_dsc_t
     }
 }
 
+#if LV_DRAW_SW_MIPMAP
+
+/**
+ * Get how many times an image should be halved before transforming it
+ * @param scale     the scale of the image (256: no scale)
+ * @return          downscale the image by 2^level
+ */
+static uint32_t mipmap_get_level(int32_t scale)
+{
+    /*Keep the remaining scale between 50% and 100%*/
+    uint32_t level = 0;
+    while(scale > 0 && level < MIPMAP_LEVEL_MAX && (scale << (level + 1)) <= LV_SCALE_NONE) level++;
+    return level;
+}
+
+/**
+ * Get a downscaled copy of a cached image. The copy is created once and stored next to the decoded image.
+ * @param decoder_dsc   the decoded image
+ * @param level_x       downscale the width by 2^level_x
+ * @param level_y       downscale the height by 2^level_y
+ * @return              the downscaled copy or NULL if the image is not cached or on error
+ */
+static const lv_draw_buf_t * mipmap_get(const lv_image_decoder_dsc_t * decoder_dsc, uint32_t level_x, uint32_t level_y)
+{
+    /*Creating a copy on each draw would be slower than transforming the original image*/
+    if(decoder_dsc->cache_entry == NULL) return NULL;
+
+    /*The decoded image might be post processed after reading it from the cache*/
+    lv_image_cache_data_t * cached_data = lv_cache_entry_get_data(decoder_dsc->cache_entry);
+    if(cached_data->decoded != decoder_dsc->decoded) return NULL;
+
+    /*Other draw units might draw the same image*/
+    lv_mutex_lock(&_draw_info.mipmap_mutex);
+
+    lv_image_cache_mipmap_t * mipmap = cached_data->mipmaps;
+    while(mipmap) {
+        if(mipmap->level_x == level_x && mipmap->level_y == level_y) break;
+        mipmap = mipmap->next;
+    }
+
+    const lv_draw_buf_t * decoded = mipmap ? mipmap->decoded : NULL;
+    if(decoded == NULL) {
+        lv_draw_buf_t * new_decoded = lv_draw_sw_mipmap_create(decoder_dsc->decoded, level_x, level_y);
+        if(new_decoded) {
+            if(lv_image_cache_add_mipmap(decoder_dsc->cache_entry, new_decoded, level_x, level_y) == LV_RESULT_OK) {
+                decoded = new_decoded;
+            }
+            else {
+                lv_draw_buf_destroy(new_decoded);
+            }
+        }
+    }
+
+    lv_mutex_unlock(&_draw_info.mipmap_mutex);
+
+    return decoded;
+}
+
+#endif /*LV_DRAW_SW_MIPMAP*/
+
 #endif /*LV_USE_DRAW_SW*/
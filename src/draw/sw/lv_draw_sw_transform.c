@@ -14,10 +14,22 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_color.h"
 #include "../../stdlib/lv_string.h"
+#include "../../stdlib/lv_mem.h"
+
+/*Interpolate 4 pixels at once with vector instructions if the compiler targets them*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TRANSFORM_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define TRANSFORM_NEON 1
+#endif
 
 /*********************
  *      DEFINES
  *********************/
+/*Transform rotated images in TILE_SIZE x TILE_SIZE px blocks*/
+#define TILE_SIZE   32
 
 /**********************
  *      TYPEDEFS
@@ -35,11 +47,31 @@ typedef struct {
     int32_t pivot_x_256;
     int32_t pivot_y_256;
     lv_point_t pivot;
+    int64_t tan_x;  /*tan of the skews in 1/65536 units*/
+    int64_t tan_y;
+    int32_t det;    /*Determinant of the skew matrix in 1/65536 units*/
 } point_transform_dsc_t;
 
+/*Where to start to read a row of the destination area on the source image and how to step*/
+typedef struct {
+    int32_t xs_ups;
+    int32_t ys_ups;
+    int32_t xs_step;
+    int32_t ys_step;
+} transform_line_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void transform(const lv_area_t * dest_area, const void * src_buf, int32_t src_w, int32_t src_h,
+                      int32_t src_stride, uint32_t level_x, uint32_t level_y,
+                      const lv_draw_image_dsc_t * draw_dsc, lv_color_format_t src_cf, void * dest_buf);
+
+static void transform_line(const void * src_buf, int32_t src_w, int32_t src_h, int32_t src_stride,
+                           lv_color_format_t src_cf, const lv_draw_image_dsc_t * draw_dsc,
+                           const transform_line_dsc_t * line, int32_t x_start, int32_t x_end,
+                           uint8_t * dest_buf, uint8_t * alpha_buf);
+
 /**
  * Transform a point with 1/256 precision (the output coordinates are upscaled by 256)
  * @param t         pointer to n initialized `point_transform_dsc_t` structure
@@ -53,27 +85,38 @@ static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int
 
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size);
 
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa);
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa);
 
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa);
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8,
+                               bool aa);
 
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                         int32_t x_end, uint8_t * abuf, bool aa);
+                         int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
 
 static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                 int32_t x_end, uint8_t * abuf, bool aa);
+                                 int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
 
 static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                     int32_t x_end, uint8_t * abuf, bool aa);
+                                     int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa);
+
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+static void transform_argb8888_simd(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                    int32_t x_start, int32_t x_end, uint8_t * dest_buf);
+
+static void transform_rgb565_simd(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -94,10 +137,223 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
     LV_UNUSED(draw_unit);
     LV_UNUSED(sup);
 
+    transform(dest_area, src_buf, src_w, src_h, src_stride, 0, 0, draw_dsc, src_cf, dest_buf);
+}
+
+#if LV_DRAW_SW_MIPMAP
+
+void lv_draw_sw_transform_mipmap(lv_draw_unit_t * draw_unit, const lv_area_t * dest_area, const lv_draw_buf_t * mipmap,
+                                 uint32_t level_x, uint32_t level_y,
+                                 const lv_draw_image_dsc_t * draw_dsc, const lv_draw_image_sup_t * sup, lv_color_format_t cf, void * dest_buf)
+{
+    LV_UNUSED(draw_unit);
+    LV_UNUSED(sup);
+
+    transform(dest_area, mipmap->data, mipmap->header.w, mipmap->header.h, mipmap->header.stride, level_x, level_y,
+              draw_dsc, cf, dest_buf);
+}
+
+lv_draw_buf_t * lv_draw_sw_mipmap_create(const lv_draw_buf_t * src, uint32_t level_x, uint32_t level_y)
+{
+    lv_color_format_t cf = src->header.cf;
+    bool premultiplied = src->header.flags & LV_IMAGE_FLAGS_PREMULTIPLIED;
+    switch(cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_XRGB8888:
+        case LV_COLOR_FORMAT_RGB888:
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB565A8:
+        case LV_COLOR_FORMAT_A8:
+        case LV_COLOR_FORMAT_L8:
+            break;
+        default:
+            return NULL;
+    }
+
+    /*The sums of the 4 channels of the pixels are stored in 32 bit,
+     *it limits the number of pixels of a box to 2^16*/
+    LV_ASSERT(level_x + level_y <= 16);
+
+    int32_t src_w = src->header.w;
+    int32_t src_h = src->header.h;
+    int32_t src_stride = src->header.stride;
+    int32_t dest_w = ((src_w - 1) >> level_x) + 1;
+    int32_t dest_h = ((src_h - 1) >> level_y) + 1;
+
+    lv_draw_buf_t * dest = lv_draw_buf_create(dest_w, dest_h, cf, 0);
+    if(dest == NULL) return NULL;
+    if(premultiplied) dest->header.flags |= LV_IMAGE_FLAGS_PREMULTIPLIED;
+
+    uint32_t * sum = lv_malloc(dest_w * 4 * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(sum);
+    if(sum == NULL) {
+        lv_draw_buf_destroy(dest);
+        return NULL;
+    }
+
+    int32_t dest_stride = dest->header.stride;
+    const uint8_t * src_alpha = src->data + src_stride * src_h;
+    uint8_t * dest_alpha = dest->data + dest_stride * dest_h;
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < dest_h; y++) {
+        int32_t ys_start = y << level_y;
+        int32_t ys_end = LV_MIN(ys_start + (1 << level_y), src_h);
+        lv_memzero(sum, dest_w * 4 * sizeof(uint32_t));
+
+        /*Sum the pixels of each box. Straight alpha colors are weighted by their opacity.*/
+        int32_t ys;
+        for(ys = ys_start; ys < ys_end; ys++) {
+            const uint8_t * src_row = src->data + ys * src_stride;
+            int32_t xs;
+            switch(cf) {
+                case LV_COLOR_FORMAT_ARGB8888:
+                    if(!premultiplied) {
+                        for(xs = 0; xs < src_w; xs++) {
+                            uint32_t * s = &sum[(xs >> level_x) * 4];
+                            const uint8_t * px = &src_row[xs * 4];
+                            s[0] += px[0] * px[3];
+                            s[1] += px[1] * px[3];
+                            s[2] += px[2] * px[3];
+                            s[3] += px[3];
+                        }
+                        break;
+                    }
+                /*Premultiplied colors can be simply summed*/
+                /* fall through */
+                case LV_COLOR_FORMAT_XRGB8888:
+                    for(xs = 0; xs < src_w; xs++) {
+                        uint32_t * s = &sum[(xs >> level_x) * 4];
+                        const uint8_t * px = &src_row[xs * 4];
+                        s[0] += px[0];
+                        s[1] += px[1];
+                        s[2] += px[2];
+                        s[3] += px[3];
+                    }
+                    break;
+                case LV_COLOR_FORMAT_RGB888:
+                    for(xs = 0; xs < src_w; xs++) {
+                        uint32_t * s = &sum[(xs >> level_x) * 4];
+                        const uint8_t * px = &src_row[xs * 3];
+                        s[0] += px[0];
+                        s[1] += px[1];
+                        s[2] += px[2];
+                    }
+                    break;
+                case LV_COLOR_FORMAT_RGB565:
+                    for(xs = 0; xs < src_w; xs++) {
+                        uint32_t * s = &sum[(xs >> level_x) * 4];
+                        uint16_t px = ((const uint16_t *)src_row)[xs];
+                        s[0] += px & 0x1F;
+                        s[1] += (px >> 5) & 0x3F;
+                        s[2] += px >> 11;
+                    }
+                    break;
+                case LV_COLOR_FORMAT_RGB565A8: {
+                        const uint8_t * src_alpha_row = src_alpha + ys * (src_stride / 2);
+                        for(xs = 0; xs < src_w; xs++) {
+                            uint32_t * s = &sum[(xs >> level_x) * 4];
+                            uint16_t px = ((const uint16_t *)src_row)[xs];
+                            uint32_t a = src_alpha_row[xs];
+                            s[0] += (px & 0x1F) * a;
+                            s[1] += ((px >> 5) & 0x3F) * a;
+                            s[2] += (px >> 11) * a;
+                            s[3] += a;
+                        }
+                    }
+                    break;
+                default:    /*A8 and L8*/
+                    for(xs = 0; xs < src_w; xs++) {
+                        sum[(xs >> level_x) * 4] += src_row[xs];
+                    }
+                    break;
+            }
+        }
+
+        /*Store the averages*/
+        uint8_t * dest_row = dest->data + y * dest_stride;
+        for(x = 0; x < dest_w; x++) {
+            int32_t xs_start = x << level_x;
+            int32_t xs_end = LV_MIN(xs_start + (1 << level_x), src_w);
+            uint32_t cnt = (xs_end - xs_start) * (ys_end - ys_start);
+            uint32_t * s = &sum[x * 4];
+            switch(cf) {
+                case LV_COLOR_FORMAT_ARGB8888:
+                    if(!premultiplied) {
+                        uint8_t * px = &dest_row[x * 4];
+                        if(s[3] == 0) {
+                            lv_memzero(px, 4);
+                        }
+                        else {
+                            px[0] = (s[0] + s[3] / 2) / s[3];
+                            px[1] = (s[1] + s[3] / 2) / s[3];
+                            px[2] = (s[2] + s[3] / 2) / s[3];
+                            px[3] = (s[3] + cnt / 2) / cnt;
+                        }
+                        break;
+                    }
+                /* fall through */
+                case LV_COLOR_FORMAT_XRGB8888: {
+                        uint8_t * px = &dest_row[x * 4];
+                        px[0] = (s[0] + cnt / 2) / cnt;
+                        px[1] = (s[1] + cnt / 2) / cnt;
+                        px[2] = (s[2] + cnt / 2) / cnt;
+                        px[3] = (s[3] + cnt / 2) / cnt;
+                    }
+                    break;
+                case LV_COLOR_FORMAT_RGB888: {
+                        uint8_t * px = &dest_row[x * 3];
+                        px[0] = (s[0] + cnt / 2) / cnt;
+                        px[1] = (s[1] + cnt / 2) / cnt;
+                        px[2] = (s[2] + cnt / 2) / cnt;
+                    }
+                    break;
+                case LV_COLOR_FORMAT_RGB565:
+                    ((uint16_t *)dest_row)[x] = (((s[2] + cnt / 2) / cnt) << 11) +
+                                                (((s[1] + cnt / 2) / cnt) << 5) +
+                                                ((s[0] + cnt / 2) / cnt);
+                    break;
+                case LV_COLOR_FORMAT_RGB565A8: {
+                        uint8_t * dest_alpha_row = dest_alpha + y * (dest_stride / 2);
+                        if(s[3] == 0) {
+                            ((uint16_t *)dest_row)[x] = 0;
+                            dest_alpha_row[x] = 0;
+                        }
+                        else {
+                            ((uint16_t *)dest_row)[x] = (((s[2] + s[3] / 2) / s[3]) << 11) +
+                                                        (((s[1] + s[3] / 2) / s[3]) << 5) +
+                                                        ((s[0] + s[3] / 2) / s[3]);
+                            dest_alpha_row[x] = (s[3] + cnt / 2) / cnt;
+                        }
+                    }
+                    break;
+                default:
+                    dest_row[x] = (s[0] + cnt / 2) / cnt;
+                    break;
+            }
+        }
+    }
+
+    lv_free(sum);
+
+    return dest;
+}
+
+#endif /*LV_DRAW_SW_MIPMAP*/
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void transform(const lv_area_t * dest_area, const void * src_buf, int32_t src_w, int32_t src_h,
+                      int32_t src_stride, uint32_t level_x, uint32_t level_y,
+                      const lv_draw_image_dsc_t * draw_dsc, lv_color_format_t src_cf, void * dest_buf)
+{
     point_transform_dsc_t tr_dsc;
     tr_dsc.angle = -draw_dsc->rotation;
-    tr_dsc.scale_x = draw_dsc->scale_x;
-    tr_dsc.scale_y = draw_dsc->scale_y;
+    tr_dsc.scale_x = draw_dsc->scale_x << level_x;
+    tr_dsc.scale_y = draw_dsc->scale_y << level_y;
     tr_dsc.pivot = draw_dsc->pivot;
 
     int32_t angle_low = tr_dsc.angle / 10;
@@ -114,8 +370,16 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
     tr_dsc.cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
     tr_dsc.sinma = tr_dsc.sinma >> (LV_TRIGO_SHIFT - 10);
     tr_dsc.cosma = tr_dsc.cosma >> (LV_TRIGO_SHIFT - 10);
-    tr_dsc.pivot_x_256 = tr_dsc.pivot.x * 256;
-    tr_dsc.pivot_y_256 = tr_dsc.pivot.y * 256;
+    /*The pivot on the source image. If it's downscaled the center of the first pixel moves too.*/
+    tr_dsc.pivot_x_256 = ((tr_dsc.pivot.x * 256 + 0x80) >> level_x) - 0x80;
+    tr_dsc.pivot_y_256 = ((tr_dsc.pivot.y * 256 + 0x80) >> level_y) - 0x80;
+
+    /*On a downscaled image the skew is relative to the downscaled pixels*/
+    int64_t tan_x = _lv_skew_get_tan(draw_dsc->skew_x);
+    int64_t tan_y = _lv_skew_get_tan(draw_dsc->skew_y);
+    tr_dsc.tan_x = (tan_x << level_y) >> level_x;
+    tr_dsc.tan_y = (tan_y << level_x) >> level_y;
+    tr_dsc.det = (int32_t)(65536 - ((tan_x * tan_y) >> 16));
 
     int32_t dest_w = lv_area_get_width(dest_area);
     int32_t dest_h = lv_area_get_height(dest_area);
@@ -144,11 +408,19 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
         alpha_buf = NULL;
     }
 
-    bool aa = (bool) draw_dsc->antialias;
-    bool is_rotated = draw_dsc->rotation;
+    /*If the image is skewed so much that it's squeezed to less than 1/16 of its area
+     *it's only a thin line. Don't draw it as the source coordinates would overflow.*/
+    if(tr_dsc.det > -4096 && tr_dsc.det < 4096) {
+        lv_memzero(dest_buf, dest_stride * dest_h);
+        if(alpha_buf) lv_memzero(alpha_buf, dest_stride_a8 * dest_h);
+        return;
+    }
+
+    /*Skewed images are read diagonally as well so handle them like rotated images*/
+    bool is_rotated = draw_dsc->rotation || tr_dsc.tan_x || tr_dsc.tan_y;
 
-    int32_t xs_ups = 0, ys_ups = 0, ys_ups_start = 0, ys_step_256_original = 0;
-    int32_t xs_step_256 = 0, ys_step_256 = 0;
+    int32_t xs_ups = 0, ys_ups_start = 0, ys_step_256_original = 0;
+    int32_t xs_step_256 = 0;
 
     /*If scaled only make some simplification to avoid rounding errors.
      *For example if there is a 100x100 image zoomed to 300%
@@ -163,8 +435,8 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
     if(is_rotated == false) {
         int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
 
-        int32_t x_max = (((src_w - 1 - draw_dsc->pivot.x) * draw_dsc->scale_x) >> 8) + draw_dsc->pivot.x;
-        int32_t y_max = (((src_h - 1 - draw_dsc->pivot.y) * draw_dsc->scale_y) >> 8) + draw_dsc->pivot.y;
+        int32_t x_max = (int32_t)((((int64_t)(src_w - 1) * 256 - tr_dsc.pivot_x_256) * tr_dsc.scale_x) >> 16) + tr_dsc.pivot.x;
+        int32_t y_max = (int32_t)((((int64_t)(src_h - 1) * 256 - tr_dsc.pivot_y_256) * tr_dsc.scale_y) >> 16) + tr_dsc.pivot.y;
 
         lv_area_t dest_area_limited;
         dest_area_limited.x1 = dest_area->x1 > x_max ? x_max : dest_area->x1;
@@ -190,85 +462,128 @@ void lv_draw_sw_transform(lv_draw_unit_t * draw_unit, const lv_area_t * dest_are
         ys_ups_start = ys1_ups + 0x80;
     }
 
-    int32_t y;
-    for(y = 0; y < dest_h; y++) {
-        if(is_rotated == false) {
-            ys_ups = ys_ups_start + ((ys_step_256_original * y) >> 8);
-            ys_step_256 = 0;
-        }
-        else {
-            int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
-            transform_point_upscaled(&tr_dsc, dest_area->x1, dest_area->y1 + y, &xs1_ups, &ys1_ups);
-            transform_point_upscaled(&tr_dsc, dest_area->x2, dest_area->y1 + y, &xs2_ups, &ys2_ups);
-
-            int32_t xs_diff = xs2_ups - xs1_ups;
-            int32_t ys_diff = ys2_ups - ys1_ups;
-            xs_step_256 = 0;
-            ys_step_256 = 0;
-            if(dest_w > 1) {
-                xs_step_256 = (256 * xs_diff) / (dest_w - 1);
-                ys_step_256 = (256 * ys_diff) / (dest_w - 1);
+    /*Rotated images are read diagonally, so reading a whole row would evict the source pixels
+     *from the data cache before the next row could use them. Therefore transform them in tiles.
+     *The start and step of the rows are calculated for the whole row to get the same result.*/
+    int32_t tile_w = is_rotated ? TILE_SIZE : dest_w;
+    transform_line_dsc_t lines[TILE_SIZE];
+    int32_t y_tile;
+    for(y_tile = 0; y_tile < dest_h; y_tile += TILE_SIZE) {
+        int32_t tile_h = LV_MIN(TILE_SIZE, dest_h - y_tile);
+        int32_t y;
+        for(y = 0; y < tile_h; y++) {
+            transform_line_dsc_t * line = &lines[y];
+            if(is_rotated == false) {
+                line->xs_ups = xs_ups;
+                line->ys_ups = ys_ups_start + ((ys_step_256_original * (y_tile + y)) >> 8);
+                line->xs_step = xs_step_256;
+                line->ys_step = 0;
+            }
+            else {
+                int32_t xs1_ups, ys1_ups, xs2_ups, ys2_ups;
+                transform_point_upscaled(&tr_dsc, dest_area->x1, dest_area->y1 + y_tile + y, &xs1_ups, &ys1_ups);
+                transform_point_upscaled(&tr_dsc, dest_area->x2, dest_area->y1 + y_tile + y, &xs2_ups, &ys2_ups);
+
+                int32_t xs_diff = xs2_ups - xs1_ups;
+                int32_t ys_diff = ys2_ups - ys1_ups;
+                line->xs_step = 0;
+                line->ys_step = 0;
+                if(dest_w > 1) {
+                    line->xs_step = (int32_t)((256 * (int64_t)xs_diff) / (dest_w - 1));
+                    line->ys_step = (int32_t)((256 * (int64_t)ys_diff) / (dest_w - 1));
+                }
+
+                line->xs_ups = xs1_ups + 0x80;
+                line->ys_ups = ys1_ups + 0x80;
             }
+        }
 
-            xs_ups = xs1_ups + 0x80;
-            ys_ups = ys1_ups + 0x80;
+        int32_t x_tile;
+        for(x_tile = 0; x_tile < dest_w; x_tile += tile_w) {
+            int32_t x_end = LV_MIN(x_tile + tile_w, dest_w);
+            for(y = 0; y < tile_h; y++) {
+                uint8_t * dest_line = (uint8_t *)dest_buf + (y_tile + y) * dest_stride;
+                uint8_t * alpha_line = alpha_buf ? alpha_buf + (y_tile + y) * dest_stride_a8 : NULL;
+                transform_line(src_buf, src_w, src_h, src_stride, src_cf, draw_dsc, &lines[y], x_tile, x_end,
+                               dest_line, alpha_line);
+            }
         }
+    }
+}
 
-        switch(src_cf) {
-            case LV_COLOR_FORMAT_XRGB8888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 4);
-                break;
-            case LV_COLOR_FORMAT_RGB888:
-                transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa,
-                                 3);
-                break;
-            case LV_COLOR_FORMAT_A8:
-                transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
-                break;
-            case LV_COLOR_FORMAT_ARGB8888:
-                transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   aa);
-                break;
-            case LV_COLOR_FORMAT_RGB565:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                   alpha_buf, false, aa);
-                break;
-            case LV_COLOR_FORMAT_RGB565A8:
-                transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w,
-                                   (uint16_t *)dest_buf,
-                                   alpha_buf, true, aa);
-                break;
-            case LV_COLOR_FORMAT_L8:
-                if(draw_dsc->recolor_opa >= LV_OPA_MIN)
-                    transform_l8_to_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf,
-                                             aa);
-                else
-                    transform_l8_to_al88(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, dest_w, dest_buf, aa);
+static void transform_line(const void * src_buf, int32_t src_w, int32_t src_h, int32_t src_stride,
+                           lv_color_format_t src_cf, const lv_draw_image_dsc_t * draw_dsc,
+                           const transform_line_dsc_t * line, int32_t x_start, int32_t x_end,
+                           uint8_t * dest_buf, uint8_t * alpha_buf)
+{
+    int32_t xs_ups = line->xs_ups;
+    int32_t ys_ups = line->ys_ups;
+    int32_t xs_step_256 = line->xs_step;
+    int32_t ys_step_256 = line->ys_step;
+    bool aa = (bool) draw_dsc->antialias;
+
+    switch(src_cf) {
+        case LV_COLOR_FORMAT_XRGB8888:
+            transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                             dest_buf, aa, 4);
+            break;
+        case LV_COLOR_FORMAT_RGB888:
+            transform_rgb888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                             dest_buf, aa, 3);
+            break;
+        case LV_COLOR_FORMAT_A8:
+            transform_a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                         dest_buf, aa);
+            break;
+        case LV_COLOR_FORMAT_ARGB8888:
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+            if(aa) {
+                transform_argb8888_simd(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                        x_start, x_end, dest_buf);
                 break;
-            default:
+            }
+#endif
+            transform_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                               dest_buf, aa);
+            break;
+        case LV_COLOR_FORMAT_RGB565:
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+            if(aa) {
+                transform_rgb565_simd(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                      x_start, x_end, (uint16_t *)dest_buf, alpha_buf);
                 break;
-        }
-
-        dest_buf = (uint8_t *)dest_buf + dest_stride;
-        if(alpha_buf) alpha_buf += dest_stride_a8;
+            }
+#endif
+            transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                               (uint16_t *)dest_buf, alpha_buf, false, aa);
+            break;
+        case LV_COLOR_FORMAT_RGB565A8:
+            transform_rgb565a8(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256, x_start, x_end,
+                               (uint16_t *)dest_buf, alpha_buf, true, aa);
+            break;
+        case LV_COLOR_FORMAT_L8:
+            if(draw_dsc->recolor_opa >= LV_OPA_MIN)
+                transform_l8_to_argb8888(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                         x_start, x_end, dest_buf, aa);
+            else
+                transform_l8_to_al88(src_buf, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step_256, ys_step_256,
+                                     x_start, x_end, dest_buf, aa);
+            break;
+        default:
+            break;
     }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                              int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                             int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
+                             int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa, uint32_t px_size)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -357,14 +672,14 @@ static void transform_rgb888(const uint8_t * src, int32_t src_w, int32_t src_h,
 
 static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint8_t * dest_buf, bool aa)
+                               int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *) dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -446,7 +761,8 @@ static void transform_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h
 
 static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                               int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8, bool aa)
+                               int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf, bool src_has_a8,
+                               bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
@@ -457,7 +773,7 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
     int32_t alpha_stride = src_stride / 2; /*alpha map stride is always half of RGB map stride*/
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -479,20 +795,22 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
         int32_t y_next;
         if(xs_fract < 0x80) {
             x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
+            xs_fract = 0x7F - xs_fract;
         }
         else {
             x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
+            xs_fract = xs_fract - 0x80;
         }
+        xs_fract = xs_fract * 2;
         if(ys_fract < 0x80) {
             y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
+            ys_fract = 0x7F - ys_fract;
         }
         else {
             y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
+            ys_fract = ys_fract - 0x80;
         }
+        ys_fract = ys_fract * 2;
 
         const uint16_t * src_tmp_u16 = (const uint16_t *)(src + (ys_int * src_stride) + xs_int * 2);
         cbuf[x] = src_tmp_u16[0];
@@ -557,13 +875,13 @@ static void transform_rgb565a8(const uint8_t * src, int32_t src_w, int32_t src_h
 
 static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                          int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                         int32_t x_end, uint8_t * abuf, bool aa)
+                         int32_t x_start, int32_t x_end, uint8_t * abuf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -585,20 +903,22 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
         int32_t y_next;
         if(xs_fract < 0x80) {
             x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
+            xs_fract = 0x7F - xs_fract;
         }
         else {
             x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
+            xs_fract = xs_fract - 0x80;
         }
+        xs_fract = xs_fract * 2;
         if(ys_fract < 0x80) {
             y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
+            ys_fract = 0x7F - ys_fract;
         }
         else {
             y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
+            ys_fract = ys_fract - 0x80;
         }
+        ys_fract = ys_fract * 2;
 
         const uint8_t * src_tmp = src;
         src_tmp += ys_int * src_stride + xs_int;
@@ -632,14 +952,14 @@ static void transform_a8(const uint8_t * src, int32_t src_w, int32_t src_h, int3
 /* L8 will be transformed into an AL88 buffer, because it will not be recolored */
 static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                 int32_t x_end, uint8_t * dest_buf, bool aa)
+                                 int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color16a_t * dest_al88 = (lv_color16a_t *)dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -662,20 +982,22 @@ static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src
         int32_t y_next;
         if(xs_fract < 0x80) {
             x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
+            xs_fract = 0x7F - xs_fract;
         }
         else {
             x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
+            xs_fract = xs_fract - 0x80;
         }
+        xs_fract = xs_fract * 2;
         if(ys_fract < 0x80) {
             y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
+            ys_fract = 0x7F - ys_fract;
         }
         else {
             y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
+            ys_fract = ys_fract - 0x80;
         }
+        ys_fract = ys_fract * 2;
 
         const uint8_t * src_tmp = src;
         src_tmp += ys_int * src_stride + xs_int;
@@ -709,14 +1031,14 @@ static void transform_l8_to_al88(const uint8_t * src, int32_t src_w, int32_t src
 /* L8 has to be transformed into an ARGB8888 buffer, because it will be recolored as well */
 static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
                                      int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
-                                     int32_t x_end, uint8_t * dest_buf, bool aa)
+                                     int32_t x_start, int32_t x_end, uint8_t * dest_buf, bool aa)
 {
     int32_t xs_ups_start = xs_ups;
     int32_t ys_ups_start = ys_ups;
     lv_color32_t * dest_c32 = (lv_color32_t *)dest_buf;
 
     int32_t x;
-    for(x = 0; x < x_end; x++) {
+    for(x = x_start; x < x_end; x++) {
         xs_ups = xs_ups_start + ((xs_step * x) >> 8);
         ys_ups = ys_ups_start + ((ys_step * x) >> 8);
 
@@ -738,20 +1060,22 @@ static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t
         int32_t y_next;
         if(xs_fract < 0x80) {
             x_next = -1;
-            xs_fract = (0x7F - xs_fract) * 2;
+            xs_fract = 0x7F - xs_fract;
         }
         else {
             x_next = 1;
-            xs_fract = (xs_fract - 0x80) * 2;
+            xs_fract = xs_fract - 0x80;
         }
+        xs_fract = xs_fract * 2;
         if(ys_fract < 0x80) {
             y_next = -1;
-            ys_fract = (0x7F - ys_fract) * 2;
+            ys_fract = 0x7F - ys_fract;
         }
         else {
             y_next = 1;
-            ys_fract = (ys_fract - 0x80) * 2;
+            ys_fract = ys_fract - 0x80;
         }
+        ys_fract = ys_fract * 2;
 
         const uint8_t * src_tmp = src;
         src_tmp += ys_int * src_stride + xs_int;
@@ -782,19 +1106,285 @@ static void transform_l8_to_argb8888(const uint8_t * src, int32_t src_w, int32_t
     }
 }
 
-static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
-                                     int32_t * yout)
+#if defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)
+
+/**
+ * Get the source pixels of 4 destination pixels and their neighbors for the interpolation.
+ * Works the same way as the scalar functions.
+ * @param src           the source image
+ * @param src_w         width of the source image
+ * @param src_h         height of the source image
+ * @param src_stride    stride of the source image
+ * @param px_size       2 for RGB565, 4 for ARGB8888
+ * @param line          where to start and how to step on the source image
+ * @param x             index of the first destination pixel
+ * @param px            store the pixels here
+ * @param px_hor        store the horizontal neighbors here
+ * @param px_ver        store the vertical neighbors here
+ * @param xs_fract      store the horizontal mix ratios here (0..127)
+ * @param ys_fract      store the vertical mix ratios here (0..127)
+ * @return              true: all pixels and their neighbors are on the image;
+ *                      false: at least one isn't so the scalar functions should handle them
+ */
+static inline bool fetch_4px(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride, int32_t px_size,
+                             const transform_line_dsc_t * line, int32_t x, uint32_t px[4], uint32_t px_hor[4],
+                             uint32_t px_ver[4], uint32_t xs_fract[4], uint32_t ys_fract[4])
 {
-    if(t->angle == 0 && t->scale_x == LV_SCALE_NONE && t->scale_y == LV_SCALE_NONE) {
-        *xout = xin * 256;
-        *yout = yin * 256;
-        return;
+    int32_t i;
+    for(i = 0; i < 4; i++) {
+        int32_t xs_ups = line->xs_ups + ((line->xs_step * (x + i)) >> 8);
+        int32_t ys_ups = line->ys_ups + ((line->ys_step * (x + i)) >> 8);
+
+        int32_t xs_int = xs_ups >> 8;
+        int32_t ys_int = ys_ups >> 8;
+        int32_t xs_f = xs_ups & 0xFF;
+        int32_t ys_f = ys_ups & 0xFF;
+        int32_t x_next = xs_f < 0x80 ? -1 : 1;
+        int32_t y_next = ys_f < 0x80 ? -1 : 1;
+
+        if(xs_int < 0 || xs_int >= src_w || xs_int + x_next < 0 || xs_int + x_next >= src_w ||
+           ys_int < 0 || ys_int >= src_h || ys_int + y_next < 0 || ys_int + y_next >= src_h) {
+            return false;
+        }
+
+        xs_fract[i] = xs_f < 0x80 ? 0x7F - xs_f : xs_f - 0x80;
+        ys_fract[i] = ys_f < 0x80 ? 0x7F - ys_f : ys_f - 0x80;
+
+        const uint8_t * src_px = src + ys_int * src_stride + xs_int * px_size;
+        if(px_size == 4) {
+            px[i] = *(const uint32_t *)src_px;
+            px_hor[i] = *(const uint32_t *)(src_px + x_next * 4);
+            px_ver[i] = *(const uint32_t *)(src_px + y_next * src_stride);
+        }
+        else {
+            px[i] = *(const uint16_t *)src_px;
+            px_hor[i] = *(const uint16_t *)(src_px + x_next * 2);
+            px_ver[i] = *(const uint16_t *)(src_px + y_next * src_stride);
+        }
     }
 
+    return true;
+}
+
+#ifdef TRANSFORM_SSE2
+
+/**
+ * Mix the neighbors into 4 ARGB8888 pixels the same way as `transform_argb8888`:
+ * - if the neighbor is transparent only the alpha is faded,
+ * - if the neighbor is the same color nothing changes,
+ * - else both are mixed but the color is kept if the ratio is <= LV_OPA_MIN
+ * @param c         4 pixels
+ * @param n         their neighbors
+ * @param fract     the mix ratios in 32 bit lanes
+ * @return          the mixed pixels
+ */
+static inline __m128i mix_argb8888_sse2(__m128i c, __m128i n, __m128i fract)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a_mask = _mm_set1_epi32((int32_t)0xFF000000);
+
+    __m128i n_transp = _mm_cmpeq_epi32(_mm_and_si128(n, a_mask), zero);
+    __m128i same = _mm_cmpeq_epi32(c, n);
+    __m128i a_sel = _mm_or_si128(n_transp, _mm_xor_si128(same, _mm_cmpeq_epi32(zero, zero)));
+    __m128i rgb_sel = _mm_andnot_si128(_mm_or_si128(n_transp, same),
+                                       _mm_cmpgt_epi32(fract, _mm_set1_epi32(LV_OPA_MIN)));
+    __m128i sel = _mm_or_si128(_mm_and_si128(a_sel, a_mask), _mm_andnot_si128(a_mask, rgb_sel));
+
+    /*Repeat the ratios for the 4 channels in 16 bit lanes*/
+    __m128i f16 = _mm_or_si128(fract, _mm_slli_epi32(fract, 16));
+    __m128i f_lo = _mm_unpacklo_epi32(f16, f16);
+    __m128i f_hi = _mm_unpackhi_epi32(f16, f16);
+    __m128i f_inv_lo = _mm_sub_epi16(_mm_set1_epi16(0xFF), f_lo);
+    __m128i f_inv_hi = _mm_sub_epi16(_mm_set1_epi16(0xFF), f_hi);
+
+    /*255 * 255 fits into 16 bits*/
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(n, zero), f_lo),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), f_inv_lo));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(n, zero), f_hi),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), f_inv_hi));
+    __m128i mixed = _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+
+    return _mm_or_si128(_mm_and_si128(sel, mixed), _mm_andnot_si128(sel, c));
+}
+
+/**
+ * Mix RGB565 colors the same way as `lv_color_16_16_mix`
+ * @param fg        4 foreground colors spread to 32 bit lanes with `0x7E0F81F` mask
+ * @param bg        4 background colors spread to 32 bit lanes with `0x7E0F81F` mask
+ * @param mix       the mix ratios already divided by 8 in both 16 bit halves of the 32 bit lanes
+ * @return          the mixed colors spread to 32 bit lanes
+ */
+static inline __m128i mix_rgb565_sse2(__m128i fg, __m128i bg, __m128i mix)
+{
+    /*SSE2 has no 32 bit multiplication so assemble the lower 32 bits of the product from 16 bit ones*/
+    __m128i diff = _mm_sub_epi32(fg, bg);
+    __m128i prod = _mm_add_epi32(_mm_mullo_epi16(diff, mix), _mm_slli_epi32(_mm_mulhi_epu16(diff, mix), 16));
+    return _mm_and_si128(_mm_add_epi32(_mm_srli_epi32(prod, 5), bg), _mm_set1_epi32(0x7E0F81F));
+}
+
+#else /*TRANSFORM_NEON*/
+
+/**
+ * Mix the neighbors into 4 ARGB8888 pixels the same way as `transform_argb8888`:
+ * - if the neighbor is transparent only the alpha is faded,
+ * - if the neighbor is the same color nothing changes,
+ * - else both are mixed but the color is kept if the ratio is <= LV_OPA_MIN
+ * @param c         4 pixels
+ * @param n         their neighbors
+ * @param fract     the mix ratios in 32 bit lanes
+ * @return          the mixed pixels
+ */
+static inline uint32x4_t mix_argb8888_neon(uint32x4_t c, uint32x4_t n, uint32x4_t fract)
+{
+    const uint32x4_t a_mask = vdupq_n_u32(0xFF000000);
+
+    uint32x4_t n_transp = vceqq_u32(vandq_u32(n, a_mask), vdupq_n_u32(0));
+    uint32x4_t same = vceqq_u32(c, n);
+    uint32x4_t a_sel = vornq_u32(n_transp, same);
+    uint32x4_t rgb_sel = vbicq_u32(vcgtq_u32(fract, vdupq_n_u32(LV_OPA_MIN)), vorrq_u32(n_transp, same));
+    uint32x4_t sel = vbslq_u32(a_mask, a_sel, rgb_sel);
+
+    /*Repeat the ratios for the 4 channels*/
+    uint8x16_t f = vreinterpretq_u8_u32(vmulq_n_u32(fract, 0x01010101));
+    uint8x16_t f_inv = vsubq_u8(vdupq_n_u8(0xFF), f);
+    uint8x16_t n8 = vreinterpretq_u8_u32(n);
+    uint8x16_t c8 = vreinterpretq_u8_u32(c);
+
+    uint16x8_t lo = vmlal_u8(vmull_u8(vget_low_u8(n8), vget_low_u8(f)), vget_low_u8(c8), vget_low_u8(f_inv));
+    uint16x8_t hi = vmlal_u8(vmull_u8(vget_high_u8(n8), vget_high_u8(f)), vget_high_u8(c8), vget_high_u8(f_inv));
+    uint32x4_t mixed = vreinterpretq_u32_u8(vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+
+    return vbslq_u32(sel, mixed, c);
+}
+
+/**
+ * Mix RGB565 colors the same way as `lv_color_16_16_mix`
+ * @param fg        4 foreground colors spread to 32 bit lanes with `0x7E0F81F` mask
+ * @param bg        4 background colors spread to 32 bit lanes with `0x7E0F81F` mask
+ * @param mix       the mix ratios already divided by 8
+ * @return          the mixed colors spread to 32 bit lanes
+ */
+static inline uint32x4_t mix_rgb565_neon(uint32x4_t fg, uint32x4_t bg, uint32x4_t mix)
+{
+    uint32x4_t prod = vmulq_u32(vsubq_u32(fg, bg), mix);
+    return vandq_u32(vaddq_u32(vshrq_n_u32(prod, 5), bg), vdupq_n_u32(0x7E0F81F));
+}
+
+#endif /*TRANSFORM_SSE2*/
+
+static void transform_argb8888_simd(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                    int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                    int32_t x_start, int32_t x_end, uint8_t * dest_buf)
+{
+    transform_line_dsc_t line = {xs_ups, ys_ups, xs_step, ys_step};
+    uint32_t px[4], px_hor[4], px_ver[4], xs_fract[4], ys_fract[4];
+    uint32_t * dest_u32 = (uint32_t *)dest_buf;
+
+    int32_t x;
+    for(x = x_start; x + 4 <= x_end; x += 4) {
+        if(!fetch_4px(src, src_w, src_h, src_stride, 4, &line, x, px, px_hor, px_ver, xs_fract, ys_fract)) {
+            /*Close to the edges of the image*/
+            transform_argb8888(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x, x + 4,
+                               dest_buf, true);
+            continue;
+        }
+
+#ifdef TRANSFORM_SSE2
+        __m128i c = _mm_loadu_si128((const __m128i *)px);
+        c = mix_argb8888_sse2(c, _mm_loadu_si128((const __m128i *)px_ver), _mm_loadu_si128((const __m128i *)ys_fract));
+        c = mix_argb8888_sse2(c, _mm_loadu_si128((const __m128i *)px_hor), _mm_loadu_si128((const __m128i *)xs_fract));
+        _mm_storeu_si128((__m128i *)(dest_u32 + x), c);
+#else
+        uint32x4_t c = vld1q_u32(px);
+        c = mix_argb8888_neon(c, vld1q_u32(px_ver), vld1q_u32(ys_fract));
+        c = mix_argb8888_neon(c, vld1q_u32(px_hor), vld1q_u32(xs_fract));
+        vst1q_u32(dest_u32 + x, c);
+#endif
+    }
+
+    transform_argb8888(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x, x_end, dest_buf, true);
+}
+
+static void transform_rgb565_simd(const uint8_t * src, int32_t src_w, int32_t src_h, int32_t src_stride,
+                                  int32_t xs_ups, int32_t ys_ups, int32_t xs_step, int32_t ys_step,
+                                  int32_t x_start, int32_t x_end, uint16_t * cbuf, uint8_t * abuf)
+{
+    transform_line_dsc_t line = {xs_ups, ys_ups, xs_step, ys_step};
+    uint32_t px[4], px_hor[4], px_ver[4], xs_fract[4], ys_fract[4];
+
+    int32_t x;
+    for(x = x_start; x + 4 <= x_end; x += 4) {
+        if(!fetch_4px(src, src_w, src_h, src_stride, 2, &line, x, px, px_hor, px_ver, xs_fract, ys_fract)) {
+            /*Close to the edges of the image*/
+            transform_rgb565a8(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x, x + 4,
+                               cbuf, abuf, false, true);
+            continue;
+        }
+
+        /*The ratios are doubled to 0..254 and `lv_color_16_16_mix` divides them by 8.
+         *Mixing the same colors gives the same color so the case of equal neighbors needs no special handling.*/
+#ifdef TRANSFORM_SSE2
+        const __m128i mask = _mm_set1_epi32(0x7E0F81F);
+        __m128i c = _mm_loadu_si128((const __m128i *)px);
+        __m128i hor = _mm_loadu_si128((const __m128i *)px_hor);
+        __m128i ver = _mm_loadu_si128((const __m128i *)px_ver);
+        c = _mm_and_si128(_mm_or_si128(c, _mm_slli_epi32(c, 16)), mask);
+        hor = _mm_and_si128(_mm_or_si128(hor, _mm_slli_epi32(hor, 16)), mask);
+        ver = _mm_and_si128(_mm_or_si128(ver, _mm_slli_epi32(ver, 16)), mask);
+
+        __m128i xs_mix = _mm_srli_epi32(_mm_add_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i *)xs_fract), 1),
+                                                      _mm_set1_epi32(4)), 3);
+        __m128i ys_mix = _mm_srli_epi32(_mm_add_epi32(_mm_slli_epi32(_mm_loadu_si128((const __m128i *)ys_fract), 1),
+                                                      _mm_set1_epi32(4)), 3);
+        xs_mix = _mm_or_si128(xs_mix, _mm_slli_epi32(xs_mix, 16));
+        ys_mix = _mm_or_si128(ys_mix, _mm_slli_epi32(ys_mix, 16));
+
+        __m128i v = mix_rgb565_sse2(ver, c, ys_mix);
+        __m128i h = mix_rgb565_sse2(hor, c, xs_mix);
+        c = mix_rgb565_sse2(h, v, _mm_set1_epi32(((LV_OPA_50 + 4) >> 3) * 0x10001));
+        c = _mm_or_si128(c, _mm_srli_epi32(c, 16));
+
+        /*Sign extend the lower 16 bits to pack them without saturation*/
+        c = _mm_srai_epi32(_mm_slli_epi32(c, 16), 16);
+        _mm_storel_epi64((__m128i *)(cbuf + x), _mm_packs_epi32(c, c));
+#else
+        const uint32x4_t mask = vdupq_n_u32(0x7E0F81F);
+        uint32x4_t c = vld1q_u32(px);
+        uint32x4_t hor = vld1q_u32(px_hor);
+        uint32x4_t ver = vld1q_u32(px_ver);
+        c = vandq_u32(vorrq_u32(c, vshlq_n_u32(c, 16)), mask);
+        hor = vandq_u32(vorrq_u32(hor, vshlq_n_u32(hor, 16)), mask);
+        ver = vandq_u32(vorrq_u32(ver, vshlq_n_u32(ver, 16)), mask);
+
+        uint32x4_t xs_mix = vshrq_n_u32(vaddq_u32(vshlq_n_u32(vld1q_u32(xs_fract), 1), vdupq_n_u32(4)), 3);
+        uint32x4_t ys_mix = vshrq_n_u32(vaddq_u32(vshlq_n_u32(vld1q_u32(ys_fract), 1), vdupq_n_u32(4)), 3);
+
+        uint32x4_t v = mix_rgb565_neon(ver, c, ys_mix);
+        uint32x4_t h = mix_rgb565_neon(hor, c, xs_mix);
+        c = mix_rgb565_neon(h, v, vdupq_n_u32((LV_OPA_50 + 4) >> 3));
+        c = vorrq_u32(c, vshrq_n_u32(c, 16));
+        vst1_u16(cbuf + x, vmovn_u32(c));
+#endif
+        lv_memset(abuf + x, 0xff, 4);
+    }
+
+    transform_rgb565a8(src, src_w, src_h, src_stride, xs_ups, ys_ups, xs_step, ys_step, x, x_end, cbuf, abuf, false,
+                       true);
+}
+
+#endif /*defined(TRANSFORM_SSE2) || defined(TRANSFORM_NEON)*/
+
+static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int32_t yin, int32_t * xout,
+                                     int32_t * yout)
+{
     xin -= t->pivot.x;
     yin -= t->pivot.y;
 
-    if(t->angle == 0) {
+    if(t->angle == 0 && t->scale_x == LV_SCALE_NONE && t->scale_y == LV_SCALE_NONE) {
+        *xout = xin * 256 + t->pivot_x_256;
+        *yout = yin * 256 + t->pivot_y_256;
+    }
+    else if(t->angle == 0) {
         *xout = ((int32_t)(xin * 256 * 256 / t->scale_x)) + (t->pivot_x_256);
         *yout = ((int32_t)(yin * 256 * 256 / t->scale_y)) + (t->pivot_y_256);
     }
@@ -806,6 +1396,14 @@ static void transform_point_upscaled(point_transform_dsc_t * t, int32_t xin, int
         *xout = (((t->cosma * xin - t->sinma * yin) * 256 / t->scale_x) >> 2) + (t->pivot_x_256);
         *yout = (((t->sinma * xin + t->cosma * yin) * 256 / t->scale_y) >> 2) + (t->pivot_y_256);
     }
+
+    /*The image is skewed before scaling and rotating, so the inverse of the skew comes last*/
+    if(t->tan_x || t->tan_y) {
+        int64_t x = *xout - t->pivot_x_256;
+        int64_t y = *yout - t->pivot_y_256;
+        *xout = (int32_t)((x * 65536 - t->tan_x * y) / t->det) + t->pivot_x_256;
+        *yout = (int32_t)((y * 65536 - t->tan_y * x) / t->det) + t->pivot_y_256;
+    }
 }
 
 #endif /*LV_USE_DRAW_SW*/
@@ -15,6 +15,7 @@
     #include "../../libs/thorvg/thorvg_capi.h"
 #endif
 #include "../../stdlib/lv_string.h"
+#include "blend/lv_draw_sw_blend.h"
 
 /*********************
  *      DEFINES
@@ -37,9 +38,32 @@ typedef struct {
     uint8_t a;
 } _tvg_color;
 
+typedef struct {
+    Tvg_Canvas * canvas;
+    float ofs_x;    /*Offset of the canvas target in the layer's buffer*/
+    float ofs_y;
+} _tvg_draw_ctx;
+
+/*Used when rendering to a temporary ARGB8888 buffer and blending it to a 16/24 bit layer*/
+typedef struct {
+    _tvg_draw_ctx tvg;
+    lv_draw_unit_t * draw_unit;
+    lv_layer_t * layer;
+    lv_draw_buf_t * tmp_buf;
+    lv_area_t render_area;          /*Absolute coordinates of `tmp_buf`*/
+    lv_blend_mode_t blend_mode;     /*The blend mode of the paths in `tvg.canvas`*/
+} _tvg_via_argb8888_ctx;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void _draw_to_canvas(const lv_draw_vector_task_dsc_t * dsc, void * buf, uint32_t stride, int32_t width,
+                            int32_t height, float ofs_x, float ofs_y);
+static void _draw_via_argb8888(lv_draw_unit_t * draw_unit, const lv_draw_vector_task_dsc_t * dsc);
+static void _via_argb8888_task_cb(void * ctx, const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc);
+static void _via_argb8888_flush(_tvg_via_argb8888_ctx * ctx);
+static lv_blend_mode_t _lv_vector_blend_to_sw(lv_vector_blend_t blend);
+static void _unpremultiply(lv_draw_buf_t * draw_buf);
 
 /**********************
  *  STATIC VARIABLES
@@ -381,9 +405,10 @@ static void _set_paint_blend_mode(Tvg_Paint * obj, lv_vector_blend_t blend)
     tvg_paint_set_blend_method(obj, _lv_blend_to_tvg(blend));
 }
 
-static void _task_draw_cb(void * ctx, const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc)
+static void _push_paint(_tvg_draw_ctx * draw_ctx, const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc,
+                        bool set_blend_mode)
 {
-    Tvg_Canvas * canvas = (Tvg_Canvas *)ctx;
+    Tvg_Canvas * canvas = draw_ctx->canvas;
 
     Tvg_Paint * obj = tvg_shape_new();
 
@@ -400,31 +425,40 @@ static void _task_draw_cb(void * ctx, const lv_vector_path_t * path, const lv_ve
             0.0f, 0.0f, 1.0f,
         };
         _set_paint_matrix(obj, &mtx);
-        tvg_shape_append_rect(obj, rc.x, rc.y, rc.w, rc.h, 0, 0);
+        tvg_shape_append_rect(obj, rc.x - draw_ctx->ofs_x, rc.y - draw_ctx->ofs_y, rc.w, rc.h, 0, 0);
         tvg_shape_set_fill_color(obj, c.r, c.g, c.b, c.a);
     }
     else {
+        /*Move the path into the coordinate system of the canvas target*/
+        lv_matrix_t matrix;
+        lv_matrix_identity(&matrix);
+        lv_matrix_translate(&matrix, -draw_ctx->ofs_x, -draw_ctx->ofs_y);
+        lv_matrix_multiply(&matrix, &dsc->matrix);
+
         Tvg_Matrix mtx;
-        _lv_matrix_to_tvg(&mtx, &dsc->matrix);
+        _lv_matrix_to_tvg(&mtx, &matrix);
         _set_paint_matrix(obj, &mtx);
 
         _set_paint_shape(obj, path);
 
-        _set_paint_fill(obj, canvas, &dsc->fill_dsc, &dsc->matrix);
+        _set_paint_fill(obj, canvas, &dsc->fill_dsc, &matrix);
         _set_paint_stroke(obj, &dsc->stroke_dsc);
-        _set_paint_blend_mode(obj, dsc->blend_mode);
+        if(set_blend_mode) _set_paint_blend_mode(obj, dsc->blend_mode);
     }
 
     tvg_canvas_push(canvas, obj);
 }
 
+static void _task_draw_cb(void * ctx, const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc)
+{
+    _push_paint((_tvg_draw_ctx *)ctx, path, dsc, true);
+}
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
 void lv_draw_sw_vector(lv_draw_unit_t * draw_unit, const lv_draw_vector_task_dsc_t * dsc)
 {
-    LV_UNUSED(draw_unit);
-
     if(dsc->task_list == NULL)
         return;
 
@@ -435,21 +469,49 @@ void lv_draw_sw_vector(lv_draw_unit_t * draw_unit, const lv_draw_vector_task_dsc
 
     lv_color_format_t cf = draw_buf->header.cf;
 
-    if(cf != LV_COLOR_FORMAT_ARGB8888 && \
-       cf != LV_COLOR_FORMAT_XRGB8888) {
-        LV_LOG_ERROR("unsupported layer color: %d", cf);
-        return;
+    switch(cf) {
+        case LV_COLOR_FORMAT_ARGB8888:
+        case LV_COLOR_FORMAT_XRGB8888: {
+                /*The rounded corners of the layer are clipped only by the blend functions*/
+                if(draw_unit->clip_corner_radius > 0) {
+                    _draw_via_argb8888(draw_unit, dsc);
+                    break;
+                }
+
+                /*ThorVG can render directly into the layer*/
+                int32_t width = lv_area_get_width(&layer->buf_area);
+                int32_t height = lv_area_get_height(&layer->buf_area);
+                _draw_to_canvas(dsc, draw_buf->data, draw_buf->header.stride, width, height, 0, 0);
+            }
+            break;
+        case LV_COLOR_FORMAT_RGB565:
+        case LV_COLOR_FORMAT_RGB888:
+            _draw_via_argb8888(draw_unit, dsc);
+            break;
+        default:
+            LV_LOG_ERROR("unsupported layer color: %d", cf);
+            _lv_vector_for_each_destroy_tasks(dsc->task_list, NULL, NULL);
+            break;
     }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
 
-    void * buf = draw_buf->data;
-    int32_t width = lv_area_get_width(&layer->buf_area);
-    int32_t height = lv_area_get_height(&layer->buf_area);
-    uint32_t stride = draw_buf->header.stride;
+static void _draw_to_canvas(const lv_draw_vector_task_dsc_t * dsc, void * buf, uint32_t stride, int32_t width,
+                            int32_t height, float ofs_x, float ofs_y)
+{
     Tvg_Canvas * canvas = tvg_swcanvas_create();
     tvg_swcanvas_set_target(canvas, buf, stride / 4, width, height, TVG_COLORSPACE_ARGB8888);
 
+    _tvg_draw_ctx ctx;
+    ctx.canvas = canvas;
+    ctx.ofs_x = ofs_x;
+    ctx.ofs_y = ofs_y;
+
     lv_ll_t * task_list = dsc->task_list;
-    _lv_vector_for_each_destroy_tasks(task_list, _task_draw_cb, canvas);
+    _lv_vector_for_each_destroy_tasks(task_list, _task_draw_cb, &ctx);
 
     if(tvg_canvas_draw(canvas) == TVG_RESULT_SUCCESS) {
         tvg_canvas_sync(canvas);
@@ -458,8 +520,183 @@ void lv_draw_sw_vector(lv_draw_unit_t * draw_unit, const lv_draw_vector_task_dsc
     tvg_canvas_destroy(canvas);
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
+/**
+ * ThorVG can render only to 32 bit buffers. For other layer formats render the task area
+ * into a temporary ARGB8888 buffer and blend it to the layer with the SW blend functions.
+ * This way no full size 32 bit layer is required for vector drawing on 16/24 bit displays.
+ * It's used for 32 bit layers too if the rounded corners need to be clipped while blending.
+ * Consecutive paths with the same blend mode are rendered together and blended to the layer at once.
+ */
+static void _draw_via_argb8888(lv_draw_unit_t * draw_unit, const lv_draw_vector_task_dsc_t * dsc)
+{
+    lv_layer_t * layer = dsc->base.layer;
+    const lv_draw_task_t * t = ((lv_draw_sw_unit_t *)draw_unit)->task_act;
+
+    _tvg_via_argb8888_ctx ctx;
+    lv_memzero(&ctx, sizeof(ctx));
+    if(!_lv_area_intersect(&ctx.render_area, &t->area, draw_unit->clip_area) ||
+       !_lv_area_intersect(&ctx.render_area, &ctx.render_area, &layer->buf_area)) {
+        _lv_vector_for_each_destroy_tasks(dsc->task_list, NULL, NULL);
+        return;
+    }
+
+    int32_t w = lv_area_get_width(&ctx.render_area);
+    int32_t h = lv_area_get_height(&ctx.render_area);
+    ctx.tmp_buf = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_ARGB8888, LV_STRIDE_AUTO);
+    if(ctx.tmp_buf == NULL) {
+        LV_LOG_WARN("Couldn't allocate %"LV_PRId32"x%"LV_PRId32" buffer for vector drawing", w, h);
+        _lv_vector_for_each_destroy_tasks(dsc->task_list, NULL, NULL);
+        return;
+    }
+
+    ctx.draw_unit = draw_unit;
+    ctx.layer = layer;
+    ctx.tvg.ofs_x = (float)(ctx.render_area.x1 - layer->buf_area.x1);
+    ctx.tvg.ofs_y = (float)(ctx.render_area.y1 - layer->buf_area.y1);
+
+    _lv_vector_for_each_destroy_tasks(dsc->task_list, _via_argb8888_task_cb, &ctx);
+    _via_argb8888_flush(&ctx);
+
+    lv_draw_buf_destroy(ctx.tmp_buf);
+}
+
+static void _via_argb8888_task_cb(void * ctx, const lv_vector_path_t * path, const lv_vector_draw_dsc_t * dsc)
+{
+    _tvg_via_argb8888_ctx * via_ctx = ctx;
+
+    /*Clear the area directly in the layer by writing the color as it is*/
+    if(!path) {
+        _via_argb8888_flush(via_ctx);
+
+        lv_area_t clear_area = dsc->scissor_area;
+        lv_area_move(&clear_area, via_ctx->layer->buf_area.x1, via_ctx->layer->buf_area.y1);
+        if(!_lv_area_intersect(&clear_area, &clear_area, &via_ctx->render_area)) return;
+
+        lv_draw_sw_blend_dsc_t blend_dsc;
+        lv_memzero(&blend_dsc, sizeof(blend_dsc));
+        blend_dsc.blend_area = &clear_area;
+        blend_dsc.color = lv_color_make(dsc->fill_dsc.color.red, dsc->fill_dsc.color.green, dsc->fill_dsc.color.blue);
+        blend_dsc.opa = LV_OPA_COVER;
+        blend_dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+        lv_draw_sw_blend(via_ctx->draw_unit, &blend_dsc);
+        return;
+    }
+
+    lv_blend_mode_t blend_mode = _lv_vector_blend_to_sw(dsc->blend_mode);
+    if(via_ctx->tvg.canvas && via_ctx->blend_mode != blend_mode) _via_argb8888_flush(via_ctx);
+
+    if(via_ctx->tvg.canvas == NULL) {
+        lv_draw_buf_t * tmp_buf = via_ctx->tmp_buf;
+        lv_draw_buf_clear(tmp_buf, NULL);
+        via_ctx->tvg.canvas = tvg_swcanvas_create();
+        tvg_swcanvas_set_target(via_ctx->tvg.canvas, (uint32_t *)tmp_buf->data, tmp_buf->header.stride / 4,
+                                tmp_buf->header.w, tmp_buf->header.h, TVG_COLORSPACE_ARGB8888);
+        via_ctx->blend_mode = blend_mode;
+    }
+
+    /*The blend mode is applied when the buffer is blended to the layer*/
+    _push_paint(&via_ctx->tvg, path, dsc, false);
+}
+
+/**
+ * Render the collected paths and blend them to the layer
+ */
+static void _via_argb8888_flush(_tvg_via_argb8888_ctx * ctx)
+{
+    if(ctx->tvg.canvas == NULL) return;
+
+    if(tvg_canvas_draw(ctx->tvg.canvas) == TVG_RESULT_SUCCESS) {
+        tvg_canvas_sync(ctx->tvg.canvas);
+    }
+    tvg_canvas_destroy(ctx->tvg.canvas);
+    ctx->tvg.canvas = NULL;
+
+    /*ThorVG renders with premultiplied alpha but the blend functions expect straight alpha*/
+    _unpremultiply(ctx->tmp_buf);
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memzero(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.blend_area = &ctx->render_area;
+    blend_dsc.src_area = &ctx->render_area;
+    blend_dsc.src_buf = ctx->tmp_buf->data;
+    blend_dsc.src_stride = ctx->tmp_buf->header.stride;
+    blend_dsc.src_color_format = LV_COLOR_FORMAT_ARGB8888;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_dsc.blend_mode = ctx->blend_mode;
+    lv_draw_sw_blend(ctx->draw_unit, &blend_dsc);
+}
+
+/**
+ * Get the SW blend mode of a vector blend mode. The ones without SW equivalent are blended normally.
+ */
+static lv_blend_mode_t _lv_vector_blend_to_sw(lv_vector_blend_t blend)
+{
+    switch(blend) {
+        case LV_VECTOR_BLEND_ADDITIVE:
+            return LV_BLEND_MODE_ADDITIVE;
+        case LV_VECTOR_BLEND_SUBTRACTIVE:
+            return LV_BLEND_MODE_SUBTRACTIVE;
+        case LV_VECTOR_BLEND_MULTIPLY:
+            return LV_BLEND_MODE_MULTIPLY;
+        default:
+            return LV_BLEND_MODE_NORMAL;
+    }
+}
+
+static void _unpremultiply(lv_draw_buf_t * draw_buf)
+{
+    /*`(c * recip[a]) >> 16` is the same as `c * 255 / a` for every `c` and `a` but needs no division*/
+    static const uint32_t recip[256] = {
+    0, 16711681, 8355841, 5570561, 4177921, 3342337, 2785281, 2387383,
+    2088961, 1856854, 1671169, 1519244, 1392641, 1285514, 1193692, 1114113,
+    1044481, 983041, 928427, 879563, 835585, 795795, 759622, 726595,
+    696321, 668468, 642757, 618952, 596846, 576265, 557057, 539087,
+    522241, 506415, 491521, 477477, 464214, 451668, 439782, 428505,
+    417793, 407602, 397898, 388644, 379811, 371371, 363298, 355568,
+    348161, 341055, 334234, 327681, 321379, 315315, 309476, 303849,
+    298423, 293188, 288133, 283249, 278529, 273962, 269544, 265265,
+    261121, 257103, 253208, 249429, 245761, 242199, 238739, 235376,
+    232107, 228928, 225834, 222823, 219891, 217035, 214253, 211541,
+    208897, 206318, 203801, 201346, 198949, 196609, 194322, 192089,
+    189906, 187772, 185686, 183645, 181649, 179696, 177784, 175913,
+    174081, 172286, 170528, 168805, 167117, 165463, 163841, 162250,
+    160690, 159159, 157658, 156184, 154738, 153319, 151925, 150556,
+    149212, 147891, 146594, 145319, 144067, 142835, 141625, 140435,
+    139265, 138114, 136981, 135868, 134772, 133694, 132633, 131589,
+    130561, 129548, 128552, 127571, 126604, 125652, 124715, 123791,
+    122881, 121984, 121100, 120228, 119370, 118523, 117688, 116865,
+    116054, 115253, 114464, 113685, 112917, 112159, 111412, 110674,
+    109946, 109227, 108518, 107818, 107127, 106444, 105771, 105105,
+    104449, 103800, 103159, 102526, 101901, 101283, 100673, 100070,
+    99475, 98886, 98305, 97730, 97161, 96600, 96045, 95496,
+    94953, 94417, 93886, 93362, 92843, 92330, 91823, 91321,
+    90825, 90334, 89848, 89368, 88892, 88422, 87957, 87496,
+    87041, 86590, 86143, 85701, 85264, 84831, 84403, 83979,
+    83559, 83143, 82732, 82324, 81921, 81521, 81125, 80733,
+    80345, 79961, 79580, 79203, 78829, 78459, 78092, 77729,
+    77369, 77013, 76660, 76310, 75963, 75619, 75278, 74941,
+    74606, 74275, 73946, 73620, 73297, 72977, 72660, 72345,
+    72034, 71724, 71418, 71114, 70813, 70514, 70218, 69924,
+    69633, 69344, 69057, 68773, 68491, 68211, 67934, 67659,
+    67386, 67116, 66847, 66581, 66317, 66055, 65795, 65537,
+    };
+
+    uint32_t w = draw_buf->header.w;
+    uint32_t h = draw_buf->header.h;
+    uint8_t * row = draw_buf->data;
+    for(uint32_t y = 0; y < h; y++) {
+        lv_color32_t * px = (lv_color32_t *)row;
+        for(uint32_t x = 0; x < w; x++) {
+            uint32_t a = px[x].alpha;
+            /*Fully transparent and fully opaque pixels are the same in both representations*/
+            if(a == 0 || a == 0xFF) continue;
+            uint32_t r = recip[a];
+            px[x].red = (uint8_t)LV_MIN((px[x].red * r) >> 16, 255);
+            px[x].green = (uint8_t)LV_MIN((px[x].green * r) >> 16, 255);
+            px[x].blue = (uint8_t)LV_MIN((px[x].blue * r) >> 16, 255);
+        }
+        row += draw_buf->header.stride;
+    }
+}
 
 #endif /*LV_USE_DRAW_SW*/
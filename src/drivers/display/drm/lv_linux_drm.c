@@ -32,6 +32,17 @@
     #error LV_COLOR_DEPTH not supported
 #endif
 
+#ifndef LV_LINUX_DRM_BUFFER_COUNT
+    #define LV_LINUX_DRM_BUFFER_COUNT 2
+#endif
+
+#if LV_LINUX_DRM_BUFFER_COUNT != 2 && LV_LINUX_DRM_BUFFER_COUNT != 3
+    #error LV_LINUX_DRM_BUFFER_COUNT must be 2 or 3
+#endif
+
+/*If more areas are flushed in a frame the whole plane is reported as damaged*/
+#define DRM_DAMAGE_CLIP_MAX 32
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -64,7 +75,16 @@ typedef struct {
     drmModePropertyPtr plane_props[128];
     drmModePropertyPtr crtc_props[128];
     drmModePropertyPtr conn_props[128];
-    drm_buffer_t drm_bufs[2]; /*DUMB buffers*/
+    drm_buffer_t drm_bufs[LV_LINUX_DRM_BUFFER_COUNT]; /*DUMB buffers*/
+    lv_draw_buf_t draw_bufs[2];     /*The DUMB buffers LVGL renders into*/
+    int32_t committed_idx;          /*Index of the last committed DUMB buffer or -1*/
+    bool has_damage_clips;          /*The plane supports FB_DAMAGE_CLIPS*/
+    uint32_t damage_cnt;            /*DRM_DAMAGE_CLIP_MAX + 1 means the whole plane*/
+    struct drm_mode_rect damage[DRM_DAMAGE_CLIP_MAX];
+#if LV_LINUX_DRM_BUFFER_COUNT == 3
+    uint32_t prev_damage_cnt;       /*The damaged areas of the previous frame*/
+    struct drm_mode_rect prev_damage[DRM_DAMAGE_CLIP_MAX];
+#endif
 } drm_dev_t;
 
 /**********************
@@ -89,7 +109,12 @@ static int drm_open(const char * path);
 static int drm_setup(drm_dev_t * drm_dev, const char * device_path, int64_t connector_id, unsigned int fourcc);
 static int drm_allocate_dumb(drm_dev_t * drm_dev, drm_buffer_t * buf);
 static int drm_setup_buffers(drm_dev_t * drm_dev);
-static void drm_flush_wait(lv_display_t * drm_dev);
+static void drm_wait_flip(drm_dev_t * drm_dev, int timeout_ms);
+static void drm_add_damage(drm_dev_t * drm_dev, const lv_area_t * area);
+#if LV_LINUX_DRM_BUFFER_COUNT == 3
+    static void drm_use_free_buffer(drm_dev_t * drm_dev, int32_t idx);
+#endif
+static void drm_flush_wait(lv_display_t * disp);
 static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map);
 
 /**********************
@@ -119,6 +144,7 @@ lv_display_t * lv_linux_drm_create(void)
         return NULL;
     }
     drm_dev->fd = -1;
+    drm_dev->committed_idx = -1;
     lv_display_set_driver_data(disp, drm_dev);
     lv_display_set_flush_wait_cb(disp, drm_flush_wait);
     lv_display_set_flush_cb(disp, drm_flush);
@@ -152,10 +178,17 @@ void lv_linux_drm_set_file(lv_display_t * disp, const char * file, int64_t conne
     int32_t ver_res = drm_dev->height;
     int32_t width = drm_dev->mmWidth;
 
-    size_t buf_size = LV_MIN(drm_dev->drm_bufs[1].size, drm_dev->drm_bufs[0].size);
-    lv_display_set_buffers(disp, drm_dev->drm_bufs[1].map, drm_dev->drm_bufs[0].map, buf_size,
-                           LV_DISPLAY_RENDER_MODE_DIRECT);
+    /*Render directly into the DUMB buffers. With 3 buffers the draw buffers are
+     *pointed to the free DUMB buffer after each commit.*/
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    for(uint32_t i = 0; i < 2; i++) {
+        lv_draw_buf_init(&drm_dev->draw_bufs[i], hor_res, ver_res, cf, drm_dev->drm_bufs[i].pitch,
+                         drm_dev->drm_bufs[i].map, drm_dev->drm_bufs[i].size);
+    }
+
     lv_display_set_resolution(disp, hor_res, ver_res);
+    lv_display_set_draw_buffers(disp, &drm_dev->draw_bufs[1], &drm_dev->draw_bufs[0]);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
 
     if(width) {
         lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 25400, width * 1000));
@@ -380,10 +413,24 @@ static int drm_dmabuf_set_plane(drm_dev_t * drm_dev, drm_buffer_t * buf)
     drm_add_plane_property(drm_dev, "CRTC_W", drm_dev->width);
     drm_add_plane_property(drm_dev, "CRTC_H", drm_dev->height);
 
+    /*Let the kernel update only the changed areas (e.g. on USB, SPI or virtual displays)*/
+    uint32_t damage_blob_id = 0;
+    if(drm_dev->has_damage_clips && drm_dev->damage_cnt > 0 && drm_dev->damage_cnt <= DRM_DAMAGE_CLIP_MAX) {
+        ret = drmModeCreatePropertyBlob(drm_dev->fd, drm_dev->damage,
+                                        drm_dev->damage_cnt * sizeof(struct drm_mode_rect), &damage_blob_id);
+        if(ret == 0) drm_add_plane_property(drm_dev, "FB_DAMAGE_CLIPS", damage_blob_id);
+        else damage_blob_id = 0;
+    }
+
     ret = drmModeAtomicCommit(drm_dev->fd, drm_dev->req, flags, drm_dev);
+
+    /*The commit keeps its own reference to the blob*/
+    if(damage_blob_id) drmModeDestroyPropertyBlob(drm_dev->fd, damage_blob_id);
+
     if(ret) {
         LV_LOG_ERROR("drmModeAtomicCommit failed: %s (%d)", strerror(errno), errno);
         drmModeAtomicFree(drm_dev->req);
+        drm_dev->req = NULL;
         return ret;
     }
 
@@ -685,6 +732,8 @@ static int drm_setup(drm_dev_t * drm_dev, const char * device_path, int64_t conn
         goto err;
     }
 
+    drm_dev->has_damage_clips = get_plane_property_id(drm_dev, "FB_DAMAGE_CLIPS") != 0;
+
     ret = drm_get_crtc_props(drm_dev);
     if(ret) {
         LV_LOG_ERROR("Cannot get crtc props");
@@ -778,21 +827,22 @@ static int drm_setup_buffers(drm_dev_t * drm_dev)
     int ret;
 
     /*Allocate DUMB buffers*/
-    ret = drm_allocate_dumb(drm_dev, &drm_dev->drm_bufs[0]);
-    if(ret)
-        return ret;
-
-    ret = drm_allocate_dumb(drm_dev, &drm_dev->drm_bufs[1]);
-    if(ret)
-        return ret;
+    for(uint32_t i = 0; i < LV_LINUX_DRM_BUFFER_COUNT; i++) {
+        ret = drm_allocate_dumb(drm_dev, &drm_dev->drm_bufs[i]);
+        if(ret)
+            return ret;
+    }
 
     return 0;
 }
 
-static void drm_flush_wait(lv_display_t * disp)
+/**
+ * Handle the events of the DRM device until the pending page flip completes
+ * @param drm_dev       pointer to the DRM device
+ * @param timeout_ms    return after this time even if the flip is still pending (-1: wait forever)
+ */
+static void drm_wait_flip(drm_dev_t * drm_dev, int timeout_ms)
 {
-    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
-
     struct pollfd pfd;
     pfd.fd = drm_dev->fd;
     pfd.events = POLLIN;
@@ -800,11 +850,13 @@ static void drm_flush_wait(lv_display_t * disp)
     while(drm_dev->req) {
         int ret;
         do {
-            ret = poll(&pfd, 1, -1);
+            ret = poll(&pfd, 1, timeout_ms);
         } while(ret == -1 && errno == EINTR);
 
         if(ret > 0)
             drmHandleEvent(drm_dev->fd, &drm_dev->drm_event_ctx);
+        else if(ret == 0)
+            return;     /*Timeout*/
         else {
             LV_LOG_ERROR("poll failed: %s", strerror(errno));
             return;
@@ -812,25 +864,117 @@ static void drm_flush_wait(lv_display_t * disp)
     }
 }
 
-static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+/**
+ * Save a flushed area to report it in FB_DAMAGE_CLIPS
+ * @param drm_dev   pointer to the DRM device
+ * @param area      the flushed area
+ */
+static void drm_add_damage(drm_dev_t * drm_dev, const lv_area_t * area)
 {
-    if(!lv_display_flush_is_last(disp)) return;
+    if(drm_dev->damage_cnt >= DRM_DAMAGE_CLIP_MAX) {
+        /*Too many areas, mark the whole plane as damaged*/
+        drm_dev->damage_cnt = DRM_DAMAGE_CLIP_MAX + 1;
+        return;
+    }
+
+    /*The rectangles of DRM are exclusive on the bottom right side*/
+    struct drm_mode_rect * rect = &drm_dev->damage[drm_dev->damage_cnt];
+    rect->x1 = area->x1;
+    rect->y1 = area->y1;
+    rect->x2 = area->x2 + 1;
+    rect->y2 = area->y2 + 1;
+    drm_dev->damage_cnt++;
+}
 
-    LV_UNUSED(area);
-    LV_UNUSED(px_map);
+#if LV_LINUX_DRM_BUFFER_COUNT == 3
+/**
+ * Point the draw buffer of the next frame to the DUMB buffer which is neither on
+ * the screen nor waiting for the page flip.
+ * @param drm_dev   pointer to the DRM device
+ * @param idx       index of the DUMB buffer committed just now
+ */
+static void drm_use_free_buffer(drm_dev_t * drm_dev, int32_t idx)
+{
+    int32_t on_screen_idx = drm_dev->committed_idx;
+    drm_dev->committed_idx = idx;
+
+    /*Nothing was on the screen yet so the other draw buffer is free*/
+    if(on_screen_idx < 0 || on_screen_idx == idx) {
+        lv_memcpy(drm_dev->prev_damage, drm_dev->damage, sizeof(drm_dev->damage));
+        drm_dev->prev_damage_cnt = drm_dev->damage_cnt;
+        return;
+    }
+
+    int32_t free_idx = 3 - idx - on_screen_idx;
+    uint8_t * committed_map = drm_dev->drm_bufs[idx].map;
+    lv_draw_buf_t * committed = drm_dev->draw_bufs[0].data == committed_map ? &drm_dev->draw_bufs[0] :
+                                &drm_dev->draw_bufs[1];
+    lv_draw_buf_t * next = committed == &drm_dev->draw_bufs[0] ? &drm_dev->draw_bufs[1] : &drm_dev->draw_bufs[0];
+
+    next->data = drm_dev->drm_bufs[free_idx].map;
+    next->unaligned_data = next->data;
+
+    /*The free buffer has missed the last 2 frames. LVGL copies the areas of the last frame
+     *from the committed buffer, the areas of the frame before that are copied here.*/
+    if(drm_dev->prev_damage_cnt > DRM_DAMAGE_CLIP_MAX) {
+        lv_draw_buf_copy(next, NULL, committed, NULL);
+    }
+    else {
+        for(uint32_t i = 0; i < drm_dev->prev_damage_cnt; i++) {
+            const struct drm_mode_rect * rect = &drm_dev->prev_damage[i];
+            lv_area_t a = {rect->x1, rect->y1, rect->x2 - 1, rect->y2 - 1};
+            lv_draw_buf_copy(next, &a, committed, &a);
+        }
+    }
+
+    lv_memcpy(drm_dev->prev_damage, drm_dev->damage, sizeof(drm_dev->damage));
+    drm_dev->prev_damage_cnt = drm_dev->damage_cnt;
+}
+#endif
+
+static void drm_flush_wait(lv_display_t * disp)
+{
+    drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
+
+#if LV_LINUX_DRM_BUFFER_COUNT == 3
+    /*There is always a free buffer to render into, so only handle the completed flips.
+     *If a flip is still pending `drm_flush` waits for it before the next commit.*/
+    drm_wait_flip(drm_dev, 0);
+#else
+    drm_wait_flip(drm_dev, -1);
+#endif
+}
+
+static void drm_flush(lv_display_t * disp, const lv_area_t * area, uint8_t * px_map)
+{
     drm_dev_t * drm_dev = lv_display_get_driver_data(disp);
 
-    for(int idx = 0; idx < 2; idx++) {
+    /*Collect all the flushed areas of the frame*/
+    drm_add_damage(drm_dev, area);
+
+    if(!lv_display_flush_is_last(disp)) return;
+
+    for(int32_t idx = 0; idx < LV_LINUX_DRM_BUFFER_COUNT; idx++) {
         if(drm_dev->drm_bufs[idx].map == px_map) {
+            /*Only one atomic commit can be pending at a time*/
+            drm_wait_flip(drm_dev, -1);
+
             /*Request buffer swap*/
-            if(drm_dmabuf_set_plane(drm_dev, &drm_dev->drm_bufs[idx])) {
+            if(drm_dmabuf_set_plane(drm_dev, &drm_dev->drm_bufs[idx]))
                 LV_LOG_ERROR("Flush fail");
-                return;
-            }
             else
                 LV_LOG_TRACE("Flush done");
+
+#if LV_LINUX_DRM_BUFFER_COUNT == 3
+            drm_use_free_buffer(drm_dev, idx);
+#else
+            drm_dev->committed_idx = idx;
+#endif
+            break;
         }
     }
+
+    drm_dev->damage_cnt = 0;
 }
 
 #endif /*LV_USE_LINUX_DRM*/
@@ -33,6 +33,9 @@
  *      DEFINES
  *********************/
 
+/*Flipping the pages is not supported with the BSD framebuffer interface*/
+#define FBDEV_PAN_FLIP (LV_LINUX_FBDEV_PAN_FLIP && !LV_LINUX_FBDEV_BSD)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -60,11 +63,15 @@ typedef struct {
     struct fb_fix_screeninfo finfo;
 #endif /* LV_LINUX_FBDEV_BSD */
     char * fbp;
-    uint8_t * rotated_buf;
-    size_t rotated_buf_size;
     long int screensize;
     int fbfd;
     bool force_refresh;
+#if FBDEV_PAN_FLIP
+    bool pan_flip;              /*Render directly into 2 pages of the framebuffer*/
+    bool pan_pending;           /*A page was panned but the vsync hasn't happened yet*/
+    bool vsync_supported;
+    lv_draw_buf_t pages[2];
+#endif
 } lv_linux_fb_t;
 
 /**********************
@@ -73,6 +80,12 @@ typedef struct {
 
 static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p);
 static uint32_t tick_get_cb(void);
+#if FBDEV_PAN_FLIP
+    static bool pan_flip_setup(lv_linux_fb_t * dsc);
+    static void pan_flip_init_buffers(lv_display_t * disp, lv_linux_fb_t * dsc);
+    static void pan_flip_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p);
+    static void pan_flip_wait_cb(lv_display_t * disp);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -182,6 +195,10 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     }
 #endif /* LV_LINUX_FBDEV_BSD */
 
+#if FBDEV_PAN_FLIP
+    dsc->pan_flip = pan_flip_setup(dsc);
+#endif
+
     LV_LOG_INFO("%dx%d, %dbpp", dsc->vinfo.xres, dsc->vinfo.yres, dsc->vinfo.bits_per_pixel);
 
     /* Figure out the size of the screen in bytes*/
@@ -217,6 +234,23 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
     int32_t hor_res = dsc->vinfo.xres;
     int32_t ver_res = dsc->vinfo.yres;
     int32_t width = dsc->vinfo.width;
+
+    lv_display_set_resolution(disp, hor_res, ver_res);
+
+    if(width > 0) {
+        lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
+    }
+
+    LV_LOG_INFO("Resolution is set to %" LV_PRId32 "x%" LV_PRId32 " at %" LV_PRId32 "dpi",
+                hor_res, ver_res, lv_display_get_dpi(disp));
+
+#if FBDEV_PAN_FLIP
+    if(dsc->pan_flip) {
+        pan_flip_init_buffers(disp, dsc);
+        return;
+    }
+#endif
+
     uint32_t draw_buf_size = hor_res * (dsc->vinfo.bits_per_pixel >> 3);
     if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
         draw_buf_size *= LV_LINUX_FBDEV_BUFFER_SIZE;
@@ -233,15 +267,7 @@ void lv_linux_fbdev_set_file(lv_display_t * disp, const char * file)
         draw_buf_2 = malloc(draw_buf_size);
     }
 
-    lv_display_set_resolution(disp, hor_res, ver_res);
     lv_display_set_buffers(disp, draw_buf, draw_buf_2, draw_buf_size, LV_LINUX_FBDEV_RENDER_MODE);
-
-    if(width > 0) {
-        lv_display_set_dpi(disp, DIV_ROUND_UP(hor_res * 254, width * 10));
-    }
-
-    LV_LOG_INFO("Resolution is set to %" LV_PRId32 "x%" LV_PRId32 " at %" LV_PRId32 "dpi",
-                hor_res, ver_res, lv_display_get_dpi(disp));
 }
 
 void lv_linux_fbdev_set_force_refresh(lv_display_t * disp, bool enabled)
@@ -271,39 +297,10 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
     lv_display_rotation_t rotation = lv_display_get_rotation(disp);
 
     /* Not all framebuffer kernel drivers support hardware rotation, so we need to handle it in software here */
-    if(rotation != LV_DISPLAY_ROTATION_0 && LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL) {
-        /* (Re)allocate temporary buffer if needed */
-        size_t buf_size = w * h * px_size;
-        if(!dsc->rotated_buf || dsc->rotated_buf_size != buf_size) {
-            dsc->rotated_buf = realloc(dsc->rotated_buf, buf_size);
-            dsc->rotated_buf_size = buf_size;
-        }
-
-        /* Rotate the pixel buffer */
-        uint32_t w_stride = lv_draw_buf_width_to_stride(w, cf);
-        uint32_t h_stride = lv_draw_buf_width_to_stride(h, cf);
-
-        switch(rotation) {
-            case LV_DISPLAY_ROTATION_0:
-                break;
-            case LV_DISPLAY_ROTATION_90:
-                lv_draw_sw_rotate(color_p, dsc->rotated_buf, w, h, w_stride, h_stride, rotation, cf);
-                break;
-            case LV_DISPLAY_ROTATION_180:
-                lv_draw_sw_rotate(color_p, dsc->rotated_buf, w, h, w_stride, w_stride, rotation, cf);
-                break;
-            case LV_DISPLAY_ROTATION_270:
-                lv_draw_sw_rotate(color_p, dsc->rotated_buf, w, h, w_stride, h_stride, rotation, cf);
-                break;
-        }
-        color_p = dsc->rotated_buf;
-
-        /* Rotate the area */
+    bool sw_rotate = rotation != LV_DISPLAY_ROTATION_0 && LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_PARTIAL;
+    if(sw_rotate) {
+        /* Rotate the area. The pixels are rotated directly into the framebuffer below. */
         lv_display_rotate_area(disp, (lv_area_t *)area);
-        if(rotation != LV_DISPLAY_ROTATION_180) {
-            w = lv_area_get_width(area);
-            h = lv_area_get_height(area);
-        }
     }
 
     /* Ensure that we're within the framebuffer's bounds */
@@ -317,25 +314,21 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
         (area->y1 + dsc->vinfo.yoffset) * dsc->finfo.line_length;
 
     uint8_t * fbp = (uint8_t *)dsc->fbp;
-    int32_t y;
-    if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_DIRECT) {
+    if(sw_rotate) {
+        uint32_t w_stride = lv_draw_buf_width_to_stride(w, cf);
+        lv_draw_sw_rotate(color_p, &fbp[fb_pos], w, h, w_stride, dsc->finfo.line_length, rotation, cf);
+    }
+    else if(LV_LINUX_FBDEV_RENDER_MODE == LV_DISPLAY_RENDER_MODE_DIRECT) {
         uint32_t color_pos =
             area->x1 * px_size +
             area->y1 * disp->hor_res * px_size;
 
-        for(y = area->y1; y <= area->y2; y++) {
-            lv_memcpy(&fbp[fb_pos], &color_p[color_pos], w * px_size);
-            fb_pos += dsc->finfo.line_length;
-            color_pos += disp->hor_res * px_size;
-        }
+        lv_memcpy_2d(&fbp[fb_pos], dsc->finfo.line_length, &color_p[color_pos], disp->hor_res * px_size,
+                     w * px_size, lv_area_get_height(area));
     }
     else {
         w = lv_area_get_width(area);
-        for(y = area->y1; y <= area->y2; y++) {
-            lv_memcpy(&fbp[fb_pos], color_p, w * px_size);
-            fb_pos += dsc->finfo.line_length;
-            color_p += w * px_size;
-        }
+        lv_memcpy_2d(&fbp[fb_pos], dsc->finfo.line_length, color_p, w * px_size, w * px_size, lv_area_get_height(area));
     }
 
     if(dsc->force_refresh) {
@@ -348,6 +341,106 @@ static void flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * colo
     lv_display_flush_ready(disp);
 }
 
+#if FBDEV_PAN_FLIP
+
+/**
+ * Check if the virtual screen can hold 2 pages and try to enlarge it if not.
+ * @param dsc   pointer to the framebuffer descriptor with the screen information already queried
+ * @return      true: the pages can be flipped with FBIOPAN_DISPLAY
+ */
+static bool pan_flip_setup(lv_linux_fb_t * dsc)
+{
+    if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2) {
+        struct fb_var_screeninfo vinfo = dsc->vinfo;
+        vinfo.yres_virtual = vinfo.yres * 2;
+        if(ioctl(dsc->fbfd, FBIOPUT_VSCREENINFO, &vinfo) == -1 ||
+           ioctl(dsc->fbfd, FBIOGET_VSCREENINFO, &dsc->vinfo) == -1 ||
+           ioctl(dsc->fbfd, FBIOGET_FSCREENINFO, &dsc->finfo) == -1) {
+            LV_LOG_WARN("The virtual screen can't be enlarged to 2 pages");
+        }
+    }
+
+    if(dsc->vinfo.yres_virtual < dsc->vinfo.yres * 2 ||
+       dsc->finfo.smem_len < dsc->finfo.line_length * dsc->vinfo.yres * 2 ||
+       dsc->finfo.ypanstep == 0 || dsc->vinfo.yres % dsc->finfo.ypanstep != 0) {
+        LV_LOG_WARN("Page flipping is not supported, copying the rendered areas to the framebuffer");
+        return false;
+    }
+
+    /*Show the first page, LVGL starts rendering into the second one*/
+    dsc->vinfo.xoffset = 0;
+    dsc->vinfo.yoffset = 0;
+    if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+        perror("ioctl(FBIOPAN_DISPLAY)");
+        return false;
+    }
+
+    dsc->vsync_supported = true;
+    return true;
+}
+
+/**
+ * Let LVGL render directly into the 2 pages of the mapped framebuffer
+ * @param disp  pointer to a display
+ * @param dsc   pointer to the framebuffer descriptor with the framebuffer mapped to memory
+ */
+static void pan_flip_init_buffers(lv_display_t * disp, lv_linux_fb_t * dsc)
+{
+    lv_color_format_t cf = lv_display_get_color_format(disp);
+    uint32_t page_size = dsc->finfo.line_length * dsc->vinfo.yres;
+    uint8_t * fbp = (uint8_t *)dsc->fbp;
+
+    lv_draw_buf_init(&dsc->pages[0], dsc->vinfo.xres, dsc->vinfo.yres, cf, dsc->finfo.line_length, fbp, page_size);
+    lv_draw_buf_init(&dsc->pages[1], dsc->vinfo.xres, dsc->vinfo.yres, cf, dsc->finfo.line_length, fbp + page_size,
+                     page_size);
+
+    /*The areas of the last frame are synchronized between the pages by LVGL*/
+    lv_display_set_draw_buffers(disp, &dsc->pages[1], &dsc->pages[0]);
+    lv_display_set_render_mode(disp, LV_DISPLAY_RENDER_MODE_DIRECT);
+    lv_display_set_flush_cb(disp, pan_flip_flush_cb);
+    lv_display_set_flush_wait_cb(disp, pan_flip_wait_cb);
+
+    LV_LOG_INFO("Rendering directly into 2 framebuffer pages");
+}
+
+static void pan_flip_flush_cb(lv_display_t * disp, const lv_area_t * area, uint8_t * color_p)
+{
+    LV_UNUSED(area);
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+
+    /*Show the page only when the whole frame is rendered*/
+    if(lv_display_flush_is_last(disp)) {
+        dsc->vinfo.yoffset = color_p == dsc->pages[1].data ? dsc->vinfo.yres : 0;
+        if(ioctl(dsc->fbfd, FBIOPAN_DISPLAY, &dsc->vinfo) == -1) {
+            perror("ioctl(FBIOPAN_DISPLAY)");
+        }
+        else {
+            dsc->pan_pending = true;
+        }
+    }
+
+    lv_display_flush_ready(disp);
+}
+
+static void pan_flip_wait_cb(lv_display_t * disp)
+{
+    lv_linux_fb_t * dsc = lv_display_get_driver_data(disp);
+    if(!dsc->pan_pending) return;
+
+    /*Wait until the new page is shown, so the old page can be drawn again without tearing*/
+    dsc->pan_pending = false;
+    if(dsc->vsync_supported) {
+        uint32_t crtc = 0;
+        if(ioctl(dsc->fbfd, FBIO_WAITFORVSYNC, &crtc) == -1) {
+            /*Many drivers pan synchronously without supporting FBIO_WAITFORVSYNC*/
+            LV_LOG_WARN("FBIO_WAITFORVSYNC is not supported");
+            dsc->vsync_supported = false;
+        }
+    }
+}
+
+#endif /*FBDEV_PAN_FLIP*/
+
 static uint32_t tick_get_cb(void)
 {
     struct timeval tv_now;
@@ -13,6 +13,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <string.h>
+#include <time.h>
 #include <sys/param.h> /*To detect BSD*/
 #ifdef BSD
     #include <dev/evdev/input.h>
@@ -24,14 +25,52 @@
 #include "../../stdlib/lv_mem.h"
 #include "../../stdlib/lv_string.h"
 #include "../../display/lv_display.h"
+#include "../../tick/lv_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define EVDEV_EVENT_BUF_SIZE    64  /*Number of events read from the device at once*/
+#define EVDEV_MAX_SLOTS         10  /*Number of tracked multi-touch contacts*/
+
+#ifndef input_event_sec
+    #define input_event_sec time.tv_sec
+    #define input_event_usec time.tv_usec
+#endif
+
+#define EVDEV_BITS_PER_LONG     (sizeof(unsigned long) * 8)
+#define EVDEV_LONGS(bit_cnt)    (((bit_cnt) + EVDEV_BITS_PER_LONG - 1) / EVDEV_BITS_PER_LONG)
+#define EVDEV_TEST_BIT(bits, bit) (((bits)[(bit) / EVDEV_BITS_PER_LONG] >> ((bit) % EVDEV_BITS_PER_LONG)) & 1)
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    int x;
+    int y;
+    int tracking_id;    /*-1: no contact in the slot*/
+} lv_evdev_slot_t;
+
+typedef struct {
+    int root_x;
+    int root_y;
+    int key;
+    lv_indev_state_t state;
+    /*Multi-touch*/
+    int slot;           /*The slot the ABS_MT_* events refer to*/
+    int primary_slot;   /*The slot of the contact moving the pointer or -1*/
+    bool wait_lift;     /*The primary contact was lifted, wait until all the others are lifted too*/
+    lv_evdev_slot_t slots[EVDEV_MAX_SLOTS];
+} lv_evdev_state_t;
+
 typedef struct {
     /*Device*/
     int fd;
+    clockid_t clock_id; /*The clock of the event timestamps*/
+    bool abs_xy;        /*Has absolute X and Y axes*/
+    bool mt_slots;      /*Multi-touch device using slots (protocol B)*/
     /*Config*/
     bool swap_axes;
     int min_x;
@@ -39,10 +78,17 @@ typedef struct {
     int max_x;
     int max_y;
     /*State*/
-    int root_x;
-    int root_y;
-    int key;
-    lv_indev_state_t state;
+    lv_evdev_state_t st;        /*All the processed events applied*/
+    lv_evdev_state_t frame_st;  /*State at the end of the last complete frame*/
+    uint32_t timestamp;         /*Time of the last complete frame*/
+    bool timestamp_valid;       /*`timestamp` could be converted to the tick time base*/
+    bool dropped;               /*Events were lost, skip until the next SYN_REPORT*/
+    bool continue_reading;
+    /*Event buffer*/
+    struct input_event events[EVDEV_EVENT_BUF_SIZE];
+    uint32_t event_cnt;
+    uint32_t event_pos;
+    bool event_buf_filled;      /*The last read filled the buffer, so more events might be pending*/
 } lv_evdev_t;
 
 /**********************
@@ -108,55 +154,258 @@ static lv_point_t _evdev_process_pointer(lv_indev_t * indev, int x, int y)
     return p;
 }
 
+/**
+ * Convert the time of an event to the time base of `lv_tick_get()`
+ * @return true on success, false if the clock of the events couldn't be read
+ */
+static bool _evdev_get_timestamp(lv_evdev_t * dsc, const struct input_event * in, uint32_t * timestamp)
+{
+    struct timespec now;
+    if(clock_gettime(dsc->clock_id, &now) != 0) return false;
+
+    int64_t age_ms = ((int64_t)now.tv_sec - in->input_event_sec) * 1000 +
+                     (now.tv_nsec / 1000000 - in->input_event_usec / 1000);
+    *timestamp = lv_tick_get();
+    if(age_ms > 0) *timestamp -= (uint32_t)age_ms;
+
+    return true;
+}
+
+/**
+ * Get the next event from the buffer. If all buffered events are processed read the next ones from the device.
+ * @param dsc           pointer to the driver data
+ * @param frame_start   index of the first event of the current frame. These events are kept in the buffer
+ *                      so the frame can be processed again. Updated to the new index or UINT32_MAX if the
+ *                      frame doesn't fit into the buffer.
+ * @return              pointer to the next event or NULL if there are no more events
+ */
+static const struct input_event * _evdev_next_event(lv_evdev_t * dsc, uint32_t * frame_start)
+{
+    if(dsc->event_pos >= dsc->event_cnt) {
+        uint32_t keep = 0;
+        if(*frame_start != UINT32_MAX) {
+            keep = dsc->event_cnt - *frame_start;
+            if(keep == EVDEV_EVENT_BUF_SIZE) {
+                keep = 0;
+                *frame_start = UINT32_MAX;
+            }
+            else {
+                lv_memmove(dsc->events, &dsc->events[*frame_start], keep * sizeof(struct input_event));
+                *frame_start = 0;
+            }
+        }
+
+        size_t size = (EVDEV_EVENT_BUF_SIZE - keep) * sizeof(struct input_event);
+        ssize_t len = read(dsc->fd, &dsc->events[keep], size);
+        dsc->event_buf_filled = len == (ssize_t)size;
+        dsc->event_cnt = keep + (len > 0 ? (uint32_t)len / sizeof(struct input_event) : 0);
+        dsc->event_pos = keep;
+        if(dsc->event_pos >= dsc->event_cnt) return NULL;
+    }
+
+    return &dsc->events[dsc->event_pos++];
+}
+
+/**
+ * Apply an event to the state
+ * @return true if a key was pressed or released
+ */
+static bool _evdev_process_event(lv_evdev_t * dsc, const struct input_event * in)
+{
+    lv_evdev_state_t * st = &dsc->st;
+
+    if(in->type == EV_REL) {
+        if(in->code == REL_X) st->root_x += in->value;
+        else if(in->code == REL_Y) st->root_y += in->value;
+    }
+    else if(in->type == EV_ABS) {
+        if(dsc->mt_slots) {
+            /*Only the contacts are processed, ABS_X/Y just repeats one of them*/
+            if(in->code == ABS_MT_SLOT) {
+                st->slot = in->value;
+                return false;
+            }
+
+            if(st->slot < 0 || st->slot >= EVDEV_MAX_SLOTS) return false;
+            lv_evdev_slot_t * slot = &st->slots[st->slot];
+            if(in->code == ABS_MT_POSITION_X) slot->x = in->value;
+            else if(in->code == ABS_MT_POSITION_Y) slot->y = in->value;
+            else if(in->code == ABS_MT_TRACKING_ID) slot->tracking_id = in->value;
+        }
+        else {
+            if(in->code == ABS_X || in->code == ABS_MT_POSITION_X) st->root_x = in->value;
+            else if(in->code == ABS_Y || in->code == ABS_MT_POSITION_Y) st->root_y = in->value;
+            else if(in->code == ABS_MT_TRACKING_ID) {
+                st->state = in->value >= 0 ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+            }
+        }
+    }
+    else if(in->type == EV_KEY) {
+        if(in->code == BTN_MOUSE || in->code == BTN_TOUCH) {
+            if(dsc->mt_slots) return false;
+            if(in->value == 0) st->state = LV_INDEV_STATE_RELEASED;
+            else if(in->value == 1) st->state = LV_INDEV_STATE_PRESSED;
+        }
+        else {
+            st->key = _evdev_process_key(in->code);
+            if(st->key) {
+                st->state = in->value ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Select the contact to move the pointer at the end of a multi-touch frame.
+ * If the primary contact is lifted the pointer is released until all the other contacts are lifted too,
+ * to avoid jumping to another finger.
+ */
+static void _evdev_update_primary_contact(lv_evdev_t * dsc)
+{
+    lv_evdev_state_t * st = &dsc->st;
+
+    int first = -1;
+    int i;
+    for(i = EVDEV_MAX_SLOTS - 1; i >= 0; i--) {
+        if(st->slots[i].tracking_id >= 0) first = i;
+    }
+
+    if(st->primary_slot >= 0 && st->slots[st->primary_slot].tracking_id < 0) {
+        st->primary_slot = -1;
+        st->wait_lift = true;
+    }
+    if(first < 0) st->wait_lift = false;
+    if(st->primary_slot < 0 && !st->wait_lift) st->primary_slot = first;
+
+    if(st->primary_slot >= 0) {
+        st->root_x = st->slots[st->primary_slot].x;
+        st->root_y = st->slots[st->primary_slot].y;
+        st->state = LV_INDEV_STATE_PRESSED;
+    }
+    else {
+        st->state = LV_INDEV_STATE_RELEASED;
+    }
+}
+
+/**
+ * Query the current state of the device after events were dropped by the kernel
+ */
+static void _evdev_resync(lv_indev_t * indev)
+{
+    lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
+    lv_evdev_state_t * st = &dsc->st;
+    if(lv_indev_get_type(indev) != LV_INDEV_TYPE_POINTER) return;
+
+    struct input_absinfo absinfo;
+    if(dsc->mt_slots) {
+#ifdef EVIOCGMTSLOTS
+        struct {
+            uint32_t code;
+            int32_t values[EVDEV_MAX_SLOTS];
+        } mt;
+
+        static const uint32_t codes[] = {ABS_MT_TRACKING_ID, ABS_MT_POSITION_X, ABS_MT_POSITION_Y};
+        uint32_t c;
+        for(c = 0; c < sizeof(codes) / sizeof(codes[0]); c++) {
+            mt.code = codes[c];
+            if(ioctl(dsc->fd, EVIOCGMTSLOTS(sizeof(mt)), &mt) < 0) continue;
+            int i;
+            for(i = 0; i < EVDEV_MAX_SLOTS; i++) {
+                if(mt.code == ABS_MT_TRACKING_ID) st->slots[i].tracking_id = mt.values[i];
+                else if(mt.code == ABS_MT_POSITION_X) st->slots[i].x = mt.values[i];
+                else st->slots[i].y = mt.values[i];
+            }
+        }
+#endif /*EVIOCGMTSLOTS*/
+        if(ioctl(dsc->fd, EVIOCGABS(ABS_MT_SLOT), &absinfo) == 0) st->slot = absinfo.value;
+        return;
+    }
+
+    if(dsc->abs_xy) {
+        if(ioctl(dsc->fd, EVIOCGABS(ABS_X), &absinfo) == 0) st->root_x = absinfo.value;
+        if(ioctl(dsc->fd, EVIOCGABS(ABS_Y), &absinfo) == 0) st->root_y = absinfo.value;
+    }
+
+    unsigned long keys[EVDEV_LONGS(KEY_CNT)] = {0};
+    if(ioctl(dsc->fd, EVIOCGKEY(sizeof(keys)), keys) >= 0) {
+        bool pressed = EVDEV_TEST_BIT(keys, BTN_TOUCH) || EVDEV_TEST_BIT(keys, BTN_MOUSE);
+        st->state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    }
+}
+
 static void _evdev_read(lv_indev_t * indev, lv_indev_data_t * data)
 {
     lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
     LV_ASSERT_NULL(dsc);
 
-    /*Update dsc with buffered events*/
-    struct input_event in = { 0 };
-    while(read(dsc->fd, &in, sizeof(in)) > 0) {
-        if(in.type == EV_REL) {
-            if(in.code == REL_X) dsc->root_x += in.value;
-            else if(in.code == REL_Y) dsc->root_y += in.value;
-        }
-        else if(in.type == EV_ABS) {
-            if(in.code == ABS_X || in.code == ABS_MT_POSITION_X) dsc->root_x = in.value;
-            else if(in.code == ABS_Y || in.code == ABS_MT_POSITION_Y) dsc->root_y = in.value;
-            else if(in.code == ABS_MT_TRACKING_ID) {
-                if(in.value == -1) dsc->state = LV_INDEV_STATE_RELEASED;
-                else if(in.value == 0) dsc->state = LV_INDEV_STATE_PRESSED;
+    /*Merge the frames (events up to a SYN_REPORT) while the pressed state is the same, as the core needs only
+     *the position and time of the last one to calculate the velocity. The frame changing the state is
+     *reported in the next sample, to not lose the movement right before releasing.*/
+    lv_indev_state_t sample_state = dsc->frame_st.state;
+    uint32_t frame_start = dsc->event_pos;
+    bool has_frame = false;
+    struct input_event last_event;
+
+    const struct input_event * in;
+    while((in = _evdev_next_event(dsc, &frame_start)) != NULL) {
+        if(in->type == EV_SYN) {
+            if(in->code == SYN_DROPPED) {
+                dsc->dropped = true;
+                continue;
             }
-        }
-        else if(in.type == EV_KEY) {
-            if(in.code == BTN_MOUSE || in.code == BTN_TOUCH) {
-                if(in.value == 0) dsc->state = LV_INDEV_STATE_RELEASED;
-                else if(in.value == 1) dsc->state = LV_INDEV_STATE_PRESSED;
+            if(in->code != SYN_REPORT) continue;
+
+            if(dsc->dropped) {
+                _evdev_resync(indev);
+                dsc->dropped = false;
             }
-            else {
-                dsc->key = _evdev_process_key(in.code);
-                if(dsc->key) {
-                    dsc->state = in.value ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
-                    data->continue_reading = true; /*Keep following events in buffer for now*/
-                    break;
-                }
+            if(dsc->mt_slots) _evdev_update_primary_contact(dsc);
+
+            if(has_frame && dsc->st.state != sample_state && frame_start != UINT32_MAX) {
+                dsc->st = dsc->frame_st;
+                dsc->event_pos = frame_start;
+                break;
             }
+
+            has_frame = true;
+            last_event = *in;
+            dsc->frame_st = dsc->st;
+            frame_start = dsc->event_pos;
+            if(dsc->st.state != sample_state) break;
+        }
+        else if(!dsc->dropped && _evdev_process_event(dsc, in)) {
+            /*Report each key separately*/
+            has_frame = true;
+            last_event = *in;
+            dsc->frame_st = dsc->st;
+            break;
         }
     }
 
+    if(has_frame) dsc->timestamp_valid = _evdev_get_timestamp(dsc, &last_event, &dsc->timestamp);
+
     /*Process and store in data*/
+    const lv_evdev_state_t * st = &dsc->frame_st;
     switch(lv_indev_get_type(indev)) {
         case LV_INDEV_TYPE_KEYPAD:
-            data->state = dsc->state;
-            data->key = dsc->key;
+            data->state = st->state;
+            data->key = st->key;
             break;
         case LV_INDEV_TYPE_POINTER:
-            data->state = dsc->state;
-            data->point = _evdev_process_pointer(indev, dsc->root_x, dsc->root_y);
+            data->state = st->state;
+            data->point = _evdev_process_pointer(indev, st->root_x, st->root_y);
             break;
         default:
             break;
     }
+
+    data->timestamp = dsc->timestamp;
+    data->timestamp_valid = dsc->timestamp_valid;
+    data->continue_reading = dsc->event_pos < dsc->event_cnt || dsc->event_buf_filled;
+    dsc->continue_reading = data->continue_reading;
 }
 
 /**********************
@@ -180,26 +429,53 @@ lv_indev_t * lv_evdev_create(lv_indev_type_t indev_type, const char * dev_path)
         goto err_after_open;
     }
 
+    /* Get the event timestamps from the same clock as the tick usually uses. */
+
+    dsc->clock_id = CLOCK_REALTIME;
+#ifdef EVIOCSCLOCKID
+    int clock_id = CLOCK_MONOTONIC;
+    if(ioctl(dsc->fd, EVIOCSCLOCKID, &clock_id) == 0) dsc->clock_id = CLOCK_MONOTONIC;
+#endif
+
+    dsc->st.primary_slot = -1;
+    int i;
+    for(i = 0; i < EVDEV_MAX_SLOTS; i++) dsc->st.slots[i].tracking_id = -1;
+
     /* Detect the minimum and maximum values of the input device for calibration. */
 
     if(indev_type == LV_INDEV_TYPE_POINTER) {
+        unsigned long abs_bits[EVDEV_LONGS(ABS_CNT)] = {0};
+        if(ioctl(dsc->fd, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits) >= 0) {
+            dsc->abs_xy = EVDEV_TEST_BIT(abs_bits, ABS_X) && EVDEV_TEST_BIT(abs_bits, ABS_Y);
+            dsc->mt_slots = EVDEV_TEST_BIT(abs_bits, ABS_MT_SLOT) && EVDEV_TEST_BIT(abs_bits, ABS_MT_POSITION_X);
+        }
+
+        /*Multi-touch devices have separate axes for the contacts*/
+        int abs_x = dsc->mt_slots ? ABS_MT_POSITION_X : ABS_X;
+        int abs_y = dsc->mt_slots ? ABS_MT_POSITION_Y : ABS_Y;
+
         struct input_absinfo absinfo;
-        if(ioctl(dsc->fd, EVIOCGABS(ABS_X), &absinfo) == 0) {
+        if(ioctl(dsc->fd, EVIOCGABS(abs_x), &absinfo) == 0) {
             dsc->min_x = absinfo.minimum;
             dsc->max_x = absinfo.maximum;
         }
         else {
             LV_LOG_ERROR("ioctl EVIOCGABS(ABS_X) failed: %s", strerror(errno));
         }
-        if(ioctl(dsc->fd, EVIOCGABS(ABS_Y), &absinfo) == 0) {
+        if(ioctl(dsc->fd, EVIOCGABS(abs_y), &absinfo) == 0) {
             dsc->min_y = absinfo.minimum;
             dsc->max_y = absinfo.maximum;
         }
         else {
             LV_LOG_ERROR("ioctl EVIOCGABS(ABS_Y) failed: %s", strerror(errno));
         }
+        if(dsc->mt_slots && ioctl(dsc->fd, EVIOCGABS(ABS_MT_SLOT), &absinfo) == 0) {
+            dsc->st.slot = absinfo.value;
+        }
     }
 
+    dsc->frame_st = dsc->st;
+
     lv_indev_t * indev = lv_indev_create();
     if(indev == NULL) goto err_after_open;
     lv_indev_set_type(indev, indev_type);
@@ -231,6 +507,47 @@ void lv_evdev_set_calibration(lv_indev_t * indev, int min_x, int min_y, int max_
     dsc->max_y = max_y;
 }
 
+int lv_evdev_get_fd(lv_indev_t * indev)
+{
+    lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
+    LV_ASSERT_NULL(dsc);
+    return dsc->fd;
+}
+
+void lv_evdev_handle_events(lv_indev_t * indev)
+{
+    lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
+    LV_ASSERT_NULL(dsc);
+
+    /*`continue_reading` is ignored in event-driven mode so read the samples one by one*/
+    do {
+        dsc->continue_reading = false;
+        lv_indev_read(indev);
+    } while(dsc->continue_reading);
+}
+
+uint32_t lv_evdev_get_touch_points(lv_indev_t * indev, lv_point_t points[], uint32_t max_cnt)
+{
+    lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
+    LV_ASSERT_NULL(dsc);
+
+    const lv_evdev_state_t * st = &dsc->frame_st;
+    if(!dsc->mt_slots) {
+        if(max_cnt == 0 || st->state != LV_INDEV_STATE_PRESSED) return 0;
+        points[0] = _evdev_process_pointer(indev, st->root_x, st->root_y);
+        return 1;
+    }
+
+    uint32_t cnt = 0;
+    int i;
+    for(i = 0; i < EVDEV_MAX_SLOTS && cnt < max_cnt; i++) {
+        if(st->slots[i].tracking_id < 0) continue;
+        points[cnt] = _evdev_process_pointer(indev, st->slots[i].x, st->slots[i].y);
+        cnt++;
+    }
+    return cnt;
+}
+
 void lv_evdev_delete(lv_indev_t * indev)
 {
     lv_evdev_t * dsc = lv_indev_get_driver_data(indev);
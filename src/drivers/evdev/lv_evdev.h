@@ -49,6 +49,31 @@ void lv_evdev_set_swap_axes(lv_indev_t * indev, bool swap_axes);
  */
 void lv_evdev_set_calibration(lv_indev_t * indev, int min_x, int min_y, int max_x, int max_y);
 
+/**
+ * Get the file descriptor of the device, e.g. to wait for events with `poll()` in event-driven mode.
+ * @param indev evdev input device
+ * @return the file descriptor of the device
+ */
+int lv_evdev_get_fd(lv_indev_t * indev);
+
+/**
+ * Process all the pending events of the device. To be used in event-driven mode (`LV_INDEV_MODE_EVENT`)
+ * instead of `lv_indev_read()` when the file descriptor of the device becomes readable.
+ * @param indev evdev input device
+ */
+void lv_evdev_handle_events(lv_indev_t * indev);
+
+/**
+ * Get the coordinates of all the contacts touching a multi-touch device. The pointer follows
+ * the first contact, these are the coordinates of all of them in the order of their slots.
+ * The display rotation is not applied.
+ * @param indev evdev input device
+ * @param points store the coordinates here
+ * @param max_cnt maximum number of coordinates to store
+ * @return number of stored coordinates
+ */
+uint32_t lv_evdev_get_touch_points(lv_indev_t * indev, lv_point_t points[], uint32_t max_cnt);
+
 /**
  * Remove evdev input device.
  * @param indev evdev input device to close and free
@@ -72,6 +72,8 @@ static lv_obj_t * pointer_search_obj(lv_display_t * disp, lv_point_t * p);
 static void indev_proc_reset_query_handler(lv_indev_t * indev);
 static void indev_click_focus(lv_indev_t * indev);
 static void indev_gesture(lv_indev_t * indev);
+static void indev_update_velocity(lv_indev_t * indev);
+static uint32_t indev_get_sample_time(const lv_indev_t * indev);
 static bool indev_reset_check(lv_indev_t * indev);
 static void indev_read_core(lv_indev_t * indev, lv_indev_data_t * data);
 static void indev_reset_core(lv_indev_t * indev, lv_obj_t * obj);
@@ -224,6 +226,12 @@ void lv_indev_read(lv_indev_t * indev)
         indev_read_core(indev, &data);
         continue_reading = indev->mode != LV_INDEV_MODE_EVENT && data.continue_reading;
 
+        /*A sample can't be taken in the future. Probably it's a rounding error in the driver.*/
+        uint32_t now = lv_tick_get();
+        if(data.timestamp_valid && (int32_t)(now - data.timestamp) < 0) data.timestamp = now;
+        indev->sample_timestamp = data.timestamp;
+        indev->sample_timestamp_valid = data.timestamp_valid;
+
         /*The active object might be deleted even in the read function*/
         indev_proc_reset_query_handler(indev);
         indev_obj_act = NULL;
@@ -232,10 +240,10 @@ void lv_indev_read(lv_indev_t * indev)
 
         /*Save the last activity time*/
         if(indev->state == LV_INDEV_STATE_PRESSED) {
-            indev->disp->last_activity_time = lv_tick_get();
+            indev->disp->last_activity_time = now;
         }
         else if(indev->type == LV_INDEV_TYPE_ENCODER && data.enc_diff) {
-            indev->disp->last_activity_time = lv_tick_get();
+            indev->disp->last_activity_time = now;
         }
 
         if(indev->type == LV_INDEV_TYPE_POINTER) {
@@ -679,6 +687,16 @@ static void indev_pointer_proc(lv_indev_t * i, lv_indev_data_t * data)
 
     i->pointer.last_point.x = i->pointer.act_point.x;
     i->pointer.last_point.y = i->pointer.act_point.y;
+
+    /*Keep the time of the newest sample, so out of order samples can't move it backwards*/
+    if(!i->sample_timestamp_valid) {
+        i->pointer.last_sample_valid = false;
+    }
+    else if(!i->pointer.last_sample_valid ||
+            (int32_t)(i->sample_timestamp - i->pointer.last_sample_timestamp) > 0) {
+        i->pointer.last_sample_timestamp = i->sample_timestamp;
+        i->pointer.last_sample_valid = true;
+    }
 }
 
 /**
@@ -718,7 +736,7 @@ static void indev_keypad_proc(lv_indev_t * i, lv_indev_data_t * data)
     /*Key press happened*/
     if(data->state == LV_INDEV_STATE_PRESSED && prev_state == LV_INDEV_STATE_RELEASED) {
         LV_LOG_INFO("%" LV_PRIu32 " key is pressed", data->key);
-        i->pr_timestamp = lv_tick_get();
+        i->pr_timestamp = indev_get_sample_time(i);
 
         /*Move the focus on NEXT*/
         if(data->key == LV_KEY_NEXT) {
@@ -862,7 +880,7 @@ static void indev_encoder_proc(lv_indev_t * i, lv_indev_data_t * data)
     if(data->state == LV_INDEV_STATE_PRESSED && last_state == LV_INDEV_STATE_RELEASED) {
         LV_LOG_INFO("pressed");
 
-        i->pr_timestamp = lv_tick_get();
+        i->pr_timestamp = indev_get_sample_time(i);
 
         if(data->key == LV_KEY_ENTER) {
             bool editable_or_scrollable = lv_obj_is_editable(indev_obj_act) ||
@@ -1175,7 +1193,7 @@ static void indev_proc_press(lv_indev_t * indev)
         if(indev_obj_act != NULL) {
 
             /*Save the time when the obj pressed to count long press time.*/
-            indev->pr_timestamp                 = lv_tick_get();
+            indev->pr_timestamp                 = indev_get_sample_time(indev);
             indev->long_pr_sent                 = 0;
             indev->pointer.scroll_sum.x     = 0;
             indev->pointer.scroll_sum.y     = 0;
@@ -1187,6 +1205,10 @@ static void indev_proc_press(lv_indev_t * indev)
             indev->pointer.gesture_sum.y  = 0;
             indev->pointer.vect.x         = 0;
             indev->pointer.vect.y         = 0;
+            indev->pointer.velocity.x     = 0;
+            indev->pointer.velocity.y     = 0;
+            indev->pointer.carry_vect.x   = 0;
+            indev->pointer.carry_vect.y   = 0;
 
             const bool is_enabled = !lv_obj_has_state(indev_obj_act, LV_STATE_DISABLED);
             if(is_enabled) {
@@ -1205,14 +1227,10 @@ static void indev_proc_press(lv_indev_t * indev)
         }
     }
 
-    /*Calculate the vector and apply a low pass filter: new value = 0.5 * old_value + 0.5 * new_value*/
+    /*Calculate the vector and the velocity used for scroll throw and gestures*/
     indev->pointer.vect.x = indev->pointer.act_point.x - indev->pointer.last_point.x;
     indev->pointer.vect.y = indev->pointer.act_point.y - indev->pointer.last_point.y;
-
-    indev->pointer.scroll_throw_vect.x = (indev->pointer.scroll_throw_vect.x + indev->pointer.vect.x) / 2;
-    indev->pointer.scroll_throw_vect.y = (indev->pointer.scroll_throw_vect.y + indev->pointer.vect.y) / 2;
-
-    indev->pointer.scroll_throw_vect_ori = indev->pointer.scroll_throw_vect;
+    indev_update_velocity(indev);
 
     if(indev_obj_act) {
         const bool is_enabled = !lv_obj_has_state(indev_obj_act, LV_STATE_DISABLED);
@@ -1525,8 +1543,8 @@ void indev_gesture(lv_indev_t * indev)
 
     if(gesture_obj == NULL) return;
 
-    if((LV_ABS(indev->pointer.vect.x) < indev_act->gesture_min_velocity) &&
-       (LV_ABS(indev->pointer.vect.y) < indev_act->gesture_min_velocity)) {
+    if((LV_ABS(indev->pointer.velocity.x) < indev_act->gesture_min_velocity) &&
+       (LV_ABS(indev->pointer.velocity.y) < indev_act->gesture_min_velocity)) {
         indev->pointer.gesture_sum.x = 0;
         indev->pointer.gesture_sum.y = 0;
     }
@@ -1561,6 +1579,66 @@ void indev_gesture(lv_indev_t * indev)
     }
 }
 
+/**
+ * Update the velocity and the scroll throw vector of a pointer from its last movement.
+ * If the driver provides the time of the samples the movement is scaled to `LV_DEF_REFR_PERIOD`,
+ * so the result doesn't depend on how often and how regularly the device is read.
+ * @param indev pointer to an input device
+ */
+static void indev_update_velocity(lv_indev_t * indev)
+{
+    lv_point_t * vect = &indev->pointer.vect;
+    lv_point_t * throw_vect = &indev->pointer.scroll_throw_vect;
+
+    lv_point_t * carry = &indev->pointer.carry_vect;
+
+    if(!indev->sample_timestamp_valid || !indev->pointer.last_sample_valid) {
+        indev->pointer.velocity = *vect;
+        carry->x = 0;
+        carry->y = 0;
+    }
+    else {
+        int32_t dt = (int32_t)(indev->sample_timestamp - indev->pointer.last_sample_timestamp);
+        if(dt <= 0) {
+            /*No time has elapsed since the previous sample so the velocity can't be measured.
+             *Keep the previous velocity and account the movement in the next sample.*/
+            carry->x += vect->x;
+            carry->y += vect->y;
+            return;
+        }
+
+        indev->pointer.velocity.x = (vect->x + carry->x) * LV_DEF_REFR_PERIOD / dt;
+        indev->pointer.velocity.y = (vect->y + carry->y) * LV_DEF_REFR_PERIOD / dt;
+        carry->x = 0;
+        carry->y = 0;
+
+        /*If more refresh periods have elapsed since the previous sample fade out the old value
+         *as if the device were read in each period*/
+        int32_t periods = dt / LV_DEF_REFR_PERIOD - 1;
+        while(periods > 0 && (throw_vect->x != 0 || throw_vect->y != 0)) {
+            throw_vect->x /= 2;
+            throw_vect->y /= 2;
+            periods--;
+        }
+    }
+
+    /*Apply a low pass filter: new value = 0.5 * old_value + 0.5 * new_value*/
+    throw_vect->x = (throw_vect->x + indev->pointer.velocity.x) / 2;
+    throw_vect->y = (throw_vect->y + indev->pointer.velocity.y) / 2;
+
+    indev->pointer.scroll_throw_vect_ori = *throw_vect;
+}
+
+/**
+ * Get the time of the currently processed sample.
+ * @param indev pointer to an input device
+ * @return the timestamp provided by the driver or the current time if there is no timestamp
+ */
+static uint32_t indev_get_sample_time(const lv_indev_t * indev)
+{
+    return indev->sample_timestamp_valid ? indev->sample_timestamp : lv_tick_get();
+}
+
 /**
  * Checks if the reset_query flag has been set. If so, perform necessary global indev cleanup actions
  * @param proc pointer to an input device 'proc'
@@ -56,6 +56,9 @@ typedef struct {
 
     lv_indev_state_t state; /**< LV_INDEV_STATE_RELEASED or LV_INDEV_STATE_PRESSED*/
     bool continue_reading;  /**< If set to true, the read callback is invoked again, unless the device is in event-driven mode*/
+
+    uint32_t timestamp;     /**< When the sample was taken in `lv_tick_get()` time base. Used only if `timestamp_valid` is set*/
+    bool timestamp_valid;   /**< Set to true if `timestamp` is filled, else the time of reading is used*/
 } lv_indev_data_t;
 
 typedef void (*lv_indev_read_cb_t)(lv_indev_t * indev, lv_indev_data_t * data);
@@ -38,9 +38,11 @@ struct _lv_indev_t {
     uint8_t reset_query : 1;
     uint8_t enabled : 1;
     uint8_t wait_until_release : 1;
+    uint8_t sample_timestamp_valid : 1; /**< `sample_timestamp` was provided by the driver*/
 
     uint32_t pr_timestamp;         /**< Pressed time stamp*/
     uint32_t longpr_rep_timestamp; /**< Long press repeat time stamp*/
+    uint32_t sample_timestamp;     /**< Time of the currently processed sample if `sample_timestamp_valid` is set*/
 
     void * driver_data;
     void * user_data;
@@ -78,6 +80,10 @@ struct _lv_indev_t {
         lv_point_t last_point; /**< Last point of input device.*/
         lv_point_t last_raw_point; /**< Last point read from read_cb. */
         lv_point_t vect; /**< Difference between `act_point` and `last_point`.*/
+        lv_point_t velocity; /**< `vect` scaled to `LV_DEF_REFR_PERIOD` if the samples have timestamps*/
+        lv_point_t carry_vect; /**< Movement of the samples without elapsed time, added to the next sample*/
+        uint32_t last_sample_timestamp; /*Time of the previous sample if `last_sample_valid` is set*/
+        bool last_sample_valid;         /*The previous sample had a timestamp from the driver*/
         lv_point_t scroll_sum; /*Count the dragged pixels to check LV_INDEV_DEF_SCROLL_LIMIT*/
         lv_point_t scroll_throw_vect;
         lv_point_t scroll_throw_vect_ori;
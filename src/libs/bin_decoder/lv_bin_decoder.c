@@ -52,6 +52,9 @@ typedef struct {
     lv_draw_buf_t * decompressed;       /*Decompressed data could be used directly, thus must also be draw buf*/
     lv_draw_buf_t c_array;              /*An C-array image that need to be converted to a draw buf*/
     lv_draw_buf_t * decoded_partial;    /*A draw buf for decoded image via get_area_cb*/
+    lv_draw_buf_t mapped;               /*A draw buf pointing to the image data mapped from the file*/
+    const void * mapped_data;           /*The mapped region of the file, NULL if not mapped*/
+    uint32_t mapped_size;
 } decoder_data_t;
 
 /**********************
@@ -59,8 +62,11 @@ typedef struct {
  **********************/
 static decoder_data_t * get_decoder_data(lv_image_decoder_dsc_t * dsc);
 static void free_decoder_data(lv_image_decoder_dsc_t * dsc);
+static void free_decoder_data_core(decoder_data_t * decoder_data);
+static void bin_decoder_cache_free_cb(lv_image_cache_data_t * cached_data, void * user_data);
 static lv_result_t decode_indexed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 static lv_result_t load_indexed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_result_t map_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 #if LV_BIN_DECODER_RAM_LOAD
     static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
 #endif
@@ -103,6 +109,7 @@ void lv_bin_decoder_init(void)
     lv_image_decoder_set_open_cb(decoder, lv_bin_decoder_open);
     lv_image_decoder_set_get_area_cb(decoder, lv_bin_decoder_get_area);
     lv_image_decoder_set_close_cb(decoder, lv_bin_decoder_close);
+    lv_image_decoder_set_cache_free_cb(decoder, (lv_cache_free_cb_t)bin_decoder_cache_free_cb);
 
     decoder->name = DECODER_NAME;
 }
@@ -226,6 +233,10 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         else if(LV_COLOR_FORMAT_IS_ALPHA_ONLY(cf)) {
             res = decode_alpha_only(decoder, dsc);
         }
+        else if(map_rgb(decoder, dsc) == LV_RESULT_OK) {
+            /*The image is drawn straight from the mapped file. The mapping is cached below to reuse it.*/
+            res = LV_RESULT_OK;
+        }
 #if LV_BIN_DECODER_RAM_LOAD
         else if(cf == LV_COLOR_FORMAT_ARGB8888      \
                 || cf == LV_COLOR_FORMAT_XRGB8888   \
@@ -339,14 +350,20 @@ lv_result_t lv_bin_decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     search_key.src = dsc->src;
     search_key.slot.size = dsc->decoded->data_size;
 
-    lv_cache_entry_t * cache_entry = lv_image_decoder_add_to_cache(decoder, &search_key, dsc->decoded, dsc->user_data);
+    /*A mapped image needs the mapping and the open file, so the cache entry takes all the decoder data.
+     *Else only the decoded draw buffer is cached.*/
+    decoder_data_t * decoder_data = get_decoder_data(dsc);
+    bool mapped = dsc->decoded == &decoder_data->mapped;
+
+    lv_cache_entry_t * cache_entry = lv_image_decoder_add_to_cache(decoder, &search_key, dsc->decoded,
+                                                                   mapped ? decoder_data : NULL);
     if(cache_entry == NULL) {
         free_decoder_data(dsc);
         return LV_RESULT_INVALID;
     }
     dsc->cache_entry = cache_entry;
-    decoder_data_t * decoder_data = get_decoder_data(dsc);
-    decoder_data->decoded = NULL; /*Cache will take care of it*/
+    if(mapped) dsc->user_data = NULL; /*Cache will take care of it*/
+    else decoder_data->decoded = NULL; /*Cache will take care of it*/
 
     return LV_RESULT_OK;
 }
@@ -534,6 +551,17 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
     decoder_data_t * decoder_data = dsc->user_data;
     if(decoder_data == NULL) return;
 
+    free_decoder_data_core(decoder_data);
+    dsc->user_data = NULL;
+}
+
+static void free_decoder_data_core(decoder_data_t * decoder_data)
+{
+    if(decoder_data->mapped_data) {
+        lv_fs_unmap(decoder_data->f, decoder_data->mapped_data, decoder_data->mapped_size);
+        decoder_data->mapped_data = NULL;
+    }
+
     if(decoder_data->f) {
         lv_fs_close(decoder_data->f);
         lv_free(decoder_data->f);
@@ -543,7 +571,27 @@ static void free_decoder_data(lv_image_decoder_dsc_t * dsc)
     if(decoder_data->decompressed) lv_draw_buf_destroy(decoder_data->decompressed);
     lv_free(decoder_data->palette);
     lv_free(decoder_data);
-    dsc->user_data = NULL;
+}
+
+/**
+ * Free a cache entry added by this decoder
+ * @param cached_data   the entry being freed. Its `user_data` is the decoder data of a mapped image, else NULL.
+ * @param user_data     unused
+ */
+static void bin_decoder_cache_free_cb(lv_image_cache_data_t * cached_data, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*Unmap and close the file of a mapped image*/
+    if(cached_data->user_data) {
+        free_decoder_data_core(cached_data->user_data);
+        return;
+    }
+
+    lv_draw_buf_t * decoded = (lv_draw_buf_t *)cached_data->decoded;
+    if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) {
+        lv_draw_buf_destroy(decoded);
+    }
 }
 
 static lv_result_t decode_indexed(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
@@ -758,6 +806,52 @@ static lv_result_t load_indexed(lv_image_decoder_t * decoder, lv_image_decoder_d
 #endif
 }
 
+/**
+ * Use the pixels of an uncompressed RGB image in place if the file system can map the file to the memory
+ * @param decoder   pointer to the decoder
+ * @param dsc       pointer to the decoder descriptor
+ * @return          LV_RESULT_OK: the image is mapped; LV_RESULT_INVALID: it needs to be read
+ */
+static lv_result_t map_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    decoder_data_t * decoder_data = dsc->user_data;
+    lv_color_format_t cf = dsc->header.cf;
+
+    if(cf != LV_COLOR_FORMAT_ARGB8888 && cf != LV_COLOR_FORMAT_XRGB8888 && cf != LV_COLOR_FORMAT_RGB888 &&
+       cf != LV_COLOR_FORMAT_RGB565 && cf != LV_COLOR_FORMAT_RGB565A8 && cf != LV_COLOR_FORMAT_ARGB8565) {
+        return LV_RESULT_INVALID;
+    }
+
+    /*The mapped data is read-only so it can't be re-strided in place*/
+    if(dsc->args.stride_align && cf != LV_COLOR_FORMAT_RGB565A8 &&
+       dsc->header.stride != lv_draw_buf_width_to_stride(dsc->header.w, cf)) {
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t len = dsc->header.stride * dsc->header.h;
+    if(cf == LV_COLOR_FORMAT_RGB565A8) {
+        len += (dsc->header.stride / 2) * dsc->header.h; /*A8 mask*/
+    }
+
+    const void * data = lv_fs_map(decoder_data->f, sizeof(lv_image_header_t), len);
+    if(data == NULL) return LV_RESULT_INVALID;
+
+    /*The draw units might need aligned pixels*/
+    if(lv_draw_buf_align((void *)data, cf) != data) {
+        lv_fs_unmap(decoder_data->f, data, len);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->mapped_data = data;
+    decoder_data->mapped_size = len;
+
+    /*No LV_IMAGE_FLAGS_MODIFIABLE flag so a copy is made if the data needs to be changed*/
+    lv_draw_buf_init(&decoder_data->mapped, dsc->header.w, dsc->header.h, cf, dsc->header.stride, (void *)data, len);
+    dsc->decoded = &decoder_data->mapped;
+    return LV_RESULT_OK;
+}
+
 #if LV_BIN_DECODER_RAM_LOAD
 static lv_result_t decode_rgb(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc)
 {
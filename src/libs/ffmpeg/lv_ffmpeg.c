@@ -36,6 +36,8 @@
 
 #define FRAME_DEF_REFR_PERIOD   33  /*[ms]*/
 
+#define DECODE_THREAD_STACK_SIZE    (256 * 1024)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -86,6 +88,11 @@ static int ffmpeg_output_video_frame(struct ffmpeg_context_s * ffmpeg_ctx);
 static bool ffmpeg_pix_fmt_has_alpha(enum AVPixelFormat pix_fmt);
 static bool ffmpeg_pix_fmt_is_yuv(enum AVPixelFormat pix_fmt);
 
+static void lv_ffmpeg_player_rewind(lv_ffmpeg_player_t * player);
+#if LV_FFMPEG_DECODE_IN_THREAD
+    static lv_result_t decode_frame_cb(lv_frame_queue_t * queue, uint8_t * buf, uint32_t * delay);
+#endif
+
 static void lv_ffmpeg_player_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_ffmpeg_player_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 
@@ -151,6 +158,9 @@ lv_result_t lv_ffmpeg_player_set_src(lv_obj_t * obj, const char * path)
     lv_ffmpeg_player_t * player = (lv_ffmpeg_player_t *)obj;
 
     if(player->ffmpeg_ctx) {
+#if LV_FFMPEG_DECODE_IN_THREAD
+        lv_frame_queue_deinit(&player->queue);
+#endif
         ffmpeg_close(player->ffmpeg_ctx);
         player->ffmpeg_ctx = NULL;
     }
@@ -173,17 +183,28 @@ lv_result_t lv_ffmpeg_player_set_src(lv_obj_t * obj, const char * path)
     bool has_alpha = player->ffmpeg_ctx->has_alpha;
     int width = player->ffmpeg_ctx->video_dec_ctx->width;
     int height = player->ffmpeg_ctx->video_dec_ctx->height;
-    uint32_t data_size = 0;
-
-    data_size = width * height * 4;
 
     player->imgdsc.header.w = width;
     player->imgdsc.header.h = height;
-    player->imgdsc.data_size = data_size;
     player->imgdsc.header.cf = has_alpha ? LV_COLOR_FORMAT_ARGB8888 : LV_COLOR_FORMAT_NATIVE;
     player->imgdsc.header.stride = width * lv_color_format_get_size(player->imgdsc.header.cf);
+
+    /*The decoder writes the frames with this stride, see ffmpeg_output_video_frame()*/
+    uint32_t data_size = (uint32_t)player->imgdsc.header.stride * height;
+    player->imgdsc.data_size = data_size;
     player->imgdsc.data = ffmpeg_get_image_data(player->ffmpeg_ctx);
 
+#if LV_FFMPEG_DECODE_IN_THREAD
+    /*The thread decodes to the buffer of the context and copies the frames to the buffers of the queue.
+     *If it fails, just decode the frames in the timer.*/
+    lv_result_t queue_res = lv_frame_queue_init(&player->queue, LV_FFMPEG_DECODE_AHEAD_CNT, data_size,
+                                                decode_frame_cb, player);
+    if(queue_res == LV_RESULT_OK) queue_res = lv_frame_queue_start(&player->queue, DECODE_THREAD_STACK_SIZE);
+
+    if(queue_res == LV_RESULT_OK) player->imgdsc.data = lv_frame_queue_get_shown_buf(&player->queue);
+    else lv_frame_queue_deinit(&player->queue);
+#endif
+
     lv_image_set_src(&player->img.obj, &(player->imgdsc));
 
     int period = ffmpeg_get_frame_refr_period(player->ffmpeg_ctx);
@@ -217,14 +238,12 @@ void lv_ffmpeg_player_set_cmd(lv_obj_t * obj, lv_ffmpeg_player_cmd_t cmd)
 
     switch(cmd) {
         case LV_FFMPEG_PLAYER_CMD_START:
-            av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
-                          0, 0, AVSEEK_FLAG_BACKWARD);
+            lv_ffmpeg_player_rewind(player);
             lv_timer_resume(timer);
             LV_LOG_INFO("ffmpeg player start");
             break;
         case LV_FFMPEG_PLAYER_CMD_STOP:
-            av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
-                          0, 0, AVSEEK_FLAG_BACKWARD);
+            lv_ffmpeg_player_rewind(player);
             lv_timer_pause(timer);
             LV_LOG_INFO("ffmpeg player stop");
             break;
@@ -772,6 +791,7 @@ static void ffmpeg_close_src_ctx(struct ffmpeg_context_s * ffmpeg_ctx)
     avcodec_free_context(&(ffmpeg_ctx->video_dec_ctx));
     avformat_close_input(&(ffmpeg_ctx->fmt_ctx));
     av_frame_free(&(ffmpeg_ctx->frame));
+    av_packet_free(&(ffmpeg_ctx->pkt));
     if(ffmpeg_ctx->video_src_data[0] != NULL) {
         av_free(ffmpeg_ctx->video_src_data[0]);
         ffmpeg_ctx->video_src_data[0] = NULL;
@@ -810,6 +830,25 @@ static void lv_ffmpeg_player_frame_update_cb(lv_timer_t * timer)
         return;
     }
 
+#if LV_FFMPEG_DECODE_IN_THREAD
+    if(player->queue.bufs) {
+        uint8_t * buf;
+        if(lv_frame_queue_pop(&player->queue, false, &buf, NULL) != LV_RESULT_OK) {
+            /*If the frame is not ready yet, show it in the next period*/
+            if(lv_frame_queue_is_ended(&player->queue)) {
+                lv_ffmpeg_player_set_cmd(obj, player->auto_restart ? LV_FFMPEG_PLAYER_CMD_START :
+                                         LV_FFMPEG_PLAYER_CMD_STOP);
+            }
+            return;
+        }
+
+        player->imgdsc.data = buf;
+        lv_image_cache_drop(lv_image_get_src(obj));
+        lv_obj_invalidate(obj);
+        return;
+    }
+#endif
+
     int has_next = ffmpeg_update_next_frame(player->ffmpeg_ctx);
 
     if(has_next < 0) {
@@ -822,6 +861,38 @@ static void lv_ffmpeg_player_frame_update_cb(lv_timer_t * timer)
     lv_obj_invalidate(obj);
 }
 
+static void lv_ffmpeg_player_rewind(lv_ffmpeg_player_t * player)
+{
+#if LV_FFMPEG_DECODE_IN_THREAD
+    /*The thread reads the file so stop it while seeking*/
+    lv_frame_queue_stop(&player->queue);
+#endif
+
+    av_seek_frame(player->ffmpeg_ctx->fmt_ctx,
+                  0, 0, AVSEEK_FLAG_BACKWARD);
+
+#if LV_FFMPEG_DECODE_IN_THREAD
+    if(player->queue.bufs) lv_frame_queue_start(&player->queue, DECODE_THREAD_STACK_SIZE);
+#endif
+}
+
+#if LV_FFMPEG_DECODE_IN_THREAD
+/**
+ * Decode the next frame of the video. Runs on the decoder thread.
+ */
+static lv_result_t decode_frame_cb(lv_frame_queue_t * queue, uint8_t * buf, uint32_t * delay)
+{
+    lv_ffmpeg_player_t * player = queue->user_data;
+
+    if(ffmpeg_update_next_frame(player->ffmpeg_ctx) < 0) return LV_RESULT_INVALID;
+
+    lv_memcpy(buf, ffmpeg_get_image_data(player->ffmpeg_ctx), player->imgdsc.data_size);
+    *delay = 0; /*The period of the timer is the frame rate*/
+
+    return LV_RESULT_OK;
+}
+#endif
+
 static void lv_ffmpeg_player_constructor(const lv_obj_class_t * class_p,
                                          lv_obj_t * obj)
 {
@@ -856,6 +927,10 @@ static void lv_ffmpeg_player_destructor(const lv_obj_class_t * class_p,
 
     lv_image_cache_drop(lv_image_get_src(obj));
 
+#if LV_FFMPEG_DECODE_IN_THREAD
+    lv_frame_queue_deinit(&player->queue);
+#endif
+
     ffmpeg_close(player->ffmpeg_ctx);
     player->ffmpeg_ctx = NULL;
 
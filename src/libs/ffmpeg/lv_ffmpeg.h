@@ -14,12 +14,19 @@ extern "C" {
  *********************/
 #include "../../lv_conf_internal.h"
 #include "../../widgets/image/lv_image.h"
+#include "../../misc/lv_frame_queue.h"
 #if LV_USE_FFMPEG != 0
 
 /*********************
  *      DEFINES
  *********************/
 
+#if LV_FFMPEG_DECODE_AHEAD_CNT > 0 && LV_USE_OS
+    #define LV_FFMPEG_DECODE_IN_THREAD 1
+#else
+    #define LV_FFMPEG_DECODE_IN_THREAD 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +40,9 @@ typedef struct {
     lv_image_dsc_t imgdsc;
     bool auto_restart;
     struct ffmpeg_context_s * ffmpeg_ctx;
+#if LV_FFMPEG_DECODE_IN_THREAD
+    lv_frame_queue_t queue;     /*The frames decoded in advance. Not used if `queue.bufs == NULL`*/
+#endif
 } lv_ffmpeg_player_t;
 
 typedef enum {
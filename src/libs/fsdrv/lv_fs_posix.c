@@ -17,6 +17,14 @@
 #include <unistd.h>
 #include <errno.h>
 
+#if defined(_POSIX_MAPPED_FILES) && _POSIX_MAPPED_FILES > 0
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define FS_POSIX_MMAP 1
+#else
+    #define FS_POSIX_MMAP 0
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -44,6 +52,10 @@ static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_
 static lv_fs_res_t fs_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw);
 static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
 static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+#if FS_POSIX_MMAP
+    static const void * fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len);
+    static void fs_unmap(lv_fs_drv_t * drv, void * file_p, const void * ptr, uint32_t len);
+#endif
 static void * fs_dir_open(lv_fs_drv_t * drv, const char * path);
 static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * dir_p, char * fn, uint32_t fn_len);
 static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * dir_p);
@@ -82,6 +94,10 @@ void lv_fs_posix_init(void)
     fs_drv_p->write_cb = fs_write;
     fs_drv_p->seek_cb = fs_seek;
     fs_drv_p->tell_cb = fs_tell;
+#if FS_POSIX_MMAP
+    fs_drv_p->map_cb = fs_map;
+    fs_drv_p->unmap_cb = fs_unmap;
+#endif
 
     fs_drv_p->dir_close_cb = fs_dir_close;
     fs_drv_p->dir_open_cb = fs_dir_open;
@@ -252,6 +268,59 @@ static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
     return LV_FS_RES_OK;
 }
 
+#if FS_POSIX_MMAP
+/**
+ * Map a region of a file to the memory. The pages are loaded by the OS only when they are read.
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    a file handle. (opened with fs_open)
+ * @param pos       start of the region in bytes
+ * @param len       length of the region in bytes
+ * @return          pointer to the region or NULL on error
+ */
+static const void * fs_map(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len)
+{
+    LV_UNUSED(drv);
+
+    int fd = FILEP2FD(file_p);
+
+    /*Accessing a mapped page beyond the end of the file would raise SIGBUS*/
+    struct stat st;
+    if(fstat(fd, &st) < 0 || len == 0 || (uint64_t)pos + len > (uint64_t)st.st_size) return NULL;
+
+    /*The offset of the mapping needs to be page aligned*/
+    long page_size = sysconf(_SC_PAGESIZE);
+    if(page_size <= 0) return NULL;
+    uint32_t delta = pos % (uint32_t)page_size;
+
+    void * base = mmap(NULL, len + delta, PROT_READ, MAP_PRIVATE, fd, (off_t)(pos - delta));
+    if(base == MAP_FAILED) {
+        LV_LOG_INFO("Could not map file: %d, errno: %d", fd, errno);
+        return NULL;
+    }
+
+    return (const uint8_t *)base + delta;
+}
+
+/**
+ * Unmap a region mapped by `fs_map`
+ * @param drv       pointer to a driver where this function belongs
+ * @param file_p    a file handle. (opened with fs_open)
+ * @param ptr       the pointer returned by `fs_map`
+ * @param len       the length passed to `fs_map`
+ */
+static void fs_unmap(lv_fs_drv_t * drv, void * file_p, const void * ptr, uint32_t len)
+{
+    LV_UNUSED(drv);
+    LV_UNUSED(file_p);
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    uint32_t delta = (uint32_t)((lv_uintptr_t)ptr % (lv_uintptr_t)page_size);
+    if(munmap((uint8_t *)ptr - delta, len + delta) < 0) {
+        LV_LOG_WARN("Could not unmap file, errno: %d", errno);
+    }
+}
+#endif /*FS_POSIX_MMAP*/
+
 /**
  * Initialize a 'fs_read_dir_t' variable for directory reading
  * @param drv   pointer to a driver where this function belongs
@@ -16,6 +16,8 @@
  *********************/
 #define MY_CLASS (&lv_gif_class)
 
+#define DECODE_THREAD_STACK_SIZE    (16 * 1024)
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -26,6 +28,10 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+#if LV_GIF_DECODE_IN_THREAD
+    static bool show_decoded_frame(lv_obj_t * obj);
+    static lv_result_t decode_frame_cb(lv_frame_queue_t * queue, uint8_t * buf, uint32_t * delay);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -64,6 +70,9 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     if(gifobj->gif) {
         lv_image_cache_drop(lv_image_get_src(obj));
 
+#if LV_GIF_DECODE_IN_THREAD
+        lv_frame_queue_deinit(&gifobj->queue);
+#endif
         gd_close_gif(gifobj->gif);
         gifobj->gif = NULL;
         gifobj->imgdsc.data = NULL;
@@ -87,11 +96,35 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     gifobj->imgdsc.header.w = gifobj->gif->width;
     gifobj->last_call = lv_tick_get();
 
+#if LV_GIF_DECODE_IN_THREAD
+    /*The thread renders the frames to the canvas of the GIF and copies them to the buffers of the queue.
+     *If it fails, just decode the frames in the timer.*/
+    uint32_t frame_size = (uint32_t)gifobj->gif->width * gifobj->gif->height * 4;
+    lv_result_t res = lv_frame_queue_init(&gifobj->queue, LV_GIF_DECODE_AHEAD_CNT, frame_size, decode_frame_cb, gifobj);
+    if(res == LV_RESULT_OK) res = lv_frame_queue_start(&gifobj->queue, DECODE_THREAD_STACK_SIZE);
+
+    if(res == LV_RESULT_OK) gifobj->imgdsc.data = lv_frame_queue_get_shown_buf(&gifobj->queue);
+    else lv_frame_queue_deinit(&gifobj->queue);
+#endif
+
     lv_image_set_src(obj, &gifobj->imgdsc);
 
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 
+#if LV_GIF_DECODE_IN_THREAD
+    if(gifobj->queue.bufs) {
+        /*Show the first frame right away*/
+        uint8_t * buf;
+        if(lv_frame_queue_pop(&gifobj->queue, true, &buf, &gifobj->delay) == LV_RESULT_OK) {
+            gifobj->imgdsc.data = buf;
+            lv_image_cache_drop(lv_image_get_src(obj));
+            lv_obj_invalidate(obj);
+        }
+        return;
+    }
+#endif
+
     next_frame_task_cb(gifobj->timer);
 
 }
@@ -105,7 +138,17 @@ void lv_gif_restart(lv_obj_t * obj)
         return;
     }
 
+#if LV_GIF_DECODE_IN_THREAD
+    /*The thread reads the file so stop it while rewinding*/
+    lv_frame_queue_stop(&gifobj->queue);
+#endif
+
     gd_rewind(gifobj->gif);
+
+#if LV_GIF_DECODE_IN_THREAD
+    if(gifobj->queue.bufs) lv_frame_queue_start(&gifobj->queue, DECODE_THREAD_STACK_SIZE);
+#endif
+
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 }
@@ -150,6 +193,10 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 
     lv_image_cache_drop(lv_image_get_src(obj));
 
+#if LV_GIF_DECODE_IN_THREAD
+    lv_frame_queue_deinit(&gifobj->queue);
+#endif
+
     if(gifobj->gif)
         gd_close_gif(gifobj->gif);
     lv_timer_delete(gifobj->timer);
@@ -159,6 +206,18 @@ static void next_frame_task_cb(lv_timer_t * t)
 {
     lv_obj_t * obj = t->user_data;
     lv_gif_t * gifobj = (lv_gif_t *) obj;
+
+#if LV_GIF_DECODE_IN_THREAD
+    if(gifobj->queue.bufs) {
+        if(show_decoded_frame(obj) == false) {
+            /*It was the last repeat*/
+            lv_timer_pause(t);
+            lv_obj_send_event(obj, LV_EVENT_READY, NULL);
+        }
+        return;
+    }
+#endif
+
     uint32_t elaps = lv_tick_elaps(gifobj->last_call);
     if(elaps < gifobj->gif->gce.delay * 10) return;
 
@@ -178,4 +237,50 @@ static void next_frame_task_cb(lv_timer_t * t)
     lv_obj_invalidate(obj);
 }
 
+#if LV_GIF_DECODE_IN_THREAD
+/**
+ * Show the next frame decoded by the thread if the current one was shown long enough
+ * @param obj       pointer to a GIF object
+ * @return          false: all the frames were shown
+ */
+static bool show_decoded_frame(lv_obj_t * obj)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    if(lv_tick_elaps(gifobj->last_call) < gifobj->delay) return true;
+
+    uint8_t * buf;
+    uint32_t delay;
+    if(lv_frame_queue_pop(&gifobj->queue, false, &buf, &delay) != LV_RESULT_OK) {
+        /*If the frame is not ready yet, try again in the next period*/
+        return !lv_frame_queue_is_ended(&gifobj->queue);
+    }
+
+    gifobj->last_call = lv_tick_get();
+    gifobj->delay = delay;
+    gifobj->imgdsc.data = buf;
+
+    lv_image_cache_drop(lv_image_get_src(obj));
+    lv_obj_invalidate(obj);
+    return true;
+}
+
+/**
+ * Decode the next frame of a GIF. Runs on the decoder thread.
+ */
+static lv_result_t decode_frame_cb(lv_frame_queue_t * queue, uint8_t * buf, uint32_t * delay)
+{
+    lv_gif_t * gifobj = queue->user_data;
+    gd_GIF * gif = gifobj->gif;
+
+    if(gd_get_frame(gif) == 0) return LV_RESULT_INVALID;
+
+    /*The canvas keeps the state needed for the disposal of the frame*/
+    gd_render_frame(gif, gif->canvas);
+    lv_memcpy(buf, gif->canvas, queue->buf_size);
+    *delay = gif->gce.delay * 10;
+
+    return LV_RESULT_OK;
+}
+#endif
+
 #endif /*LV_USE_GIF*/
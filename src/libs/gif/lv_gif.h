@@ -18,11 +18,18 @@ extern "C" {
 #if LV_USE_GIF
 
 #include "gifdec.h"
+#include "../../misc/lv_frame_queue.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+#if LV_GIF_DECODE_AHEAD_CNT > 0 && LV_USE_OS
+    #define LV_GIF_DECODE_IN_THREAD 1
+#else
+    #define LV_GIF_DECODE_IN_THREAD 0
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,6 +40,10 @@ typedef struct {
     lv_timer_t * timer;
     lv_draw_buf_t imgdsc;
     uint32_t last_call;
+#if LV_GIF_DECODE_IN_THREAD
+    lv_frame_queue_t queue;     /*The frames decoded in advance. Not used if `queue.bufs == NULL`*/
+    uint32_t delay;             /*Time to show the current frame [ms]*/
+#endif
 } lv_gif_t;
 
 LV_ATTRIBUTE_EXTERN_DATA extern const lv_obj_class_t lv_gif_class;
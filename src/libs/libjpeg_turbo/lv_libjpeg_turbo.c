@@ -25,6 +25,9 @@
 #define JPEG_SIGNATURE 0xFFD8FF
 #define IS_JPEG_SIGNATURE(x) (((x) & 0x00FFFFFF) == JPEG_SIGNATURE)
 
+/*Number of lines to return in one `get_area_cb` call*/
+#define DECODE_AREA_LINES 16
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -33,13 +36,30 @@ typedef struct error_mgr_s {
     jmp_buf jb;
 } error_mgr_t;
 
+/*Used if only the drawn areas of the image are decoded*/
+typedef struct {
+    uint8_t * data;                         /*The whole JPEG file*/
+    uint32_t data_size;
+    struct jpeg_decompress_struct cinfo;
+    error_mgr_t jerr;
+    JSAMPARRAY line;                        /*A line of the cropped columns*/
+    JDIMENSION crop_x;                      /*The first column in `line`*/
+    lv_draw_buf_t * decoded_partial;
+} decoder_data_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_result_t decoder_info(lv_image_decoder_t * decoder, const void * src, lv_image_header_t * header);
 static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area);
 static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc);
-static lv_draw_buf_t * decode_jpeg_file(const char * filename);
+static lv_result_t decoder_open_partial(lv_image_decoder_dsc_t * dsc, uint8_t * data, uint32_t data_size);
+static bool fits_cache(lv_image_decoder_dsc_t * dsc);
+static uint32_t get_scale_denom(lv_image_decoder_dsc_t * dsc, uint32_t angle);
+static lv_draw_buf_t * decode_jpeg_data(uint8_t * data, uint32_t data_size, uint32_t image_angle,
+                                        uint32_t scale_denom);
 static uint8_t * read_file(const char * filename, uint32_t * size);
 static bool get_jpeg_head_info(const char * filename, uint32_t * width, uint32_t * height, uint32_t * orientation);
 static bool get_jpeg_size(uint8_t * data, uint32_t data_size, uint32_t * width, uint32_t * height);
@@ -74,6 +94,7 @@ void lv_libjpeg_turbo_init(void)
     lv_image_decoder_t * dec = lv_image_decoder_create();
     lv_image_decoder_set_info_cb(dec, decoder_info);
     lv_image_decoder_set_open_cb(dec, decoder_open);
+    lv_image_decoder_set_get_area_cb(dec, decoder_get_area);
     lv_image_decoder_set_close_cb(dec, decoder_close);
 
     dec->name = DECODER_NAME;
@@ -168,7 +189,29 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     /*If it's a JPEG file...*/
     if(dsc->src_type == LV_IMAGE_SRC_FILE) {
         const char * fn = dsc->src;
-        lv_draw_buf_t * decoded = decode_jpeg_file(fn);
+        uint32_t data_size;
+        uint8_t * data = read_file(fn, &data_size);
+        if(data == NULL) {
+            LV_LOG_WARN("can't load file %s", fn);
+            return LV_RESULT_INVALID;
+        }
+
+        /* Get rotate angle from Exif data */
+        uint32_t image_angle = 0;
+        if(!get_jpeg_direction(data, data_size, &image_angle)) {
+            LV_LOG_WARN("read jpeg orientation failed.");
+        }
+
+        uint32_t scale_denom = get_scale_denom(dsc, image_angle);
+
+        /*If the whole image can't be cached anyway, decode only the drawn areas instead of allocating it at once.
+         *Rotated images are always decoded at once.*/
+        if(image_angle == 0 && scale_denom == 1 && !dsc->args.no_cache && !fits_cache(dsc)) {
+            return decoder_open_partial(dsc, data, data_size);
+        }
+
+        lv_draw_buf_t * decoded = decode_jpeg_data(data, data_size, image_angle, scale_denom);
+        lv_free(data);
         if(decoded == NULL) {
             LV_LOG_WARN("decode jpeg file failed");
             return LV_RESULT_INVALID;
@@ -181,6 +224,9 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
         /*If the image cache is disabled, just return the decoded image*/
         if(!lv_image_cache_is_enabled()) return LV_RESULT_OK;
 
+        /*A downscaled image can't be used by others who need the original size*/
+        if(scale_denom != 1) return LV_RESULT_OK;
+
         /*Add the decoded image to the cache*/
         lv_image_cache_data_t search_key;
         search_key.src_type = dsc->src_type;
@@ -200,6 +246,84 @@ static lv_result_t decoder_open(lv_image_decoder_t * decoder, lv_image_decoder_d
     return LV_RESULT_INVALID;    /*If not returned earlier then it failed*/
 }
 
+/**
+ * Decode `DECODE_AREA_LINES` lines of `full_area` in each call.
+ * Only the columns of `full_area` are decoded and the lines above it are skipped without running the IDCT on them.
+ */
+static lv_result_t decoder_get_area(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t * dsc,
+                                    const lv_area_t * full_area, lv_area_t * decoded_area)
+{
+    LV_UNUSED(decoder); /*Unused*/
+
+    decoder_data_t * decoder_data = dsc->user_data;
+    if(decoder_data == NULL) return LV_RESULT_INVALID;
+
+    struct jpeg_decompress_struct * cinfo = &decoder_data->cinfo;
+
+    if(setjmp(decoder_data->jerr.jb)) {
+        LV_LOG_WARN("decoding error");
+        jpeg_abort_decompress(cinfo);
+        return LV_RESULT_INVALID;
+    }
+
+    if(decoded_area->y1 == LV_COORD_MIN) {
+        if(full_area->x1 < 0 || full_area->y1 < 0 ||
+           full_area->x2 >= dsc->header.w || full_area->y2 >= dsc->header.h) {
+            return LV_RESULT_INVALID;
+        }
+
+        /*Start again from the beginning of the file*/
+        jpeg_abort_decompress(cinfo);
+        jpeg_mem_src(cinfo, decoder_data->data, decoder_data->data_size);
+        jpeg_read_header(cinfo, TRUE);
+        cinfo->out_color_space = JCS_EXT_BGR;
+        jpeg_start_decompress(cinfo);
+
+        /*The first column is moved to an iMCU boundary so a few more columns might be decoded*/
+        JDIMENSION crop_x = full_area->x1;
+        JDIMENSION crop_w = lv_area_get_width(full_area);
+        jpeg_crop_scanline(cinfo, &crop_x, &crop_w);
+        decoder_data->crop_x = crop_x;
+        decoder_data->line = (*cinfo->mem->alloc_sarray)
+                             ((j_common_ptr) cinfo, JPOOL_IMAGE, crop_w * JPEG_PIXEL_SIZE, 1);
+
+        jpeg_skip_scanlines(cinfo, full_area->y1);
+
+        *decoded_area = *full_area;
+        decoded_area->y2 = full_area->y1 - 1;
+    }
+
+    if(decoded_area->y2 >= full_area->y2) return LV_RESULT_INVALID;
+
+    decoded_area->y1 = decoded_area->y2 + 1;
+    decoded_area->y2 = LV_MIN(decoded_area->y1 + DECODE_AREA_LINES - 1, full_area->y2);
+
+    int32_t w = lv_area_get_width(decoded_area);
+    int32_t h = lv_area_get_height(decoded_area);
+    lv_draw_buf_t * decoded = lv_draw_buf_reshape(decoder_data->decoded_partial, LV_COLOR_FORMAT_RGB888, w, h,
+                                                  LV_STRIDE_AUTO);
+    if(decoded == NULL) {
+        if(decoder_data->decoded_partial != NULL) {
+            lv_draw_buf_destroy(decoder_data->decoded_partial);
+            decoder_data->decoded_partial = NULL;
+        }
+        decoded = lv_draw_buf_create(w, h, LV_COLOR_FORMAT_RGB888, LV_STRIDE_AUTO);
+        if(decoded == NULL) return LV_RESULT_INVALID;
+        decoder_data->decoded_partial = decoded; /*Free on decoder close*/
+    }
+
+    const uint8_t * src = decoder_data->line[0] + (decoded_area->x1 - decoder_data->crop_x) * JPEG_PIXEL_SIZE;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        jpeg_read_scanlines(cinfo, decoder_data->line, 1);
+        lv_memcpy(decoded->data + y * decoded->header.stride, src, w * JPEG_PIXEL_SIZE);
+    }
+
+    dsc->decoded = decoded;
+
+    return LV_RESULT_OK;
+}
+
 /**
  * Free the allocated resources
  */
@@ -207,10 +331,98 @@ static void decoder_close(lv_image_decoder_t * decoder, lv_image_decoder_dsc_t *
 {
     LV_UNUSED(decoder); /*Unused*/
 
-    if(dsc->args.no_cache || !lv_image_cache_is_enabled())
-        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
-    else
+    decoder_data_t * decoder_data = dsc->user_data;
+    if(decoder_data) {
+        jpeg_destroy_decompress(&decoder_data->cinfo);
+        if(decoder_data->decoded_partial) lv_draw_buf_destroy(decoder_data->decoded_partial);
+        lv_free(decoder_data->data);
+        lv_free(decoder_data);
+        dsc->user_data = NULL;
+    }
+    else if(dsc->cache_entry) {
         lv_cache_release(dsc->cache, dsc->cache_entry, NULL);
+    }
+    else {
+        lv_draw_buf_destroy((lv_draw_buf_t *)dsc->decoded);
+    }
+}
+
+/**
+ * Prepare decoding the image in areas with `decoder_get_area`
+ * @param dsc       pointer to the decoder descriptor
+ * @param data      the content of the JPEG file. It's freed on close.
+ * @param data_size size of `data`
+ * @return LV_RESULT_OK: no error; LV_RESULT_INVALID: out of memory
+ */
+static lv_result_t decoder_open_partial(lv_image_decoder_dsc_t * dsc, uint8_t * data, uint32_t data_size)
+{
+    decoder_data_t * decoder_data = lv_malloc_zeroed(sizeof(decoder_data_t));
+    LV_ASSERT_MALLOC(decoder_data);
+    if(decoder_data == NULL) {
+        lv_free(data);
+        return LV_RESULT_INVALID;
+    }
+
+    decoder_data->data = data;
+    decoder_data->data_size = data_size;
+    decoder_data->cinfo.err = jpeg_std_error(&decoder_data->jerr.pub);
+    decoder_data->jerr.pub.error_exit = error_exit;
+    jpeg_create_decompress(&decoder_data->cinfo);
+
+    dsc->user_data = decoder_data;
+    dsc->decoded = NULL;    /*Need to read via get_area_cb*/
+
+    return LV_RESULT_OK;
+}
+
+/**
+ * Check if the whole decoded image fits into the image cache
+ * @param dsc   pointer to the decoder descriptor
+ * @return      true: the image can be cached
+ */
+static bool fits_cache(lv_image_decoder_dsc_t * dsc)
+{
+    if(!lv_image_cache_is_enabled()) return false;
+
+    uint32_t size = lv_draw_buf_width_to_stride(dsc->header.w, LV_COLOR_FORMAT_RGB888) * dsc->header.h;
+    return size <= lv_cache_get_max_size(dsc->cache, NULL);
+}
+
+/**
+ * Select the strongest DCT scaling (1/1, 1/2, 1/4 or 1/8) which still keeps the image
+ * at least as large as the target size in the decoder arguments
+ * @param dsc       pointer to the decoder descriptor
+ * @param angle     the rotation of the image from the Exif data
+ * @return          the image should be decoded at 1/`scale_denom` size
+ */
+static uint32_t get_scale_denom(lv_image_decoder_dsc_t * dsc, uint32_t angle)
+{
+    int32_t target_w = dsc->args.target_w;
+    int32_t target_h = dsc->args.target_h;
+    if(target_w <= 0 && target_h <= 0) return 1;
+
+    /*Prefer caching the original image if it fits as the downscaled image is decoded again on each use*/
+    if(!dsc->args.no_cache && fits_cache(dsc)) return 1;
+
+    /*The header is already rotated, so rotate the target too to compare it with the size in the file*/
+    int32_t w = dsc->header.w;
+    int32_t h = dsc->header.h;
+    if(angle % 180) {
+        w = dsc->header.h;
+        h = dsc->header.w;
+        target_w = dsc->args.target_h;
+        target_h = dsc->args.target_w;
+    }
+
+    uint32_t denom = 1;
+    while(denom < 8) {
+        int32_t next = denom * 2;
+        if(target_w > 0 && (w + next - 1) / next < target_w) break;
+        if(target_h > 0 && (h + next - 1) / next < target_h) break;
+        denom = next;
+    }
+
+    return denom;
 }
 
 static uint8_t * read_file(const char * filename, uint32_t * size)
@@ -268,7 +480,8 @@ failed:
     return data;
 }
 
-static lv_draw_buf_t * decode_jpeg_file(const char * filename)
+static lv_draw_buf_t * decode_jpeg_data(uint8_t * data, uint32_t data_size, uint32_t image_angle,
+                                        uint32_t scale_denom)
 {
     /* This struct contains the JPEG decompression parameters and pointers to
      * working space (which is allocated as needed by the JPEG library).
@@ -284,23 +497,9 @@ static lv_draw_buf_t * decode_jpeg_file(const char * filename)
     JSAMPARRAY buffer;  /* Output row buffer */
 
     int row_stride;     /* physical row width in output buffer */
-    uint32_t image_angle = 0;   /* image rotate angle */
 
     lv_draw_buf_t * decoded = NULL;
 
-    /* In this example we want to open the input file before doing anything else,
-     * so that the setjmp() error recovery below can assume the file is open.
-     * VERY IMPORTANT: use "b" option to fopen() if you are on a machine that
-     * requires it in order to read binary files.
-     */
-
-    uint32_t data_size;
-    uint8_t * data = read_file(filename, &data_size);
-    if(data == NULL) {
-        LV_LOG_WARN("can't load file %s", filename);
-        return NULL;
-    }
-
     /* allocate and initialize JPEG decompression object */
 
     /* We set up the normal JPEG error routines, then override error_exit. */
@@ -319,15 +518,9 @@ static lv_draw_buf_t * decode_jpeg_file(const char * filename)
         * We need to clean up the JPEG object, close the input file, and return.
         */
         jpeg_destroy_decompress(&cinfo);
-        lv_free(data);
         return NULL;
     }
 
-    /* Get rotate angle from Exif data */
-    if(!get_jpeg_direction(data, data_size, &image_angle)) {
-        LV_LOG_WARN("read jpeg orientation failed.");
-    }
-
     /* Now we can initialize the JPEG decompression object. */
     jpeg_create_decompress(&cinfo);
 
@@ -349,9 +542,9 @@ static lv_draw_buf_t * decode_jpeg_file(const char * filename)
 
     cinfo.out_color_space = JCS_EXT_BGR;
 
-    /* In this example, we don't need to change any of the defaults set by
-     * jpeg_read_header(), so we do nothing here.
-     */
+    /* Let the IDCT output fewer pixels if the image is shown smaller anyway */
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
 
     /* Start decompressor */
 
@@ -410,13 +603,6 @@ static lv_draw_buf_t * decode_jpeg_file(const char * filename)
     /* This is an important step since it will release a good deal of memory. */
     jpeg_destroy_decompress(&cinfo);
 
-    /* After finish_decompress, we can close the input file.
-    * Here we postpone it until after no more JPEG errors are possible,
-    * so as to simplify the setjmp error logic above.  (Actually, I don't
-    * think that jpeg_destroy can do an error exit, but why assume anything...)
-    */
-    lv_free(data);
-
     /* At this point you may want to check to see whether any corrupt-data
     * warnings occurred (test whether jerr.pub.num_warnings is nonzero).
     */
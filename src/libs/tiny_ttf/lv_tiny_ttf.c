@@ -11,6 +11,7 @@
 #if LV_USE_TINY_TTF
 
 #include "../../core/lv_global.h"
+#include "../../misc/lv_text_private.h"
 
 #define font_draw_buf_handlers &(LV_GLOBAL_DEFAULT()->font_draw_buf_handlers)
 
@@ -19,6 +20,8 @@
  *********************/
 
 #define CACHE_NAME  "TINY_TTF"
+#define GLYPH_CACHE_NAME  "TINY_TTF_GLYPH"
+#define KERNING_CACHE_NAME  "TINY_TTF_KERNING"
 
 #define STB_RECT_PACK_IMPLEMENTATION
 #define STBRP_STATIC
@@ -66,6 +69,8 @@ typedef struct ttf_font_desc {
     float scale;
     int ascent;
     int descent;
+    lv_cache_t * glyph_cache;   /*Glyph index and metrics by code point*/
+    lv_cache_t * kerning_cache; /*Kerning by glyph index pairs. NULL if the font has no kerning info*/
 } ttf_font_desc_t;
 
 typedef struct _tiny_ttf_cache_data_t {
@@ -74,6 +79,22 @@ typedef struct _tiny_ttf_cache_data_t {
     uint32_t size;
     lv_draw_buf_t * draw_buf;
 } tiny_ttf_cache_data_t;
+
+typedef struct _tiny_ttf_glyph_cache_data_t {
+    uint32_t unicode;
+    int glyph_index;    /*0 if the font has no glyph for `unicode`*/
+    int adv_w;          /*Advance width in unscaled font units*/
+    int x1;             /*Bounding box of the bitmap at the current scale*/
+    int y1;
+    int x2;
+    int y2;
+} tiny_ttf_glyph_cache_data_t;
+
+typedef struct _tiny_ttf_kerning_cache_data_t {
+    int glyph_index;
+    int glyph_index_next;
+    int kern;           /*Kerning in unscaled font units*/
+} tiny_ttf_kerning_cache_data_t;
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -89,6 +110,17 @@ static bool tiny_ttf_cache_create_cb(tiny_ttf_cache_data_t * node, void * user_d
 static void tiny_ttf_cache_free_cb(tiny_ttf_cache_data_t * node, void * user_data);
 static lv_cache_compare_res_t tiny_ttf_cache_compare_cb(const tiny_ttf_cache_data_t * lhs,
                                                         const tiny_ttf_cache_data_t * rhs);
+
+static bool tiny_ttf_glyph_get(ttf_font_desc_t * dsc, uint32_t unicode, tiny_ttf_glyph_cache_data_t * glyph_out);
+static int tiny_ttf_kerning_get(ttf_font_desc_t * dsc, int glyph_index, int glyph_index_next);
+static bool tiny_ttf_glyph_cache_create_cb(tiny_ttf_glyph_cache_data_t * node, void * user_data);
+static void tiny_ttf_glyph_cache_free_cb(tiny_ttf_glyph_cache_data_t * node, void * user_data);
+static lv_cache_compare_res_t tiny_ttf_glyph_cache_compare_cb(const tiny_ttf_glyph_cache_data_t * lhs,
+                                                              const tiny_ttf_glyph_cache_data_t * rhs);
+static bool tiny_ttf_kerning_cache_create_cb(tiny_ttf_kerning_cache_data_t * node, void * user_data);
+static void tiny_ttf_kerning_cache_free_cb(tiny_ttf_kerning_cache_data_t * node, void * user_data);
+static lv_cache_compare_res_t tiny_ttf_kerning_cache_compare_cb(const tiny_ttf_kerning_cache_data_t * lhs,
+                                                                const tiny_ttf_kerning_cache_data_t * rhs);
 /**********************
  *  GLOBAL VARIABLES
  **********************/
@@ -117,6 +149,27 @@ void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size)
     stbtt_GetFontVMetrics(&dsc->info, &dsc->ascent, &dsc->descent, &line_gap);
     font->line_height = (int32_t)(dsc->scale * (dsc->ascent - dsc->descent + line_gap));
     font->base_line = (int32_t)(dsc->scale * (line_gap - dsc->descent));
+
+    /*The cached bounding boxes are valid only for the previous scale*/
+    if(dsc->glyph_cache) {
+        lv_cache_drop_all(dsc->glyph_cache, NULL);
+    }
+}
+
+void lv_tiny_ttf_preload(lv_font_t * font, const char * letters)
+{
+    LV_ASSERT_NULL(font);
+    LV_ASSERT_NULL(letters);
+
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
+    tiny_ttf_glyph_cache_data_t glyph;
+
+    uint32_t i = 0;
+    uint32_t letter = lv_text_encoded_next(letters, &i);
+    while(letter != 0) {
+        tiny_ttf_glyph_get(dsc, letter, &glyph);
+        letter = lv_text_encoded_next(letters, &i);
+    }
 }
 
 void lv_tiny_ttf_destroy(lv_font_t * font)
@@ -131,6 +184,10 @@ void lv_tiny_ttf_destroy(lv_font_t * font)
         }
 #endif
         lv_cache_drop_all(tiny_ttf_cache, (void *)font->dsc);
+        lv_cache_destroy(ttf->glyph_cache, NULL);
+        if(ttf->kerning_cache) {
+            lv_cache_destroy(ttf->kerning_cache, NULL);
+        }
         lv_free(ttf);
         font->dsc = NULL;
     }
@@ -206,30 +263,29 @@ static bool ttf_get_glyph_dsc_cb(const lv_font_t * font, lv_font_glyph_dsc_t * d
         return true;
     }
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
-    int g1 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter);
-    if(g1 == 0) {
+    tiny_ttf_glyph_cache_data_t glyph;
+    if(!tiny_ttf_glyph_get(dsc, unicode_letter, &glyph) || glyph.glyph_index == 0) {
         /* Glyph not found */
         return false;
     }
-    int x1, y1, x2, y2;
 
-    stbtt_GetGlyphBitmapBox(&dsc->info, g1, dsc->scale, dsc->scale, &x1, &y1, &x2, &y2);
-    int g2 = 0;
-    if(unicode_letter_next != 0) {
-        g2 = stbtt_FindGlyphIndex(&dsc->info, (int)unicode_letter_next);
+    int k = 0;
+    if(unicode_letter_next != 0 && dsc->kerning_cache) {
+        tiny_ttf_glyph_cache_data_t glyph_next;
+        if(tiny_ttf_glyph_get(dsc, unicode_letter_next, &glyph_next)) {
+            k = tiny_ttf_kerning_get(dsc, glyph.glyph_index, glyph_next.glyph_index);
+        }
     }
-    int advw, lsb;
-    stbtt_GetGlyphHMetrics(&dsc->info, g1, &advw, &lsb);
-    int k = stbtt_GetGlyphKernAdvance(&dsc->info, g1, g2);
-    dsc_out->adv_w = (uint16_t)floor((((float)advw + (float)k) * dsc->scale) +
+
+    dsc_out->adv_w = (uint16_t)floor((((float)glyph.adv_w + (float)k) * dsc->scale) +
                                      0.5f); /*Horizontal space required by the glyph in [px]*/
-    dsc_out->box_w = (x2 - x1 + 1);         /*width of the bitmap in [px]*/
-    dsc_out->box_h = (y2 - y1 + 1);         /*height of the bitmap in [px]*/
-    dsc_out->ofs_x = x1;                    /*X offset of the bitmap in [pf]*/
-    dsc_out->ofs_y = -y2;                   /*Y offset of the bitmap measured from the as line*/
+    dsc_out->box_w = (glyph.x2 - glyph.x1 + 1); /*width of the bitmap in [px]*/
+    dsc_out->box_h = (glyph.y2 - glyph.y1 + 1); /*height of the bitmap in [px]*/
+    dsc_out->ofs_x = glyph.x1;                  /*X offset of the bitmap in [pf]*/
+    dsc_out->ofs_y = -glyph.y2;                 /*Y offset of the bitmap measured from the as line*/
     dsc_out->format = LV_FONT_GLYPH_FORMAT_A8;
     dsc_out->is_placeholder = false;
-    dsc_out->gid.index = (uint32_t)g1;
+    dsc_out->gid.index = (uint32_t)glyph.glyph_index;
     return true; /*true: glyph found; false: glyph was not found*/
 }
 
@@ -270,7 +326,6 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
                                       size_t cache_size)
 {
     LV_UNUSED(data_size);
-    LV_UNUSED(cache_size);
     if((path == NULL && data == NULL) || 0 >= font_size) {
         LV_LOG_ERROR("tiny_ttf: invalid argument\n");
         return NULL;
@@ -318,8 +373,46 @@ static lv_font_t * lv_tiny_ttf_create(const char * path, const void * data, size
     out_font->get_glyph_bitmap = ttf_get_glyph_bitmap_cb;
     out_font->release_glyph = ttf_release_glyph_cb;
     out_font->dsc = dsc;
+
+    if(cache_size == 0) {
+        cache_size = LV_TINY_TTF_CACHE_GLYPH_CNT;
+    }
+
+    lv_cache_ops_t glyph_ops = {
+        .compare_cb = (lv_cache_compare_cb_t)tiny_ttf_glyph_cache_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)tiny_ttf_glyph_cache_create_cb,
+        .free_cb = (lv_cache_free_cb_t)tiny_ttf_glyph_cache_free_cb,
+    };
+    dsc->glyph_cache = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(tiny_ttf_glyph_cache_data_t),
+                                       cache_size, glyph_ops);
+    if(dsc->glyph_cache == NULL) goto cache_failed;
+    lv_cache_set_name(dsc->glyph_cache, GLYPH_CACHE_NAME);
+
+    /*Most fonts have no kerning info, don't waste memory on a kerning cache for them*/
+    if(dsc->info.kern || dsc->info.gpos) {
+        lv_cache_ops_t kerning_ops = {
+            .compare_cb = (lv_cache_compare_cb_t)tiny_ttf_kerning_cache_compare_cb,
+            .create_cb = (lv_cache_create_cb_t)tiny_ttf_kerning_cache_create_cb,
+            .free_cb = (lv_cache_free_cb_t)tiny_ttf_kerning_cache_free_cb,
+        };
+        dsc->kerning_cache = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(tiny_ttf_kerning_cache_data_t),
+                                             cache_size, kerning_ops);
+        if(dsc->kerning_cache == NULL) goto cache_failed;
+        lv_cache_set_name(dsc->kerning_cache, KERNING_CACHE_NAME);
+    }
+
     lv_tiny_ttf_set_size(out_font, font_size);
     return out_font;
+
+cache_failed:
+    if(dsc->glyph_cache) lv_cache_destroy(dsc->glyph_cache, NULL);
+#if LV_TINY_TTF_FILE_SUPPORT != 0
+    if(dsc->stream.file != NULL) lv_fs_close(&dsc->file);
+#endif
+    lv_free(out_font);
+    lv_free(dsc);
+    LV_LOG_ERROR("tiny_ttf: couldn't create the cache\n");
+    return NULL;
 }
 #if LV_TINY_TTF_FILE_SUPPORT != 0
 lv_font_t * lv_tiny_ttf_create_file_ex(const char * path, int32_t font_size, size_t cache_size)
@@ -400,4 +493,100 @@ static lv_cache_compare_res_t tiny_ttf_cache_compare_cb(const tiny_ttf_cache_dat
     return 0;
 }
 
+static bool tiny_ttf_glyph_get(ttf_font_desc_t * dsc, uint32_t unicode, tiny_ttf_glyph_cache_data_t * glyph_out)
+{
+    tiny_ttf_glyph_cache_data_t search_key = {
+        .unicode = unicode,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(dsc->glyph_cache, &search_key, dsc);
+    if(entry == NULL) {
+        LV_LOG_ERROR("glyph lookup failed for unicode = 0x%" LV_PRIx32, unicode);
+        return false;
+    }
+
+    *glyph_out = *(tiny_ttf_glyph_cache_data_t *)lv_cache_entry_get_data(entry);
+    lv_cache_release(dsc->glyph_cache, entry, NULL);
+    return true;
+}
+
+static int tiny_ttf_kerning_get(ttf_font_desc_t * dsc, int glyph_index, int glyph_index_next)
+{
+    tiny_ttf_kerning_cache_data_t search_key = {
+        .glyph_index = glyph_index,
+        .glyph_index_next = glyph_index_next,
+    };
+
+    lv_cache_entry_t * entry = lv_cache_acquire_or_create(dsc->kerning_cache, &search_key, dsc);
+    if(entry == NULL) {
+        return 0;
+    }
+
+    tiny_ttf_kerning_cache_data_t * data = lv_cache_entry_get_data(entry);
+    int kern = data->kern;
+    lv_cache_release(dsc->kerning_cache, entry, NULL);
+    return kern;
+}
+
+static bool tiny_ttf_glyph_cache_create_cb(tiny_ttf_glyph_cache_data_t * node, void * user_data)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)user_data;
+
+    /*Missing glyphs are cached too to avoid searching them again*/
+    node->glyph_index = stbtt_FindGlyphIndex(&dsc->info, (int)node->unicode);
+    if(node->glyph_index == 0) {
+        return true;
+    }
+
+    int lsb;
+    stbtt_GetGlyphHMetrics(&dsc->info, node->glyph_index, &node->adv_w, &lsb);
+    stbtt_GetGlyphBitmapBox(&dsc->info, node->glyph_index, dsc->scale, dsc->scale,
+                            &node->x1, &node->y1, &node->x2, &node->y2);
+    return true;
+}
+
+static void tiny_ttf_glyph_cache_free_cb(tiny_ttf_glyph_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+static lv_cache_compare_res_t tiny_ttf_glyph_cache_compare_cb(const tiny_ttf_glyph_cache_data_t * lhs,
+                                                              const tiny_ttf_glyph_cache_data_t * rhs)
+{
+    if(lhs->unicode != rhs->unicode) {
+        return lhs->unicode > rhs->unicode ? 1 : -1;
+    }
+
+    return 0;
+}
+
+static bool tiny_ttf_kerning_cache_create_cb(tiny_ttf_kerning_cache_data_t * node, void * user_data)
+{
+    ttf_font_desc_t * dsc = (ttf_font_desc_t *)user_data;
+
+    node->kern = stbtt_GetGlyphKernAdvance(&dsc->info, node->glyph_index, node->glyph_index_next);
+    return true;
+}
+
+static void tiny_ttf_kerning_cache_free_cb(tiny_ttf_kerning_cache_data_t * node, void * user_data)
+{
+    LV_UNUSED(node);
+    LV_UNUSED(user_data);
+}
+
+static lv_cache_compare_res_t tiny_ttf_kerning_cache_compare_cb(const tiny_ttf_kerning_cache_data_t * lhs,
+                                                                const tiny_ttf_kerning_cache_data_t * rhs)
+{
+    if(lhs->glyph_index != rhs->glyph_index) {
+        return lhs->glyph_index > rhs->glyph_index ? 1 : -1;
+    }
+
+    if(lhs->glyph_index_next != rhs->glyph_index_next) {
+        return lhs->glyph_index_next > rhs->glyph_index_next ? 1 : -1;
+    }
+
+    return 0;
+}
+
 #endif
@@ -47,6 +47,10 @@ lv_font_t * lv_tiny_ttf_create_data(const void * data, size_t data_size, int32_t
 /* create a font from the specified data pointer with the specified line height and the specified cache size.*/
 lv_font_t * lv_tiny_ttf_create_data_ex(const void * data, size_t data_size, int32_t font_size, size_t cache_size);
 
+/* load the glyph metrics of the UTF-8 encoded `letters` into the font's cache in advance.
+ * Kerning is still looked up and cached when the letters are drawn.*/
+void lv_tiny_ttf_preload(lv_font_t * font, const char * letters);
+
 /* set the size of the font to a new font_size*/
 void lv_tiny_ttf_set_size(lv_font_t * font, int32_t font_size);
 
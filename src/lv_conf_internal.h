@@ -167,6 +167,22 @@
     #endif
 #endif
 
+#if LV_USE_STDLIB_STRING == LV_STDLIB_BUILTIN
+    /*Use SSE2/AVX2 or NEON in `lv_memcpy()` and `lv_memset()` if the compiler targets them
+     *(e.g. `-msse2`, `-mavx2`, `-mfpu=neon`). Otherwise word copies are used.*/
+    #ifndef LV_STRING_USE_SIMD
+        #ifdef _LV_KCONFIG_PRESENT
+            #ifdef CONFIG_LV_STRING_USE_SIMD
+                #define LV_STRING_USE_SIMD CONFIG_LV_STRING_USE_SIMD
+            #else
+                #define LV_STRING_USE_SIMD 0
+            #endif
+        #else
+            #define LV_STRING_USE_SIMD 1
+        #endif
+    #endif
+#endif
+
 #if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN
     /*Size of the memory available for `lv_malloc()` in bytes (>= 2kB)*/
     #ifndef LV_MEM_SIZE
@@ -211,6 +227,35 @@
             #endif
         #endif
     #endif
+
+    /*Serve small allocations from slabs of equally sized slots in front of the TLSF heap.
+     *It reduces fragmentation and makes allocating and freeing small objects faster.*/
+    #ifndef LV_MEM_USE_SLAB
+        #ifdef CONFIG_LV_MEM_USE_SLAB
+            #define LV_MEM_USE_SLAB CONFIG_LV_MEM_USE_SLAB
+        #else
+            #define LV_MEM_USE_SLAB 0
+        #endif
+    #endif
+    #if LV_MEM_USE_SLAB
+        /*Allocations up to this size are served from slabs. Size classes are multiples of 8 bytes.*/
+        #ifndef LV_MEM_SLAB_MAX_SIZE
+            #ifdef CONFIG_LV_MEM_SLAB_MAX_SIZE
+                #define LV_MEM_SLAB_MAX_SIZE CONFIG_LV_MEM_SLAB_MAX_SIZE
+            #else
+                #define LV_MEM_SLAB_MAX_SIZE 128    /*[bytes]*/
+            #endif
+        #endif
+
+        /*Size of one slab allocated from the heap. Must be a power of 2.*/
+        #ifndef LV_MEM_SLAB_SIZE
+            #ifdef CONFIG_LV_MEM_SLAB_SIZE
+                #define LV_MEM_SLAB_SIZE CONFIG_LV_MEM_SLAB_SIZE
+            #else
+                #define LV_MEM_SLAB_SIZE 2048       /*[bytes]*/
+            #endif
+        #endif
+    #endif
 #endif  /*LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN*/
 
 /*====================
@@ -265,6 +310,16 @@
     #endif
 #endif
 
+/*Number of calls which can be queued by `lv_async_call_from_thread()` between two `lv_timer_handler()` calls.
+ *Must be a power of 2.*/
+#ifndef LV_ASYNC_QUEUE_SIZE
+    #ifdef CONFIG_LV_ASYNC_QUEUE_SIZE
+        #define LV_ASYNC_QUEUE_SIZE CONFIG_LV_ASYNC_QUEUE_SIZE
+    #else
+        #define LV_ASYNC_QUEUE_SIZE 32
+    #endif
+#endif
+
 /*========================
  * RENDERING CONFIGURATION
  *========================*/
@@ -305,6 +360,17 @@
     #endif
 #endif
 
+/* Max. memory used to retain the rendered image of the widgets with `LV_OBJ_FLAG_CACHE_AS_BITMAP`.
+ * If the budget is exceeded the least recently used images are freed.
+ * 0: disable the feature */
+#ifndef LV_OBJ_BITMAP_CACHE_SIZE
+    #ifdef CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+        #define LV_OBJ_BITMAP_CACHE_SIZE CONFIG_LV_OBJ_BITMAP_CACHE_SIZE
+    #else
+        #define LV_OBJ_BITMAP_CACHE_SIZE        0   /*[bytes]*/
+    #endif
+#endif
+
 /* The stack size of the drawing thread.
  * NOTE: If FreeType or ThorVG is enabled, it is recommended to set it to 32KB or more.
  */
@@ -400,6 +466,18 @@
         #endif
     #endif
 
+    /* Downscale the images with a box filter first if they are scaled to 50% or less.
+     * It avoids the aliasing of heavily downscaled images (e.g. thumbnails).
+     * The downscaled copies are stored with the cached decoded images (see `LV_CACHE_DEF_SIZE`).
+     * Images which are not cached (e.g. used directly from a C array) are not downscaled this way. */
+    #ifndef LV_DRAW_SW_MIPMAP
+        #ifdef CONFIG_LV_DRAW_SW_MIPMAP
+            #define LV_DRAW_SW_MIPMAP CONFIG_LV_DRAW_SW_MIPMAP
+        #else
+            #define LV_DRAW_SW_MIPMAP           0
+        #endif
+    #endif
+
     #ifndef LV_USE_DRAW_SW_ASM
         #ifdef CONFIG_LV_USE_DRAW_SW_ASM
             #define LV_USE_DRAW_SW_ASM CONFIG_LV_USE_DRAW_SW_ASM
@@ -896,6 +974,40 @@
     #endif
 #endif
 
+/*Cache the blocks read by `lv_fs_read()` and share them between all the files opened for reading.
+ *The blocks are kept after closing the files so reopened files (e.g. fonts and images) are not read again.
+ *If a file is read sequentially the next blocks are read in advance without seeking in the file.*/
+#ifndef LV_USE_FS_BLOCK_CACHE
+    #ifdef CONFIG_LV_USE_FS_BLOCK_CACHE
+        #define LV_USE_FS_BLOCK_CACHE CONFIG_LV_USE_FS_BLOCK_CACHE
+    #else
+        #define LV_USE_FS_BLOCK_CACHE 0
+    #endif
+#endif
+#if LV_USE_FS_BLOCK_CACHE
+    #ifndef LV_FS_BLOCK_CACHE_BLOCK_SIZE
+        #ifdef CONFIG_LV_FS_BLOCK_CACHE_BLOCK_SIZE
+            #define LV_FS_BLOCK_CACHE_BLOCK_SIZE CONFIG_LV_FS_BLOCK_CACHE_BLOCK_SIZE
+        #else
+            #define LV_FS_BLOCK_CACHE_BLOCK_SIZE 4096   /*[bytes]*/
+        #endif
+    #endif
+    #ifndef LV_FS_BLOCK_CACHE_BLOCK_CNT
+        #ifdef CONFIG_LV_FS_BLOCK_CACHE_BLOCK_CNT
+            #define LV_FS_BLOCK_CACHE_BLOCK_CNT CONFIG_LV_FS_BLOCK_CACHE_BLOCK_CNT
+        #else
+            #define LV_FS_BLOCK_CACHE_BLOCK_CNT 16      /*Number of blocks to cache. Can be changed by `lv_fs_block_cache_resize()`*/
+        #endif
+    #endif
+    #ifndef LV_FS_BLOCK_CACHE_READ_AHEAD
+        #ifdef CONFIG_LV_FS_BLOCK_CACHE_READ_AHEAD
+            #define LV_FS_BLOCK_CACHE_READ_AHEAD CONFIG_LV_FS_BLOCK_CACHE_READ_AHEAD
+        #else
+            #define LV_FS_BLOCK_CACHE_READ_AHEAD 2      /*Number of blocks to read in advance*/
+        #endif
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -925,6 +1037,16 @@
     #endif
 #endif
 
+/* Cache the resolved value of the style properties per object part, so getting them becomes an array lookup.
+ * Needs about 150 bytes + 8 bytes per used property for each part of the objects whose style is read */
+#ifndef LV_OBJ_STYLE_RESOLVED_CACHE
+    #ifdef CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+        #define LV_OBJ_STYLE_RESOLVED_CACHE CONFIG_LV_OBJ_STYLE_RESOLVED_CACHE
+    #else
+        #define LV_OBJ_STYLE_RESOLVED_CACHE     0
+    #endif
+#endif
+
 /* Add `id` field to `lv_obj_t` */
 #ifndef LV_USE_OBJ_ID
     #ifdef CONFIG_LV_USE_OBJ_ID
@@ -2367,6 +2489,15 @@
         #define LV_GIF_CACHE_DECODE_DATA 0
     #endif
 #endif
+/*Decode this many frames in advance on a background thread. 0: decode the frames in an `lv_timer`.
+ *Needs `LV_USE_OS` and uses an extra width x height x 4 bytes RAM per frame*/
+#ifndef LV_GIF_DECODE_AHEAD_CNT
+    #ifdef CONFIG_LV_GIF_DECODE_AHEAD_CNT
+        #define LV_GIF_DECODE_AHEAD_CNT CONFIG_LV_GIF_DECODE_AHEAD_CNT
+    #else
+        #define LV_GIF_DECODE_AHEAD_CNT 0
+    #endif
+#endif
 #endif
 
 
@@ -2452,6 +2583,14 @@
             #define LV_TINY_TTF_FILE_SUPPORT 0
         #endif
     #endif
+    /* Default number of glyph metrics cached per font if 0 is passed as `cache_size` */
+    #ifndef LV_TINY_TTF_CACHE_GLYPH_CNT
+        #ifdef CONFIG_LV_TINY_TTF_CACHE_GLYPH_CNT
+            #define LV_TINY_TTF_CACHE_GLYPH_CNT CONFIG_LV_TINY_TTF_CACHE_GLYPH_CNT
+        #else
+            #define LV_TINY_TTF_CACHE_GLYPH_CNT 256
+        #endif
+    #endif
 #endif
 
 /*Rlottie library*/
@@ -2526,6 +2665,15 @@
             #define LV_FFMPEG_DUMP_FORMAT 0
         #endif
     #endif
+    /*Decode this many frames in advance on a background thread in the player. 0: decode the frames in an `lv_timer`.
+     *Needs `LV_USE_OS` and uses an extra frame buffer per frame*/
+    #ifndef LV_FFMPEG_DECODE_AHEAD_CNT
+        #ifdef CONFIG_LV_FFMPEG_DECODE_AHEAD_CNT
+            #define LV_FFMPEG_DECODE_AHEAD_CNT CONFIG_LV_FFMPEG_DECODE_AHEAD_CNT
+        #else
+            #define LV_FFMPEG_DECODE_AHEAD_CNT 0
+        #endif
+    #endif
 #endif
 
 /*==================
@@ -2687,6 +2835,36 @@
     #endif
 #endif
 
+/*1: Record the call site, size and lifetime of the allocations made by `lv_malloc()` and `lv_realloc()`.
+ *The live memory is aggregated per call site and per widget class. See `lv_mem_track_dump()`.
+ *Each allocation gets a few dozen bytes of header.*/
+#ifndef LV_USE_MEM_TRACK
+    #ifdef CONFIG_LV_USE_MEM_TRACK
+        #define LV_USE_MEM_TRACK CONFIG_LV_USE_MEM_TRACK
+    #else
+        #define LV_USE_MEM_TRACK 0
+    #endif
+#endif
+#if LV_USE_MEM_TRACK
+    /*Max number of different call sites to track. The rest are aggregated together.*/
+    #ifndef LV_MEM_TRACK_SITE_CNT
+        #ifdef CONFIG_LV_MEM_TRACK_SITE_CNT
+            #define LV_MEM_TRACK_SITE_CNT CONFIG_LV_MEM_TRACK_SITE_CNT
+        #else
+            #define LV_MEM_TRACK_SITE_CNT 512
+        #endif
+    #endif
+
+    /*Max number of different tags (widget classes) to track. The rest are aggregated together.*/
+    #ifndef LV_MEM_TRACK_TAG_CNT
+        #ifdef CONFIG_LV_MEM_TRACK_TAG_CNT
+            #define LV_MEM_TRACK_TAG_CNT CONFIG_LV_MEM_TRACK_TAG_CNT
+        #else
+            #define LV_MEM_TRACK_TAG_CNT 64
+        #endif
+    #endif
+#endif
+
 /*1: Enable Monkey test*/
 #ifndef LV_USE_MONKEY
     #ifdef CONFIG_LV_USE_MONKEY
@@ -2986,6 +3164,15 @@
             #define LV_LINUX_FBDEV_BUFFER_SIZE   60
         #endif
     #endif
+    /*Render directly into 2 pages of the framebuffer and switch them with FBIOPAN_DISPLAY
+     *if the virtual screen can hold 2 pages. The render mode and buffer settings are ignored then.*/
+    #ifndef LV_LINUX_FBDEV_PAN_FLIP
+        #ifdef CONFIG_LV_LINUX_FBDEV_PAN_FLIP
+            #define LV_LINUX_FBDEV_PAN_FLIP CONFIG_LV_LINUX_FBDEV_PAN_FLIP
+        #else
+            #define LV_LINUX_FBDEV_PAN_FLIP      0
+        #endif
+    #endif
 #endif
 
 /*Use Nuttx to open window and handle touchscreen*/
@@ -3059,6 +3246,17 @@
         #define LV_USE_LINUX_DRM        0
     #endif
 #endif
+#if LV_USE_LINUX_DRM
+    /*2: double buffering
+     *3: triple buffering to render the next frame while the previous one is waiting for the page flip*/
+    #ifndef LV_LINUX_DRM_BUFFER_COUNT
+        #ifdef CONFIG_LV_LINUX_DRM_BUFFER_COUNT
+            #define LV_LINUX_DRM_BUFFER_COUNT CONFIG_LV_LINUX_DRM_BUFFER_COUNT
+        #else
+            #define LV_LINUX_DRM_BUFFER_COUNT   2
+        #endif
+    #endif
+#endif
 
 /*Interface for TFT_eSPI*/
 #ifndef LV_USE_TFT_ESPI
@@ -24,6 +24,7 @@
 #include "draw/lv_draw.h"
 #include "misc/lv_async.h"
 #include "misc/lv_fs.h"
+#include "others/observer/lv_observer.h"
 #if LV_USE_DRAW_VGLITE
     #include "draw/nxp/vglite/lv_draw_vglite.h"
 #endif
@@ -148,6 +149,10 @@ void lv_init(void)
 
     lv_mem_init();
 
+#if LV_USE_MEM_TRACK
+    lv_mem_track_init();
+#endif
+
     _lv_draw_buf_init_handlers();
 
 #if LV_USE_SPAN != 0
@@ -162,6 +167,8 @@ void lv_init(void)
 
     _lv_timer_core_init();
 
+    _lv_async_init();
+
     _lv_fs_init();
 
     _lv_layout_init();
@@ -401,6 +408,12 @@ void lv_deinit(void)
 
     _lv_fs_deinit();
 
+    _lv_async_deinit();
+
+#if LV_USE_OBSERVER
+    _lv_subject_deferred_deinit();
+#endif
+
     _lv_timer_core_deinit();
 
 #if LV_USE_PROFILER && LV_USE_PROFILER_BUILTIN
@@ -411,6 +424,10 @@ void lv_deinit(void)
     lv_objid_builtin_destroy();
 #endif
 
+#if LV_USE_MEM_TRACK
+    lv_mem_track_deinit();
+#endif
+
     lv_mem_deinit();
 
     lv_initialized = false;
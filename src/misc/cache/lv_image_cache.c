@@ -97,6 +97,36 @@ bool lv_image_cache_is_enabled(void)
     return lv_cache_is_enabled(img_cache_p);
 }
 
+lv_result_t lv_image_cache_add_mipmap(lv_cache_entry_t * entry, lv_draw_buf_t * decoded, uint32_t level_x,
+                                      uint32_t level_y)
+{
+    LV_ASSERT_NULL(entry);
+    LV_ASSERT_NULL(decoded);
+
+    lv_image_cache_mipmap_t * mipmap = lv_malloc(sizeof(lv_image_cache_mipmap_t));
+    LV_ASSERT_MALLOC(mipmap);
+    if(mipmap == NULL) return LV_RESULT_INVALID;
+
+    mipmap->decoded = decoded;
+    mipmap->level_x = level_x;
+    mipmap->level_y = level_y;
+
+    lv_cache_t * cache = (lv_cache_t *)lv_cache_entry_get_cache(entry);
+    lv_image_cache_data_t * data = lv_cache_entry_get_data(entry);
+
+    lv_mutex_lock(&cache->lock);
+    mipmap->next = data->mipmaps;
+    data->mipmaps = mipmap;
+
+    /*The size of the entry is subtracted from the cache's size when it's removed.
+     *If it's already removed (but still used) only the entry needs to be updated.*/
+    data->slot.size += decoded->data_size;
+    if(!lv_cache_entry_is_invalid(entry)) cache->size += decoded->data_size;
+    lv_mutex_unlock(&cache->lock);
+
+    return LV_RESULT_OK;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -130,12 +160,25 @@ static lv_cache_compare_res_t image_cache_compare_cb(
 
 static void image_cache_free_cb(lv_image_cache_data_t * entry, void * user_data)
 {
-    LV_UNUSED(user_data);
+    /* Let the decoder free the decoded image or destroy the decoded draw buffer if necessary. */
+    const lv_image_decoder_t * decoder = entry->decoder;
+    if(decoder && decoder->cache_free_cb) {
+        decoder->cache_free_cb(entry, user_data);
+    }
+    else {
+        lv_draw_buf_t * decoded = (lv_draw_buf_t *)entry->decoded;
+        if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) {
+            lv_draw_buf_destroy(decoded);
+        }
+    }
 
-    /* Destroy the decoded draw buffer if necessary. */
-    lv_draw_buf_t * decoded = (lv_draw_buf_t *)entry->decoded;
-    if(lv_draw_buf_has_flag(decoded, LV_IMAGE_FLAGS_ALLOCATED)) {
-        lv_draw_buf_destroy(decoded);
+    /*Destroy the downscaled copies too*/
+    lv_image_cache_mipmap_t * mipmap = entry->mipmaps;
+    while(mipmap) {
+        lv_image_cache_mipmap_t * next = mipmap->next;
+        lv_draw_buf_destroy(mipmap->decoded);
+        lv_free(mipmap);
+        mipmap = next;
     }
 
     /*Free the duplicated file name*/
@@ -16,6 +16,8 @@ extern "C" {
 
 #include "../../lv_conf_internal.h"
 #include "../lv_types.h"
+#include "../../draw/lv_draw_buf.h"
+#include "lv_cache_entry.h"
 
 /*********************
  *      DEFINES
@@ -56,6 +58,18 @@ void lv_image_cache_drop(const void * src);
  */
 bool lv_image_cache_is_enabled(void);
 
+/**
+ * Attach a downscaled copy of a cached image to its cache entry.
+ * The copy is freed together with the entry and its size is counted in the size of the entry.
+ * @param entry     the cache entry of the image, e.g. `cache_entry` of a decoder descriptor
+ * @param decoded   the downscaled image. The cache takes its ownership if the function succeeds.
+ * @param level_x   the width of the image was downscaled by 2^level_x
+ * @param level_y   the height of the image was downscaled by 2^level_y
+ * @return          LV_RESULT_OK: attached; LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_image_cache_add_mipmap(lv_cache_entry_t * entry, lv_draw_buf_t * decoded, uint32_t level_x,
+                                      uint32_t level_y);
+
 /*************************
  *    GLOBAL VARIABLES
  *************************/
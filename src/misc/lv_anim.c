@@ -21,8 +21,9 @@
  *********************/
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
+#define ANIM_ARRAY_SIZE_MIN 8
+#define ANIM_HASH_SIZE_MIN  16
 #define state LV_GLOBAL_DEFAULT()->anim_state
-#define anim_ll_p &(state.anim_ll)
 
 /**********************
  *      TYPEDEFS
@@ -33,6 +34,12 @@
  **********************/
 static void anim_timer(lv_timer_t * param);
 static void anim_mark_list_change(void);
+static bool anim_add(lv_anim_t * a);
+static void anim_delete(lv_anim_t * a);
+static void anim_remove(lv_anim_t * a);
+static void anims_compact(void);
+static bool hash_resize(uint32_t new_size);
+static uint32_t hash_var(const void * var);
 static void anim_completed_handler(lv_anim_t * a);
 static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1,
                                          int32_t y1, int32_t x2, int32_t y2);
@@ -59,16 +66,22 @@ static bool remove_concurrent_anims(lv_anim_t * a_current);
 
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(anim_ll_p, sizeof(lv_anim_t));
     state.timer = lv_timer_create(anim_timer, LV_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    state.anim_list_changed = false;
-    state.anim_run_round = false;
 }
 
 void _lv_anim_core_deinit(void)
 {
     lv_anim_delete_all();
+
+    lv_free(state.anims);
+    lv_free(state.hash);
+    state.anims = NULL;
+    state.hash = NULL;
+    state.anim_cnt = 0;
+    state.anim_size = 0;
+    state.deleted_cnt = 0;
+    state.hash_size = 0;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -86,17 +99,21 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
 {
     LV_TRACE_ANIM("begin");
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(anim_ll_p);
+    lv_anim_t * new_anim = lv_malloc(sizeof(lv_anim_t));
     LV_ASSERT_MALLOC(new_anim);
     if(new_anim == NULL) return NULL;
 
     /*Initialize the animation descriptor*/
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
     if(a->var == a) new_anim->var = new_anim;
-    new_anim->run_round = state.anim_run_round;
     new_anim->last_timer_run = lv_tick_get();
 
+    /*Add the new animation to the running animations*/
+    if(!anim_add(new_anim)) {
+        lv_free(new_anim);
+        return NULL;
+    }
+
     /*Set the start value*/
     if(new_anim->early_apply) {
         if(new_anim->get_value_cb) {
@@ -119,8 +136,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         }
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*Resume the animation timer if it was paused*/
     anim_mark_list_change();
 
     LV_TRACE_ANIM("finished");
@@ -143,24 +159,41 @@ uint32_t lv_anim_get_playtime(const lv_anim_t * a)
 
 bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
     bool del_any = false;
-    a        = _lv_ll_get_head(anim_ll_p);
+
+    if(var == NULL) {
+        /*Any variable can match so scan all the animations from the newest*/
+        state.scan_cnt++;
+        uint32_t i = state.anim_cnt;
+        while(i > 0) {
+            i--;
+            lv_anim_t * a = state.anims[i];
+            if(a && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+                anim_delete(a);
+                del_any = true;
+            }
+        }
+        state.scan_cnt--;
+        if(state.scan_cnt == 0 && state.deleted_cnt * 2 > state.anim_cnt) anims_compact();
+
+        return del_any;
+    }
+
+    if(state.hash_size == 0) return false;
+
+    lv_anim_t * a = state.hash[hash_var(var)];
     while(a != NULL) {
-        bool del = false;
-        if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(anim_ll_p, a);
-            if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
+        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
+            anim_delete(a);
             del_any = true;
-            del = true;
-        }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? _lv_ll_get_head(anim_ll_p) : _lv_ll_get_next(anim_ll_p, a);
+            /*Start from the head of the bucket again, because we don't know
+             *how the animations were changed in `a->deleted_cb` */
+            a = state.hash[hash_var(var)];
+        }
+        else {
+            a = a->_hash_next;
+        }
     }
 
     return del_any;
@@ -168,17 +201,36 @@ bool lv_anim_delete(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_delete_all(void)
 {
-    _lv_ll_clear(anim_ll_p);
+    uint32_t i;
+    for(i = 0; i < state.anim_cnt; i++) {
+        if(state.anims[i]) lv_free(state.anims[i]);
+    }
+
+    if(state.scan_cnt > 0) {
+        /*Keep the indices for the ongoing scan*/
+        lv_memzero(state.anims, state.anim_cnt * sizeof(lv_anim_t *));
+        state.deleted_cnt = state.anim_cnt;
+    }
+    else {
+        state.anim_cnt = 0;
+        state.deleted_cnt = 0;
+    }
+
+    if(state.hash) lv_memzero(state.hash, state.hash_size * sizeof(lv_anim_t *));
+
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(anim_ll_p, a) {
+    if(state.hash_size == 0) return NULL;
+
+    lv_anim_t * a = state.hash[hash_var(var)];
+    while(a != NULL) {
         if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
             return a;
         }
+        a = a->_hash_next;
     }
 
     return NULL;
@@ -191,11 +243,7 @@ lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(anim_ll_p, a) cnt++;
-
-    return cnt;
+    return (uint16_t)(state.anim_cnt - state.deleted_cnt);
 }
 
 uint32_t lv_anim_speed_clamped(uint32_t speed, uint32_t min_time, uint32_t max_time)
@@ -347,72 +395,61 @@ static void anim_timer(lv_timer_t * param)
 {
     LV_UNUSED(param);
 
-    /*Flip the run round*/
-    state.anim_run_round = state.anim_run_round ? false : true;
+    uint32_t tick = lv_tick_get();
 
-    lv_anim_t * a = _lv_ll_get_head(anim_ll_p);
+    /*Step the animations from the newest. The animations started meanwhile are added to the end
+     *and run first in the next round. The deleted ones leave a NULL slot, so the indices are stable.*/
+    state.scan_cnt++;
+    uint32_t i = state.anim_cnt;
+    while(i > 0) {
+        i--;
+        lv_anim_t * a = state.anims[i];
+        if(a == NULL) continue;
 
-    while(a != NULL) {
-        uint32_t elaps = lv_tick_elaps(a->last_timer_run);
-        a->act_time += elaps;
+        a->act_time += tick - a->last_timer_run;
+        a->last_timer_run = tick;
 
-        a->last_timer_run = lv_tick_get();
+        /*The animation will run now for the first time. Call `start_cb`*/
+        if(!a->start_cb_called && a->act_time >= 0) {
 
-        /*It can be set by `lv_anim_delete()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_completed_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        state.anim_list_changed = false;
+            if(a->early_apply == 0 && a->get_value_cb) {
+                int32_t v_ofs = a->get_value_cb(a);
+                a->start_value += v_ofs;
+                a->end_value += v_ofs;
+            }
 
-        if(a->run_round != state.anim_run_round) {
-            a->run_round = state.anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+            resolve_time(a);
 
-            /*The animation will run now for the first time. Call `start_cb`*/
-            if(!a->start_cb_called && a->act_time >= 0) {
+            if(a->start_cb) a->start_cb(a);
+            a->start_cb_called = 1;
 
-                if(a->early_apply == 0 && a->get_value_cb) {
-                    int32_t v_ofs = a->get_value_cb(a);
-                    a->start_value += v_ofs;
-                    a->end_value += v_ofs;
-                }
+            /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
+            if(state.anims[i] == a) remove_concurrent_anims(a);
+        }
 
-                resolve_time(a);
+        /*The callbacks might delete the animation*/
+        if(state.anims[i] == a && a->act_time >= 0) {
+            if(a->act_time > a->duration) a->act_time = a->duration;
 
-                if(a->start_cb) a->start_cb(a);
-                a->start_cb_called = 1;
+            int32_t new_value;
+            new_value = a->path_cb(a);
 
-                /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
-                remove_concurrent_anims(a);
+            if(new_value != a->current_value) {
+                a->current_value = new_value;
+                /*Apply the calculated value*/
+                if(a->exec_cb) a->exec_cb(a->var, new_value);
+                if(state.anims[i] == a && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
             }
 
-            if(a->act_time >= 0) {
-                if(a->act_time > a->duration) a->act_time = a->duration;
-
-                int32_t new_value;
-                new_value = a->path_cb(a);
-
-                if(new_value != a->current_value) {
-                    a->current_value = new_value;
-                    /*Apply the calculated value*/
-                    if(a->exec_cb) a->exec_cb(a->var, new_value);
-                    if(!state.anim_list_changed && a->custom_exec_cb) a->custom_exec_cb(a, new_value);
-                }
-
-                /*If the time is elapsed the animation is ready*/
-                if(!state.anim_list_changed && a->act_time >= a->duration) {
-                    anim_completed_handler(a);
-                }
+            /*If the time is elapsed the animation is ready*/
+            if(state.anims[i] == a && a->act_time >= a->duration) {
+                anim_completed_handler(a);
             }
         }
-
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(state.anim_list_changed)
-            a = _lv_ll_get_head(anim_ll_p);
-        else
-            a = _lv_ll_get_next(anim_ll_p, a);
     }
+    state.scan_cnt--;
 
+    if(state.scan_cnt == 0 && state.deleted_cnt > 0) anims_compact();
 }
 
 /**
@@ -432,10 +469,9 @@ static void anim_completed_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_duration == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Remove the animation from the running animations.
          * This way the `completed_cb` will see the animations like it's animation is already deleted*/
-        _lv_ll_remove(anim_ll_p, a);
-        /*Flag that the list has changed*/
+        anim_remove(a);
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
@@ -467,13 +503,130 @@ static void anim_completed_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    state.anim_list_changed = true;
-    if(_lv_ll_get_head(anim_ll_p) == NULL)
+    if(state.anim_cnt == state.deleted_cnt)
         lv_timer_pause(state.timer);
     else
         lv_timer_resume(state.timer);
 }
 
+/**
+ * Add an animation to the array of the running animations and to the index
+ * @param a     pointer to an allocated animation
+ * @return      true: success; false: out of memory
+ */
+static bool anim_add(lv_anim_t * a)
+{
+    if(state.anim_cnt == state.anim_size) {
+        /*Reuse the slots of the deleted animations if possible*/
+        if(state.scan_cnt == 0 && state.deleted_cnt > 0) anims_compact();
+
+        if(state.anim_cnt == state.anim_size) {
+            uint32_t new_size = LV_MAX(state.anim_size * 2, ANIM_ARRAY_SIZE_MIN);
+            lv_anim_t ** new_anims = lv_realloc(state.anims, new_size * sizeof(lv_anim_t *));
+            LV_ASSERT_MALLOC(new_anims);
+            if(new_anims == NULL) return false;
+            state.anims = new_anims;
+            state.anim_size = new_size;
+        }
+    }
+
+    /*Keep the average length of the buckets below 1*/
+    uint32_t running_cnt = state.anim_cnt - state.deleted_cnt + 1;
+    if(running_cnt > state.hash_size) {
+        if(!hash_resize(LV_MAX(state.hash_size * 2, ANIM_HASH_SIZE_MIN)) && state.hash_size == 0) return false;
+    }
+
+    a->_index = state.anim_cnt;
+    state.anims[state.anim_cnt] = a;
+    state.anim_cnt++;
+
+    /*Add to the head of the bucket so the newest animations are found first*/
+    uint32_t h = hash_var(a->var);
+    a->_hash_next = state.hash[h];
+    state.hash[h] = a;
+
+    return true;
+}
+
+/**
+ * Remove an animation, call its `deleted_cb` and free it
+ * @param a     pointer to a running animation
+ */
+static void anim_delete(lv_anim_t * a)
+{
+    anim_remove(a);
+    if(a->deleted_cb != NULL) a->deleted_cb(a);
+    lv_free(a);
+    anim_mark_list_change();
+}
+
+/**
+ * Remove an animation from the running animations and from the index without freeing it
+ * @param a     pointer to a running animation
+ */
+static void anim_remove(lv_anim_t * a)
+{
+    state.anims[a->_index] = NULL;
+    state.deleted_cnt++;
+
+    lv_anim_t ** prev_next = &state.hash[hash_var(a->var)];
+    while(*prev_next != a) prev_next = &(*prev_next)->_hash_next;
+    *prev_next = a->_hash_next;
+}
+
+/**
+ * Remove the NULL slots of the deleted animations from `anims`
+ */
+static void anims_compact(void)
+{
+    uint32_t i;
+    uint32_t j = 0;
+    for(i = 0; i < state.anim_cnt; i++) {
+        lv_anim_t * a = state.anims[i];
+        if(a == NULL) continue;
+
+        a->_index = j;
+        state.anims[j] = a;
+        j++;
+    }
+
+    state.anim_cnt = j;
+    state.deleted_cnt = 0;
+}
+
+static bool hash_resize(uint32_t new_size)
+{
+    lv_anim_t ** new_hash = lv_malloc_zeroed(new_size * sizeof(lv_anim_t *));
+    LV_ASSERT_MALLOC(new_hash);
+    if(new_hash == NULL) return false;
+
+    lv_free(state.hash);
+    state.hash = new_hash;
+    state.hash_size = new_size;
+
+    /*Add the animations from the oldest to have the newest at the head of the buckets*/
+    uint32_t i;
+    for(i = 0; i < state.anim_cnt; i++) {
+        lv_anim_t * a = state.anims[i];
+        if(a == NULL) continue;
+
+        uint32_t h = hash_var(a->var);
+        a->_hash_next = state.hash[h];
+        state.hash[h] = a;
+    }
+
+    return true;
+}
+
+static uint32_t hash_var(const void * var)
+{
+    uint32_t h = (uint32_t)((lv_uintptr_t)var >> 3);
+    h ^= h >> 16;
+    h *= 0x45d9f3b;
+    h ^= h >> 16;
+    return h & (state.hash_size - 1);
+}
+
 static int32_t lv_anim_path_cubic_bezier(const lv_anim_t * a, int32_t x1, int32_t y1, int32_t x2, int32_t y2)
 {
     /*Calculate the current step*/
@@ -520,11 +673,9 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
 {
     if(a_current->exec_cb == NULL && a_current->custom_exec_cb == NULL) return false;
 
-    lv_anim_t * a;
     bool del_any = false;
-    a = _lv_ll_get_head(anim_ll_p);
+    lv_anim_t * a = state.hash[hash_var(a_current->var)];
     while(a != NULL) {
-        bool del = false;
         /*We can't test for custom_exec_cb equality because in the MicroPython binding
          *a wrapper callback is used here an the real callback data is stored in the `user_data`.
          *Therefore equality check would remove all animations.*/
@@ -533,19 +684,16 @@ static bool remove_concurrent_anims(lv_anim_t * a_current)
            (a->var == a_current->var) &&
            ((a->exec_cb && a->exec_cb == a_current->exec_cb)
             /*|| (a->custom_exec_cb && a->custom_exec_cb == a_current->custom_exec_cb)*/)) {
-            _lv_ll_remove(anim_ll_p, a);
-            if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_free(a);
-            /*Read by `anim_timer`. It need to know if a delete occurred in the linked list*/
-            anim_mark_list_change();
-
+            anim_delete(a);
             del_any = true;
-            del = true;
-        }
 
-        /*Always start from the head on delete, because we don't know
-         *how `anim_ll_p` was changes in `a->deleted_cb` */
-        a = del ? _lv_ll_get_head(anim_ll_p) : _lv_ll_get_next(anim_ll_p, a);
+            /*Start from the head of the bucket again, because we don't know
+             *how the animations were changed in `a->deleted_cb` */
+            a = state.hash[hash_var(a_current->var)];
+        }
+        else {
+            a = a->_hash_next;
+        }
     }
 
     return del_any;
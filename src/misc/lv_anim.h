@@ -86,10 +86,19 @@ typedef enum {
 } lv_anim_enable_t;
 
 typedef struct {
-    bool anim_list_changed;
-    bool anim_run_round;
     lv_timer_t * timer;
-    lv_ll_t anim_ll;
+
+    /*The running animations in the order they were started.
+     *The slots of the deleted animations are NULL until the array is compacted.*/
+    struct _lv_anim_t ** anims;
+    uint32_t anim_cnt;      /*Number of used slots in `anims`*/
+    uint32_t anim_size;     /*Size of `anims`*/
+    uint32_t deleted_cnt;   /*Number of NULL slots in `anims`*/
+    uint32_t scan_cnt;      /*`anims` can't be compacted while it's being scanned*/
+
+    /*Index of the running animations by `var`. Each bucket is a linked list of animations*/
+    struct _lv_anim_t ** hash;
+    uint32_t hash_size;     /*Always a power of 2*/
 } lv_anim_state_t;
 
 /** Get the current value during an animation*/
@@ -153,8 +162,9 @@ struct _lv_anim_t {
 
     /*Animation system use these - user shouldn't set*/
     uint32_t last_timer_run;
+    struct _lv_anim_t * _hash_next;  /**< Next animation in the same bucket of the index*/
+    uint32_t _index;                /**< Position among the running animations*/
     uint8_t playback_now : 1; /**< Play back is in progress*/
-    uint8_t run_round : 1;    /**< Indicates the animation has run in this round*/
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
     uint8_t early_apply  : 1;    /**< 1: Apply start value immediately even is there is `delay`*/
 };
@@ -509,6 +509,62 @@ void lv_point_array_transform(lv_point_t * points, size_t count, int32_t angle,
     }
 }
 
+void lv_point_array_skew(lv_point_t * points, size_t count, int32_t skew_x, int32_t skew_y, const lv_point_t * pivot,
+                         bool inverse)
+{
+    if(skew_x == 0 && skew_y == 0) return;
+
+    int64_t tan_x = _lv_skew_get_tan(skew_x);
+    int64_t tan_y = _lv_skew_get_tan(skew_y);
+
+    /*The determinant of the skew matrix. If it's ~0 everything is skewed onto a line
+     *so the inverse is huge. Limit it to keep the coordinates in range.*/
+    int64_t det = 65536 - ((tan_x * tan_y) >> 16);
+    if(det >= 0 && det < 256) det = 256;
+    else if(det < 0 && det > -256) det = -256;
+
+    uint32_t i;
+    for(i = 0; i < count; i++) {
+        int64_t x = points[i].x - pivot->x;
+        int64_t y = points[i].y - pivot->y;
+        int64_t x_new;
+        int64_t y_new;
+        if(inverse) {
+            x_new = (x * 65536 - tan_x * y) / det;
+            y_new = (y * 65536 - tan_y * x) / det;
+        }
+        else {
+            x_new = x + ((tan_x * y + 32768) >> 16);
+            y_new = y + ((tan_y * x + 32768) >> 16);
+        }
+
+        points[i].x = (int32_t)LV_CLAMP(LV_COORD_MIN, x_new + pivot->x, LV_COORD_MAX);
+        points[i].y = (int32_t)LV_CLAMP(LV_COORD_MIN, y_new + pivot->y, LV_COORD_MAX);
+    }
+}
+
+int32_t _lv_skew_get_tan(int32_t skew)
+{
+    /*tan() repeats in every 180°, so map the angle to -90°..90°*/
+    skew = skew % 1800;
+    if(skew > 900) skew -= 1800;
+    else if(skew < -900) skew += 1800;
+
+    bool neg = skew < 0;
+    if(neg) skew = -skew;
+    if(skew == 900) skew = 899;
+
+    int32_t angle_low = skew / 10;
+    int32_t angle_high = angle_low + 1;
+    int32_t angle_rem = skew - (angle_low * 10);
+
+    int32_t sinma = (lv_trigo_sin(angle_low) * (10 - angle_rem) + lv_trigo_sin(angle_high) * angle_rem) / 10;
+    int32_t cosma = (lv_trigo_cos(angle_low) * (10 - angle_rem) + lv_trigo_cos(angle_high) * angle_rem) / 10;
+
+    int32_t tan = (int32_t)(((int64_t)sinma << 16) / cosma);
+    return neg ? -tan : tan;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -281,6 +281,26 @@ void lv_point_array_transform(lv_point_t * points, size_t count, int32_t angle,
                               const lv_point_t * pivot,
                               bool zoom_first);
 
+/**
+ * Skew an array of points around a pivot point
+ * (x' = x + tan(skew_x) * y; y' = tan(skew_y) * x + y)
+ * @param points        pointer to an array of points
+ * @param count         number of points in the array
+ * @param skew_x        horizontal skew with 0.1 degree resolution (123 means 12.3°)
+ * @param skew_y        vertical skew with 0.1 degree resolution (123 means 12.3°)
+ * @param pivot         pointer to the pivot point of the skew
+ * @param inverse       true: apply the inverse of the skew
+ */
+void lv_point_array_skew(lv_point_t * points, size_t count, int32_t skew_x, int32_t skew_y, const lv_point_t * pivot,
+                         bool inverse);
+
+/**
+ * Get the tangent of a skew angle
+ * @param skew          skew with 0.1 degree resolution. ±90° is limited to ±89.9°
+ * @return              tan(skew) in 1/65536 units
+ */
+int32_t _lv_skew_get_tan(int32_t skew);
+
 static inline lv_point_t lv_point_from_precise(const lv_point_precise_t * p)
 {
     lv_point_t point = {
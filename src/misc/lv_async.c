@@ -9,26 +9,33 @@
 
 #include "lv_async.h"
 #include "lv_timer.h"
+#include "../core/lv_global.h"
+#include "../osal/lv_os.h"
 #include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
 
 /*********************
  *      DEFINES
  *********************/
+#define state LV_GLOBAL_DEFAULT()->async_state
+
+#define CALLS_SIZE_MIN  8
+#define SLOT_MASK       (LV_ASYNC_QUEUE_SIZE - 1)
+
+#if LV_ASYNC_QUEUE_SIZE < 2 || (LV_ASYNC_QUEUE_SIZE & (LV_ASYNC_QUEUE_SIZE - 1)) != 0
+    #error "LV_ASYNC_QUEUE_SIZE must be a power of 2"
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
-typedef struct _lv_async_info_t {
-    lv_async_cb_t cb;
-    void * user_data;
-} lv_async_info_t;
-
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
-static void lv_async_timer_cb(lv_timer_t * timer);
+static bool calls_reserve(void);
+static bool slot_is_ready(const lv_async_slot_t * slot, uint32_t pos);
 
 /**********************
  *  STATIC VARIABLES
@@ -42,67 +49,169 @@ static void lv_async_timer_cb(lv_timer_t * timer);
  *   GLOBAL FUNCTIONS
  **********************/
 
+void _lv_async_init(void)
+{
+    lv_memzero(&state, sizeof(state));
+
+    uint32_t i;
+    for(i = 0; i < LV_ASYNC_QUEUE_SIZE; i++) {
+        state.slots[i].seq = i;
+    }
+}
+
+void _lv_async_deinit(void)
+{
+    lv_free(state.calls);
+    state.calls = NULL;
+    state.calls_size = 0;
+    state.calls_head = 0;
+    state.calls_cnt = 0;
+}
+
 lv_result_t lv_async_call(lv_async_cb_t async_xcb, void * user_data)
 {
-    /*Allocate an info structure*/
-    lv_async_info_t * info = lv_malloc(sizeof(lv_async_info_t));
+    if(!calls_reserve()) return LV_RESULT_INVALID;
 
-    if(info == NULL)
-        return LV_RESULT_INVALID;
+    lv_async_call_t * call = &state.calls[(state.calls_head + state.calls_cnt) % state.calls_size];
+    call->cb = async_xcb;
+    call->user_data = user_data;
+    state.calls_cnt++;
 
-    /*Create a new timer*/
-    lv_timer_t * timer = lv_timer_create(lv_async_timer_cb, 0, info);
+    _lv_timer_handler_resume();
+    return LV_RESULT_OK;
+}
 
-    if(timer == NULL) {
-        lv_free(info);
-        return LV_RESULT_INVALID;
+lv_result_t lv_async_call_from_thread(lv_async_cb_t async_xcb, void * user_data)
+{
+    /*Reserve a slot. If an other thread was faster try again with the next position.*/
+    uint32_t pos = lv_atomic_load(&state.enqueue_pos);
+    lv_async_slot_t * slot;
+    while(1) {
+        slot = &state.slots[pos & SLOT_MASK];
+        int32_t dif = (int32_t)(lv_atomic_load(&slot->seq) - pos);
+        if(dif == 0) {
+            if(lv_atomic_cas(&state.enqueue_pos, &pos, pos + 1)) break;
+        }
+        else if(dif < 0) {
+            /*The slot still has a call from the previous round which wasn't run yet*/
+            return LV_RESULT_INVALID;
+        }
+        else {
+            pos = lv_atomic_load(&state.enqueue_pos);
+        }
     }
 
-    info->cb = async_xcb;
-    info->user_data = user_data;
+    slot->call.cb = async_xcb;
+    slot->call.user_data = user_data;
+
+    /*Publish the call. The LVGL thread doesn't read the slot until `seq` is set.*/
+    lv_atomic_store(&slot->seq, pos + 1);
 
-    lv_timer_set_repeat_count(timer, 1);
+    _lv_timer_handler_resume();
     return LV_RESULT_OK;
 }
 
 lv_result_t lv_async_call_cancel(lv_async_cb_t async_xcb, void * user_data)
 {
-    lv_timer_t * timer = lv_timer_get_next(NULL);
     lv_result_t res = LV_RESULT_INVALID;
 
-    while(timer != NULL) {
-        /*Find the next timer node*/
-        lv_timer_t * timer_next = lv_timer_get_next(timer);
-
-        /*Find async timer callback*/
-        if(timer->timer_cb == lv_async_timer_cb) {
-            lv_async_info_t * info = (lv_async_info_t *)timer->user_data;
-
-            /*Match user function callback and user data*/
-            if(info->cb == async_xcb && info->user_data == user_data) {
-                lv_timer_delete(timer);
-                lv_free(info);
-                res = LV_RESULT_OK;
-            }
+    /*Just clear the callback. The queue entries are freed when they are reached.*/
+    uint32_t i;
+    for(i = 0; i < state.calls_cnt; i++) {
+        lv_async_call_t * call = &state.calls[(state.calls_head + i) % state.calls_size];
+        if(call->cb == async_xcb && call->user_data == user_data) {
+            call->cb = NULL;
+            res = LV_RESULT_OK;
         }
+    }
 
-        timer = timer_next;
+    /*The calls from other threads are also read only in the LVGL thread, so the published ones can be cleared*/
+    uint32_t pos;
+    for(pos = state.dequeue_pos; slot_is_ready(&state.slots[pos & SLOT_MASK], pos); pos++) {
+        lv_async_call_t * call = &state.slots[pos & SLOT_MASK].call;
+        if(call->cb == async_xcb && call->user_data == user_data) {
+            call->cb = NULL;
+            res = LV_RESULT_OK;
+        }
     }
 
     return res;
 }
 
+void _lv_async_run(void)
+{
+    /*Run only the calls queued so far. The calls queued by the callbacks will run in the next round.*/
+    uint32_t cnt = state.calls_cnt;
+    while(cnt > 0 && state.calls_cnt > 0) {
+        /*Remove the call first as the callback might add new calls and reallocate the buffer*/
+        lv_async_call_t call = state.calls[state.calls_head];
+        state.calls_head = (state.calls_head + 1) % state.calls_size;
+        state.calls_cnt--;
+        cnt--;
+
+        if(call.cb) call.cb(call.user_data);
+    }
+
+    uint32_t end = lv_atomic_load(&state.enqueue_pos);
+    while(state.dequeue_pos != end) {
+        uint32_t pos = state.dequeue_pos;
+        lv_async_slot_t * slot = &state.slots[pos & SLOT_MASK];
+
+        /*Reserved by an other thread but not published yet*/
+        if(!slot_is_ready(slot, pos)) break;
+
+        lv_async_call_t call = slot->call;
+        state.dequeue_pos++;
+
+        /*Release the slot for the next round*/
+        lv_atomic_store(&slot->seq, pos + LV_ASYNC_QUEUE_SIZE);
+
+        if(call.cb) call.cb(call.user_data);
+    }
+}
+
+bool _lv_async_is_pending(void)
+{
+    return state.calls_cnt > 0 || slot_is_ready(&state.slots[state.dequeue_pos & SLOT_MASK], state.dequeue_pos);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
-static void lv_async_timer_cb(lv_timer_t * timer)
+/**
+ * Make sure there is space for one more call in the queue of the LVGL thread
+ * @return          true: success; false: out of memory
+ */
+static bool calls_reserve(void)
 {
-    /*Save the info because an lv_async_call_cancel might delete it in the callback*/
-    lv_async_info_t * info = (lv_async_info_t *)timer->user_data;
-    lv_async_info_t info_save = *info;
-    lv_timer_delete(timer);
-    lv_free(info);
+    if(state.calls_cnt < state.calls_size) return true;
+
+    uint32_t new_size = LV_MAX(state.calls_size * 2, CALLS_SIZE_MIN);
+    lv_async_call_t * new_calls = lv_malloc(new_size * sizeof(lv_async_call_t));
+    LV_ASSERT_MALLOC(new_calls);
+    if(new_calls == NULL) return false;
+
+    /*Unwrap the ring buffer*/
+    uint32_t i;
+    for(i = 0; i < state.calls_cnt; i++) {
+        new_calls[i] = state.calls[(state.calls_head + i) % state.calls_size];
+    }
 
-    info_save.cb(info_save.user_data);
+    lv_free(state.calls);
+    state.calls = new_calls;
+    state.calls_size = new_size;
+    state.calls_head = 0;
+    return true;
+}
+
+/**
+ * Check if a call from an other thread is published in a slot
+ * @param slot      pointer to a slot
+ * @param pos       the position the slot should have
+ * @return          true: the slot has a call to run
+ */
+static bool slot_is_ready(const lv_async_slot_t * slot, uint32_t pos)
+{
+    return lv_atomic_load(&slot->seq) == pos + 1;
 }
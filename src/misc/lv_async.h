@@ -29,6 +29,31 @@ extern "C" {
  */
 typedef void (*lv_async_cb_t)(void *);
 
+typedef struct {
+    lv_async_cb_t cb;
+    void * user_data;
+} lv_async_call_t;
+
+typedef struct {
+    volatile uint32_t seq;  /*Position of the call stored in the slot + 1 if it's ready to run*/
+    lv_async_call_t call;
+} lv_async_slot_t;
+
+typedef struct {
+    /*Calls from the LVGL thread in a ring buffer which is grown when it's full*/
+    lv_async_call_t * calls;
+    uint32_t calls_size;
+    uint32_t calls_head;
+    uint32_t calls_cnt;
+
+    /*Calls from other threads in a fixed size lock-free ring buffer.
+     *The producers reserve the slots by incrementing `enqueue_pos` and
+     *publish them by setting `seq` of the slot.*/
+    lv_async_slot_t slots[LV_ASYNC_QUEUE_SIZE];
+    volatile uint32_t enqueue_pos;
+    uint32_t dequeue_pos;
+} lv_async_state_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -36,6 +61,7 @@ typedef void (*lv_async_cb_t)(void *);
 /**
  * Call an asynchronous function the next time lv_timer_handler() is run. This function is likely to return
  * **before** the call actually happens!
+ * Can be called only from the LVGL thread. Use `lv_async_call_from_thread()` in other threads.
  * @param async_xcb a callback which is the task itself.
  *                 (the 'x' in the argument name indicates that it's not a fully generic function because it not follows
  *                  the `func_name(object, callback, ...)` convention)
@@ -43,13 +69,46 @@ typedef void (*lv_async_cb_t)(void *);
  */
 lv_result_t lv_async_call(lv_async_cb_t async_xcb, void * user_data);
 
+/**
+ * Call an asynchronous function in the next lv_timer_handler() from an other thread or an interrupt.
+ * It doesn't allocate memory and doesn't need the LVGL lock.
+ * @param async_xcb a callback which is the task itself
+ * @param user_data custom parameter
+ * @return          LV_RESULT_OK: the call is queued;
+ *                  LV_RESULT_INVALID: the queue is full (see `LV_ASYNC_QUEUE_SIZE`)
+ */
+lv_result_t lv_async_call_from_thread(lv_async_cb_t async_xcb, void * user_data);
+
 /**
  * Cancel an asynchronous function call
  * @param async_xcb a callback which is the task itself.
  * @param user_data custom parameter
+ * @return          LV_RESULT_OK: at least one call was cancelled; LV_RESULT_INVALID: no matching call was found
  */
 lv_result_t lv_async_call_cancel(lv_async_cb_t async_xcb, void * user_data);
 
+/**
+ * Initialize the async call queues
+ */
+void _lv_async_init(void);
+
+/**
+ * Drop the queued async calls and free the queue of the LVGL thread
+ */
+void _lv_async_deinit(void);
+
+/**
+ * Run the async calls queued before this function was called.
+ * Called once in each lv_timer_handler().
+ */
+void _lv_async_run(void);
+
+/**
+ * Check if there are async calls waiting to run
+ * @return          true: there are calls to run
+ */
+bool _lv_async_is_pending(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -73,9 +73,16 @@ static inline lv_color32_t lv_color_mix32(lv_color32_t fg, lv_color32_t bg)
     if(fg.alpha <= LV_OPA_MIN) {
         return bg;
     }
-    bg.red = (uint32_t)((uint32_t)fg.red * fg.alpha + (uint32_t)bg.red * (255 - fg.alpha)) >> 8;
-    bg.green = (uint32_t)((uint32_t)fg.green * fg.alpha + (uint32_t)bg.green * (255 - fg.alpha)) >> 8;
-    bg.blue = (uint32_t)((uint32_t)fg.blue * fg.alpha + (uint32_t)bg.blue * (255 - fg.alpha)) >> 8;
+    /*Mix red and blue with the same multiplications. 255 * 255 fits into 16 bit
+     *so the channels can't overflow into each other.*/
+    uint32_t mix = fg.alpha;
+    uint32_t mix_inv = 255 - fg.alpha;
+    uint32_t fg_rb = ((uint32_t)fg.red << 16) | fg.blue;
+    uint32_t bg_rb = ((uint32_t)bg.red << 16) | bg.blue;
+    uint32_t rb = (fg_rb * mix + bg_rb * mix_inv) >> 8;
+    bg.red = (uint8_t)(rb >> 16);
+    bg.green = (uint8_t)(((uint32_t)fg.green * mix + (uint32_t)bg.green * mix_inv) >> 8);
+    bg.blue = (uint8_t)rb;
     return bg;
 }
 
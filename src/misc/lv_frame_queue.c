@@ -0,0 +1,269 @@
+/**
+ * @file lv_frame_queue.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_frame_queue.h"
+#if LV_USE_OS
+
+#include "lv_assert.h"
+#include "lv_log.h"
+#include "../stdlib/lv_mem.h"
+#include "../stdlib/lv_string.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*`lv_thread_delete()` joins the thread only with pthread, the others kill it at once.
+ *With them the thread must not return (and delete itself) before it's deleted.*/
+#if LV_USE_OS == LV_OS_PTHREAD || LV_USE_OS == LV_OS_CUSTOM
+    #define THREAD_DELETE_JOINS 1
+#else
+    #define THREAD_DELETE_JOINS 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static void decode_thread_cb(void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_result_t lv_frame_queue_init(lv_frame_queue_t * queue, uint32_t ahead_cnt, uint32_t buf_size,
+                                lv_frame_queue_decode_cb_t decode_cb, void * user_data)
+{
+    LV_ASSERT_NULL(queue);
+    lv_memzero(queue, sizeof(lv_frame_queue_t));
+
+    queue->buf_cnt = ahead_cnt + 1;
+    queue->buf_size = buf_size;
+    queue->bufs = lv_malloc_zeroed(queue->buf_cnt * sizeof(uint8_t *));
+    queue->delays = lv_malloc_zeroed(queue->buf_cnt * sizeof(uint32_t));
+    LV_ASSERT_MALLOC(queue->bufs);
+    LV_ASSERT_MALLOC(queue->delays);
+    if(queue->bufs == NULL || queue->delays == NULL) {
+        lv_free(queue->bufs);
+        lv_free(queue->delays);
+        queue->bufs = NULL;
+        return LV_RESULT_INVALID;
+    }
+
+    uint32_t i;
+    for(i = 0; i < queue->buf_cnt; i++) {
+        queue->bufs[i] = lv_malloc(buf_size);
+        LV_ASSERT_MALLOC(queue->bufs[i]);
+        if(queue->bufs[i] == NULL) {
+            while(i > 0) lv_free(queue->bufs[--i]);
+            lv_free(queue->bufs);
+            lv_free(queue->delays);
+            queue->bufs = NULL;
+            return LV_RESULT_INVALID;
+        }
+    }
+
+    /*Shown until the first frame is taken*/
+    lv_memzero(lv_frame_queue_get_shown_buf(queue), buf_size);
+
+    queue->decode_cb = decode_cb;
+    queue->user_data = user_data;
+    lv_mutex_init(&queue->lock);
+    lv_thread_sync_init(&queue->decode_sync);
+    lv_thread_sync_init(&queue->ready_sync);
+
+    return LV_RESULT_OK;
+}
+
+void lv_frame_queue_deinit(lv_frame_queue_t * queue)
+{
+    if(queue->bufs == NULL) return;
+
+    lv_frame_queue_stop(queue);
+
+    uint32_t i;
+    for(i = 0; i < queue->buf_cnt; i++) {
+        lv_free(queue->bufs[i]);
+    }
+    lv_free(queue->bufs);
+    lv_free(queue->delays);
+    queue->bufs = NULL;
+    queue->delays = NULL;
+
+    lv_mutex_delete(&queue->lock);
+    lv_thread_sync_delete(&queue->decode_sync);
+    lv_thread_sync_delete(&queue->ready_sync);
+}
+
+lv_result_t lv_frame_queue_start(lv_frame_queue_t * queue, size_t stack_size)
+{
+    if(queue->bufs == NULL) return LV_RESULT_INVALID;
+    if(queue->running) return LV_RESULT_OK;
+
+    queue->exit = false;
+    queue->exited = false;
+    queue->ended = false;
+    queue->ready_cnt = 0;
+
+    /*Created for each thread as it might be killed while using them*/
+    lv_thread_sync_init(&queue->exit_sync);
+    lv_thread_sync_init(&queue->park_sync);
+
+    lv_result_t res = lv_thread_init(&queue->thread, LV_THREAD_PRIO_MID, decode_thread_cb, stack_size, queue);
+    if(res != LV_RESULT_OK) {
+        LV_LOG_WARN("Couldn't create the decoder thread");
+        lv_thread_sync_delete(&queue->exit_sync);
+        lv_thread_sync_delete(&queue->park_sync);
+        return res;
+    }
+
+    queue->running = true;
+    return LV_RESULT_OK;
+}
+
+void lv_frame_queue_stop(lv_frame_queue_t * queue)
+{
+    if(!queue->running) return;
+
+    lv_mutex_lock(&queue->lock);
+    queue->exit = true;
+    lv_mutex_unlock(&queue->lock);
+
+    lv_thread_sync_signal(&queue->decode_sync);
+
+    /*Wait until the thread has finished decoding and released the lock. Only after that can it be deleted
+     *safely where `lv_thread_delete()` kills the thread.*/
+    lv_mutex_lock(&queue->lock);
+    while(!queue->exited) {
+        lv_mutex_unlock(&queue->lock);
+        lv_thread_sync_wait(&queue->exit_sync);
+        lv_mutex_lock(&queue->lock);
+    }
+    lv_mutex_unlock(&queue->lock);
+
+    lv_thread_delete(&queue->thread);
+    lv_thread_sync_delete(&queue->exit_sync);
+    lv_thread_sync_delete(&queue->park_sync);
+    queue->running = false;
+
+    /*Keep `read` to not overwrite the shown frame when the decoding is started again*/
+    queue->ready_cnt = 0;
+    queue->ended = false;
+}
+
+lv_result_t lv_frame_queue_pop(lv_frame_queue_t * queue, bool wait, uint8_t ** buf, uint32_t * delay)
+{
+    if(queue->bufs == NULL) return LV_RESULT_INVALID;
+
+    lv_mutex_lock(&queue->lock);
+    while(wait && queue->running && queue->ready_cnt == 0 && !queue->ended) {
+        lv_mutex_unlock(&queue->lock);
+        lv_thread_sync_wait(&queue->ready_sync);
+        lv_mutex_lock(&queue->lock);
+    }
+
+    if(queue->ready_cnt == 0) {
+        lv_mutex_unlock(&queue->lock);
+        return LV_RESULT_INVALID;
+    }
+
+    *buf = queue->bufs[queue->read];
+    if(delay) *delay = queue->delays[queue->read];
+    queue->read = (queue->read + 1) % queue->buf_cnt;
+    queue->ready_cnt--;
+    lv_mutex_unlock(&queue->lock);
+
+    /*The buffer of the previous frame is free now*/
+    lv_thread_sync_signal(&queue->decode_sync);
+
+    return LV_RESULT_OK;
+}
+
+bool lv_frame_queue_is_ended(lv_frame_queue_t * queue)
+{
+    if(queue->bufs == NULL) return true;
+
+    lv_mutex_lock(&queue->lock);
+    bool ended = queue->ended && queue->ready_cnt == 0;
+    lv_mutex_unlock(&queue->lock);
+
+    return ended;
+}
+
+uint8_t * lv_frame_queue_get_shown_buf(lv_frame_queue_t * queue)
+{
+    return queue->bufs[(queue->read + queue->buf_cnt - 1) % queue->buf_cnt];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void decode_thread_cb(void * user_data)
+{
+    lv_frame_queue_t * queue = user_data;
+
+    while(1) {
+        /*Wait for a free buffer. One buffer is always kept for the shown frame.*/
+        lv_mutex_lock(&queue->lock);
+        while(!queue->exit && (queue->ended || queue->ready_cnt >= queue->buf_cnt - 1)) {
+            lv_mutex_unlock(&queue->lock);
+            lv_thread_sync_wait(&queue->decode_sync);
+            lv_mutex_lock(&queue->lock);
+        }
+
+        if(queue->exit) {
+            queue->exited = true;
+            lv_mutex_unlock(&queue->lock);
+            break;
+        }
+
+        /*The LVGL thread doesn't touch this buffer until `ready_cnt` is increased*/
+        uint32_t i = (queue->read + queue->ready_cnt) % queue->buf_cnt;
+        lv_mutex_unlock(&queue->lock);
+
+        uint32_t delay = 0;
+        lv_result_t res = queue->decode_cb(queue, queue->bufs[i], &delay);
+
+        lv_mutex_lock(&queue->lock);
+        if(res == LV_RESULT_OK) {
+            queue->delays[i] = delay;
+            queue->ready_cnt++;
+        }
+        else {
+            queue->ended = true;
+        }
+        lv_mutex_unlock(&queue->lock);
+
+        lv_thread_sync_signal(&queue->ready_sync);
+    }
+
+    LV_LOG_INFO("exit frame decoder thread");
+    lv_thread_sync_signal(&queue->exit_sync);
+
+#if !THREAD_DELETE_JOINS
+    /*Don't hold anything and don't delete itself while `lv_thread_delete()` kills the thread*/
+    while(1) {
+        lv_thread_sync_wait(&queue->park_sync);
+    }
+#endif
+}
+
+#endif /*LV_USE_OS*/
@@ -0,0 +1,143 @@
+/**
+ * @file lv_frame_queue.h
+ *
+ * Decode the frames of an animation in advance on a background thread.
+ * The decoded frames are stored in a ring of buffers from where the LVGL thread can take them when it's time
+ * to show the next frame.
+ */
+
+#ifndef LV_FRAME_QUEUE_H
+#define LV_FRAME_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+
+#include "../lv_conf_internal.h"
+#include "../osal/lv_os.h"
+
+#if LV_USE_OS
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_frame_queue_t;
+typedef struct _lv_frame_queue_t lv_frame_queue_t;
+
+/**
+ * Decode the next frame. Called from the background thread.
+ * @param queue     pointer to the frame queue
+ * @param buf       store the frame here. Its size is the `buf_size` given in `lv_frame_queue_init`.
+ * @param delay     store here how long the frame should be shown [ms]
+ * @return          LV_RESULT_OK: a frame was decoded; LV_RESULT_INVALID: there are no more frames
+ */
+typedef lv_result_t (*lv_frame_queue_decode_cb_t)(lv_frame_queue_t * queue, uint8_t * buf, uint32_t * delay);
+
+struct _lv_frame_queue_t {
+    lv_frame_queue_decode_cb_t decode_cb;
+    void * user_data;
+
+    uint8_t ** bufs;
+    uint32_t * delays;
+    uint32_t buf_cnt;
+    uint32_t buf_size;
+
+    /*The ready frames are `bufs[read]`...`bufs[read + ready_cnt - 1]` and the shown one is `bufs[read - 1]`.
+     *Protected by `lock`.*/
+    uint32_t read;
+    uint32_t ready_cnt;
+    bool ended;                     /*No more frames will be decoded until restart*/
+    bool exit;                      /*Ask the thread to stop*/
+    bool exited;                    /*Set by the thread when it doesn't use the queue anymore*/
+    bool running;
+
+    lv_thread_t thread;
+    lv_mutex_t lock;
+    lv_thread_sync_t decode_sync;   /*Wakes up the thread when a buffer is released*/
+    lv_thread_sync_t ready_sync;    /*Signaled by the thread when a frame is decoded*/
+    lv_thread_sync_t exit_sync;     /*Signaled by the thread when it set `exited`. Created on start.*/
+    lv_thread_sync_t park_sync;     /*Never signaled, the exited thread waits on it until it's deleted.
+                                     *Created on start.*/
+};
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Allocate the buffers of a frame queue. The decoding doesn't start yet.
+ * @param queue         pointer to a frame queue
+ * @param ahead_cnt     number of frames to decode in advance. One more buffer is allocated for the shown frame.
+ * @param buf_size      size of a frame in bytes
+ * @param decode_cb     function to decode the next frame
+ * @param user_data     custom data, available as `queue->user_data`
+ * @return              LV_RESULT_OK: success; LV_RESULT_INVALID: out of memory
+ */
+lv_result_t lv_frame_queue_init(lv_frame_queue_t * queue, uint32_t ahead_cnt, uint32_t buf_size,
+                                lv_frame_queue_decode_cb_t decode_cb, void * user_data);
+
+/**
+ * Stop the thread and free the buffers of a frame queue
+ * @param queue         pointer to a frame queue
+ */
+void lv_frame_queue_deinit(lv_frame_queue_t * queue);
+
+/**
+ * Start decoding the frames on a background thread
+ * @param queue         pointer to a frame queue
+ * @param stack_size    stack size of the thread in bytes
+ * @return              LV_RESULT_OK: success; LV_RESULT_INVALID: the thread couldn't be created
+ */
+lv_result_t lv_frame_queue_start(lv_frame_queue_t * queue, size_t stack_size);
+
+/**
+ * Stop the background thread and drop the frames which are not shown yet.
+ * After it the source of the frames can be modified (e.g. rewound) and the decoding started again.
+ * @param queue         pointer to a frame queue
+ */
+void lv_frame_queue_stop(lv_frame_queue_t * queue);
+
+/**
+ * Take the next decoded frame. The buffer of the previously taken frame can be reused by the thread after it.
+ * @param queue         pointer to a frame queue
+ * @param wait          true: wait until the next frame is decoded; false: return immediately
+ * @param buf           store the buffer of the frame here
+ * @param delay         store how long the frame should be shown [ms]
+ * @return              LV_RESULT_OK: there was a frame; LV_RESULT_INVALID: no ready frame or the animation ended
+ */
+lv_result_t lv_frame_queue_pop(lv_frame_queue_t * queue, bool wait, uint8_t ** buf, uint32_t * delay);
+
+/**
+ * Check if all the frames were decoded and taken
+ * @param queue         pointer to a frame queue
+ * @return              true: there are no more frames
+ */
+bool lv_frame_queue_is_ended(lv_frame_queue_t * queue);
+
+/**
+ * Get the buffer which is shown before the first frame is taken. It's zeroed by `lv_frame_queue_init`.
+ * @param queue         pointer to a frame queue
+ * @return              pointer to the buffer
+ */
+uint8_t * lv_frame_queue_get_shown_buf(lv_frame_queue_t * queue);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OS*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FRAME_QUEUE_H*/
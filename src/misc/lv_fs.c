@@ -13,20 +13,68 @@
 #include "../stdlib/lv_string.h"
 #include "lv_ll.h"
 #include "../core/lv_global.h"
+#if LV_USE_FS_BLOCK_CACHE
+    #include "cache/lv_cache.h"
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 #define fsdrv_ll_p &(LV_GLOBAL_DEFAULT()->fsdrv_ll)
+#if LV_USE_FS_BLOCK_CACHE
+    #define fs_block_cache_p (LV_GLOBAL_DEFAULT()->fs_block_cache)
+    #define fs_block_file_ll_p &(LV_GLOBAL_DEFAULT()->fs_block_file_ll)
+    #define BLOCK_SIZE LV_FS_BLOCK_CACHE_BLOCK_SIZE
+#endif
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_FS_BLOCK_CACHE
+/*A file which has blocks in the cache*/
+typedef struct {
+    lv_fs_drv_t * drv;
+    char * path;
+    uint32_t path_hash;
+    uint32_t block_cnt;     /*Number of cached blocks. The file is removed when it's 0.*/
+    uint32_t max_index;     /*The largest index of the cached blocks*/
+} lv_fs_block_file_t;
+
+typedef struct {
+    /*Key*/
+    lv_fs_drv_t * drv;
+    const char * path;      /*Points to the path of the file in the key, the block uses the path of `file`*/
+    uint32_t path_hash;
+    uint32_t index;
+
+    /*Data*/
+    lv_fs_block_file_t * file;
+    uint8_t * data;
+    uint32_t size;          /*Number of bytes in `data`. Less then `BLOCK_SIZE` only at the end of the file*/
+} lv_fs_block_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+static void close_on_error(lv_fs_file_t * file_p);
+
+static inline bool is_block_cached(const lv_fs_file_t * file_p);
+
+#if LV_USE_FS_BLOCK_CACHE
+static lv_fs_res_t lv_fs_read_blocks(lv_fs_file_t * file_p, char * buf, uint32_t btr, uint32_t * br);
+static void read_ahead(lv_fs_file_t * file_p, uint32_t index);
+static void drop_blocks(lv_fs_file_t * file_p, uint32_t first, uint32_t last);
+static lv_cache_entry_t * block_acquire(lv_fs_file_t * file_p, uint32_t index, bool * created);
+static bool block_create_cb(lv_fs_block_t * block, lv_fs_file_t * file_p);
+static void block_free_cb(lv_fs_block_t * block, void * user_data);
+static lv_cache_compare_res_t block_compare_cb(const lv_fs_block_t * lhs, const lv_fs_block_t * rhs);
+static lv_fs_block_file_t * block_file_find(lv_fs_drv_t * drv, const char * path, uint32_t path_hash);
+static void block_file_release(lv_fs_block_file_t * file);
+static uint32_t path_hash(const char * path);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -43,11 +91,30 @@ static const char * lv_fs_get_real_path(const char * path);
 void _lv_fs_init(void)
 {
     _lv_ll_init(fsdrv_ll_p, sizeof(lv_fs_drv_t *));
+
+#if LV_USE_FS_BLOCK_CACHE
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)block_compare_cb,
+        .create_cb = (lv_cache_create_cb_t)block_create_cb,
+        .free_cb = (lv_cache_free_cb_t)block_free_cb,
+    };
+
+    fs_block_cache_p = lv_cache_create(&lv_cache_class_lru_rb_count, sizeof(lv_fs_block_t),
+                                       LV_FS_BLOCK_CACHE_BLOCK_CNT, ops);
+    lv_cache_set_name(fs_block_cache_p, "FS_BLOCK");
+    _lv_ll_init(fs_block_file_ll_p, sizeof(lv_fs_block_file_t));
+#endif
 }
 
 void _lv_fs_deinit(void)
 {
     _lv_ll_clear(fsdrv_ll_p);
+
+#if LV_USE_FS_BLOCK_CACHE
+    lv_cache_destroy(fs_block_cache_p, NULL);
+    fs_block_cache_p = NULL;
+    _lv_ll_clear(fs_block_file_ll_p);
+#endif
 }
 
 bool lv_fs_is_ready(char letter)
@@ -91,6 +158,11 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
     LV_PROFILER_BEGIN;
 
     file_p->drv = drv;
+    file_p->cache = NULL;
+#if LV_USE_FS_BLOCK_CACHE
+    file_p->block_path = NULL;
+    file_p->block_read = false;
+#endif
 
     /* For memory-mapped files we set the file handle to our file descriptor so that we can access the cache from the file operations */
     if(drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
@@ -106,9 +178,47 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
         file_p->file_d = file_d;
     }
 
-    if(drv->cache_size) {
+#if LV_USE_FS_BLOCK_CACHE
+    /*Read only files use the shared blocks instead of their own buffer. Only the position is stored in `cache`.*/
+    bool block_read = mode == LV_FS_MODE_RD && drv->cache_size != LV_FS_CACHE_FROM_BUFFER && drv->seek_cb &&
+                      lv_cache_get_max_size(fs_block_cache_p, NULL) > 0;
+
+    /*The path is needed to find the blocks of the file when reading or writing it*/
+    if(block_read || ((mode & LV_FS_MODE_WR) && drv->cache_size != LV_FS_CACHE_FROM_BUFFER)) {
+        file_p->block_path = lv_strdup(path);
+        LV_ASSERT_MALLOC(file_p->block_path);
+        file_p->block_path_hash = path_hash(path);
+    }
+
+    /*If the path couldn't be stored the file is read with its own buffer*/
+    if(block_read && file_p->block_path) {
         file_p->cache = lv_malloc_zeroed(sizeof(lv_fs_file_cache_t));
         LV_ASSERT_MALLOC(file_p->cache);
+        if(file_p->cache == NULL) {
+            close_on_error(file_p);
+            LV_PROFILER_END;
+            return LV_FS_RES_OUT_OF_MEM;
+        }
+
+        file_p->cache->start = UINT32_MAX;
+        file_p->cache->end = UINT32_MAX - 1;
+        file_p->block_read = true;
+        file_p->block_next = UINT32_MAX;
+        file_p->drv_position = 0;
+    }
+
+    /*Opening only for writing might truncate the file (e.g. "wb" with stdio)*/
+    if(mode == LV_FS_MODE_WR) drop_blocks(file_p, 0, UINT32_MAX);
+#endif
+
+    if(drv->cache_size && file_p->cache == NULL) {
+        file_p->cache = lv_malloc_zeroed(sizeof(lv_fs_file_cache_t));
+        LV_ASSERT_MALLOC(file_p->cache);
+        if(file_p->cache == NULL) {
+            close_on_error(file_p);
+            LV_PROFILER_END;
+            return LV_FS_RES_OUT_OF_MEM;
+        }
 
         /* If this is a memory-mapped file, then set "cache" to the memory buffer */
         if(drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
@@ -153,7 +263,7 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
-    if(file_p->drv->cache_size && file_p->cache) {
+    if(file_p->cache) {
         /* Only free cache if it was pre-allocated (for memory-mapped files it is never allocated) */
         if(file_p->drv->cache_size != LV_FS_CACHE_FROM_BUFFER && file_p->cache->buffer) {
             lv_free(file_p->cache->buffer);
@@ -162,6 +272,11 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
         lv_free(file_p->cache);
     }
 
+#if LV_USE_FS_BLOCK_CACHE
+    lv_free(file_p->block_path);
+    file_p->block_path = NULL;
+#endif
+
     file_p->file_d = NULL;
     file_p->drv    = NULL;
     file_p->cache  = NULL;
@@ -173,6 +288,10 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
 static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t btr, uint32_t * br)
 {
+#if LV_USE_FS_BLOCK_CACHE
+    if(is_block_cached(file_p)) return lv_fs_read_blocks(file_p, buf, btr, br);
+#endif
+
     LV_PROFILER_BEGIN;
 
     lv_fs_res_t res = LV_FS_RES_OK;
@@ -271,7 +390,7 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     uint32_t br_tmp = 0;
     lv_fs_res_t res;
 
-    if(file_p->drv->cache_size) {
+    if(file_p->cache) {
         res = lv_fs_read_cached(file_p, (char *)buf, btr, &br_tmp);
     }
     else {
@@ -317,6 +436,19 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     if(file_p->drv->cache_size && res == LV_FS_RES_OK)
         file_p->cache->file_position += bw_tmp;
 
+#if LV_USE_FS_BLOCK_CACHE
+    /*The cached blocks of the written range are outdated now. Drop all blocks of the file if the position is unknown.*/
+    if(res == LV_FS_RES_OK && bw_tmp > 0) {
+        uint32_t pos;
+        if(lv_fs_tell(file_p, &pos) == LV_FS_RES_OK && pos >= bw_tmp) {
+            drop_blocks(file_p, (pos - bw_tmp) / BLOCK_SIZE, (pos - 1) / BLOCK_SIZE);
+        }
+        else {
+            drop_blocks(file_p, 0, UINT32_MAX);
+        }
+    }
+#endif
+
     LV_PROFILER_END;
 
     return res;
@@ -335,13 +467,14 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
     LV_PROFILER_BEGIN;
 
     lv_fs_res_t res = LV_FS_RES_OK;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache) {
         switch(whence) {
             case LV_FS_SEEK_SET: {
                     file_p->cache->file_position = pos;
 
-                    /*FS seek if new position is outside cache buffer*/
-                    if(file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end) {
+                    /*FS seek if new position is outside cache buffer. The shared blocks are read from any position.*/
+                    if(!is_block_cached(file_p) &&
+                       (file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end)) {
                         res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
                     }
 
@@ -350,8 +483,9 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
             case LV_FS_SEEK_CUR: {
                     file_p->cache->file_position += pos;
 
-                    /*FS seek if new position is outside cache buffer*/
-                    if(file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end) {
+                    /*FS seek if new position is outside cache buffer. The shared blocks are read from any position.*/
+                    if(!is_block_cached(file_p) &&
+                       (file_p->cache->file_position < file_p->cache->start || file_p->cache->file_position > file_p->cache->end)) {
                         res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, file_p->cache->file_position, LV_FS_SEEK_SET);
                     }
 
@@ -366,6 +500,9 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
 
                         if(res == LV_FS_RES_OK) {
                             file_p->cache->file_position = tmp_position;
+#if LV_USE_FS_BLOCK_CACHE
+                            file_p->drv_position = tmp_position;
+#endif
                         }
                     }
                     break;
@@ -396,7 +533,7 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     LV_PROFILER_BEGIN;
 
     lv_fs_res_t res;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache) {
         *pos = file_p->cache->file_position;
         res = LV_FS_RES_OK;
     }
@@ -409,6 +546,36 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     return res;
 }
 
+const void * lv_fs_map(lv_fs_file_t * file_p, uint32_t pos, uint32_t len)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    if(drv == NULL) return NULL;
+
+    /*The data is already in memory*/
+    if(drv->cache_size == LV_FS_CACHE_FROM_BUFFER) {
+        const lv_fs_file_cache_t * cache = file_p->cache;
+        if(pos > cache->end || len > cache->end - pos) return NULL;
+        return (const uint8_t *)cache->buffer + pos;
+    }
+
+    if(drv->map_cb == NULL) return NULL;
+
+    LV_PROFILER_BEGIN;
+    const void * ptr = drv->map_cb(drv, file_p->file_d, pos, len);
+    LV_PROFILER_END;
+
+    return ptr;
+}
+
+void lv_fs_unmap(lv_fs_file_t * file_p, const void * ptr, uint32_t len)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    if(drv == NULL || ptr == NULL) return;
+    if(drv->cache_size == LV_FS_CACHE_FROM_BUFFER) return;
+
+    if(drv->unmap_cb) drv->unmap_cb(drv, file_p->file_d, ptr, len);
+}
+
 lv_fs_res_t lv_fs_dir_open(lv_fs_dir_t * rddir_p, const char * path)
 {
     if(path == NULL) return LV_FS_RES_INV_PARAM;
@@ -495,6 +662,23 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p)
     return res;
 }
 
+#if LV_USE_FS_BLOCK_CACHE
+
+void lv_fs_block_cache_resize(uint32_t block_cnt)
+{
+    lv_cache_set_max_size(fs_block_cache_p, block_cnt, NULL);
+    while(lv_cache_get_size(fs_block_cache_p, NULL) > block_cnt) {
+        if(!lv_cache_evict_one(fs_block_cache_p, NULL)) break;
+    }
+}
+
+void lv_fs_block_cache_drop_all(void)
+{
+    lv_cache_drop_all(fs_block_cache_p, NULL);
+}
+
+#endif /*LV_USE_FS_BLOCK_CACHE*/
+
 void lv_fs_drv_init(lv_fs_drv_t * drv)
 {
     lv_memzero(drv, sizeof(lv_fs_drv_t));
@@ -621,3 +805,330 @@ static const char * lv_fs_get_real_path(const char * path)
 
     return path;
 }
+
+/**
+ * Close a file which couldn't be opened completely
+ * @param file_p    pointer to a lv_fs_file_t variable
+ */
+static void close_on_error(lv_fs_file_t * file_p)
+{
+    if(file_p->drv->close_cb) file_p->drv->close_cb(file_p->drv, file_p->file_d);
+
+#if LV_USE_FS_BLOCK_CACHE
+    lv_free(file_p->block_path);
+    file_p->block_path = NULL;
+    file_p->block_read = false;
+#endif
+
+    file_p->file_d = NULL;
+    file_p->drv = NULL;
+}
+
+/**
+ * Check if a file is read through the shared block cache
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @return          true: the blocks of the file are cached in the shared block cache
+ */
+static inline bool is_block_cached(const lv_fs_file_t * file_p)
+{
+#if LV_USE_FS_BLOCK_CACHE
+    return file_p->block_read;
+#else
+    LV_UNUSED(file_p);
+    return false;
+#endif
+}
+
+#if LV_USE_FS_BLOCK_CACHE
+
+/**
+ * Read from a file through the shared block cache
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param buf       pointer to a buffer where the read bytes are stored
+ * @param btr       Bytes To Read
+ * @param br        the number of real read bytes (Bytes Read)
+ * @return          LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t lv_fs_read_blocks(lv_fs_file_t * file_p, char * buf, uint32_t btr, uint32_t * br)
+{
+    LV_PROFILER_BEGIN;
+
+    lv_fs_res_t res = LV_FS_RES_OK;
+    uint32_t pos = file_p->cache->file_position;
+    *br = 0;
+
+    while(btr > 0) {
+        uint32_t index = pos / BLOCK_SIZE;
+        uint32_t offset = pos % BLOCK_SIZE;
+
+        bool created;
+        lv_cache_entry_t * entry = block_acquire(file_p, index, &created);
+        if(entry == NULL) {
+            /*Couldn't read or cache the block, read the rest directly*/
+            uint32_t br_direct = 0;
+            res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+            if(res == LV_FS_RES_OK) {
+                res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_direct);
+            }
+            file_p->drv_position = res == LV_FS_RES_OK ? pos + br_direct : UINT32_MAX;
+            pos += br_direct;
+            *br += br_direct;
+            break;
+        }
+
+        lv_fs_block_t * block = lv_cache_entry_get_data(entry);
+        uint32_t block_size = block->size;
+        uint32_t n = block_size > offset ? LV_MIN(block_size - offset, btr) : 0;
+        lv_memcpy(buf, block->data + offset, n);
+        lv_cache_release(fs_block_cache_p, entry, NULL);
+
+        buf += n;
+        btr -= n;
+        pos += n;
+        *br += n;
+
+        /*Reading the block after the previous one means the file is read sequentially.
+         *The driver is already at the next block so read it now, without seeking later.*/
+        if(created && index == file_p->block_next && block_size == BLOCK_SIZE) {
+            read_ahead(file_p, index + 1);
+        }
+        file_p->block_next = index + 1;
+
+        /*End of the file*/
+        if(block_size < BLOCK_SIZE) break;
+    }
+
+    file_p->cache->file_position = pos;
+
+    LV_PROFILER_END;
+
+    return res;
+}
+
+/**
+ * Read the next blocks of a file into the block cache
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param index     index of the first block to read
+ */
+static void read_ahead(lv_fs_file_t * file_p, uint32_t index)
+{
+    /*Keep at least the block being read*/
+    size_t max_cnt = lv_cache_get_max_size(fs_block_cache_p, NULL);
+    uint32_t cnt = max_cnt > LV_FS_BLOCK_CACHE_READ_AHEAD ? LV_FS_BLOCK_CACHE_READ_AHEAD :
+                   (max_cnt > 0 ? (uint32_t)max_cnt - 1 : 0);
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        bool created;
+        lv_cache_entry_t * entry = block_acquire(file_p, index + i, &created);
+        if(entry == NULL) break;
+
+        lv_fs_block_t * block = lv_cache_entry_get_data(entry);
+        bool end = block->size < BLOCK_SIZE;
+        lv_cache_release(fs_block_cache_p, entry, NULL);
+
+        /*Stop at the end of the file and at the already cached blocks*/
+        if(end || !created) break;
+    }
+}
+
+/**
+ * Drop the cached blocks of a file in a range
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param first     index of the first block
+ * @param last      index of the last block. Limited to the largest cached index of the file.
+ */
+static void drop_blocks(lv_fs_file_t * file_p, uint32_t first, uint32_t last)
+{
+    /*Memory-mapped files are never cached in blocks*/
+    if(file_p->drv->cache_size == LV_FS_CACHE_FROM_BUFFER) return;
+
+    /*Without the path the blocks of the file can't be found*/
+    if(file_p->block_path == NULL) {
+        lv_fs_block_cache_drop_all();
+        return;
+    }
+
+    lv_fs_block_file_t * file = block_file_find(file_p->drv, file_p->block_path, file_p->block_path_hash);
+    if(file == NULL) return; /*No blocks of the file are cached*/
+
+    /*Keep the file while its blocks are dropped and stop when only this reference remains*/
+    file->block_cnt++;
+
+    lv_fs_block_t search_key;
+    search_key.drv = file->drv;
+    search_key.path = file->path;
+    search_key.path_hash = file->path_hash;
+
+    last = LV_MIN(last, file->max_index);
+    uint32_t i;
+    for(i = first; i <= last && file->block_cnt > 1; i++) {
+        search_key.index = i;
+        lv_cache_drop(fs_block_cache_p, &search_key, NULL);
+    }
+
+    block_file_release(file);
+}
+
+/**
+ * Get a block of a file from the block cache or read it if it's not cached yet
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param index     index of the block
+ * @param created   set to true if the block was read now
+ * @return          the acquired cache entry or NULL on error
+ */
+static lv_cache_entry_t * block_acquire(lv_fs_file_t * file_p, uint32_t index, bool * created)
+{
+    lv_fs_block_t search_key;
+    search_key.drv = file_p->drv;
+    search_key.path = file_p->block_path;
+    search_key.path_hash = file_p->block_path_hash;
+    search_key.index = index;
+
+    lv_cache_entry_t * entry = lv_cache_acquire(fs_block_cache_p, &search_key, NULL);
+    *created = entry == NULL;
+    if(entry == NULL) entry = lv_cache_acquire_or_create(fs_block_cache_p, &search_key, file_p);
+
+    return entry;
+}
+
+static bool block_create_cb(lv_fs_block_t * block, lv_fs_file_t * file_p)
+{
+    uint32_t pos = block->index * BLOCK_SIZE;
+    if(file_p->drv_position != pos) {
+        lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) {
+            file_p->drv_position = UINT32_MAX;
+            return false;
+        }
+        file_p->drv_position = pos;
+    }
+
+    block->data = lv_malloc(BLOCK_SIZE);
+    LV_ASSERT_MALLOC(block->data);
+    if(block->data == NULL) return false;
+
+    uint32_t br = 0;
+    lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, block->data, BLOCK_SIZE, &br);
+    if(res != LV_FS_RES_OK) {
+        file_p->drv_position = UINT32_MAX;
+        lv_free(block->data);
+        return false;
+    }
+
+    file_p->drv_position = pos + br;
+    block->size = br;
+
+    /*The key points to the path of the file, but the block can outlive the file.
+     *So use the path stored with the other blocks of the file or make a copy.*/
+    lv_fs_block_file_t * file = block_file_find(block->drv, block->path, block->path_hash);
+    if(file == NULL) {
+        file = _lv_ll_ins_head(fs_block_file_ll_p);
+        LV_ASSERT_MALLOC(file);
+        if(file == NULL) {
+            lv_free(block->data);
+            return false;
+        }
+
+        file->path = lv_strdup(block->path);
+        LV_ASSERT_MALLOC(file->path);
+        if(file->path == NULL) {
+            _lv_ll_remove(fs_block_file_ll_p, file);
+            lv_free(file);
+            lv_free(block->data);
+            return false;
+        }
+
+        file->drv = block->drv;
+        file->path_hash = block->path_hash;
+        file->block_cnt = 0;
+        file->max_index = 0;
+    }
+
+    file->block_cnt++;
+    if(block->index > file->max_index) file->max_index = block->index;
+    block->file = file;
+    block->path = file->path;
+
+    return true;
+}
+
+static void block_free_cb(lv_fs_block_t * block, void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    block_file_release(block->file);
+    lv_free(block->data);
+}
+
+static lv_cache_compare_res_t block_compare_cb(const lv_fs_block_t * lhs, const lv_fs_block_t * rhs)
+{
+    if(lhs->index != rhs->index) {
+        return lhs->index > rhs->index ? 1 : -1;
+    }
+
+    if(lhs->path_hash != rhs->path_hash) {
+        return lhs->path_hash > rhs->path_hash ? 1 : -1;
+    }
+
+    if(lhs->drv != rhs->drv) {
+        return lhs->drv > rhs->drv ? 1 : -1;
+    }
+
+    int32_t cmp_res = lv_strcmp(lhs->path, rhs->path);
+    if(cmp_res != 0) {
+        return cmp_res > 0 ? 1 : -1;
+    }
+
+    return 0;
+}
+
+/**
+ * Find a file which has blocks in the cache
+ * @param drv           driver of the file
+ * @param path          path of the file
+ * @param path_hash     hash of `path`
+ * @return              the file or NULL if none of its blocks are cached
+ */
+static lv_fs_block_file_t * block_file_find(lv_fs_drv_t * drv, const char * path, uint32_t path_hash)
+{
+    lv_fs_block_file_t * file;
+    _LV_LL_READ(fs_block_file_ll_p, file) {
+        if(file->path_hash == path_hash && file->drv == drv && lv_strcmp(file->path, path) == 0) return file;
+    }
+
+    return NULL;
+}
+
+/**
+ * Release a reference to a file with cached blocks and remove it after its last block
+ * @param file          the file
+ */
+static void block_file_release(lv_fs_block_file_t * file)
+{
+    file->block_cnt--;
+    if(file->block_cnt > 0) return;
+
+    lv_free(file->path);
+    _lv_ll_remove(fs_block_file_ll_p, file);
+    lv_free(file);
+}
+
+/**
+ * Calculate the FNV-1a hash of a path to compare the paths of the blocks quickly
+ * @param path      the path
+ * @return          the hash
+ */
+static uint32_t path_hash(const char * path)
+{
+    uint32_t hash = 2166136261u;
+    while(*path) {
+        hash ^= (uint8_t) * path;
+        hash *= 16777619u;
+        path++;
+    }
+
+    return hash;
+}
+
+#endif /*LV_USE_FS_BLOCK_CACHE*/
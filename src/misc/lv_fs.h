@@ -90,6 +90,10 @@ struct _lv_fs_drv_t {
     lv_fs_res_t (*seek_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence);
     lv_fs_res_t (*tell_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 
+    /*Optional. Return a read-only pointer to a region of the file or NULL if it can't be mapped*/
+    const void * (*map_cb)(lv_fs_drv_t * drv, void * file_p, uint32_t pos, uint32_t len);
+    void (*unmap_cb)(lv_fs_drv_t * drv, void * file_p, const void * ptr, uint32_t len);
+
     void * (*dir_open_cb)(lv_fs_drv_t * drv, const char * path);
     lv_fs_res_t (*dir_read_cb)(lv_fs_drv_t * drv, void * rddir_p, char * fn, uint32_t fn_len);
     lv_fs_res_t (*dir_close_cb)(lv_fs_drv_t * drv, void * rddir_p);
@@ -108,6 +112,13 @@ typedef struct {
     void * file_d;
     lv_fs_drv_t * drv;
     lv_fs_file_cache_t * cache;
+#if LV_USE_FS_BLOCK_CACHE
+    char * block_path;          /**< Path to find the blocks of the file in the shared block cache. NULL if not used*/
+    uint32_t block_path_hash;
+    bool block_read;            /**< The file is read through the shared block cache*/
+    uint32_t block_next;        /**< Index of the block after the last read one to detect sequential reads*/
+    uint32_t drv_position;      /**< Position of the driver in the file*/
+#endif
 } lv_fs_file_t;
 
 /* Extended path object to specify the buffer for memory-mapped files */
@@ -229,6 +240,25 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
  */
 lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos);
 
+/**
+ * Get a read-only pointer to a region of a file without copying it into RAM.
+ * It works with files opened from a buffer and with drivers having `map_cb`.
+ * The pointer is valid until `lv_fs_unmap` is called and the file must be kept open until then.
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param pos       start of the region in bytes from the beginning of the file
+ * @param len       length of the region in bytes
+ * @return          pointer to the region or NULL if the file can't be mapped
+ */
+const void * lv_fs_map(lv_fs_file_t * file_p, uint32_t pos, uint32_t len);
+
+/**
+ * Release a region of a file returned by `lv_fs_map`
+ * @param file_p    pointer to a lv_fs_file_t variable
+ * @param ptr       the pointer returned by `lv_fs_map`
+ * @param len       the same length as passed to `lv_fs_map`
+ */
+void lv_fs_unmap(lv_fs_file_t * file_p, const void * ptr, uint32_t len);
+
 /**
  * Initialize a 'fs_dir_t' variable for directory reading
  * @param rddir_p   pointer to a 'lv_fs_dir_t' variable
@@ -254,6 +284,22 @@ lv_fs_res_t lv_fs_dir_read(lv_fs_dir_t * rddir_p, char * fn, uint32_t fn_len);
  */
 lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p);
 
+#if LV_USE_FS_BLOCK_CACHE
+
+/**
+ * Set the number of blocks in the block cache shared by the files opened for reading.
+ * The files opened while the size is 0 don't use the block cache.
+ * @param block_cnt the new number of blocks. The least recently used blocks are freed if there are more blocks.
+ */
+void lv_fs_block_cache_resize(uint32_t block_cnt);
+
+/**
+ * Free all the cached blocks. Needs to be called if the files were changed without `lv_fs_write()`.
+ */
+void lv_fs_block_cache_drop_all(void);
+
+#endif /*LV_USE_FS_BLOCK_CACHE*/
+
 /**
  * Fill a buffer with the letters of existing drivers
  * @param buf       buffer to store the letters ('\0' added after the last letter)
@@ -295,17 +295,16 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
 
     LV_ASSERT(prop != LV_STYLE_PROP_INV);
 
+    /*Keep the properties sorted to allow bisecting them in `lv_style_get_prop()`*/
     lv_style_prop_t * props;
-    int32_t i;
-
+    uint32_t pos = 0;
     if(style->values_and_props) {
         props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        for(i = style->prop_cnt - 1; i >= 0; i--) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                values[i] = value;
-                return;
-            }
+        pos = _lv_style_find_prop_pos(props, style->prop_cnt, prop);
+        if(pos < style->prop_cnt && props[pos] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            values[pos] = value;
+            return;
         }
     }
 
@@ -314,20 +313,21 @@ void lv_style_set_prop(lv_style_t * style, lv_style_prop_t prop, lv_style_value_
     if(values_and_props == NULL) return;
     style->values_and_props = values_and_props;
 
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-    /*Shift all props to make place for the value before them*/
-    for(i = style->prop_cnt - 1; i >= 0; i--) {
-        props[i + sizeof(lv_style_value_t) / sizeof(lv_style_prop_t)] = props[i];
-    }
-    style->prop_cnt++;
+    /*Move the props after the new value and make place for the new prop at `pos`.
+     *Start with the last ones as the props are moved to higher addresses*/
+    lv_style_prop_t * old_props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    props = values_and_props + (style->prop_cnt + 1) * sizeof(lv_style_value_t);
+    lv_memmove(props + pos + 1, old_props + pos, (style->prop_cnt - pos) * sizeof(lv_style_prop_t));
+    lv_memmove(props, old_props, pos * sizeof(lv_style_prop_t));
 
-    /*Go to the new position with the props*/
-    props = values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
+    /*Make place for the new value too*/
     lv_style_value_t * values = (lv_style_value_t *)values_and_props;
+    lv_memmove(values + pos + 1, values + pos, (style->prop_cnt - pos) * sizeof(lv_style_value_t));
 
     /*Set the new property and value*/
-    props[style->prop_cnt - 1] = prop;
-    values[style->prop_cnt - 1] = value;
+    props[pos] = prop;
+    values[pos] = value;
+    style->prop_cnt++;
 
     uint32_t group = _lv_style_get_prop_group(prop);
     style->has_group |= (uint32_t)1 << group;
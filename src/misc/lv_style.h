@@ -29,6 +29,9 @@ extern "C" {
 
 #define LV_STYLE_SENTINEL_VALUE     0xAABBCCDD
 
+/*The properties of non-constant styles are sorted. Ranges up to this size are scanned linearly, the larger ones are bisected*/
+#define _LV_STYLE_PROP_SCAN_MAX     8
+
 /**
  * Flags for style behavior
  *
@@ -481,6 +484,30 @@ void lv_style_transition_dsc_init(lv_style_transition_dsc_t * tr, const lv_style
  */
 lv_style_value_t lv_style_prop_get_default(lv_style_prop_t prop);
 
+/**
+ * Used internally to find a property in the sorted property list of a non-constant style
+ * @param props     the property IDs of the style in ascending order
+ * @param prop_cnt  number of properties in `props`
+ * @param prop      the property to find
+ * @return          index of `prop` in `props` if it's there, else the index where it should be inserted
+ */
+static inline uint32_t _lv_style_find_prop_pos(const lv_style_prop_t * props, uint32_t prop_cnt, lv_style_prop_t prop)
+{
+    uint32_t first = 0;
+    uint32_t last = prop_cnt;
+    while(last - first > _LV_STYLE_PROP_SCAN_MAX) {
+        uint32_t mid = (first + last) >> 1;
+        if(props[mid] < prop) first = mid + 1;
+        else last = mid + 1;
+    }
+
+    for(; first < last; first++) {
+        if(props[first] >= prop) break;
+    }
+
+    return first;
+}
+
 /**
  * Get the value of a property
  * @param style pointer to a style
@@ -506,13 +533,11 @@ static inline lv_style_res_t lv_style_get_prop_inlined(const lv_style_t * style,
     }
     else {
         lv_style_prop_t * props = (lv_style_prop_t *)style->values_and_props + style->prop_cnt * sizeof(lv_style_value_t);
-        uint32_t i;
-        for(i = 0; i < style->prop_cnt; i++) {
-            if(props[i] == prop) {
-                lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
-                *value = values[i];
-                return LV_STYLE_RES_FOUND;
-            }
+        uint32_t i = _lv_style_find_prop_pos(props, style->prop_cnt, prop);
+        if(i < style->prop_cnt && props[i] == prop) {
+            lv_style_value_t * values = (lv_style_value_t *)style->values_and_props;
+            *value = values[i];
+            return LV_STYLE_RES_FOUND;
         }
     }
     return LV_STYLE_RES_NOT_FOUND;
@@ -10,7 +10,9 @@
 #include "../tick/lv_tick.h"
 #include "../stdlib/lv_mem.h"
 #include "../stdlib/lv_sprintf.h"
+#include "../osal/lv_os.h"
 #include "lv_assert.h"
+#include "lv_async.h"
 #include "lv_ll.h"
 #include "lv_profiler.h"
 
@@ -21,6 +23,12 @@
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
 
+#define SCHED_SIZE_MIN 8
+
+/*`_heap_index` of the paused timers and of the timers being executed*/
+#define HEAP_INDEX_NONE     0xFFFFFFFF
+#define HEAP_INDEX_READY    0xFFFFFFFE
+
 #define state LV_GLOBAL_DEFAULT()->timer_state
 #define timer_ll_p &(state.timer_ll)
 
@@ -31,9 +39,16 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
+static void lv_timer_exec(uint32_t ready_index);
 static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
-static void lv_timer_handler_resume(void);
+static bool sched_reserve(uint32_t timer_cnt);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_sift_up(uint32_t i, uint32_t now);
+static void heap_sift_down(uint32_t i, uint32_t now);
+static uint32_t heap_key(lv_timer_t * timer, uint32_t now);
+static void ready_sort(void);
 
 /**********************
  *  STATIC VARIABLES
@@ -80,6 +95,9 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
     LV_PROFILER_BEGIN;
     uint32_t handler_start = lv_tick_get();
 
+    /*Clear it before running anything. A resume requested from now on is seen at the end.*/
+    lv_atomic_store(&state_p->resume_pending, 0);
+
     if(handler_start == 0) {
         state.run_cnt++;
         if(state.run_cnt > 100) {
@@ -88,43 +106,35 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    lv_timer_t * timer_active;
-    lv_ll_t * timer_head = timer_ll_p;
-    do {
-        state_p->timer_deleted             = false;
-        state_p->timer_created             = false;
-
-        timer_active = _lv_ll_get_head(timer_head);
-        while(timer_active) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(timer_head, timer_active);
-
-            if(lv_timer_exec(timer_active)) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(state_p->timer_created || state_p->timer_deleted) {
-                    LV_TRACE_TIMER("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
+    /*Run the async calls before the timers to let them prepare the next refresh*/
+    _lv_async_run();
 
-            timer_active = next; /*Load the next timer*/
+    /*Run the timers which are ready. They are taken from the top of the heap so the
+     *not ready timers are not touched. If a timer was created meanwhile check again
+     *as it might need to run immediately.*/
+    do {
+        state_p->timer_created = false;
+
+        while(state_p->heap_cnt > 0 && heap_key(state_p->heap[0], lv_tick_get()) == 0) {
+            lv_timer_t * timer = state_p->heap[0];
+            heap_remove(timer);
+            timer->_heap_index = HEAP_INDEX_READY;
+            state_p->ready[state_p->ready_cnt] = timer;
+            state_p->ready_cnt++;
         }
-    } while(timer_active);
+        ready_sort();
 
-    uint32_t time_until_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(timer_head);
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_until_next)
-                time_until_next = delay;
+        uint32_t i;
+        for(i = 0; i < state_p->ready_cnt; i++) {
+            /*NULL if deleted by the callback of an other timer*/
+            if(state_p->ready[i]) lv_timer_exec(i);
         }
+        state_p->ready_cnt = 0;
+    } while(state_p->timer_created);
 
-        next = _lv_ll_get_next(timer_head, next); /*Find the next timer*/
-    }
+    uint32_t time_until_next = LV_NO_TIMER_READY;
+    if(state_p->heap_cnt > 0) time_until_next = lv_timer_time_remaining(state_p->heap[0]);
+    if(_lv_async_is_pending() || lv_atomic_load(&state_p->resume_pending)) time_until_next = 0;
 
     state_p->busy_time += lv_tick_elaps(handler_start);
     uint32_t idle_period_time = lv_tick_elaps(state_p->idle_period_start);
@@ -146,7 +156,7 @@ LV_ATTRIBUTE_TIMER_HANDLER uint32_t lv_timer_handler(void)
 LV_ATTRIBUTE_TIMER_HANDLER void lv_timer_periodic_handler(void)
 {
     lv_timer_state_t * state_p = &state;
-    if(lv_tick_elaps(state_p->periodic_last_tick) >= state_p->timer_time_until_next) {
+    if(lv_tick_elaps(state_p->periodic_last_tick) >= lv_timer_get_time_until_next()) {
         LV_TRACE_TIMER("calling lv_timer_handler()");
         lv_timer_handler();
         state_p->periodic_last_tick = lv_tick_get();
@@ -162,6 +172,9 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    /*Reserve the place for the new timer in the heap to never fail later*/
+    if(!sched_reserve(state.timer_cnt + 1)) return NULL;
+
     new_timer = _lv_ll_ins_head(timer_ll_p);
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -173,10 +186,14 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
     new_timer->auto_delete = true;
+    new_timer->_seq = state.timer_seq;
+    state.timer_seq++;
 
+    state.timer_cnt++;
+    heap_insert(new_timer);
     state.timer_created = true;
 
-    lv_timer_handler_resume();
+    _lv_timer_handler_resume();
 
     return new_timer;
 }
@@ -189,8 +206,19 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
 
 void lv_timer_delete(lv_timer_t * timer)
 {
+    if(timer->_heap_index == HEAP_INDEX_READY) {
+        /*Don't let `lv_timer_handler()` execute it*/
+        uint32_t i;
+        for(i = 0; i < state.ready_cnt; i++) {
+            if(state.ready[i] == timer) state.ready[i] = NULL;
+        }
+    }
+    else if(timer->_heap_index != HEAP_INDEX_NONE) {
+        heap_remove(timer);
+    }
+
     _lv_ll_remove(timer_ll_p, timer);
-    state.timer_deleted = true;
+    state.timer_cnt--;
 
     lv_free(timer);
 }
@@ -199,31 +227,40 @@ void lv_timer_pause(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = true;
+    /*A ready timer is not added to the heap again after it's executed*/
+    if(timer->_heap_index < HEAP_INDEX_READY) {
+        heap_remove(timer);
+        timer->_heap_index = HEAP_INDEX_NONE;
+    }
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->paused = false;
-    lv_timer_handler_resume();
+    if(timer->_heap_index == HEAP_INDEX_NONE) heap_insert(timer);
+    _lv_timer_handler_resume();
 }
 
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     LV_ASSERT_NULL(timer);
     timer->period = period;
+    heap_update(timer);
 }
 
 void lv_timer_ready(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get() - timer->period - 1;
+    heap_update(timer);
 }
 
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     LV_ASSERT_NULL(timer);
     timer->repeat_count = repeat_count;
+    heap_update(timer);
 }
 
 void lv_timer_set_auto_delete(lv_timer_t * timer, bool auto_delete)
@@ -242,13 +279,14 @@ void lv_timer_reset(lv_timer_t * timer)
 {
     LV_ASSERT_NULL(timer);
     timer->last_run = lv_tick_get();
-    lv_timer_handler_resume();
+    heap_update(timer);
+    _lv_timer_handler_resume();
 }
 
 void lv_timer_enable(bool en)
 {
     state.lv_timer_run = en;
-    if(en) lv_timer_handler_resume();
+    if(en) _lv_timer_handler_resume();
 }
 
 void _lv_timer_core_deinit(void)
@@ -256,6 +294,15 @@ void _lv_timer_core_deinit(void)
     lv_timer_enable(false);
 
     _lv_ll_clear(timer_ll_p);
+
+    lv_free(state.heap);
+    lv_free(state.ready);
+    state.heap = NULL;
+    state.ready = NULL;
+    state.heap_cnt = 0;
+    state.ready_cnt = 0;
+    state.timer_cnt = 0;
+    state.sched_size = 0;
 }
 
 uint32_t lv_timer_get_idle(void)
@@ -265,6 +312,7 @@ uint32_t lv_timer_get_idle(void)
 
 uint32_t lv_timer_get_time_until_next(void)
 {
+    if(lv_atomic_load(&state.resume_pending)) return 0;
     return state.timer_time_until_next;
 }
 
@@ -279,51 +327,46 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
- * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
+ * Execute a ready timer and add it to the heap again if it's not paused or deleted
+ * @param ready_index   index of the timer in `state.ready`
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(uint32_t ready_index)
 {
-    if(timer->paused) return false;
+    lv_timer_t * timer = state.ready[ready_index];
 
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted in the callback `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    LV_TRACE_TIMER("calling timer callback: %p", *((void **)&timer->timer_cb));
 
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
 
-        if(!state.timer_deleted) {
-            LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
-        }
-        else {
-            LV_TRACE_TIMER("timer callback finished");
-        }
+    LV_ASSERT_MEM_INTEGRITY();
 
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
+    /*The timer might be deleted by itself as well*/
+    if(state.ready[ready_index] == NULL) {
+        LV_TRACE_TIMER("timer callback finished");
+        return;
     }
 
-    if(state.timer_deleted == false) { /*The timer might be deleted by itself as well*/
-        if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
-            if(timer->auto_delete) {
-                LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-                lv_timer_delete(timer);
-            }
-            else {
-                LV_TRACE_TIMER("pausing timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
-                lv_timer_pause(timer);
-            }
+    LV_TRACE_TIMER("timer callback %p finished", *((void **)&timer->timer_cb));
+
+    if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
+        if(timer->auto_delete) {
+            LV_TRACE_TIMER("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+            lv_timer_delete(timer);
+            return;
+        }
+        else {
+            LV_TRACE_TIMER("pausing timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
+            timer->paused = true;
         }
     }
 
-    return exec;
+    timer->_heap_index = HEAP_INDEX_NONE;
+    if(!timer->paused) heap_insert(timer);
 }
 
 /**
@@ -341,12 +384,13 @@ static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
 }
 
 /**
- * Call the ready lv_timer
+ * Make the next `lv_timer_handler()` call run as soon as possible
  */
-static void lv_timer_handler_resume(void)
+void _lv_timer_handler_resume(void)
 {
-    /*If there is a timer which is ready to run then resume the timer loop*/
-    state.timer_time_until_next = 0;
+    /*Only an atomic flag is written as it might be called from other threads while
+     *`lv_timer_handler()` is updating the state*/
+    lv_atomic_store(&state.resume_pending, 1);
     if(state.resume_cb) {
         state.resume_cb(state.resume_data);
     }
@@ -357,3 +401,144 @@ void lv_timer_handler_set_resume_cb(lv_timer_handler_resume_cb_t cb, void * data
     state.resume_cb = cb;
     state.resume_data = data;
 }
+
+/**
+ * Make sure `heap` and `ready` can store all the timers
+ * @param timer_cnt     the number of timers to store
+ * @return              true: success; false: out of memory
+ */
+static bool sched_reserve(uint32_t timer_cnt)
+{
+    if(timer_cnt <= state.sched_size) return true;
+
+    uint32_t new_size = LV_MAX(state.sched_size * 2, SCHED_SIZE_MIN);
+    lv_timer_t ** new_heap = lv_realloc(state.heap, new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_heap);
+    if(new_heap == NULL) return false;
+    state.heap = new_heap;
+
+    lv_timer_t ** new_ready = lv_realloc(state.ready, new_size * sizeof(lv_timer_t *));
+    LV_ASSERT_MALLOC(new_ready);
+    if(new_ready == NULL) return false;
+    state.ready = new_ready;
+
+    state.sched_size = new_size;
+    return true;
+}
+
+/**
+ * Get the time until the timer needs to run. The order of the timers by this value
+ * doesn't change as the time passes, so it's used to order the heap.
+ * @param timer     pointer to a timer
+ * @param now       the current tick
+ * @return          the remaining time or 0 if the timer is ready
+ */
+static uint32_t heap_key(lv_timer_t * timer, uint32_t now)
+{
+    /*Make the timer ready to delete or pause it*/
+    if(timer->repeat_count == 0) return 0;
+
+    uint32_t elp = now - timer->last_run;
+    if(elp >= timer->period) return 0;
+    return timer->period - elp;
+}
+
+/**
+ * Sort the ready timers by creation, the newest first as it was with the linked list of the timers.
+ * The heap can't order them as all ready timers have 0 key.
+ */
+static void ready_sort(void)
+{
+    lv_timer_t ** ready = state.ready;
+    uint32_t i;
+    for(i = 1; i < state.ready_cnt; i++) {
+        lv_timer_t * timer = ready[i];
+        uint32_t j = i;
+        /*Compare the difference to handle the overflow of the counter*/
+        while(j > 0 && (int32_t)(timer->_seq - ready[j - 1]->_seq) > 0) {
+            ready[j] = ready[j - 1];
+            j--;
+        }
+        ready[j] = timer;
+    }
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    uint32_t i = state.heap_cnt;
+    state.heap[i] = timer;
+    timer->_heap_index = i;
+    state.heap_cnt++;
+    heap_sift_up(i, lv_tick_get());
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    uint32_t i = timer->_heap_index;
+    state.heap_cnt--;
+    if(i != state.heap_cnt) {
+        /*Move the last timer to the free place and restore the order*/
+        lv_timer_t * last = state.heap[state.heap_cnt];
+        state.heap[i] = last;
+        last->_heap_index = i;
+
+        uint32_t now = lv_tick_get();
+        heap_sift_up(i, now);
+        heap_sift_down(last->_heap_index, now);
+    }
+}
+
+/**
+ * Move a timer to its new place in the heap after its period, last run or repeat count has changed
+ * @param timer     pointer to a timer
+ */
+static void heap_update(lv_timer_t * timer)
+{
+    /*Paused and ready timers are not in the heap*/
+    if(timer->_heap_index >= HEAP_INDEX_READY) return;
+
+    uint32_t now = lv_tick_get();
+    heap_sift_up(timer->_heap_index, now);
+    heap_sift_down(timer->_heap_index, now);
+}
+
+static void heap_sift_up(uint32_t i, uint32_t now)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[i];
+    uint32_t key = heap_key(timer, now);
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(heap_key(heap[parent], now) <= key) break;
+        heap[i] = heap[parent];
+        heap[i]->_heap_index = i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->_heap_index = i;
+}
+
+static void heap_sift_down(uint32_t i, uint32_t now)
+{
+    lv_timer_t ** heap = state.heap;
+    lv_timer_t * timer = heap[i];
+    uint32_t key = heap_key(timer, now);
+    while(1) {
+        uint32_t child = i * 2 + 1;
+        if(child >= state.heap_cnt) break;
+        uint32_t child_key = heap_key(heap[child], now);
+        if(child + 1 < state.heap_cnt) {
+            uint32_t right_key = heap_key(heap[child + 1], now);
+            if(right_key < child_key) {
+                child++;
+                child_key = right_key;
+            }
+        }
+        if(key <= child_key) break;
+        heap[i] = heap[child];
+        heap[i]->_heap_index = i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->_heap_index = i;
+}
@@ -51,16 +51,30 @@ struct _lv_timer_t {
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
     uint32_t auto_delete : 1;
+    uint32_t _heap_index; /**< Position in the scheduler's heap, used internally*/
+    uint32_t _seq; /**< Creation order to run the timers ready at the same time in a fixed order, used internally*/
 };
 
 typedef struct {
     lv_ll_t timer_ll; /*Linked list to store the lv_timers*/
 
+    /*Min-heap of the not paused timers. The timer which should run first is at index 0*/
+    lv_timer_t ** heap;
+    uint32_t heap_cnt;
+
+    /*The timers being executed in the current `lv_timer_handler()` call*/
+    lv_timer_t ** ready;
+    uint32_t ready_cnt;
+
+    uint32_t timer_cnt;
+    uint32_t sched_size; /*Size of `heap` and `ready`. Always >= `timer_cnt`*/
+    uint32_t timer_seq; /*`_seq` of the next created timer*/
+
     bool lv_timer_run;
     uint8_t idle_last;
-    bool timer_deleted;
     bool timer_created;
     uint32_t timer_time_until_next;
+    volatile uint32_t resume_pending; /*Set by `_lv_timer_handler_resume()` from any thread*/
 
     bool already_running;
     uint32_t periodic_last_tick;
@@ -86,6 +100,13 @@ void _lv_timer_core_init(void);
  */
 void _lv_timer_core_deinit(void);
 
+/**
+ * Make the next `lv_timer_handler()` call run as soon as possible
+ * and call the resume callback set by `lv_timer_handler_set_resume_cb()`.
+ * Can be called from any thread or interrupt.
+ */
+void _lv_timer_handler_resume(void);
+
 //! @cond Doxygen_Suppress
 
 /**
@@ -21,6 +21,19 @@ extern "C" {
 
 #include "../misc/lv_types.h"
 
+/*Implementation of the atomic operations*/
+#if defined(__GNUC__) || defined(__clang__)
+#define _LV_ATOMIC_GNUC 1
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#define _LV_ATOMIC_C11 1
+#include <stdatomic.h>
+#elif defined(_MSC_VER)
+#define _LV_ATOMIC_MSVC 1
+#include <intrin.h>
+#else
+#error "The atomic operations need GCC/Clang builtins, C11 atomics or MSVC intrinsics"
+#endif
+
 #if LV_USE_OS == LV_OS_NONE
 #include "lv_os_none.h"
 #elif LV_USE_OS == LV_OS_PTHREAD
@@ -143,6 +156,80 @@ lv_result_t lv_thread_sync_signal(lv_thread_sync_t * sync);
  */
 lv_result_t lv_thread_sync_delete(lv_thread_sync_t * sync);
 
+/*----------------------------------------
+ * Atomic access for lock-free data sharing
+ * between 2 threads
+ *----------------------------------------*/
+
+/**
+ * Load a variable written by an other thread. The memory operations after it can't be reordered before it.
+ * @param p         pointer to the variable
+ * @return          the value of the variable
+ */
+static inline uint32_t lv_atomic_load(const volatile uint32_t * p)
+{
+#if defined(_LV_ATOMIC_GNUC)
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#elif defined(_LV_ATOMIC_C11)
+    return atomic_load_explicit((volatile _Atomic uint32_t *)p, memory_order_acquire);
+#else
+    return (uint32_t)_InterlockedOr((volatile long *)p, 0);
+#endif
+}
+
+/**
+ * Store a variable read by an other thread. The memory operations before it can't be reordered after it.
+ * @param p         pointer to the variable
+ * @param v         the new value
+ */
+static inline void lv_atomic_store(volatile uint32_t * p, uint32_t v)
+{
+#if defined(_LV_ATOMIC_GNUC)
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#elif defined(_LV_ATOMIC_C11)
+    atomic_store_explicit((volatile _Atomic uint32_t *)p, v, memory_order_release);
+#else
+    _InterlockedExchange((volatile long *)p, (long)v);
+#endif
+}
+
+/**
+ * Set a variable to a new value if it still has the expected value, as a single atomic operation.
+ * @param p         pointer to the variable
+ * @param expected  pointer to the expected value. Updated to the current value on failure.
+ * @param v         the new value
+ * @return          true: the value was updated; false: the value wasn't `*expected`
+ */
+static inline bool lv_atomic_cas(volatile uint32_t * p, uint32_t * expected, uint32_t v)
+{
+#if defined(_LV_ATOMIC_GNUC)
+    return __atomic_compare_exchange_n(p, expected, v, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#elif defined(_LV_ATOMIC_C11)
+    return atomic_compare_exchange_strong_explicit((volatile _Atomic uint32_t *)p, expected, v,
+                                                   memory_order_acq_rel, memory_order_acquire);
+#else
+    uint32_t old = (uint32_t)_InterlockedCompareExchange((volatile long *)p, (long)v, (long)(*expected));
+    if(old == *expected) return true;
+    *expected = old;
+    return false;
+#endif
+}
+
+/**
+ * Don't let the CPU and the compiler reorder the memory operations across this point
+ */
+static inline void lv_atomic_fence(void)
+{
+#if defined(_LV_ATOMIC_GNUC)
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#elif defined(_LV_ATOMIC_C11)
+    atomic_thread_fence(memory_order_seq_cst);
+#else
+    volatile long dummy = 0;
+    _InterlockedExchange(&dummy, 1);    /*The interlocked operations are full barriers*/
+#endif
+}
+
 /**********************
  *      MACROS
  **********************/
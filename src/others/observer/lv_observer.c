@@ -15,6 +15,8 @@
 /*********************
  *      DEFINES
  *********************/
+#define deferred_ll_p &(LV_GLOBAL_DEFAULT()->subject_deferred_ll)
+#define post_pending LV_GLOBAL_DEFAULT()->subject_post_pending
 
 /**********************
  *      TYPEDEFS
@@ -25,9 +27,20 @@ typedef struct {
     uint32_t inv    : 1;
 } flag_and_cond_t;
 
+/*Only used in LVGL's thread. The posted values are stored in the subject, so
+ *the posting threads never touch memory which is freed when deferring is disabled.*/
+typedef struct _lv_subject_deferred_t {
+    lv_subject_t * subject;
+} lv_subject_deferred_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void value_changed(lv_subject_t * subject);
+static void post_value(lv_subject_t * subject, lv_subject_type_t type, lv_subject_value_t value);
+static void apply_posted_value(lv_subject_t * subject);
+static void deferred_remove(lv_subject_t * subject);
+static void posted_async_cb(void * user_data);
 static void unsubscribe_on_delete_cb(lv_event_t * e);
 static void group_notify_cb(lv_observer_t * observer, lv_subject_t * subject);
 static lv_observer_t * bind_to_bitfield(lv_subject_t * subject, lv_obj_t * obj, lv_observer_cb_t cb, uint32_t flag,
@@ -74,6 +87,7 @@ static void obj_value_changed_event_cb(lv_event_t * e);
 
 void lv_subject_init_int(lv_subject_t * subject, int32_t value)
 {
+    deferred_remove(subject);
     lv_memzero(subject, sizeof(lv_subject_t));
     subject->type = LV_SUBJECT_TYPE_INT;
     subject->value.num = value;
@@ -88,9 +102,9 @@ void lv_subject_set_int(lv_subject_t * subject, int32_t value)
         return;
     }
 
-    subject->prev_value.num = subject->value.num;
+    if(!subject->notify_pending) subject->prev_value.num = subject->value.num;
     subject->value.num = value;
-    lv_subject_notify(subject);
+    value_changed(subject);
 }
 
 int32_t lv_subject_get_int(lv_subject_t * subject)
@@ -115,6 +129,7 @@ int32_t lv_subject_get_previous_int(lv_subject_t * subject)
 
 void lv_subject_init_string(lv_subject_t * subject, char * buf, char * prev_buf, size_t size, const char * value)
 {
+    deferred_remove(subject);
     lv_memzero(subject, sizeof(lv_subject_t));
     lv_strncpy(buf, value, size);
     if(prev_buf) lv_strncpy(prev_buf, value, size);
@@ -135,13 +150,13 @@ void lv_subject_copy_string(lv_subject_t * subject, const char * buf)
     }
 
     if(subject->size < 1) return;
-    if(subject->prev_value.pointer) {
+    if(subject->prev_value.pointer && !subject->notify_pending) {
         lv_strncpy((char *)subject->prev_value.pointer, subject->value.pointer, subject->size - 1);
     }
 
     lv_strncpy((char *)subject->value.pointer, buf, subject->size - 1);
 
-    lv_subject_notify(subject);
+    value_changed(subject);
 
 }
 
@@ -167,6 +182,7 @@ const char * lv_subject_get_previous_string(lv_subject_t * subject)
 
 void lv_subject_init_pointer(lv_subject_t * subject, void * value)
 {
+    deferred_remove(subject);
     lv_memzero(subject, sizeof(lv_subject_t));
     subject->type = LV_SUBJECT_TYPE_POINTER;
     subject->value.pointer = value;
@@ -181,9 +197,9 @@ void lv_subject_set_pointer(lv_subject_t * subject, void * ptr)
         return;
     }
 
-    subject->prev_value.pointer = subject->value.pointer;
+    if(!subject->notify_pending) subject->prev_value.pointer = subject->value.pointer;
     subject->value.pointer = ptr;
-    lv_subject_notify(subject);
+    value_changed(subject);
 }
 
 const void * lv_subject_get_pointer(lv_subject_t * subject)
@@ -208,6 +224,7 @@ const void * lv_subject_get_previous_pointer(lv_subject_t * subject)
 
 void lv_subject_init_color(lv_subject_t * subject, lv_color_t color)
 {
+    deferred_remove(subject);
     lv_memzero(subject, sizeof(lv_subject_t));
     subject->type = LV_SUBJECT_TYPE_COLOR;
     subject->value.color = color;
@@ -222,9 +239,9 @@ void lv_subject_set_color(lv_subject_t * subject, lv_color_t color)
         return;
     }
 
-    subject->prev_value.color = subject->value.color;
+    if(!subject->notify_pending) subject->prev_value.color = subject->value.color;
     subject->value.color = color;
-    lv_subject_notify(subject);
+    value_changed(subject);
 }
 
 lv_color_t lv_subject_get_color(lv_subject_t * subject)
@@ -249,6 +266,9 @@ lv_color_t lv_subject_get_previous_color(lv_subject_t * subject)
 
 void lv_subject_init_group(lv_subject_t * subject, lv_subject_t * list[], uint32_t list_len)
 {
+    deferred_remove(subject);
+    subject->deferred = NULL;
+    subject->notify_pending = 0;
     subject->type = LV_SUBJECT_TYPE_GROUP;
     subject->size = list_len;
     _lv_ll_init(&(subject->subs_ll), sizeof(lv_observer_t));
@@ -392,6 +412,8 @@ void lv_subject_notify(lv_subject_t * subject)
 {
     LV_ASSERT_NULL(subject);
 
+    subject->notify_pending = 0;
+
     lv_observer_t * observer;
     _LV_LL_READ(&(subject->subs_ll), observer) {
         observer->notified = 0;
@@ -409,6 +431,77 @@ void lv_subject_notify(lv_subject_t * subject)
     } while(subject->notify_restart_query);
 }
 
+void lv_subject_set_deferred(lv_subject_t * subject, bool en)
+{
+    LV_ASSERT_NULL(subject);
+    if(en == (subject->deferred != NULL)) return;
+
+    if(en) {
+        if(_lv_ll_get_head(deferred_ll_p) == NULL) _lv_ll_init(deferred_ll_p, sizeof(lv_subject_deferred_t));
+        lv_subject_deferred_t * deferred = _lv_ll_ins_tail(deferred_ll_p);
+        LV_ASSERT_MALLOC(deferred);
+        if(deferred == NULL) return;
+
+        deferred->subject = subject;
+        subject->deferred = deferred;
+
+        /*Don't apply a value posted before. If a post is in progress (odd) its value will be applied.*/
+        subject->applied_seq = lv_atomic_load(&subject->post_seq) & ~1U;
+    }
+    else {
+        apply_posted_value(subject);
+        deferred_remove(subject);
+
+        if(subject->notify_pending) lv_subject_notify(subject);
+    }
+}
+
+void lv_subject_post_int(lv_subject_t * subject, int32_t value)
+{
+    lv_subject_value_t v;
+    v.num = value;
+    post_value(subject, LV_SUBJECT_TYPE_INT, v);
+}
+
+void lv_subject_post_pointer(lv_subject_t * subject, void * ptr)
+{
+    lv_subject_value_t v;
+    v.pointer = ptr;
+    post_value(subject, LV_SUBJECT_TYPE_POINTER, v);
+}
+
+void lv_subject_post_color(lv_subject_t * subject, lv_color_t color)
+{
+    lv_subject_value_t v;
+    v.color = color;
+    post_value(subject, LV_SUBJECT_TYPE_COLOR, v);
+}
+
+void _lv_subject_notify_deferred(void)
+{
+    /*Get the next item first as the current one might be removed in an observer*/
+    lv_subject_deferred_t * deferred = _lv_ll_get_head(deferred_ll_p);
+    while(deferred) {
+        lv_subject_deferred_t * deferred_next = _lv_ll_get_next(deferred_ll_p, deferred);
+        lv_subject_t * subject = deferred->subject;
+
+        apply_posted_value(subject);
+        if(subject->notify_pending) lv_subject_notify(subject);
+
+        deferred = deferred_next;
+    }
+}
+
+void _lv_subject_deferred_deinit(void)
+{
+    lv_subject_deferred_t * deferred;
+    _LV_LL_READ(deferred_ll_p, deferred) {
+        deferred->subject->deferred = NULL;
+    }
+    _lv_ll_clear(deferred_ll_p);
+    lv_atomic_store(&post_pending, 0);
+}
+
 lv_observer_t * lv_obj_bind_flag_if_eq(lv_obj_t * obj, lv_subject_t * subject, lv_obj_flag_t flag, int32_t ref_value)
 {
     lv_observer_t * observable = bind_to_bitfield(subject, obj, obj_flag_observer_cb, flag, ref_value, false);
@@ -532,6 +625,115 @@ lv_observer_t * lv_dropdown_bind_value(lv_obj_t * obj, lv_subject_t * subject)
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Notify the observers about a new value, or if the notifications are deferred,
+ * just mark the subject and make sure the displays will be refreshed
+ */
+static void value_changed(lv_subject_t * subject)
+{
+    if(subject->deferred == NULL) {
+        lv_subject_notify(subject);
+        return;
+    }
+
+    if(subject->notify_pending) return;
+    subject->notify_pending = 1;
+
+    lv_display_t * disp = lv_display_get_next(NULL);
+    while(disp) {
+        lv_timer_t * refr_timer = lv_display_get_refr_timer(disp);
+        if(refr_timer) lv_timer_resume(refr_timer);
+        disp = lv_display_get_next(disp);
+    }
+}
+
+/**
+ * Store a value for the LVGL thread and wake it up. Runs in the posting thread.
+ * Only the subject itself is accessed as the deferred state might be freed meanwhile in LVGL's thread.
+ */
+static void post_value(lv_subject_t * subject, lv_subject_type_t type, lv_subject_value_t value)
+{
+    if(subject->type != type) {
+        LV_LOG_WARN("Subject type is not %d", (int)type);
+        return;
+    }
+
+    if(subject->deferred == NULL) {
+        LV_LOG_WARN("Deferred notifications are not enabled");
+        return;
+    }
+
+    /*Only this thread writes `post_seq`, so it can be read directly*/
+    uint32_t seq = subject->post_seq;
+    lv_atomic_store(&subject->post_seq, seq + 1);
+    lv_atomic_fence();
+    subject->post_value = value;
+    lv_atomic_store(&subject->post_seq, seq + 2);
+
+    /*Wake up LVGL's thread only once for all the values posted until it runs*/
+    uint32_t expected = 0;
+    if(lv_atomic_cas(&post_pending, &expected, 1)) {
+        if(lv_async_call_from_thread(posted_async_cb, NULL) != LV_RESULT_OK) {
+            /*The queue is full. The value is applied on the next refresh or post.*/
+            lv_atomic_store(&post_pending, 0);
+        }
+    }
+}
+
+/**
+ * Take the last value posted from an other thread, if there is a new one. Runs in LVGL's thread.
+ */
+static void apply_posted_value(lv_subject_t * subject)
+{
+    uint32_t seq = lv_atomic_load(&subject->post_seq);
+    if(seq == subject->applied_seq || (seq & 1)) return;
+
+    lv_subject_value_t value = subject->post_value;
+    lv_atomic_fence();
+
+    /*A new value is being written. It will be taken next time.*/
+    if(lv_atomic_load(&subject->post_seq) != seq) return;
+    subject->applied_seq = seq;
+
+    if(!subject->notify_pending) subject->prev_value = subject->value;
+    subject->value = value;
+    value_changed(subject);
+}
+
+/**
+ * Stop deferring the notifications of a subject.
+ * As the subject might not be initialized yet, it's searched in the list instead of using `subject->deferred`.
+ */
+static void deferred_remove(lv_subject_t * subject)
+{
+    lv_subject_deferred_t * deferred;
+    _LV_LL_READ(deferred_ll_p, deferred) {
+        if(deferred->subject == subject) break;
+    }
+    if(deferred == NULL) return;
+
+    subject->deferred = NULL;
+    _lv_ll_remove(deferred_ll_p, deferred);
+    lv_free(deferred);
+}
+
+/**
+ * Take the values posted from other threads. Called via `lv_async_call_from_thread()` by `post_value()`.
+ */
+static void posted_async_cb(void * user_data)
+{
+    LV_UNUSED(user_data);
+
+    /*Clear the flag before reading the values to get an other call for the values posted from now on*/
+    lv_atomic_store(&post_pending, 0);
+    lv_atomic_fence();
+
+    lv_subject_deferred_t * deferred;
+    _LV_LL_READ(deferred_ll_p, deferred) {
+        apply_posted_value(deferred->subject);
+    }
+}
+
 static void group_notify_cb(lv_observer_t * observer, lv_subject_t * subject)
 {
     LV_UNUSED(subject);
@@ -57,6 +57,11 @@ typedef struct {
     lv_subject_value_t value;           /**< Actual value*/
     lv_subject_value_t prev_value;      /**< Previous value*/
     uint32_t notify_restart_query : 1; /**< If an observer deleted start notifying from the beginning. */
+    uint32_t notify_pending : 1;        /**< The value has changed but the deferred notification is not sent yet*/
+    struct _lv_subject_deferred_t * deferred;  /**< Set if the notifications are deferred to the next refresh*/
+    volatile uint32_t post_seq;         /**< Odd while an other thread writes `post_value`*/
+    uint32_t applied_seq;               /**< `post_seq` of the last applied posted value*/
+    lv_subject_value_t post_value;      /**< The last value posted from an other thread*/
     void * user_data;                   /**< Additional parameter, can be used freely by the user*/
 } lv_subject_t;
 
@@ -287,6 +292,54 @@ static inline lv_obj_t * lv_observer_get_target_obj(lv_observer_t * observer)
  */
 void lv_subject_notify(lv_subject_t * subject);
 
+/**
+ * Enable or disable deferred notifications. If enabled, changing the value doesn't notify the observers
+ * immediately, but only once right before the next refresh, with the last value.
+ * It's useful for subjects updated much more often than the screen is refreshed.
+ * @param subject       pointer to a subject
+ * @param en            true: enable deferred notifications; false: notify the observers on each change
+ */
+void lv_subject_set_deferred(lv_subject_t * subject, bool en);
+
+/**
+ * Set the value of an integer subject from any thread, without locking LVGL.
+ * The value is applied and the observers are notified in LVGL's thread before the next refresh.
+ * Only the last value is kept if it's set more times between 2 refreshes.
+ * @param subject       pointer to a subject with deferred notifications (see `lv_subject_set_deferred()`)
+ * @param value         the new value
+ * @note                only one thread can set the value of a subject this way
+ * @note                posting while the subject is initialized again or deferring is disabled is safe
+ *                      but the value might be ignored
+ */
+void lv_subject_post_int(lv_subject_t * subject, int32_t value);
+
+/**
+ * Set the value of a pointer subject from any thread, without locking LVGL.
+ * @param subject       pointer to a subject with deferred notifications (see `lv_subject_set_deferred()`)
+ * @param ptr           the new value
+ * @note                see `lv_subject_post_int()`
+ */
+void lv_subject_post_pointer(lv_subject_t * subject, void * ptr);
+
+/**
+ * Set the value of a color subject from any thread, without locking LVGL.
+ * @param subject       pointer to a subject with deferred notifications (see `lv_subject_set_deferred()`)
+ * @param color         the new value
+ * @note                see `lv_subject_post_int()`
+ */
+void lv_subject_post_color(lv_subject_t * subject, lv_color_t color);
+
+/**
+ * Apply the posted values and send the pending deferred notifications.
+ * Called automatically before refreshing the displays.
+ */
+void _lv_subject_notify_deferred(void);
+
+/**
+ * Free the deferred states of the subjects. Called in `lv_deinit()`.
+ */
+void _lv_subject_deferred_deinit(void);
+
 /**
  * Set an object flag if an integer subject's value is equal to a reference value, clear the flag otherwise
  * @param obj           pointer to an object
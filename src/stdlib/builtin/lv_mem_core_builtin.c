@@ -38,14 +38,49 @@
 #endif
 #define state LV_GLOBAL_DEFAULT()->tlsf_state
 
+#if LV_MEM_USE_SLAB
+    #if (LV_MEM_SLAB_SIZE & (LV_MEM_SLAB_SIZE - 1)) != 0
+        #error "LV_MEM_SLAB_SIZE must be a power of 2"
+    #endif
+    #define SLAB_SLOT_SIZE(class_idx)  (((size_t)(class_idx) + 1) * 8)
+    #define SLAB_HEADER_SIZE           ((sizeof(lv_mem_slab_t) + 7) & ~(size_t)7)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_MEM_USE_SLAB
+/**
+ * A slab is a `LV_MEM_SLAB_SIZE` aligned block of the heap which is divided into equally sized slots.
+ * The slots are handed out either from the free list or, if it's empty, sequentially from `unused_idx`.
+ */
+struct _lv_mem_slab_t {
+    lv_mem_slab_t * prev;   /*Neighbors in `slab_partial` if the slab has free slots*/
+    lv_mem_slab_t * next;
+    void * free_list;       /*Freed slots. The first bytes of a free slot point to the next one*/
+    uint16_t unused_idx;    /*Index of the first never used slot*/
+    uint16_t slot_cnt;
+    uint16_t used_cnt;
+    uint8_t class_idx;
+    uint8_t in_partial : 1;
+};
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void lv_mem_walker(void * ptr, size_t size, int used, void * user);
+static void * heap_malloc(size_t size);
+static void heap_free(void * p);
+#if LV_MEM_USE_SLAB
+    static void * slab_malloc(size_t size);
+    static void slab_free(lv_mem_slab_t * slab, void * p);
+    static lv_mem_slab_t * slab_find(void * p);
+    static lv_mem_slab_t * slab_create(uint32_t class_idx);
+    static void slab_destroy(lv_mem_slab_t * slab);
+    static void slab_partial_add(lv_mem_slab_t * slab);
+    static void slab_partial_remove(lv_mem_slab_t * slab);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -86,6 +121,15 @@ void lv_mem_init(void)
     state.tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
 
+#if LV_MEM_USE_SLAB
+    lv_memzero(state.slab_partial, sizeof(state.slab_partial));
+    state.slab_registry = NULL;
+    state.slab_cnt = 0;
+    state.slab_registry_cap = 0;
+    state.slab_alloc_cnt = 0;
+    state.heap_alloc_cnt = 0;
+#endif
+
     _lv_ll_init(&state.pool_ll, sizeof(lv_pool_t));
 
     /*Record the first pool*/
@@ -141,12 +185,12 @@ void * lv_malloc_core(size_t size)
 #if LV_USE_OS
     lv_mutex_lock(&state.mutex);
 #endif
-    void * p = lv_tlsf_malloc(state.tlsf, size);
-
-    if(p) {
-        state.cur_used += lv_tlsf_block_size(p);
-        state.max_used = LV_MAX(state.cur_used, state.max_used);
-    }
+    void * p = NULL;
+#if LV_MEM_USE_SLAB
+    if(size <= LV_MEM_SLAB_MAX_SIZE) p = slab_malloc(size);
+#endif
+    /*Fall back to the heap if the slabs couldn't serve the request*/
+    if(p == NULL) p = heap_malloc(size);
 
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -160,6 +204,33 @@ void * lv_realloc_core(void * p, size_t new_size)
     lv_mutex_lock(&state.mutex);
 #endif
 
+#if LV_MEM_USE_SLAB
+    lv_mem_slab_t * slab = slab_find(p);
+    if(slab) {
+        size_t slot_size = SLAB_SLOT_SIZE(slab->class_idx);
+        /*Keep the slot if the new data still fits but needs this class. When shrinking to a smaller class
+         *move the data, else e.g. a shrunk array would hold a large slot for a few bytes until it's freed.*/
+        if(new_size <= slot_size && (slab->class_idx == 0 || new_size > SLAB_SLOT_SIZE(slab->class_idx - 1))) {
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return p;
+        }
+
+        void * p_new = NULL;
+        if(new_size <= LV_MEM_SLAB_MAX_SIZE) p_new = slab_malloc(new_size);
+        if(p_new == NULL) p_new = heap_malloc(new_size);
+        if(p_new) {
+            lv_memcpy(p_new, p, LV_MIN(slot_size, new_size));
+            slab_free(slab, p);
+        }
+#if LV_USE_OS
+        lv_mutex_unlock(&state.mutex);
+#endif
+        return p_new;
+    }
+#endif
+
     size_t old_size = lv_tlsf_block_size(p);
     void * p_new = lv_tlsf_realloc(state.tlsf, p, new_size);
 
@@ -181,13 +252,13 @@ void lv_free_core(void * p)
     lv_mutex_lock(&state.mutex);
 #endif
 
-#if LV_MEM_ADD_JUNK
-    lv_memset(p, 0xbb, lv_tlsf_block_size(data));
+#if LV_MEM_USE_SLAB
+    lv_mem_slab_t * slab = slab_find(p);
+    if(slab) slab_free(slab, p);
+    else heap_free(p);
+#else
+    heap_free(p);
 #endif
-    size_t size = lv_tlsf_block_size(p);
-    lv_tlsf_free(state.tlsf, p);
-    if(state.cur_used > size) state.cur_used -= size;
-    else state.cur_used = 0;
 
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -216,9 +287,58 @@ void lv_mem_monitor_core(lv_mem_monitor_t * mon_p)
 
     mon_p->max_used = state.max_used;
 
+#if LV_MEM_USE_SLAB
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+    uint32_t i;
+    for(i = 0; i < state.slab_cnt; i++) {
+        lv_mem_slab_t * slab = state.slab_registry[i];
+        mon_p->slab_size += LV_MEM_SLAB_SIZE;
+        /*Everything the slab takes from the heap but no allocation uses: free slots, header and padding*/
+        mon_p->slab_free_size += lv_tlsf_block_size(slab) + lv_tlsf_alloc_overhead() -
+                                 (size_t)slab->used_cnt * SLAB_SLOT_SIZE(slab->class_idx);
+    }
+    if(state.slab_registry) {
+        mon_p->slab_free_size += lv_tlsf_block_size(state.slab_registry) + lv_tlsf_alloc_overhead();
+    }
+    mon_p->slab_alloc_cnt = state.slab_alloc_cnt;
+    mon_p->heap_alloc_cnt = state.heap_alloc_cnt;
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+#endif
+
     LV_TRACE_MEM("finished");
 }
 
+#if LV_MEM_USE_SLAB
+void lv_mem_slab_trim(void)
+{
+#if LV_USE_OS
+    lv_mutex_lock(&state.mutex);
+#endif
+
+    /*Destroying a slab moves the next ones in the registry, so go backwards*/
+    uint32_t i = state.slab_cnt;
+    while(i > 0) {
+        i--;
+        lv_mem_slab_t * slab = state.slab_registry[i];
+        if(slab->used_cnt == 0) slab_destroy(slab);
+    }
+
+    if(state.slab_cnt == 0 && state.slab_registry) {
+        lv_tlsf_free(state.tlsf, state.slab_registry);
+        state.slab_registry = NULL;
+        state.slab_registry_cap = 0;
+    }
+
+#if LV_USE_OS
+    lv_mutex_unlock(&state.mutex);
+#endif
+}
+#endif
+
 lv_result_t lv_mem_test_core(void)
 {
 #if LV_USE_OS
@@ -243,6 +363,21 @@ lv_result_t lv_mem_test_core(void)
         }
     }
 
+#if LV_MEM_USE_SLAB
+    uint32_t i;
+    for(i = 0; i < state.slab_cnt; i++) {
+        lv_mem_slab_t * slab = state.slab_registry[i];
+        if(slab->used_cnt > slab->unused_idx || slab->unused_idx > slab->slot_cnt ||
+           (i > 0 && state.slab_registry[i - 1] >= slab)) {
+            LV_LOG_WARN("slab failed");
+#if LV_USE_OS
+            lv_mutex_unlock(&state.mutex);
+#endif
+            return LV_RESULT_INVALID;
+        }
+    }
+#endif
+
     LV_TRACE_MEM("passed");
 #if LV_USE_OS
     lv_mutex_unlock(&state.mutex);
@@ -270,4 +405,176 @@ static void lv_mem_walker(void * ptr, size_t size, int used, void * user)
             mon_p->free_biggest_size = size;
     }
 }
+static void * heap_malloc(size_t size)
+{
+    void * p = lv_tlsf_malloc(state.tlsf, size);
+
+    if(p) {
+        state.cur_used += lv_tlsf_block_size(p);
+        state.max_used = LV_MAX(state.cur_used, state.max_used);
+#if LV_MEM_USE_SLAB
+        state.heap_alloc_cnt++;
+#endif
+    }
+
+    return p;
+}
+
+static void heap_free(void * p)
+{
+#if LV_MEM_ADD_JUNK
+    lv_memset(p, 0xbb, lv_tlsf_block_size(p));
+#endif
+    size_t size = lv_tlsf_block_size(p);
+    lv_tlsf_free(state.tlsf, p);
+    if(state.cur_used > size) state.cur_used -= size;
+    else state.cur_used = 0;
+}
+
+#if LV_MEM_USE_SLAB
+
+static void * slab_malloc(size_t size)
+{
+    uint32_t class_idx = (uint32_t)((size - 1) / 8);
+    lv_mem_slab_t * slab = state.slab_partial[class_idx];
+    if(slab == NULL) {
+        slab = slab_create(class_idx);
+        if(slab == NULL) return NULL;
+    }
+
+    void * p;
+    if(slab->free_list) {
+        p = slab->free_list;
+        slab->free_list = *(void **)p;
+    }
+    else {
+        p = (uint8_t *)slab + SLAB_HEADER_SIZE + slab->unused_idx * SLAB_SLOT_SIZE(class_idx);
+        slab->unused_idx++;
+    }
+
+    slab->used_cnt++;
+    if(slab->used_cnt == slab->slot_cnt) slab_partial_remove(slab);
+
+    state.slab_alloc_cnt++;
+    return p;
+}
+
+static void slab_free(lv_mem_slab_t * slab, void * p)
+{
+#if LV_MEM_ADD_JUNK
+    lv_memset(p, 0xbb, SLAB_SLOT_SIZE(slab->class_idx));
+#endif
+
+    *(void **)p = slab->free_list;
+    slab->free_list = p;
+    slab->used_cnt--;
+
+    if(slab->used_cnt == 0) {
+        /*Keep an empty slab only if it's the last one of its class to avoid thrashing*/
+        if(slab->in_partial && (slab->prev || slab->next)) {
+            slab_destroy(slab);
+            return;
+        }
+        /*Restart the sequential allocation to touch the slots in order again*/
+        slab->free_list = NULL;
+        slab->unused_idx = 0;
+    }
+
+    if(!slab->in_partial) slab_partial_add(slab);
+}
+
+/**
+ * Find the slab which contains `p`.
+ * Slabs are `LV_MEM_SLAB_SIZE` aligned so only the rounded down address needs to be searched
+ * among the sorted slab addresses.
+ */
+static lv_mem_slab_t * slab_find(void * p)
+{
+    lv_mem_slab_t * slab = (lv_mem_slab_t *)((lv_uintptr_t)p & ~((lv_uintptr_t)LV_MEM_SLAB_SIZE - 1));
+    int32_t min = 0;
+    int32_t max = (int32_t)state.slab_cnt - 1;
+    while(min <= max) {
+        int32_t mid = (min + max) / 2;
+        lv_mem_slab_t * act = state.slab_registry[mid];
+        if(act == slab) return slab;
+        if(act < slab) min = mid + 1;
+        else max = mid - 1;
+    }
+
+    return NULL;
+}
+
+static lv_mem_slab_t * slab_create(uint32_t class_idx)
+{
+    if(state.slab_cnt == state.slab_registry_cap) {
+        uint32_t new_cap = state.slab_registry_cap ? state.slab_registry_cap * 2 : 8;
+        lv_mem_slab_t ** new_registry = lv_tlsf_realloc(state.tlsf, state.slab_registry,
+                                                        new_cap * sizeof(lv_mem_slab_t *));
+        if(new_registry == NULL) return NULL;
+        state.slab_registry = new_registry;
+        state.slab_registry_cap = new_cap;
+    }
+
+    lv_mem_slab_t * slab = lv_tlsf_memalign(state.tlsf, LV_MEM_SLAB_SIZE, LV_MEM_SLAB_SIZE);
+    if(slab == NULL) return NULL;
+
+    state.cur_used += lv_tlsf_block_size(slab);
+    state.max_used = LV_MAX(state.cur_used, state.max_used);
+
+    lv_memzero(slab, sizeof(lv_mem_slab_t));
+    slab->class_idx = (uint8_t)class_idx;
+    slab->slot_cnt = (uint16_t)((LV_MEM_SLAB_SIZE - SLAB_HEADER_SIZE) / SLAB_SLOT_SIZE(class_idx));
+
+    /*Insert into the registry keeping it sorted*/
+    uint32_t i = state.slab_cnt;
+    while(i > 0 && state.slab_registry[i - 1] > slab) {
+        state.slab_registry[i] = state.slab_registry[i - 1];
+        i--;
+    }
+    state.slab_registry[i] = slab;
+    state.slab_cnt++;
+
+    slab_partial_add(slab);
+    return slab;
+}
+
+static void slab_destroy(lv_mem_slab_t * slab)
+{
+    slab_partial_remove(slab);
+
+    uint32_t i = 0;
+    while(state.slab_registry[i] != slab) i++;
+    for(; i < state.slab_cnt - 1; i++) {
+        state.slab_registry[i] = state.slab_registry[i + 1];
+    }
+    state.slab_cnt--;
+
+    heap_free(slab);
+}
+
+static void slab_partial_add(lv_mem_slab_t * slab)
+{
+    lv_mem_slab_t ** head = &state.slab_partial[slab->class_idx];
+    slab->prev = NULL;
+    slab->next = *head;
+    if(*head) (*head)->prev = slab;
+    *head = slab;
+    slab->in_partial = 1;
+}
+
+static void slab_partial_remove(lv_mem_slab_t * slab)
+{
+    if(!slab->in_partial) return;
+
+    if(slab->prev) slab->prev->next = slab->next;
+    else state.slab_partial[slab->class_idx] = slab->next;
+    if(slab->next) slab->next->prev = slab->prev;
+
+    slab->prev = NULL;
+    slab->next = NULL;
+    slab->in_partial = 0;
+}
+
+#endif /*LV_MEM_USE_SLAB*/
+
 #endif /*LV_STDLIB_BUILTIN*/
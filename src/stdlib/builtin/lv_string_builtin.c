@@ -24,6 +24,32 @@
     #define ALIGN_MASK       0x3
 #endif
 
+/*Select the widest vector unit the compiler targets. Only unaligned loads and stores are used.*/
+#if LV_STRING_USE_SIMD
+    #if defined(__AVX2__)
+        #include <immintrin.h>
+        #define SIMD_SIZE           32
+        #define SIMD_LOAD(p)        _mm256_loadu_si256((const __m256i *)(p))
+        #define SIMD_STORE(p, v)    _mm256_storeu_si256((__m256i *)(p), v)
+        #define SIMD_SPLAT(v)       _mm256_set1_epi8((char)(v))
+        typedef __m256i simd_t;
+    #elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #include <emmintrin.h>
+        #define SIMD_SIZE           16
+        #define SIMD_LOAD(p)        _mm_loadu_si128((const __m128i *)(p))
+        #define SIMD_STORE(p, v)    _mm_storeu_si128((__m128i *)(p), v)
+        #define SIMD_SPLAT(v)       _mm_set1_epi8((char)(v))
+        typedef __m128i simd_t;
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #include <arm_neon.h>
+        #define SIMD_SIZE           16
+        #define SIMD_LOAD(p)        vld1q_u8((const uint8_t *)(p))
+        #define SIMD_STORE(p, v)    vst1q_u8((uint8_t *)(p), v)
+        #define SIMD_SPLAT(v)       vdupq_n_u8(v)
+        typedef uint8x16_t simd_t;
+    #endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -69,6 +95,47 @@ void * LV_ATTRIBUTE_FAST_MEM lv_memcpy(void * dst, const void * src, size_t len)
         return dst;
     }
 
+#ifdef SIMD_SIZE
+    /*`lv_memmove()` uses this function for forward copies of overlapping memories.
+     *The first and last blocks are copied ahead, so handle only the non-overlapping case here.*/
+    if(len >= SIMD_SIZE && (d8 + len <= s8 || s8 + len <= d8)) {
+        uint8_t * d_end = d8 + len;
+        simd_t tail = SIMD_LOAD(s8 + len - SIMD_SIZE);
+
+        /*Copy the first block unaligned and continue from the next aligned destination address*/
+        SIMD_STORE(d8, SIMD_LOAD(s8));
+        size_t skip = SIMD_SIZE - ((lv_uintptr_t)d8 & (SIMD_SIZE - 1));
+        d8 += skip;
+        s8 += skip;
+        len -= skip;
+
+        while(len >= 4 * SIMD_SIZE) {
+            simd_t v0 = SIMD_LOAD(s8);
+            simd_t v1 = SIMD_LOAD(s8 + SIMD_SIZE);
+            simd_t v2 = SIMD_LOAD(s8 + 2 * SIMD_SIZE);
+            simd_t v3 = SIMD_LOAD(s8 + 3 * SIMD_SIZE);
+            SIMD_STORE(d8, v0);
+            SIMD_STORE(d8 + SIMD_SIZE, v1);
+            SIMD_STORE(d8 + 2 * SIMD_SIZE, v2);
+            SIMD_STORE(d8 + 3 * SIMD_SIZE, v3);
+            d8 += 4 * SIMD_SIZE;
+            s8 += 4 * SIMD_SIZE;
+            len -= 4 * SIMD_SIZE;
+        }
+
+        while(len >= SIMD_SIZE) {
+            SIMD_STORE(d8, SIMD_LOAD(s8));
+            d8 += SIMD_SIZE;
+            s8 += SIMD_SIZE;
+            len -= SIMD_SIZE;
+        }
+
+        /*The last block might overlap with the already copied bytes*/
+        SIMD_STORE(d_end - SIMD_SIZE, tail);
+        return dst;
+    }
+#endif
+
     lv_uintptr_t d_align = (lv_uintptr_t)d8 & ALIGN_MASK;
     lv_uintptr_t s_align = (lv_uintptr_t)s8 & ALIGN_MASK;
 
@@ -118,6 +185,38 @@ void * LV_ATTRIBUTE_FAST_MEM lv_memcpy(void * dst, const void * src, size_t len)
 void LV_ATTRIBUTE_FAST_MEM lv_memset(void * dst, uint8_t v, size_t len)
 {
     uint8_t * d8 = (uint8_t *)dst;
+
+#ifdef SIMD_SIZE
+    if(len >= SIMD_SIZE) {
+        uint8_t * d_end = d8 + len;
+        simd_t v_simd = SIMD_SPLAT(v);
+
+        /*Set the first block unaligned and continue from the next aligned address*/
+        SIMD_STORE(d8, v_simd);
+        size_t skip = SIMD_SIZE - ((lv_uintptr_t)d8 & (SIMD_SIZE - 1));
+        d8 += skip;
+        len -= skip;
+
+        while(len >= 4 * SIMD_SIZE) {
+            SIMD_STORE(d8, v_simd);
+            SIMD_STORE(d8 + SIMD_SIZE, v_simd);
+            SIMD_STORE(d8 + 2 * SIMD_SIZE, v_simd);
+            SIMD_STORE(d8 + 3 * SIMD_SIZE, v_simd);
+            d8 += 4 * SIMD_SIZE;
+            len -= 4 * SIMD_SIZE;
+        }
+
+        while(len >= SIMD_SIZE) {
+            SIMD_STORE(d8, v_simd);
+            d8 += SIMD_SIZE;
+            len -= SIMD_SIZE;
+        }
+
+        SIMD_STORE(d_end - SIMD_SIZE, v_simd);
+        return;
+    }
+#endif
+
     uintptr_t d_align = (lv_uintptr_t) d8 & ALIGN_MASK;
 
     /*Make the address aligned*/
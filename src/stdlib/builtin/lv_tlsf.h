@@ -54,6 +54,12 @@ extern "C" {
 typedef void * lv_tlsf_t;
 typedef void * lv_pool_t;
 
+#if LV_MEM_USE_SLAB
+#define LV_MEM_SLAB_CLASS_CNT   ((LV_MEM_SLAB_MAX_SIZE + 7) / 8)
+
+typedef struct _lv_mem_slab_t lv_mem_slab_t;
+#endif
+
 typedef struct {
 #if LV_USE_OS
     lv_mutex_t mutex;
@@ -62,6 +68,14 @@ typedef struct {
     size_t cur_used;
     size_t max_used;
     lv_ll_t  pool_ll;
+#if LV_MEM_USE_SLAB
+    lv_mem_slab_t * slab_partial[LV_MEM_SLAB_CLASS_CNT];   /*Slabs with free slots per size class*/
+    lv_mem_slab_t ** slab_registry;     /*All slabs sorted by address to find the slab of a pointer*/
+    uint32_t slab_cnt;
+    uint32_t slab_registry_cap;
+    uint32_t slab_alloc_cnt;
+    uint32_t heap_alloc_cnt;
+#endif
 } lv_tlsf_state_t;
 
 /* Create/destroy a memory pool. */
@@ -6,6 +6,7 @@
  *      INCLUDES
  *********************/
 #include "lv_mem.h"
+#include "lv_mem_track.h"
 #include "lv_string.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_log.h"
@@ -32,6 +33,8 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void * malloc_internal(size_t size, bool zeroed, const char * file, uint32_t line);
+static void * realloc_internal(void * data_p, size_t new_size, const char * file, uint32_t line);
 
 /**********************
  *  GLOBAL PROTOTYPES
@@ -55,41 +58,83 @@ lv_result_t lv_mem_test_core(void);
     #define LV_TRACE_MEM(...)
 #endif
 
+/*Define the functions below instead of the call site recording macros of `lv_mem.h`*/
+#if LV_USE_MEM_TRACK
+    #undef lv_malloc
+    #undef lv_malloc_zeroed
+    #undef lv_realloc
+#endif
+
 /**********************
  *   GLOBAL FUNCTIONS
  **********************/
 
 void * lv_malloc(size_t size)
 {
-    LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
-    if(size == 0) {
-        LV_TRACE_MEM("using zero_mem");
-        return &zero_mem;
-    }
+    return malloc_internal(size, false, NULL, 0);
+}
 
-    void * alloc = lv_malloc_core(size);
+void * lv_malloc_zeroed(size_t size)
+{
+    return malloc_internal(size, true, NULL, 0);
+}
 
-    if(alloc == NULL) {
-        LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
-#if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
-        lv_mem_monitor_t mon;
-        lv_mem_monitor(&mon);
-        LV_LOG_INFO("used: %zu (%3d %%), frag: %3d %%, biggest free: %zu",
-                    mon.total_size - mon.free_size, mon.used_pct, mon.frag_pct,
-                    mon.free_biggest_size);
+void lv_free(void * data)
+{
+    LV_TRACE_MEM("freeing %p", data);
+    if(data == &zero_mem) return;
+    if(data == NULL) return;
+
+#if LV_USE_MEM_TRACK
+    data = _lv_mem_track_remove(data);
 #endif
-        return NULL;
-    }
 
-#if LV_MEM_ADD_JUNK
-    lv_memset(alloc, 0xaa, size);
+    lv_free_core(data);
+}
+
+void * lv_realloc(void * data_p, size_t new_size)
+{
+    return realloc_internal(data_p, new_size, NULL, 0);
+}
+
+#if LV_USE_MEM_TRACK
+void * lv_malloc_tracked(size_t size, const char * file, uint32_t line)
+{
+    return malloc_internal(size, false, file, line);
+}
+
+void * lv_malloc_zeroed_tracked(size_t size, const char * file, uint32_t line)
+{
+    return malloc_internal(size, true, file, line);
+}
+
+void * lv_realloc_tracked(void * data_p, size_t new_size, const char * file, uint32_t line)
+{
+    return realloc_internal(data_p, new_size, file, line);
+}
 #endif
 
-    LV_TRACE_MEM("allocated at %p", alloc);
-    return alloc;
+lv_result_t lv_mem_test(void)
+{
+    if(zero_mem != ZERO_MEM_SENTINEL) {
+        LV_LOG_WARN("zero_mem is written");
+        return LV_RESULT_INVALID;
+    }
+
+    return lv_mem_test_core();
 }
 
-void * lv_malloc_zeroed(size_t size)
+void lv_mem_monitor(lv_mem_monitor_t * mon_p)
+{
+    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
+    lv_mem_monitor_core(mon_p);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * malloc_internal(size_t size, bool zeroed, const char * file, uint32_t line)
 {
     LV_TRACE_MEM("allocating %lu bytes", (unsigned long)size);
     if(size == 0) {
@@ -97,7 +142,14 @@ void * lv_malloc_zeroed(size_t size)
         return &zero_mem;
     }
 
+#if LV_USE_MEM_TRACK
+    void * alloc = lv_malloc_core(size + LV_MEM_TRACK_HEADER_SIZE);
+#else
+    LV_UNUSED(file);
+    LV_UNUSED(line);
     void * alloc = lv_malloc_core(size);
+#endif
+
     if(alloc == NULL) {
         LV_LOG_INFO("couldn't allocate memory (%lu bytes)", (unsigned long)size);
 #if LV_LOG_LEVEL <= LV_LOG_LEVEL_INFO
@@ -110,22 +162,24 @@ void * lv_malloc_zeroed(size_t size)
         return NULL;
     }
 
-    lv_memzero(alloc, size);
+#if LV_USE_MEM_TRACK
+    alloc = _lv_mem_track_add(alloc, size, file, line);
+#endif
+
+    if(zeroed) {
+        lv_memzero(alloc, size);
+    }
+#if LV_MEM_ADD_JUNK
+    else {
+        lv_memset(alloc, 0xaa, size);
+    }
+#endif
 
     LV_TRACE_MEM("allocated at %p", alloc);
     return alloc;
 }
 
-void lv_free(void * data)
-{
-    LV_TRACE_MEM("freeing %p", data);
-    if(data == &zero_mem) return;
-    if(data == NULL) return;
-
-    lv_free_core(data);
-}
-
-void * lv_realloc(void * data_p, size_t new_size)
+static void * realloc_internal(void * data_p, size_t new_size, const char * file, uint32_t line)
 {
     LV_TRACE_MEM("reallocating %p with %lu size", data_p, (unsigned long)new_size);
     if(new_size == 0) {
@@ -134,9 +188,13 @@ void * lv_realloc(void * data_p, size_t new_size)
         return &zero_mem;
     }
 
-    if(data_p == &zero_mem) return lv_malloc(new_size);
+    if(data_p == &zero_mem || data_p == NULL) return malloc_internal(new_size, false, file, line);
 
+#if LV_USE_MEM_TRACK
+    void * new_p = _lv_mem_track_realloc(data_p, new_size, file, line);
+#else
     void * new_p = lv_realloc_core(data_p, new_size);
+#endif
 
     if(new_p == NULL) {
         LV_LOG_ERROR("couldn't reallocate memory");
@@ -146,23 +204,3 @@ void * lv_realloc(void * data_p, size_t new_size)
     LV_TRACE_MEM("reallocated at %p", new_p);
     return new_p;
 }
-
-lv_result_t lv_mem_test(void)
-{
-    if(zero_mem != ZERO_MEM_SENTINEL) {
-        LV_LOG_WARN("zero_mem is written");
-        return LV_RESULT_INVALID;
-    }
-
-    return lv_mem_test_core();
-}
-
-void lv_mem_monitor(lv_mem_monitor_t * mon_p)
-{
-    lv_memzero(mon_p, sizeof(lv_mem_monitor_t));
-    lv_mem_monitor_core(mon_p);
-}
-
-/**********************
- *   STATIC FUNCTIONS
- **********************/
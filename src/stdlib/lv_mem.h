@@ -41,6 +41,10 @@ typedef struct {
     size_t max_used; /**< Max size of Heap memory used*/
     uint8_t used_pct; /**< Percentage used*/
     uint8_t frag_pct; /**< Amount of fragmentation*/
+    size_t slab_size; /**< Memory reserved by slabs for small allocations (counted as used)*/
+    size_t slab_free_size; /**< Heap memory taken by the slabs but not used by allocations (free slots, headers)*/
+    uint32_t slab_alloc_cnt; /**< Number of allocations served from slabs*/
+    uint32_t heap_alloc_cnt; /**< Number of allocations served directly by the heap*/
 } lv_mem_monitor_t;
 
 /**********************
@@ -90,6 +94,36 @@ void lv_free(void * data);
  */
 void * lv_realloc(void * data_p, size_t new_size);
 
+#if LV_USE_MEM_TRACK
+/**
+ * Same as `lv_malloc()` but records the call site. Called by the `lv_malloc()` macro.
+ * @param size      requested size in bytes
+ * @param file      source file of the call site
+ * @param line      line of the call site
+ * @return          pointer to allocated uninitialized memory, or NULL on failure
+ */
+void * lv_malloc_tracked(size_t size, const char * file, uint32_t line);
+
+/**
+ * Same as `lv_malloc_zeroed()` but records the call site. Called by the `lv_malloc_zeroed()` macro.
+ * @param size      requested size in bytes
+ * @param file      source file of the call site
+ * @param line      line of the call site
+ * @return          pointer to allocated zeroed memory, or NULL on failure
+ */
+void * lv_malloc_zeroed_tracked(size_t size, const char * file, uint32_t line);
+
+/**
+ * Same as `lv_realloc()` but records the call site. Called by the `lv_realloc()` macro.
+ * @param data_p    pointer to an allocated memory
+ * @param new_size  the desired new size in byte
+ * @param file      source file of the call site
+ * @param line      line of the call site
+ * @return          pointer to the new memory, NULL on failure
+ */
+void * lv_realloc_tracked(void * data_p, size_t new_size, const char * file, uint32_t line);
+#endif
+
 /**
  * Used internally to execute a plain `malloc` operation
  * @param size      size in bytes to `malloc`
@@ -130,10 +164,25 @@ lv_result_t lv_mem_test(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+#if LV_USE_STDLIB_MALLOC == LV_STDLIB_BUILTIN && LV_MEM_USE_SLAB
+/**
+ * Return the empty slabs to the heap, including the ones kept as a reserve for the next small allocations.
+ * It's useful before measuring the free memory, e.g. to find memory leaks.
+ */
+void lv_mem_slab_trim(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
 
+#if LV_USE_MEM_TRACK
+/*Record the call sites for `lv_mem_track`. Without parentheses the names still refer to the functions.*/
+#define lv_malloc(size)                 lv_malloc_tracked(size, __FILE__, __LINE__)
+#define lv_malloc_zeroed(size)          lv_malloc_zeroed_tracked(size, __FILE__, __LINE__)
+#define lv_realloc(data_p, new_size)    lv_realloc_tracked(data_p, new_size, __FILE__, __LINE__)
+#endif
+
 #ifdef __cplusplus
 } /*extern "C"*/
 #endif
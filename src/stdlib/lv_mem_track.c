@@ -0,0 +1,420 @@
+/**
+ * @file lv_mem_track.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_mem_track.h"
+#if LV_USE_MEM_TRACK
+
+#include "lv_mem.h"
+#include "lv_sprintf.h"
+#include "../core/lv_global.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+#include "../tick/lv_tick.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define state LV_GLOBAL_DEFAULT()->mem_track_state
+
+#define header_of(p)    ((lv_mem_track_header_t *)((uint8_t *)(p) - LV_MEM_TRACK_HEADER_SIZE))
+#define data_of(hdr)    ((void *)((uint8_t *)(hdr) + LV_MEM_TRACK_HEADER_SIZE))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_mem_track_site_t * site_get(const char * file, uint32_t line);
+static lv_mem_track_tag_t * tag_get(const char * name);
+static void list_add(lv_mem_track_header_t * hdr);
+static void list_remove(lv_mem_track_header_t * hdr);
+static void live_add(lv_mem_track_header_t * hdr);
+static void live_remove(lv_mem_track_header_t * hdr);
+static void site_freed(lv_mem_track_header_t * hdr);
+static void collect_since(uint32_t mark);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_USE_OS
+    #define TRACK_LOCK()    lv_mutex_lock(&state.mutex)
+    #define TRACK_UNLOCK()  lv_mutex_unlock(&state.mutex)
+#else
+    #define TRACK_LOCK()
+    #define TRACK_UNLOCK()
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_mem_track_init(void)
+{
+    lv_memzero(&state, sizeof(state));
+
+    /*Use the core allocator to not track the tracker itself*/
+    size_t sites_size = sizeof(lv_mem_track_site_t) * LV_MEM_TRACK_SITE_CNT;
+    size_t tags_size = sizeof(lv_mem_track_tag_t) * LV_MEM_TRACK_TAG_CNT;
+    uint8_t * buf = lv_malloc_core(sites_size + tags_size);
+    LV_ASSERT_MALLOC(buf);
+    if(buf == NULL) return;
+    lv_memzero(buf, sites_size + tags_size);
+
+    state.sites = (lv_mem_track_site_t *)buf;
+    state.tags = (lv_mem_track_tag_t *)(buf + sites_size);
+    state.site_overflow.file = "(other sites)";
+    state.tag_overflow.name = "(other tags)";
+    state.tag_none.name = "(untagged)";
+    state.mark_act = 1;
+
+#if LV_USE_OS
+    lv_mutex_init(&state.mutex);
+#endif
+}
+
+void lv_mem_track_deinit(void)
+{
+    if(state.sites == NULL) return;
+
+    if(state.live_cnt) {
+        LV_LOG_WARN("%" LV_PRIu32 " allocations (%zu bytes) are still alive", state.live_cnt, state.live_size);
+    }
+
+    /*Detach the remaining allocations so that freeing them later won't touch the tracker*/
+    lv_mem_track_header_t * hdr = state.head;
+    while(hdr) {
+        lv_mem_track_header_t * next = hdr->next;
+        hdr->prev = NULL;
+        hdr->next = NULL;
+        hdr->site = NULL;
+        hdr->tag = NULL;
+        hdr = next;
+    }
+
+#if LV_USE_OS
+    lv_mutex_delete(&state.mutex);
+#endif
+
+    lv_free_core(state.sites);
+    lv_memzero(&state, sizeof(state));
+}
+
+const char * lv_mem_track_set_tag(const char * tag)
+{
+    const char * prev = state.tag_act;
+    state.tag_act = tag;
+    return prev;
+}
+
+uint32_t lv_mem_track_mark(void)
+{
+    TRACK_LOCK();
+    state.mark_act++;
+    uint32_t mark = state.mark_act;
+    TRACK_UNLOCK();
+
+    return mark;
+}
+
+void lv_mem_track_dump(uint32_t mark)
+{
+    if(state.sites == NULL) return;
+
+    TRACK_LOCK();
+
+    collect_since(mark);
+
+    uint32_t cnt = 0;
+    size_t size = 0;
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TRACK_SITE_CNT; i++) {
+        cnt += state.sites[i].mark_cnt;
+        size += state.sites[i].mark_size;
+    }
+    cnt += state.site_overflow.mark_cnt;
+    size += state.site_overflow.mark_size;
+
+    LV_LOG("Live allocations since mark %" LV_PRIu32 ": %" LV_PRIu32 " (%zu bytes)\n", mark, cnt, size);
+
+    LV_LOG("Per call site:\n");
+    for(i = 0; i <= LV_MEM_TRACK_SITE_CNT; i++) {
+        lv_mem_track_site_t * site = i < LV_MEM_TRACK_SITE_CNT ? &state.sites[i] : &state.site_overflow;
+        if(site->mark_cnt == 0) continue;
+        uint32_t lifetime_avg = site->free_cnt ? (uint32_t)(site->lifetime_sum / site->free_cnt) : 0;
+        LV_LOG("  %s:%" LV_PRIu32 ": %zu bytes in %" LV_PRIu32 " blocks"
+               " (allocs: %" LV_PRIu32 ", frees: %" LV_PRIu32 ", peak: %zu bytes, avg lifetime: %" LV_PRIu32 " ms)\n",
+               site->file ? site->file : "(unknown)", site->line, site->mark_size, site->mark_cnt,
+               site->alloc_cnt, site->free_cnt, site->peak_size, lifetime_avg);
+    }
+
+    LV_LOG("Per tag:\n");
+    for(i = 0; i < LV_MEM_TRACK_TAG_CNT + 2; i++) {
+        lv_mem_track_tag_t * tag;
+        if(i < LV_MEM_TRACK_TAG_CNT) tag = &state.tags[i];
+        else if(i == LV_MEM_TRACK_TAG_CNT) tag = &state.tag_overflow;
+        else tag = &state.tag_none;
+        if(tag->mark_cnt == 0) continue;
+        LV_LOG("  %s: %zu bytes in %" LV_PRIu32 " blocks (peak: %zu bytes)\n",
+               tag->name, tag->mark_size, tag->mark_cnt, tag->peak_size);
+    }
+
+    TRACK_UNLOCK();
+}
+
+size_t lv_mem_track_get_live_size(uint32_t mark)
+{
+    if(mark == 0) return state.live_size;
+
+    TRACK_LOCK();
+    size_t size = 0;
+    lv_mem_track_header_t * hdr;
+    for(hdr = state.head; hdr; hdr = hdr->next) {
+        if(hdr->mark >= mark) size += hdr->size;
+    }
+    TRACK_UNLOCK();
+
+    return size;
+}
+
+void lv_mem_track_for_each_site(lv_mem_track_site_cb_t cb, void * user_data)
+{
+    if(state.sites == NULL) return;
+
+    TRACK_LOCK();
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TRACK_SITE_CNT; i++) {
+        if(state.sites[i].alloc_cnt) cb(&state.sites[i], user_data);
+    }
+    if(state.site_overflow.alloc_cnt) cb(&state.site_overflow, user_data);
+    TRACK_UNLOCK();
+}
+
+void lv_mem_track_for_each_tag(lv_mem_track_tag_cb_t cb, void * user_data)
+{
+    if(state.tags == NULL) return;
+
+    TRACK_LOCK();
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TRACK_TAG_CNT; i++) {
+        if(state.tags[i].name) cb(&state.tags[i], user_data);
+    }
+    if(state.tag_overflow.peak_size) cb(&state.tag_overflow, user_data);
+    if(state.tag_none.peak_size) cb(&state.tag_none, user_data);
+    TRACK_UNLOCK();
+}
+
+void * _lv_mem_track_add(void * p, size_t size, const char * file, uint32_t line)
+{
+    lv_mem_track_header_t * hdr = p;
+    lv_memzero(hdr, sizeof(lv_mem_track_header_t));
+    hdr->size = size;
+
+    /*Not initialized yet or deinitialized already*/
+    if(state.sites == NULL) return data_of(hdr);
+
+    hdr->time = lv_tick_get();
+
+    TRACK_LOCK();
+    hdr->mark = state.mark_act;
+    hdr->site = site_get(file, line);
+    hdr->tag = tag_get(state.tag_act);
+    hdr->site->alloc_cnt++;
+    list_add(hdr);
+    live_add(hdr);
+    TRACK_UNLOCK();
+
+    return data_of(hdr);
+}
+
+void * _lv_mem_track_remove(void * p)
+{
+    lv_mem_track_header_t * hdr = header_of(p);
+
+    /*Detached allocation*/
+    if(hdr->site == NULL) return hdr;
+
+    TRACK_LOCK();
+    list_remove(hdr);
+    live_remove(hdr);
+    site_freed(hdr);
+    TRACK_UNLOCK();
+
+    return hdr;
+}
+
+void * _lv_mem_track_realloc(void * p, size_t new_size, const char * file, uint32_t line)
+{
+    lv_mem_track_header_t * hdr = header_of(p);
+
+    if(hdr->site == NULL) {
+        hdr = lv_realloc_core(hdr, new_size + LV_MEM_TRACK_HEADER_SIZE);
+        if(hdr == NULL) return NULL;
+        hdr->size = new_size;
+        return data_of(hdr);
+    }
+
+    /*The neighbors point to the header, so take it out of the list while it might move*/
+    TRACK_LOCK();
+    list_remove(hdr);
+    live_remove(hdr);
+
+    lv_mem_track_header_t * new_hdr = lv_realloc_core(hdr, new_size + LV_MEM_TRACK_HEADER_SIZE);
+    if(new_hdr == NULL) {
+        list_add(hdr);
+        live_add(hdr);
+        TRACK_UNLOCK();
+        return NULL;
+    }
+
+    /*The memory is owned by the site which reallocated it last*/
+    lv_mem_track_site_t * site = site_get(file, line);
+    if(site != new_hdr->site) {
+        site_freed(new_hdr);
+        new_hdr->site = site;
+        new_hdr->time = lv_tick_get();
+        site->alloc_cnt++;
+    }
+
+    new_hdr->size = new_size;
+    list_add(new_hdr);
+    live_add(new_hdr);
+    TRACK_UNLOCK();
+
+    return data_of(new_hdr);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static lv_mem_track_site_t * site_get(const char * file, uint32_t line)
+{
+    uint32_t hash = (uint32_t)(((lv_uintptr_t)file >> 2) * 31 + line) * 2654435761U;
+    uint32_t idx = hash % LV_MEM_TRACK_SITE_CNT;
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TRACK_SITE_CNT; i++) {
+        lv_mem_track_site_t * site = &state.sites[idx];
+        if(site->alloc_cnt == 0) {
+            site->file = file;
+            site->line = line;
+            return site;
+        }
+        if(site->file == file && site->line == line) return site;
+
+        idx++;
+        if(idx == LV_MEM_TRACK_SITE_CNT) idx = 0;
+    }
+
+    return &state.site_overflow;
+}
+
+static lv_mem_track_tag_t * tag_get(const char * name)
+{
+    if(name == NULL) return &state.tag_none;
+
+    uint32_t hash = (uint32_t)((lv_uintptr_t)name >> 2) * 2654435761U;
+    uint32_t idx = hash % LV_MEM_TRACK_TAG_CNT;
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TRACK_TAG_CNT; i++) {
+        lv_mem_track_tag_t * tag = &state.tags[idx];
+        if(tag->name == NULL) {
+            tag->name = name;
+            return tag;
+        }
+        if(tag->name == name) return tag;
+
+        idx++;
+        if(idx == LV_MEM_TRACK_TAG_CNT) idx = 0;
+    }
+
+    return &state.tag_overflow;
+}
+
+static void list_add(lv_mem_track_header_t * hdr)
+{
+    hdr->prev = NULL;
+    hdr->next = state.head;
+    if(state.head) state.head->prev = hdr;
+    state.head = hdr;
+}
+
+static void list_remove(lv_mem_track_header_t * hdr)
+{
+    if(hdr->prev) hdr->prev->next = hdr->next;
+    else state.head = hdr->next;
+    if(hdr->next) hdr->next->prev = hdr->prev;
+}
+
+static void live_add(lv_mem_track_header_t * hdr)
+{
+    lv_mem_track_site_t * site = hdr->site;
+    site->live_cnt++;
+    site->live_size += hdr->size;
+    if(site->live_size > site->peak_size) site->peak_size = site->live_size;
+
+    lv_mem_track_tag_t * tag = hdr->tag;
+    tag->live_cnt++;
+    tag->live_size += hdr->size;
+    if(tag->live_size > tag->peak_size) tag->peak_size = tag->live_size;
+
+    state.live_cnt++;
+    state.live_size += hdr->size;
+}
+
+static void live_remove(lv_mem_track_header_t * hdr)
+{
+    hdr->site->live_cnt--;
+    hdr->site->live_size -= hdr->size;
+    hdr->tag->live_cnt--;
+    hdr->tag->live_size -= hdr->size;
+    state.live_cnt--;
+    state.live_size -= hdr->size;
+}
+
+static void site_freed(lv_mem_track_header_t * hdr)
+{
+    hdr->site->free_cnt++;
+    hdr->site->lifetime_sum += lv_tick_elaps(hdr->time);
+}
+
+static void collect_since(uint32_t mark)
+{
+    uint32_t i;
+    for(i = 0; i < LV_MEM_TRACK_SITE_CNT; i++) {
+        state.sites[i].mark_cnt = 0;
+        state.sites[i].mark_size = 0;
+    }
+    state.site_overflow.mark_cnt = 0;
+    state.site_overflow.mark_size = 0;
+
+    for(i = 0; i < LV_MEM_TRACK_TAG_CNT; i++) {
+        state.tags[i].mark_cnt = 0;
+        state.tags[i].mark_size = 0;
+    }
+    state.tag_overflow.mark_cnt = 0;
+    state.tag_overflow.mark_size = 0;
+    state.tag_none.mark_cnt = 0;
+    state.tag_none.mark_size = 0;
+
+    lv_mem_track_header_t * hdr;
+    for(hdr = state.head; hdr; hdr = hdr->next) {
+        if(hdr->mark < mark) continue;
+        hdr->site->mark_cnt++;
+        hdr->site->mark_size += hdr->size;
+        hdr->tag->mark_cnt++;
+        hdr->tag->mark_size += hdr->size;
+    }
+}
+
+#endif /*LV_USE_MEM_TRACK*/
@@ -0,0 +1,190 @@
+/**
+ * @file lv_mem_track.h
+ *
+ */
+
+#ifndef LV_MEM_TRACK_H
+#define LV_MEM_TRACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_MEM_TRACK
+
+#include "../misc/lv_types.h"
+#include "../osal/lv_os.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Statistics of the allocations made at one call site (`file`:`line`)
+ */
+typedef struct {
+    const char * file;      /**< Source file of the call site, NULL for calls via function pointers*/
+    uint32_t line;          /**< Line of the call site*/
+    uint32_t alloc_cnt;     /**< Number of allocations made here*/
+    uint32_t free_cnt;      /**< Number of allocations made here and freed already*/
+    uint32_t live_cnt;      /**< Number of allocations made here and still alive*/
+    size_t live_size;       /**< Bytes allocated here and still alive*/
+    size_t peak_size;       /**< Max value of `live_size`*/
+    uint64_t lifetime_sum;  /**< Sum of the lifetime of the freed allocations [ms]*/
+    uint32_t mark_cnt;      /**< Used internally by `lv_mem_track_dump()`*/
+    size_t mark_size;       /**< Used internally by `lv_mem_track_dump()`*/
+} lv_mem_track_site_t;
+
+/**
+ * Statistics of the allocations made while a tag was active.
+ * Widgets set their class name as tag while they are created.
+ */
+typedef struct {
+    const char * name;      /**< The tag, NULL for untagged allocations*/
+    uint32_t live_cnt;      /**< Number of allocations with this tag still alive*/
+    size_t live_size;       /**< Bytes allocated with this tag and still alive*/
+    size_t peak_size;       /**< Max value of `live_size`*/
+    uint32_t mark_cnt;      /**< Used internally by `lv_mem_track_dump()`*/
+    size_t mark_size;       /**< Used internally by `lv_mem_track_dump()`*/
+} lv_mem_track_tag_t;
+
+/**
+ * Header placed in front of every tracked allocation
+ */
+typedef struct _lv_mem_track_header_t {
+    struct _lv_mem_track_header_t * prev;
+    struct _lv_mem_track_header_t * next;
+    lv_mem_track_site_t * site;
+    lv_mem_track_tag_t * tag;
+    size_t size;
+    uint32_t time;
+    uint32_t mark;
+} lv_mem_track_header_t;
+
+/*Keep the alignment of the returned memory*/
+#define LV_MEM_TRACK_HEADER_SIZE    ((sizeof(lv_mem_track_header_t) + 15) & ~((size_t)15))
+
+typedef struct {
+    lv_mem_track_header_t * head;       /**< Linked list of the live allocations*/
+    lv_mem_track_site_t * sites;        /**< Hash table of the call sites*/
+    lv_mem_track_tag_t * tags;          /**< Hash table of the tags*/
+    lv_mem_track_site_t site_overflow;  /**< Collects the call sites which don't fit into `sites`*/
+    lv_mem_track_tag_t tag_overflow;    /**< Collects the tags which don't fit into `tags`*/
+    lv_mem_track_tag_t tag_none;        /**< Collects the untagged allocations*/
+    const char * tag_act;
+    uint32_t mark_act;
+    uint32_t live_cnt;
+    size_t live_size;
+#if LV_USE_OS
+    lv_mutex_t mutex;
+#endif
+} lv_mem_track_state_t;
+
+typedef void (*lv_mem_track_site_cb_t)(const lv_mem_track_site_t * site, void * user_data);
+
+typedef void (*lv_mem_track_tag_cb_t)(const lv_mem_track_tag_t * tag, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the allocation tracker. Called by `lv_init()` after `lv_mem_init()`.
+ */
+void lv_mem_track_init(void);
+
+/**
+ * Release the tables of the tracker and detach the allocations still alive.
+ * Called by `lv_deinit()` before `lv_mem_deinit()`.
+ */
+void lv_mem_track_deinit(void);
+
+/**
+ * Set the tag to assign to the next allocations. E.g. the name of the widget class being created.
+ * @param tag       a string with static lifetime or NULL to clear the tag
+ * @return          the previous tag to be restored later
+ */
+const char * lv_mem_track_set_tag(const char * tag);
+
+/**
+ * Start a new generation of allocations. Allocations made after the mark can be
+ * listed separately by `lv_mem_track_dump()`, e.g. to see what remained from a screen load.
+ * @return          identifier of the mark
+ */
+uint32_t lv_mem_track_mark(void);
+
+/**
+ * Print the live allocations aggregated per call site and per tag with `LV_LOG`
+ * @param mark      only consider allocations made since this mark (return value of `lv_mem_track_mark()`),
+ *                  0 to consider all live allocations
+ */
+void lv_mem_track_dump(uint32_t mark);
+
+/**
+ * Get the number of bytes allocated since a mark and still alive
+ * @param mark      return value of `lv_mem_track_mark()`, 0 to count all live allocations
+ * @return          the number of bytes requested by the live allocations (without the tracking overhead)
+ */
+size_t lv_mem_track_get_live_size(uint32_t mark);
+
+/**
+ * Call a function for each call site which allocated memory
+ * @param cb        the callback. It must not allocate or free memory.
+ * @param user_data arbitrary data passed to `cb`
+ */
+void lv_mem_track_for_each_site(lv_mem_track_site_cb_t cb, void * user_data);
+
+/**
+ * Call a function for each tag which allocated memory
+ * @param cb        the callback. It must not allocate or free memory.
+ * @param user_data arbitrary data passed to `cb`
+ */
+void lv_mem_track_for_each_tag(lv_mem_track_tag_cb_t cb, void * user_data);
+
+/**
+ * Used internally by `lv_malloc()` to register a new allocation
+ * @param p         the raw memory with `LV_MEM_TRACK_HEADER_SIZE` extra bytes in front
+ * @param size      the size requested by the user
+ * @param file      the source file of the call site
+ * @param line      the line of the call site
+ * @return          pointer to the user's memory
+ */
+void * _lv_mem_track_add(void * p, size_t size, const char * file, uint32_t line);
+
+/**
+ * Used internally by `lv_free()` to unregister an allocation
+ * @param p         pointer to the user's memory
+ * @return          pointer to the raw memory to free
+ */
+void * _lv_mem_track_remove(void * p);
+
+/**
+ * Used internally by `lv_realloc()` to reallocate a tracked memory
+ * @param p         pointer to the user's memory
+ * @param new_size  the new size requested by the user
+ * @param file      the source file of the call site
+ * @param line      the line of the call site
+ * @return          pointer to the reallocated user memory or NULL on failure
+ */
+void * _lv_mem_track_realloc(void * p, size_t new_size, const char * file, uint32_t line);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_MEM_TRACK*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_MEM_TRACK_H*/
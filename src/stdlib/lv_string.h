@@ -75,6 +75,58 @@ static inline void lv_memzero(void * dst, size_t len)
     lv_memset(dst, 0x00, len);
 }
 
+/**
+ * Copy a rectangular area of memory row by row.
+ * If the rows are continuous in both buffers they are copied in one step.
+ * @param dst           pointer to the first row of the destination
+ * @param dst_stride    distance of the destination rows in bytes
+ * @param src           pointer to the first row of the source
+ * @param src_stride    distance of the source rows in bytes
+ * @param row_len       number of bytes to copy from each row
+ * @param row_cnt       number of rows to copy
+ */
+static inline void lv_memcpy_2d(void * dst, size_t dst_stride, const void * src, size_t src_stride,
+                                size_t row_len, size_t row_cnt)
+{
+    if(dst_stride == row_len && src_stride == row_len) {
+        lv_memcpy(dst, src, row_len * row_cnt);
+        return;
+    }
+
+    uint8_t * d8 = (uint8_t *)dst;
+    const uint8_t * s8 = (const uint8_t *)src;
+    while(row_cnt) {
+        lv_memcpy(d8, s8, row_len);
+        d8 += dst_stride;
+        s8 += src_stride;
+        row_cnt--;
+    }
+}
+
+/**
+ * Fill a rectangular area of memory row by row.
+ * If the rows are continuous they are filled in one step.
+ * @param dst           pointer to the first row
+ * @param dst_stride    distance of the rows in bytes
+ * @param v             value to set
+ * @param row_len       number of bytes to set in each row
+ * @param row_cnt       number of rows to set
+ */
+static inline void lv_memset_2d(void * dst, size_t dst_stride, uint8_t v, size_t row_len, size_t row_cnt)
+{
+    if(dst_stride == row_len) {
+        lv_memset(dst, v, row_len * row_cnt);
+        return;
+    }
+
+    uint8_t * d8 = (uint8_t *)dst;
+    while(row_cnt) {
+        lv_memset(d8, v, row_len);
+        d8 += dst_stride;
+        row_cnt--;
+    }
+}
+
 /**
  * @brief Computes the length of the string str up to, but not including the terminating null character.
  * @param str Pointer to the null-terminated byte string to be examined.
@@ -23,6 +23,8 @@ extern "C" {
 #define LV_USE_OS                   LV_OS_PTHREAD
 #define LV_OBJ_STYLE_CACHE          0
 #define LV_BIN_DECODER_RAM_LOAD     1   /* Run test with bin image loaded to RAM */
+#define LV_USE_MEM_TRACK            1
+#define LV_OBJ_STYLE_RESOLVED_CACHE 1
 #endif
 
 #ifdef LVGL_CI_USING_DEF_HEAP
@@ -31,6 +33,7 @@ extern "C" {
 #define LV_USE_STDLIB_SPRINTF   LV_STDLIB_BUILTIN
 #define LV_OBJ_STYLE_CACHE      1
 #define LV_BIN_DECODER_RAM_LOAD 0
+#define LV_MEM_USE_SLAB         1
 #endif
 
 #ifdef MICROPYTHON
@@ -1,5 +1,7 @@
 #define LV_MEM_SIZE                     (32 * 1024 * 1024)
 #define LV_DRAW_SW_SHADOW_CACHE_SIZE    8
+#define LV_DRAW_SW_MIPMAP               1
+#define LV_OBJ_BITMAP_CACHE_SIZE        (256 * 1024)
 #define LV_DRAW_THREAD_STACK_SIZE    (64 * 1024) /*Increase stack size to 64KB in order to run ThorVG*/
 #define LV_USE_LOG              1
 #define LV_LOG_LEVEL            LV_LOG_LEVEL_TRACE
@@ -64,6 +66,9 @@
 #endif
 #define LV_USE_FS_MEMFS     1
 #define LV_FS_MEMFS_LETTER  'M'
+#define LV_USE_FS_BLOCK_CACHE 1
+#define LV_FS_BLOCK_CACHE_BLOCK_SIZE 64
+#define LV_FS_BLOCK_CACHE_BLOCK_CNT 0   /*Enabled by the tests with `lv_fs_block_cache_resize()`*/
 
 #define LV_USE_MONKEY       1
 #define LV_USE_RLE          1
@@ -75,6 +80,7 @@
     #define LV_USE_LIBJPEG_TURBO   1
 #endif
 #define LV_USE_GIF          1
+#define LV_GIF_DECODE_AHEAD_CNT 2
 #define LV_USE_QRCODE       1
 #define LV_USE_BARCODE      1
 #define LV_USE_FRAGMENT     1
@@ -114,10 +120,12 @@
 #ifndef LV_USE_LINUX_DRM
     #define LV_USE_LINUX_DRM    1
 #endif
+#define LV_LINUX_DRM_BUFFER_COUNT   3
 
 #ifndef LV_USE_LINUX_FBDEV
     #define LV_USE_LINUX_FBDEV  1
 #endif
+#define LV_LINUX_FBDEV_PAN_FLIP     1
 
 #define LV_USE_ILI9341      1
 #define LV_USE_ST7735       1
@@ -20,6 +20,11 @@ void lv_test_init(void)
 {
     lv_init();
     hal_init();
+
+#if LV_DRAW_SW_MIPMAP
+    /*The reference images are rendered without mipmaps. test_image_mipmap enables them.*/
+    lv_draw_sw_enable_mipmap(false);
+#endif
 }
 
 void lv_test_deinit(void)
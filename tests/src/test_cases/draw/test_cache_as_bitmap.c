@@ -0,0 +1,213 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static uint32_t draw_cnt;
+
+void setUp(void)
+{
+    /* Function run before every test */
+    draw_cnt = 0;
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+#if LV_OBJ_BITMAP_CACHE_SIZE
+
+static uint8_t frame_ref[800 * 480 * 4];
+
+static void draw_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_cnt++;
+}
+
+static lv_obj_t * panel_create(lv_obj_t * parent, int32_t w, int32_t h)
+{
+    lv_obj_t * panel = lv_obj_create(parent);
+    lv_obj_set_size(panel, w, h);
+    lv_obj_set_style_shadow_width(panel, 20, 0);
+    lv_obj_add_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+
+    lv_obj_t * label = lv_label_create(panel);
+    lv_label_set_text(label, "Cached panel");
+    lv_obj_add_event_cb(label, draw_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_t * btn = lv_button_create(panel);
+    lv_obj_align(btn, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+
+    return panel;
+}
+
+static void frame_save(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    lv_memcpy(frame_ref, buf->data, sizeof(frame_ref));
+}
+
+/**
+ * Redraw the screen and compare it with the saved frame.
+ * Blending into the retained image first results in small rounding differences.
+ * @return  the number of pixels which differ more than the tolerance
+ */
+static uint32_t frame_diff(void)
+{
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    uint32_t diff_cnt = 0;
+    uint32_t i;
+    for(i = 0; i < sizeof(frame_ref); i++) {
+        if(LV_ABS((int32_t)buf->data[i] - frame_ref[i]) > 3) {
+            diff_cnt++;
+            i += 3 - i % 4;     /*Count the pixels, not the channels*/
+        }
+    }
+
+    return diff_cnt;
+}
+
+static void compare_with_cache(lv_obj_t * obj, uint32_t max_diff_cnt)
+{
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    frame_save();
+
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    TEST_ASSERT_LESS_OR_EQUAL(max_diff_cnt, frame_diff());
+
+    /*Drawn from the retained image*/
+    uint32_t draw_cnt_prev = draw_cnt;
+    TEST_ASSERT_LESS_OR_EQUAL(max_diff_cnt, frame_diff());
+    TEST_ASSERT_EQUAL(draw_cnt_prev, draw_cnt);
+}
+
+#endif
+
+void test_cache_as_bitmap_looks_the_same(void)
+{
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    lv_obj_t * panel = panel_create(lv_screen_active(), 250, 150);
+    lv_obj_center(panel);
+    compare_with_cache(panel, 0);
+
+    /*Apply the opacity and transformation on the retained image*/
+    lv_obj_set_style_opa_layered(panel, LV_OPA_70, 0);
+    compare_with_cache(panel, 0);
+
+    lv_obj_set_style_opa_layered(panel, LV_OPA_COVER, 0);
+    lv_obj_set_style_transform_rotation(panel, 300, 0);
+    lv_obj_set_style_transform_scale(panel, 300, 0);
+    lv_obj_set_style_transform_pivot_x(panel, lv_pct(30), 0);
+    /*The layer is larger than the retained image so a few pixels are interpolated differently*/
+    compare_with_cache(panel, 20);
+
+    lv_obj_clean(lv_screen_active());
+
+    /*A cached object in a cached object*/
+    panel = panel_create(lv_screen_active(), 280, 180);
+    lv_obj_center(panel);
+    lv_obj_t * panel_inner = panel_create(panel, 150, 80);
+    lv_obj_center(panel_inner);
+    compare_with_cache(panel, 0);
+#endif
+}
+
+void test_cache_as_bitmap_render_only_on_change(void)
+{
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 400, 400);
+    lv_obj_t * panel = panel_create(cont, 200, 100);
+    lv_obj_t * label = lv_obj_get_child(panel, 0);
+    lv_obj_t * sibling = lv_obj_create(cont);
+    lv_obj_set_pos(sibling, 20, 10);
+    lv_obj_set_size(sibling, 100, 600);
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+
+    /*Redraw the area of the panel because of something else*/
+    lv_obj_invalidate(sibling);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+
+    /*Scrolling the parent (e.g. while dragging it) moves the image only*/
+    _lv_obj_scroll_by_raw(cont, 0, -30);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+
+    /*Changing a child renders the image again*/
+    lv_label_set_text(label, "Changed");
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, draw_cnt);
+
+    /*Changing the object renders the image again*/
+    lv_obj_set_style_bg_color(panel, lv_color_hex3(0x0f0), 0);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(3, draw_cnt);
+
+    /*Without the flag it's drawn normally*/
+    lv_obj_remove_flag(panel, LV_OBJ_FLAG_CACHE_AS_BITMAP);
+    lv_obj_invalidate(sibling);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(4, draw_cnt);
+#endif
+}
+
+void test_cache_as_bitmap_budget(void)
+{
+#if LV_OBJ_BITMAP_CACHE_SIZE
+    /*Larger than the budget, never retained*/
+    lv_obj_t * panel = panel_create(lv_screen_active(), 400, LV_OBJ_BITMAP_CACHE_SIZE / 4 / 400 + 1);
+    lv_refr_now(NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, draw_cnt);
+    lv_obj_delete(panel);
+
+    /*Two panels which fit into the budget only one by one*/
+    int32_t h = LV_OBJ_BITMAP_CACHE_SIZE / 4 / 300 * 2 / 3;
+    lv_obj_t * panel1 = panel_create(lv_screen_active(), 300, h);
+    lv_obj_t * panel2 = panel_create(lv_screen_active(), 300, h);
+    lv_obj_set_x(panel2, 400);
+    lv_refr_now(NULL);
+
+    lv_obj_invalidate_area(lv_screen_active(), &panel1->coords);
+    lv_refr_now(NULL);
+    draw_cnt = 0;
+    lv_obj_invalidate_area(lv_screen_active(), &panel1->coords);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(0, draw_cnt);
+
+    /*The image of the least recently drawn panel1 is freed*/
+    lv_obj_invalidate_area(lv_screen_active(), &panel2->coords);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+    lv_obj_invalidate_area(lv_screen_active(), &panel2->coords);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+
+    lv_obj_invalidate_area(lv_screen_active(), &panel1->coords);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(2, draw_cnt);
+
+    /*Can't free the image of panel1 while it's drawn in the same area, so panel2 is drawn normally*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(3, draw_cnt);
+    lv_obj_invalidate_area(lv_screen_active(), &panel1->coords);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(3, draw_cnt);
+#endif
+}
+
+#endif
@@ -62,4 +62,85 @@ void test_clip_corner_1(void)
 
 }
 
+static void draw_event_cb(lv_event_t * e)
+{
+    uint32_t * cnt = lv_event_get_user_data(e);
+    (*cnt)++;
+}
+
+void test_clip_corner_draw_children_once(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_obj_t * parent = create_panel(30, false);
+
+    uint32_t draw_cnt = 0;
+    lv_obj_t * label = lv_obj_get_child(parent, 0);
+    lv_obj_add_event_cb(label, draw_event_cb, LV_EVENT_DRAW_MAIN, &draw_cnt);
+
+    /*The label covers the top and bottom corners too*/
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, draw_cnt);
+}
+
+#if LV_USE_VECTOR_GRAPHIC && LV_USE_THORVG
+static void draw_vector_event_cb(lv_event_t * e)
+{
+    lv_obj_t * obj = lv_event_get_target(e);
+    lv_layer_t * layer = lv_event_get_layer(e);
+
+    lv_vector_dsc_t * ctx = lv_vector_dsc_create(layer);
+    lv_vector_path_t * path = lv_vector_path_create(LV_VECTOR_PATH_QUALITY_MEDIUM);
+    lv_fpoint_t pts[4] = {
+        {(float)obj->coords.x1, (float)obj->coords.y1},
+        {(float)obj->coords.x2 + 1, (float)obj->coords.y1},
+        {(float)obj->coords.x2 + 1, (float)obj->coords.y2 + 1},
+        {(float)obj->coords.x1, (float)obj->coords.y2 + 1},
+    };
+    lv_vector_path_move_to(path, &pts[0]);
+    lv_vector_path_line_to(path, &pts[1]);
+    lv_vector_path_line_to(path, &pts[2]);
+    lv_vector_path_line_to(path, &pts[3]);
+    lv_vector_path_close(path);
+    lv_vector_dsc_set_fill_color(ctx, lv_color_hex(0xff0000));
+    lv_vector_dsc_add_path(ctx, path);
+    lv_draw_vector(ctx);
+
+    lv_vector_path_delete(path);
+    lv_vector_dsc_delete(ctx);
+}
+
+void test_clip_corner_vector(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_obj_set_style_bg_color(lv_screen_active(), lv_color_white(), 0);
+
+    lv_obj_t * parent = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(parent);
+    lv_obj_set_size(parent, 200, 200);
+    lv_obj_set_style_radius(parent, 50, 0);
+    lv_obj_set_style_clip_corner(parent, true, 0);
+
+    /*Vector graphics are drawn by ThorVG but the corners should be clipped as well*/
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_remove_style_all(child);
+    lv_obj_set_size(child, lv_pct(100), lv_pct(100));
+    lv_obj_add_event_cb(child, draw_vector_event_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    const lv_area_t * coords = &parent->coords;
+    const uint8_t * corner_px = lv_draw_buf_goto_xy(buf, coords->x1 + 1, coords->y1 + 1);
+    const uint8_t * center_px = lv_draw_buf_goto_xy(buf, coords->x1 + 100, coords->y1 + 100);
+
+    /*Blue, green, red: the outer corner keeps the white background*/
+    TEST_ASSERT_EQUAL_UINT8(0xff, corner_px[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xff, corner_px[1]);
+    TEST_ASSERT_EQUAL_UINT8(0x00, center_px[0]);
+    TEST_ASSERT_EQUAL_UINT8(0xff, center_px[2]);
+}
+#endif
+
 #endif
@@ -224,4 +224,78 @@ void test_rotate270_ARGB8888(void)
     TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedArray, dstArray, sizeof(dstArray));
 }
 
+/*Compare with a pixel by pixel rotation on a buffer with partial and full tiles and padded strides*/
+static void test_rotate_large(lv_color_format_t cf, lv_display_rotation_t rotation)
+{
+    const int32_t w = 37;
+    const int32_t h = 21;
+    const int32_t px_size = lv_color_format_get_size(cf);
+    const int32_t src_stride = (w + 3) * px_size;
+    const int32_t dest_w = rotation == LV_DISPLAY_ROTATION_180 ? w : h;
+    const int32_t dest_h = rotation == LV_DISPLAY_ROTATION_180 ? h : w;
+    const int32_t dest_stride = (dest_w + 5) * px_size;
+
+    uint8_t * src = lv_malloc(src_stride * h);
+    uint8_t * dest = lv_malloc_zeroed(dest_stride * dest_h);
+    uint8_t * expected = lv_malloc_zeroed(dest_stride * dest_h);
+
+    for(int32_t i = 0; i < src_stride * h; i++) src[i] = (uint8_t)(i * 7 + (i >> 8));
+
+    /*The 90 and 270 degree rotations of RGB888 are swapped compared to the other formats*/
+    lv_display_rotation_t expected_rotation = rotation;
+    if(cf == LV_COLOR_FORMAT_RGB888 && rotation == LV_DISPLAY_ROTATION_90) expected_rotation = LV_DISPLAY_ROTATION_270;
+    else if(cf == LV_COLOR_FORMAT_RGB888 && rotation == LV_DISPLAY_ROTATION_270) expected_rotation = LV_DISPLAY_ROTATION_90;
+
+    for(int32_t y = 0; y < h; y++) {
+        for(int32_t x = 0; x < w; x++) {
+            int32_t dest_x;
+            int32_t dest_y;
+            if(expected_rotation == LV_DISPLAY_ROTATION_90) {
+                dest_x = y;
+                dest_y = w - x - 1;
+            }
+            else if(expected_rotation == LV_DISPLAY_ROTATION_180) {
+                dest_x = w - x - 1;
+                dest_y = h - y - 1;
+            }
+            else {
+                dest_x = h - y - 1;
+                dest_y = x;
+            }
+            lv_memcpy(&expected[dest_y * dest_stride + dest_x * px_size], &src[y * src_stride + x * px_size], px_size);
+        }
+    }
+
+    lv_draw_sw_rotate(src, dest, w, h, src_stride, dest_stride, rotation, cf);
+
+    for(int32_t y = 0; y < dest_h; y++) {
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(&expected[y * dest_stride], &dest[y * dest_stride], dest_w * px_size);
+    }
+
+    lv_free(src);
+    lv_free(dest);
+    lv_free(expected);
+}
+
+void test_rotate_large_RGB565(void)
+{
+    test_rotate_large(LV_COLOR_FORMAT_RGB565, LV_DISPLAY_ROTATION_90);
+    test_rotate_large(LV_COLOR_FORMAT_RGB565, LV_DISPLAY_ROTATION_180);
+    test_rotate_large(LV_COLOR_FORMAT_RGB565, LV_DISPLAY_ROTATION_270);
+}
+
+void test_rotate_large_RGB888(void)
+{
+    test_rotate_large(LV_COLOR_FORMAT_RGB888, LV_DISPLAY_ROTATION_90);
+    test_rotate_large(LV_COLOR_FORMAT_RGB888, LV_DISPLAY_ROTATION_180);
+    test_rotate_large(LV_COLOR_FORMAT_RGB888, LV_DISPLAY_ROTATION_270);
+}
+
+void test_rotate_large_ARGB8888(void)
+{
+    test_rotate_large(LV_COLOR_FORMAT_ARGB8888, LV_DISPLAY_ROTATION_90);
+    test_rotate_large(LV_COLOR_FORMAT_ARGB8888, LV_DISPLAY_ROTATION_180);
+    test_rotate_large(LV_COLOR_FORMAT_ARGB8888, LV_DISPLAY_ROTATION_270);
+}
+
 #endif
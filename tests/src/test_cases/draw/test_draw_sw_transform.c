@@ -0,0 +1,258 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define IMG_W   180
+#define IMG_H   120
+
+#define NOISE_W 64
+#define NOISE_H 48
+
+static const lv_color_format_t color_formats[] = {
+    LV_COLOR_FORMAT_ARGB8888,
+    LV_COLOR_FORMAT_XRGB8888,
+    LV_COLOR_FORMAT_RGB888,
+    LV_COLOR_FORMAT_RGB565,
+    LV_COLOR_FORMAT_RGB565A8,
+    LV_COLOR_FORMAT_A8,
+    LV_COLOR_FORMAT_L8,
+};
+
+#define IMG_CNT (sizeof(color_formats) / sizeof(color_formats[0]))
+
+static lv_draw_buf_t * imgs[IMG_CNT];
+
+/*Gradients with 8x8 px checkers and a transparent hole to have different neighbors in every direction*/
+static lv_draw_buf_t * img_create(lv_color_format_t cf)
+{
+    lv_draw_buf_t * buf = lv_draw_buf_create(IMG_W, IMG_H, cf, 0);
+    TEST_ASSERT_NOT_NULL(buf);
+
+    uint32_t stride = buf->header.stride;
+    uint8_t * alpha_map = buf->data + stride * IMG_H;
+    int32_t x, y;
+    for(y = 0; y < IMG_H; y++) {
+        uint8_t * row = buf->data + y * stride;
+        for(x = 0; x < IMG_W; x++) {
+            uint8_t r = x * 255 / (IMG_W - 1);
+            uint8_t g = y * 255 / (IMG_H - 1);
+            uint8_t b = ((x / 8 + y / 8) & 1) ? 0xff : 0x20;
+            int32_t dx = x - IMG_W / 3;
+            int32_t dy = y - IMG_H / 2;
+            int32_t d = dx * dx + dy * dy;
+            uint8_t a = d < 20 * 20 ? 0 : (d < 40 * 40 ? (d - 20 * 20) * 255 / (40 * 40 - 20 * 20) : 0xff);
+
+            switch(cf) {
+                case LV_COLOR_FORMAT_ARGB8888:
+                case LV_COLOR_FORMAT_XRGB8888:
+                    row[x * 4 + 0] = b;
+                    row[x * 4 + 1] = g;
+                    row[x * 4 + 2] = r;
+                    row[x * 4 + 3] = a;
+                    break;
+                case LV_COLOR_FORMAT_RGB888:
+                    row[x * 3 + 0] = b;
+                    row[x * 3 + 1] = g;
+                    row[x * 3 + 2] = r;
+                    break;
+                case LV_COLOR_FORMAT_RGB565:
+                case LV_COLOR_FORMAT_RGB565A8:
+                    ((uint16_t *)row)[x] = ((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3);
+                    if(cf == LV_COLOR_FORMAT_RGB565A8) alpha_map[y * stride / 2 + x] = a;
+                    break;
+                case LV_COLOR_FORMAT_A8:
+                    row[x] = a;
+                    break;
+                case LV_COLOR_FORMAT_L8:
+                    row[x] = (r + g + b) / 3;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    return buf;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        imgs[i] = img_create(color_formats[i]);
+    }
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        lv_image_cache_drop(imgs[i]);
+        lv_draw_buf_destroy(imgs[i]);
+    }
+}
+
+static void imgs_create(int32_t rotation, int32_t scale_x, int32_t scale_y, bool antialias)
+{
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        lv_obj_t * img = lv_image_create(lv_screen_active());
+        lv_image_set_src(img, imgs[i]);
+        lv_obj_set_pos(img, 20 + (i % 4) * 200, 60 + (i / 4) * 240);
+        lv_image_set_rotation(img, rotation + i * 150);
+        lv_image_set_scale_x(img, scale_x);
+        lv_image_set_scale_y(img, scale_y);
+        lv_image_set_antialias(img, antialias);
+        lv_obj_set_style_image_recolor(img, lv_color_hex(0x0000ff), 0);
+        if(color_formats[i] == LV_COLOR_FORMAT_A8) lv_obj_set_style_image_recolor_opa(img, LV_OPA_COVER, 0);
+    }
+}
+
+/*The images are wider than a tile of the transformation*/
+void test_draw_sw_transform_rotate(void)
+{
+    imgs_create(300, 256, 256, true);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_rotate_1.png");
+
+    lv_obj_clean(lv_screen_active());
+    imgs_create(2725, 256, 256, false);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_rotate_2.png");
+}
+
+void test_draw_sw_transform_rotate_and_scale(void)
+{
+    imgs_create(1000, 300, 200, true);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_rotate_and_scale_1.png");
+
+    lv_obj_clean(lv_screen_active());
+    imgs_create(3333, 180, 330, true);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_rotate_and_scale_2.png");
+}
+
+typedef struct {
+    int32_t rotation;
+    int32_t scale;
+    int32_t skew_x;
+    int32_t skew_y;
+} skew_test_t;
+
+/*The image widget has no skew so draw the images directly*/
+static void skewed_imgs_draw_event_cb(lv_event_t * e)
+{
+    const skew_test_t * t = lv_event_get_user_data(e);
+    lv_layer_t * layer = lv_event_get_layer(e);
+
+    uint32_t i;
+    for(i = 0; i < IMG_CNT; i++) {
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = imgs[i];
+        dsc.rotation = t->rotation;
+        dsc.scale_x = t->scale;
+        dsc.scale_y = t->scale;
+        dsc.skew_x = t->skew_x + i * 50;
+        dsc.skew_y = t->skew_y - i * 30;
+        dsc.pivot.x = IMG_W / 2;
+        dsc.pivot.y = IMG_H / 2;
+        dsc.recolor = lv_color_hex(0x0000ff);
+        if(color_formats[i] == LV_COLOR_FORMAT_A8) dsc.recolor_opa = LV_OPA_COVER;
+
+        lv_area_t coords;
+        coords.x1 = 20 + (i % 4) * 200;
+        coords.y1 = 60 + (i / 4) * 240;
+        coords.x2 = coords.x1 + IMG_W - 1;
+        coords.y2 = coords.y1 + IMG_H - 1;
+        lv_draw_image(layer, &dsc, &coords);
+    }
+}
+
+void test_draw_sw_transform_skew(void)
+{
+    static skew_test_t t;
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, lv_pct(100), lv_pct(100));
+    lv_obj_add_event_cb(obj, skewed_imgs_draw_event_cb, LV_EVENT_DRAW_MAIN, &t);
+
+    t.rotation = 0;
+    t.scale = 256;
+    t.skew_x = 200;
+    t.skew_y = 0;
+    lv_obj_invalidate(obj);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_skew_1.png");
+
+    t.rotation = 450;
+    t.scale = 200;
+    t.skew_x = -150;
+    t.skew_y = 250;
+    lv_obj_invalidate(obj);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_skew_2.png");
+}
+
+/*Noise with runs of equal pixels and transparent pixels to hit every special case of the interpolation*/
+static lv_draw_buf_t * noise_img_create(lv_color_format_t cf)
+{
+    lv_draw_buf_t * buf = lv_draw_buf_create(NOISE_W, NOISE_H, cf, 0);
+    TEST_ASSERT_NOT_NULL(buf);
+
+    uint32_t seed = 0x12345678;
+    int32_t x, y;
+    for(y = 0; y < NOISE_H; y++) {
+        uint8_t * row = buf->data + y * buf->header.stride;
+        for(x = 0; x < NOISE_W; x++) {
+            seed = seed * 1103515245 + 12345;
+            uint32_t rnd = seed >> 8;
+            bool copy = x > 0 && (rnd & 0x3) == 0;
+            if(cf == LV_COLOR_FORMAT_ARGB8888) {
+                uint32_t * px = (uint32_t *)row + x;
+                if(copy) {
+                    *px = px[-1];
+                    continue;
+                }
+                uint32_t a = (rnd >> 2) & 0x3;
+                a = a == 0 ? 0x00 : (a == 1 ? 0xff : (rnd >> 24));
+                *px = (a << 24) | (seed * 2654435761u >> 8);
+            }
+            else {
+                uint16_t * px = (uint16_t *)row + x;
+                *px = copy ? px[-1] : (uint16_t)(seed * 2654435761u >> 16);
+            }
+        }
+    }
+
+    return buf;
+}
+
+void test_draw_sw_transform_noise(void)
+{
+    lv_draw_buf_t * noise[2];
+    noise[0] = noise_img_create(LV_COLOR_FORMAT_ARGB8888);
+    noise[1] = noise_img_create(LV_COLOR_FORMAT_RGB565);
+
+    static const int32_t rotations[4] = {0, 150, 1234, 2700};
+    static const int32_t scales[4] = {700, 256, 450, 333};
+    uint32_t i;
+    for(i = 0; i < 8; i++) {
+        lv_obj_t * img = lv_image_create(lv_screen_active());
+        lv_image_set_src(img, noise[i / 4]);
+        lv_obj_set_pos(img, 60 + (i % 4) * 190, 60 + (i / 4) * 220);
+        lv_image_set_rotation(img, rotations[i % 4]);
+        lv_image_set_scale_x(img, scales[i % 4]);
+        lv_image_set_scale_y(img, scales[(i + 1) % 4]);
+    }
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/sw_transform_noise.png");
+
+    lv_obj_clean(lv_screen_active());
+    for(i = 0; i < 2; i++) {
+        lv_image_cache_drop(noise[i]);
+        lv_draw_buf_destroy(noise[i]);
+    }
+}
+
+#endif
@@ -232,14 +232,16 @@ static void draw_lines(lv_layer_t * layer)
     lv_vector_dsc_delete(ctx);
 }
 
-static void canvas_draw(const char * name, void (*draw_cb)(lv_layer_t *))
+static void canvas_draw_cf(const char * name, void (*draw_cb)(lv_layer_t *), lv_color_format_t cf, uint32_t stride,
+                           bool fill_bg)
 {
     LV_UNUSED(name);
     lv_obj_t * canvas = lv_canvas_create(lv_screen_active());
-    uint32_t stride = 640 * 4 + 128; /*Test non-default stride*/
-    lv_draw_buf_t * draw_buf = lv_draw_buf_create(640, 480, LV_COLOR_FORMAT_ARGB8888, stride);
+    lv_draw_buf_t * draw_buf = lv_draw_buf_create(640, 480, cf, stride);
     TEST_ASSERT_NOT_NULL(draw_buf);
     lv_canvas_set_draw_buf(canvas, draw_buf);
+    /*Anti-aliased pixels blend with the original content, so don't leave it uninitialized*/
+    if(fill_bg) lv_canvas_fill_bg(canvas, lv_color_white(), LV_OPA_COVER);
 
     lv_layer_t layer;
     lv_canvas_init_layer(canvas, &layer);
@@ -258,6 +260,12 @@ static void canvas_draw(const char * name, void (*draw_cb)(lv_layer_t *))
     lv_obj_delete(canvas);
 }
 
+static void canvas_draw(const char * name, void (*draw_cb)(lv_layer_t *))
+{
+    uint32_t stride = 640 * 4 + 128; /*Test non-default stride*/
+    canvas_draw_cf(name, draw_cb, LV_COLOR_FORMAT_ARGB8888, stride, false);
+}
+
 void test_transform(void)
 {
     lv_matrix_t matrix;
@@ -296,4 +304,14 @@ void test_draw_shapes(void)
 {
     canvas_draw("draw_shapes", draw_shapes);
 }
+
+void test_draw_shapes_rgb565(void)
+{
+    canvas_draw_cf("draw_shapes_rgb565", draw_shapes, LV_COLOR_FORMAT_RGB565, LV_STRIDE_AUTO, true);
+}
+
+void test_draw_shapes_rgb888(void)
+{
+    canvas_draw_cf("draw_shapes_rgb888", draw_shapes, LV_COLOR_FORMAT_RGB888, LV_STRIDE_AUTO, true);
+}
 #endif
@@ -0,0 +1,209 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../../../src/libs/lodepng/lodepng.h"
+
+#include "unity/unity.h"
+
+void setUp(void)
+{
+    /* Function run before every test */
+#if LV_DRAW_SW_MIPMAP
+    lv_draw_sw_enable_mipmap(true);
+#endif
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+#if LV_DRAW_SW_MIPMAP
+    lv_draw_sw_enable_mipmap(false);
+#endif
+}
+
+#if LV_DRAW_SW_MIPMAP
+
+static void set_px32(lv_draw_buf_t * buf, int32_t x, int32_t y, uint32_t c)
+{
+    lv_color32_t * px = lv_draw_buf_goto_xy(buf, x, y);
+    *px = lv_color32_make(c >> 16, c >> 8, c, c >> 24);
+}
+
+static lv_color32_t get_px32(lv_draw_buf_t * buf, int32_t x, int32_t y)
+{
+    return *(lv_color32_t *)lv_draw_buf_goto_xy(buf, x, y);
+}
+
+#endif
+
+void test_image_mipmap_argb8888(void)
+{
+#if LV_DRAW_SW_MIPMAP
+    lv_draw_buf_t * src = lv_draw_buf_create(3, 2, LV_COLOR_FORMAT_ARGB8888, 0);
+    set_px32(src, 0, 0, 0xffff0000);
+    set_px32(src, 1, 0, 0xff0000ff);
+    set_px32(src, 0, 1, 0x0000ff00);    /*Transparent, its color doesn't count*/
+    set_px32(src, 1, 1, 0x0000ff00);
+    set_px32(src, 2, 0, 0x80204060);
+    set_px32(src, 2, 1, 0x80204060);
+
+    lv_draw_buf_t * mipmap = lv_draw_sw_mipmap_create(src, 1, 1);
+    TEST_ASSERT_NOT_NULL(mipmap);
+    TEST_ASSERT_EQUAL(2, mipmap->header.w);
+    TEST_ASSERT_EQUAL(1, mipmap->header.h);
+    TEST_ASSERT_EQUAL(LV_COLOR_FORMAT_ARGB8888, mipmap->header.cf);
+
+    lv_color32_t c = get_px32(mipmap, 0, 0);
+    TEST_ASSERT_EQUAL_HEX8(0x80, c.red);
+    TEST_ASSERT_EQUAL_HEX8(0x00, c.green);
+    TEST_ASSERT_EQUAL_HEX8(0x80, c.blue);
+    TEST_ASSERT_EQUAL_HEX8(0x80, c.alpha);
+
+    /*The box is cut at the edge of the image*/
+    c = get_px32(mipmap, 1, 0);
+    TEST_ASSERT_EQUAL_HEX8(0x20, c.red);
+    TEST_ASSERT_EQUAL_HEX8(0x40, c.green);
+    TEST_ASSERT_EQUAL_HEX8(0x60, c.blue);
+    TEST_ASSERT_EQUAL_HEX8(0x80, c.alpha);
+
+    lv_draw_buf_destroy(mipmap);
+    lv_draw_buf_destroy(src);
+#endif
+}
+
+void test_image_mipmap_rgb565a8(void)
+{
+#if LV_DRAW_SW_MIPMAP
+    lv_draw_buf_t * src = lv_draw_buf_create(4, 1, LV_COLOR_FORMAT_RGB565A8, 0);
+    uint16_t * rgb = (uint16_t *)src->data;
+    uint8_t * alpha = src->data + src->header.stride;
+    rgb[0] = 0xf800;
+    rgb[1] = 0x001f;
+    rgb[2] = 0x07e0;
+    rgb[3] = 0xffff;
+    alpha[0] = 0xff;
+    alpha[1] = 0x00;
+    alpha[2] = 0x40;
+    alpha[3] = 0xc0;
+
+    lv_draw_buf_t * mipmap = lv_draw_sw_mipmap_create(src, 2, 0);
+    TEST_ASSERT_NOT_NULL(mipmap);
+    TEST_ASSERT_EQUAL(1, mipmap->header.w);
+    TEST_ASSERT_EQUAL(1, mipmap->header.h);
+
+    /*The colors are weighted by the opacity*/
+    uint16_t c = *(uint16_t *)mipmap->data;
+    TEST_ASSERT_EQUAL(27, c >> 11);
+    TEST_ASSERT_EQUAL(32, (c >> 5) & 0x3f);
+    TEST_ASSERT_EQUAL(12, c & 0x1f);
+    TEST_ASSERT_EQUAL_HEX8(0x80, mipmap->data[mipmap->header.stride]);
+
+    lv_draw_buf_destroy(mipmap);
+    lv_draw_buf_destroy(src);
+#endif
+}
+
+static const lv_image_dsc_t * checker_png_create(void)
+{
+    /*A 1 px checkerboard. Sampling it with 25% scale would pick only the black or white pixels.*/
+    static uint32_t px[64 * 64];
+    int32_t x, y;
+    for(y = 0; y < 64; y++) {
+        for(x = 0; x < 64; x++) {
+            px[y * 64 + x] = (x + y) % 2 ? 0xffffffff : 0xff000000;
+        }
+    }
+
+    /*PNG images are decoded and cached so the downscaled copy can be stored in the cache*/
+    static lv_image_dsc_t png_dsc;
+    unsigned char * png;
+    size_t png_size;
+    TEST_ASSERT_EQUAL(0, lodepng_encode32(&png, &png_size, (const unsigned char *)px, 64, 64));
+
+    lv_memzero(&png_dsc, sizeof(png_dsc));
+    png_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    png_dsc.header.cf = LV_COLOR_FORMAT_RAW_ALPHA;
+    png_dsc.data = png;
+    png_dsc.data_size = png_size;
+    return &png_dsc;
+}
+
+static void check_scaled_checker(lv_obj_t * img)
+{
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+
+    /*The image is scaled around its center to 16x16 px*/
+    lv_draw_buf_t * buf = lv_display_get_buf_active(NULL);
+    int32_t x, y;
+    for(y = 100 + 26; y < 100 + 38; y++) {
+        for(x = 100 + 26; x < 100 + 38; x++) {
+            lv_color32_t c = get_px32(buf, x, y);
+            TEST_ASSERT_INT_WITHIN(8, 0x80, c.green);
+        }
+    }
+}
+
+void test_image_mipmap_no_aliasing(void)
+{
+#if LV_DRAW_SW_MIPMAP && LV_USE_LODEPNG
+    const lv_image_dsc_t * checker = checker_png_create();
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_obj_set_pos(img, 100, 100);
+    lv_image_set_scale(img, 64);
+    lv_image_set_src(img, checker);
+
+    /*Draw twice to use the cached copy too*/
+    check_scaled_checker(img);
+    check_scaled_checker(img);
+
+    lv_obj_delete(img);
+    lv_image_cache_drop(checker);
+    lv_free((void *)checker->data);
+#endif
+}
+
+void test_image_mipmap_counted_in_cache(void)
+{
+#if LV_DRAW_SW_MIPMAP && LV_USE_LODEPNG
+    const lv_image_dsc_t * checker = checker_png_create();
+    lv_image_cache_drop(NULL);
+
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_obj_set_pos(img, 100, 100);
+    lv_image_set_src(img, checker);
+    lv_refr_now(NULL);
+
+    lv_cache_t * cache = LV_GLOBAL_DEFAULT()->img_cache;
+    size_t size_ori = lv_cache_get_size(cache, NULL);
+    TEST_ASSERT_GREATER_THAN(0, size_ori);
+
+    /*The 16x16 ARGB8888 copy is added to the size of the cached image*/
+    lv_image_set_scale(img, 64);
+    lv_refr_now(NULL);
+    size_t size_mipmap = lv_cache_get_size(cache, NULL) - size_ori;
+    TEST_ASSERT_GREATER_OR_EQUAL(16 * 16 * 4, size_mipmap);
+    TEST_ASSERT_LESS_THAN(64 * 64 * 4, size_mipmap);
+
+    /*Without the cache no copy is created, the original image is transformed*/
+    lv_image_cache_drop(NULL);
+    TEST_ASSERT_EQUAL(0, lv_cache_get_size(cache, NULL));
+    uint32_t cache_size = lv_cache_get_max_size(cache, NULL);
+    lv_image_cache_resize(0, true);
+
+    uint32_t i;
+    for(i = 0; i < 2; i++) {
+        if(i == 1) lv_draw_sw_enable_mipmap(false);
+        lv_obj_invalidate(img);
+        lv_refr_now(NULL);
+        TEST_ASSERT_EQUAL_SCREENSHOT("draw/image_mipmap_uncached.png");
+    }
+
+    lv_image_cache_resize(cache_size, false);
+    lv_obj_delete(img);
+    lv_free((void *)checker->data);
+#endif
+}
+
+#endif
@@ -58,4 +58,32 @@ void test_update_layer_type_on_state_change(void)
 
 }
 
+void test_skew(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, 200, 100);
+    lv_obj_center(obj);
+    lv_obj_set_style_border_color(obj, lv_color_hex3(0xf00), 0);
+    lv_obj_set_style_bg_color(obj, lv_color_hex3(0x0f0), 0);
+    lv_obj_t * label = lv_label_create(obj);
+    lv_label_set_text(label, "Skewed layer");
+    lv_obj_center(label);
+
+    lv_obj_set_style_transform_skew_x(obj, 300, 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/layer_transform_skew_1.png");
+
+    lv_obj_set_style_transform_skew_x(obj, -200, 0);
+    lv_obj_set_style_transform_skew_y(obj, 150, 0);
+    lv_obj_set_style_transform_rotation(obj, 300, 0);
+    lv_obj_set_style_transform_pivot_x(obj, lv_pct(20), 0);
+    lv_obj_set_style_transform_pivot_y(obj, lv_pct(70), 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/layer_transform_skew_2.png");
+
+    /*No residual parts should remain*/
+    lv_obj_set_style_transform_skew_x(obj, 0, 0);
+    lv_obj_set_style_transform_skew_y(obj, 0, 0);
+    lv_obj_set_style_transform_rotation(obj, 0, 0);
+    TEST_ASSERT_EQUAL_SCREENSHOT("draw/layer_transform_skew_3.png");
+}
+
 #endif
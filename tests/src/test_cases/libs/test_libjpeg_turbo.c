@@ -6,12 +6,15 @@
 
 void setUp(void)
 {
-    /* Function run before every test */
+    /* Temporarily remove tjpgd decoder */
+    lv_tjpgd_deinit();
 }
 
 void tearDown(void)
 {
-    /* Function run after every test */
+    /* Re-add tjpgd decoder */
+    lv_tjpgd_init();
+    lv_image_cache_resize(LV_CACHE_DEF_SIZE, true);
 }
 
 static void create_images(void)
@@ -56,9 +59,6 @@ static void create_images(void)
 
 void test_jpg_2(void)
 {
-    /* Temporarily remove tjpgd decoder */
-    lv_tjpgd_deinit();
-
     create_images();
 
     TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_2.png");
@@ -74,9 +74,170 @@ void test_jpg_2(void)
     TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_2.png");
 
     TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 64);
+}
 
-    /* Re-add tjpgd decoder */
-    lv_tjpgd_init();
+static void check_area(const char * src, const lv_area_t * area)
+{
+    const lv_image_decoder_args_t args = {
+        .no_cache = true,
+    };
+
+    /*Decode the whole image for reference*/
+    lv_image_decoder_dsc_t full_dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&full_dsc, src, &args));
+    TEST_ASSERT_NOT_NULL(full_dsc.decoded);
+    const lv_draw_buf_t * full = full_dsc.decoded;
+
+    /*The image doesn't fit into the cache so only the needed areas are decoded*/
+    lv_image_cache_resize(0, true);
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, NULL));
+    TEST_ASSERT_NULL(dsc.decoded);
+
+    lv_area_t decoded_area = {LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN, LV_COORD_MIN};
+    int32_t y_next = area->y1;
+    while(lv_image_decoder_get_area(&dsc, area, &decoded_area) == LV_RESULT_OK) {
+        TEST_ASSERT_EQUAL_INT32(area->x1, decoded_area.x1);
+        TEST_ASSERT_EQUAL_INT32(area->x2, decoded_area.x2);
+        TEST_ASSERT_EQUAL_INT32(y_next, decoded_area.y1);
+        TEST_ASSERT_EQUAL_INT32(lv_area_get_height(&decoded_area), dsc.decoded->header.h);
+
+        int32_t y;
+        for(y = decoded_area.y1; y <= decoded_area.y2; y++) {
+            const uint8_t * expected = full->data + y * full->header.stride + area->x1 * 3;
+            const uint8_t * actual = dsc.decoded->data + (y - decoded_area.y1) * dsc.decoded->header.stride;
+            TEST_ASSERT_EQUAL_MEMORY(expected, actual, lv_area_get_width(area) * 3);
+        }
+        y_next = decoded_area.y2 + 1;
+    }
+    TEST_ASSERT_EQUAL_INT32(area->y2 + 1, y_next);
+
+    lv_image_decoder_close(&dsc);
+    lv_image_decoder_close(&full_dsc);
+}
+
+void test_jpg_decode_area(void)
+{
+    lv_area_t area = {0, 0, 104, 32};
+    check_area("A:src/test_assets/test_img_lvgl_logo.jpg", &area);
+
+    /*Not aligned to the MCUs*/
+    lv_area_set(&area, 21, 9, 70, 30);
+    check_area("A:src/test_assets/test_img_lvgl_logo.jpg", &area);
+
+    /*Progressive*/
+    check_area("A:src/test_assets/test_img_lvgl_logo_with_exif_orientation_0.jpg", &area);
+}
+
+void test_jpg_draw_uncached(void)
+{
+    lv_image_cache_resize(0, true);
+
+    create_images();
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_2.png");
+}
+
+void test_jpg_decode_scaled(void)
+{
+    const char * src = "A:src/test_assets/test_img_lvgl_logo.jpg";
+    lv_image_decoder_args_t args = {
+        .no_cache = true,
+        .target_w = 25,
+    };
+
+    /*105 / 4 is still larger than 25*/
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_EQUAL_INT32(105, dsc.header.w);
+    TEST_ASSERT_EQUAL_INT32(27, dsc.decoded->header.w);
+    TEST_ASSERT_EQUAL_INT32(9, dsc.decoded->header.h);
+    TEST_ASSERT_NULL(dsc.cache_entry);
+    lv_image_decoder_close(&dsc);
+
+    /*Both sizes need to be reached*/
+    args.target_w = 10;
+    args.target_h = 10;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_EQUAL_INT32(53, dsc.decoded->header.w);
+    TEST_ASSERT_EQUAL_INT32(17, dsc.decoded->header.h);
+    lv_image_decoder_close(&dsc);
+
+    /*The target is in the rotated orientation*/
+    args.target_w = 5;
+    args.target_h = 14;
+    src = "A:src/test_assets/test_img_lvgl_logo_with_exif_orientation_90.jpg";
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_EQUAL_INT32(33, dsc.header.w);
+    TEST_ASSERT_EQUAL_INT32(5, dsc.decoded->header.w);
+    TEST_ASSERT_EQUAL_INT32(14, dsc.decoded->header.h);
+    lv_image_decoder_close(&dsc);
+
+    /*Not smaller than the image*/
+    args.no_cache = false;
+    args.target_w = 200;
+    args.target_h = 0;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_EQUAL_INT32(33, dsc.decoded->header.w);
+    TEST_ASSERT_NOT_NULL(dsc.cache_entry);
+    lv_image_decoder_close(&dsc);
+
+    /*Cache the original image instead if it fits*/
+    args.target_w = 5;
+    args.target_h = 14;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_EQUAL_INT32(33, dsc.decoded->header.w);
+    TEST_ASSERT_NOT_NULL(dsc.cache_entry);
+    lv_image_decoder_close(&dsc);
+
+    lv_image_cache_resize(0, true);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, src, &args));
+    TEST_ASSERT_EQUAL_INT32(5, dsc.decoded->header.w);
+    TEST_ASSERT_NULL(dsc.cache_entry);
+    lv_image_decoder_close(&dsc);
+}
+
+void test_jpg_draw_downscaled(void)
+{
+    lv_image_cache_resize(0, true);
+    lv_obj_clean(lv_screen_active());
+
+    const char * src = "A:src/test_assets/test_img_lvgl_logo.jpg";
+    lv_obj_t * img;
+
+    /*Decoded at 1/2 size and drawn without scaling*/
+    img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_image_set_scale(img, 128);
+    lv_obj_align(img, LV_ALIGN_CENTER, -150, -100);
+
+    /*Decoded at 1/4 size and scaled up a bit*/
+    img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_image_set_scale(img, 80);
+    lv_obj_align(img, LV_ALIGN_CENTER, 0, -100);
+
+    /*Only the width is downscaled*/
+    img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_image_set_scale_x(img, 100);
+    lv_obj_align(img, LV_ALIGN_CENTER, 150, -100);
+
+    /*Rotated around a pivot*/
+    img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_image_set_scale(img, 128);
+    lv_image_set_pivot(img, 20, 10);
+    lv_image_set_rotation(img, 300);
+    lv_obj_align(img, LV_ALIGN_CENTER, -150, 100);
+
+    /*Stretched into a smaller object*/
+    img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, src);
+    lv_image_set_inner_align(img, LV_IMAGE_ALIGN_STRETCH);
+    lv_obj_set_size(img, 40, 12);
+    lv_obj_align(img, LV_ALIGN_CENTER, 0, 100);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_downscaled.png");
 }
 
 #endif
@@ -0,0 +1,113 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define BUF_SIZE    512
+
+static uint8_t src_buf[BUF_SIZE];
+static uint8_t dst_buf[BUF_SIZE];
+static uint8_t ref_buf[BUF_SIZE];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    uint32_t i;
+    for(i = 0; i < BUF_SIZE; i++) src_buf[i] = (uint8_t)(i * 7 + 3);
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void fill_guard(void)
+{
+    uint32_t i;
+    for(i = 0; i < BUF_SIZE; i++) {
+        dst_buf[i] = 0xee;
+        ref_buf[i] = 0xee;
+    }
+}
+
+void test_memcpy_alignments(void)
+{
+    /*Cover every source/destination misalignment and the lengths around the block sizes*/
+    uint32_t src_ofs, dst_ofs, len, i;
+    for(src_ofs = 0; src_ofs < 36; src_ofs++) {
+        for(dst_ofs = 0; dst_ofs < 36; dst_ofs += 3) {
+            for(len = 0; len < 300; len += 5) {
+                fill_guard();
+                lv_memcpy(dst_buf + dst_ofs, src_buf + src_ofs, len);
+                for(i = 0; i < len; i++) ref_buf[dst_ofs + i] = src_buf[src_ofs + i];
+                TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dst_buf, BUF_SIZE);
+            }
+        }
+    }
+}
+
+void test_memset_alignments(void)
+{
+    uint32_t ofs, len, i;
+    for(ofs = 0; ofs < 36; ofs++) {
+        for(len = 0; len < 300; len += 3) {
+            fill_guard();
+            lv_memset(dst_buf + ofs, (uint8_t)len, len);
+            for(i = 0; i < len; i++) ref_buf[ofs + i] = (uint8_t)len;
+            TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dst_buf, BUF_SIZE);
+        }
+    }
+}
+
+void test_memmove_overlap(void)
+{
+    /*Forward copies of overlapping memories go through `lv_memcpy()`*/
+    uint32_t delta, i;
+    for(delta = 1; delta < 70; delta++) {
+        lv_memcpy(dst_buf, src_buf, BUF_SIZE);
+        lv_memmove(dst_buf, dst_buf + delta, 300);
+        for(i = 0; i < 300; i++) TEST_ASSERT_EQUAL_UINT8(src_buf[i + delta], dst_buf[i]);
+
+        lv_memcpy(dst_buf, src_buf, BUF_SIZE);
+        lv_memmove(dst_buf + delta, dst_buf, 300);
+        for(i = 0; i < 300; i++) TEST_ASSERT_EQUAL_UINT8(src_buf[i], dst_buf[i + delta]);
+    }
+}
+
+void test_memcpy_2d(void)
+{
+    uint32_t x, y;
+
+    /*Strided rows*/
+    fill_guard();
+    lv_memcpy_2d(dst_buf + 1, 40, src_buf + 3, 33, 21, 10);
+    for(y = 0; y < 10; y++) {
+        for(x = 0; x < 21; x++) ref_buf[1 + y * 40 + x] = src_buf[3 + y * 33 + x];
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dst_buf, BUF_SIZE);
+
+    /*Continuous rows*/
+    fill_guard();
+    lv_memcpy_2d(dst_buf, 16, src_buf, 16, 16, 8);
+    for(x = 0; x < 16 * 8; x++) ref_buf[x] = src_buf[x];
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dst_buf, BUF_SIZE);
+}
+
+void test_memset_2d(void)
+{
+    uint32_t x, y;
+
+    fill_guard();
+    lv_memset_2d(dst_buf + 5, 50, 0x12, 37, 9);
+    for(y = 0; y < 9; y++) {
+        for(x = 0; x < 37; x++) ref_buf[5 + y * 50 + x] = 0x12;
+    }
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dst_buf, BUF_SIZE);
+
+    fill_guard();
+    lv_memset_2d(dst_buf, 20, 0x34, 20, 6);
+    for(x = 0; x < 20 * 6; x++) ref_buf[x] = 0x34;
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(ref_buf, dst_buf, BUF_SIZE);
+}
+
+#endif
@@ -46,6 +46,38 @@ void test_tiny_ttf_rendering_test(void)
 #endif
 }
 
+void test_tiny_ttf_small_glyph_cache(void)
+{
+#if LV_USE_TINY_TTF
+    /*A cache smaller than the number of used glyphs forces evictions but shouldn't change the rendering*/
+    extern const uint8_t test_ubuntu_font[];
+    extern size_t test_ubuntu_font_size;
+    lv_font_t * font = lv_tiny_ttf_create_data_ex(test_ubuntu_font, test_ubuntu_font_size, 30, 4);
+    lv_tiny_ttf_preload(font, "Hello world");
+
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_text_font(&style, font);
+    lv_style_set_text_align(&style, LV_TEXT_ALIGN_CENTER);
+    lv_style_set_bg_opa(&style, LV_OPA_COVER);
+    lv_style_set_bg_color(&style, lv_color_hex(0xffaaaa));
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_obj_add_style(label, &style, 0);
+    lv_label_set_text(label, "Hello world\n"
+                      "I'm a font created with Tiny TTF\n"
+                      "Accents: ÁÉÍÓÖŐÜŰ áéíóöőüű");
+    lv_obj_center(label);
+
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/tiny_ttf_1.png");
+
+    lv_obj_delete(label);
+    lv_tiny_ttf_destroy(font);
+#else
+    TEST_PASS();
+#endif
+}
+
 void test_tiny_ttf_kerning(void)
 {
 #if LV_USE_TINY_TTF
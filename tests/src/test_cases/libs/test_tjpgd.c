@@ -99,4 +99,42 @@ void test_jdpgd_align_tile(void)
     lv_libjpeg_turbo_init();
 }
 
+static void create_images_transformed(void)
+{
+    lv_obj_clean(lv_screen_active());
+
+    create_images();
+
+    /*The images are decoded in tiles but the transformation needs the whole image*/
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_count(lv_screen_active()); i++) {
+        lv_obj_t * obj = lv_obj_get_child(lv_screen_active(), i);
+        if(!lv_obj_check_type(obj, &lv_image_class)) continue;
+        lv_image_set_rotation(obj, 300);
+        lv_image_set_scale(obj, 384);
+    }
+}
+
+void test_tjpgd_transformed(void)
+{
+    /* Temporarily remove libjpeg_turbo decoder */
+    lv_libjpeg_turbo_deinit();
+
+    create_images_transformed();
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_transformed.png");
+
+    size_t mem_before = lv_test_get_free_mem();
+    for(uint32_t i = 0; i < 20; i++) {
+        create_images_transformed();
+
+        lv_obj_invalidate(lv_screen_active());
+        lv_refr_now(NULL);
+    }
+    TEST_ASSERT_EQUAL_SCREENSHOT("libs/jpg_transformed.png");
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 32);
+
+    /* Re-add libjpeg_turbo decoder */
+    lv_libjpeg_turbo_init();
+}
+
 #endif
@@ -90,4 +90,94 @@ void test_anim_delete_custom(void)
     TEST_ASSERT_EQUAL(39, var);
 }
 
+static void delete_other_cb(lv_anim_t * a)
+{
+    lv_anim_delete(a->user_data, NULL);
+}
+
+void test_anim_delete_many(void)
+{
+    static int32_t vars[1000];
+    uint32_t i;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 100);
+    for(i = 0; i < 1000; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_start(&a);
+    }
+    TEST_ASSERT_EQUAL(1000, lv_anim_count_running());
+
+    lv_test_wait(20);
+
+    /*Delete every second animation*/
+    for(i = 0; i < 1000; i += 2) {
+        TEST_ASSERT_TRUE(lv_anim_delete(&vars[i], NULL));
+    }
+    TEST_ASSERT_EQUAL(500, lv_anim_count_running());
+
+    lv_test_wait(20);
+    for(i = 0; i < 1000; i++) {
+        if(i % 2) {
+            TEST_ASSERT_EQUAL(39, vars[i]);
+            TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[i], exec_cb));
+        }
+        else {
+            TEST_ASSERT_EQUAL(19, vars[i]);
+            TEST_ASSERT_NULL(lv_anim_get(&vars[i], exec_cb));
+        }
+    }
+
+    /*Delete all the animations with a given callback*/
+    TEST_ASSERT_TRUE(lv_anim_delete(NULL, exec_cb));
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_anim_delete_in_callback(void)
+{
+    int32_t var1 = 0;
+    int32_t var2 = 0;
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_exec_cb(&a, exec_cb);
+    lv_anim_set_duration(&a, 100);
+
+    /*Deleting the first animation deletes the other one too*/
+    lv_anim_set_var(&a, &var1);
+    lv_anim_set_deleted_cb(&a, delete_other_cb);
+    lv_anim_set_user_data(&a, &var2);
+    lv_anim_start(&a);
+
+    lv_anim_set_var(&a, &var2);
+    lv_anim_set_deleted_cb(&a, NULL);
+    lv_anim_start(&a);
+
+    lv_test_wait(20);
+    lv_anim_delete(&var1, NULL);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+
+    /*The first animation completes earlier and deletes the other one while they are stepped*/
+    var1 = 0;
+    var2 = 0;
+    lv_anim_set_var(&a, &var2);
+    lv_anim_start(&a);
+
+    lv_anim_set_var(&a, &var1);
+    lv_anim_set_duration(&a, 30);
+    lv_anim_set_completed_cb(&a, delete_other_cb);
+    lv_anim_start(&a);
+
+    lv_test_wait(20);
+    TEST_ASSERT_EQUAL(19, var2);
+    lv_test_wait(20);
+    TEST_ASSERT_EQUAL(100, var1);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_LESS_OR_EQUAL(39, var2);
+}
+
 #endif
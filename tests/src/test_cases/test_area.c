@@ -118,4 +118,36 @@ void test_pct(void)
     TEST_ASSERT_EQUAL_INT32(-PCT_MAX_VALUE, LV_COORD_GET_PCT(pct_coord));
 }
 
+void test_point_array_skew(void)
+{
+    lv_point_t pivot = {100, 50};
+    lv_point_t p[2] = {{110, 70}, {80, 50}};
+
+    /*tan(45°) = 1*/
+    lv_point_array_skew(p, 2, 450, 0, &pivot, false);
+    TEST_ASSERT_EQUAL_INT32(130, p[0].x);
+    TEST_ASSERT_EQUAL_INT32(70, p[0].y);
+    TEST_ASSERT_EQUAL_INT32(80, p[1].x);
+    TEST_ASSERT_EQUAL_INT32(50, p[1].y);
+
+    lv_point_array_skew(p, 2, 450, 0, &pivot, true);
+    TEST_ASSERT_EQUAL_INT32(110, p[0].x);
+    TEST_ASSERT_EQUAL_INT32(70, p[0].y);
+
+    /*tan(-26.6°) = -0.5*/
+    lv_point_array_skew(p, 2, 0, -266, &pivot, false);
+    TEST_ASSERT_EQUAL_INT32(110, p[0].x);
+    TEST_ASSERT_EQUAL_INT32(65, p[0].y);
+    TEST_ASSERT_EQUAL_INT32(80, p[1].x);
+    TEST_ASSERT_EQUAL_INT32(60, p[1].y);
+
+    /*The inverse of skewing in both directions*/
+    p[0].x = 110;
+    p[0].y = 70;
+    lv_point_array_skew(p, 1, 300, -200, &pivot, false);
+    lv_point_array_skew(p, 1, 300, -200, &pivot, true);
+    TEST_ASSERT_INT32_WITHIN(1, 110, p[0].x);
+    TEST_ASSERT_INT32_WITHIN(1, 70, p[0].y);
+}
+
 #endif
@@ -0,0 +1,141 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define CALL_CNT   100
+
+static uint32_t call_order[CALL_CNT * 2];
+static uint32_t call_cnt;
+
+static void record_cb(void * user_data)
+{
+    call_order[call_cnt] = (uint32_t)(lv_uintptr_t)user_data;
+    call_cnt++;
+}
+
+static void requeue_cb(void * user_data)
+{
+    record_cb(user_data);
+    lv_async_call(record_cb, (void *)((lv_uintptr_t)user_data + 1));
+}
+
+static uint32_t get_timer_cnt(void)
+{
+    uint32_t cnt = 0;
+    lv_timer_t * timer = lv_timer_get_next(NULL);
+    while(timer) {
+        cnt++;
+        timer = lv_timer_get_next(timer);
+    }
+    return cnt;
+}
+
+void setUp(void)
+{
+    /* Function run before every test */
+    call_cnt = 0;
+    lv_memzero(call_order, sizeof(call_order));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_timer_handler();
+}
+
+void test_async_call_order(void)
+{
+    uint32_t timer_cnt = get_timer_cnt();
+
+    uint32_t i;
+    for(i = 0; i < CALL_CNT; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_async_call(record_cb, (void *)(lv_uintptr_t)i));
+    }
+
+    /*No timers are created for the calls*/
+    TEST_ASSERT_EQUAL_UINT32(timer_cnt, get_timer_cnt());
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(CALL_CNT, call_cnt);
+    for(i = 0; i < CALL_CNT; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i, call_order[i]);
+    }
+}
+
+void test_async_call_in_callback_runs_in_next_round(void)
+{
+    lv_async_call(requeue_cb, (void *)10);
+    lv_async_call(record_cb, (void *)20);
+
+    /*The call queued by `requeue_cb` runs only in the next round but without waiting*/
+    TEST_ASSERT_EQUAL_UINT32(0, lv_timer_handler());
+    TEST_ASSERT_EQUAL_UINT32(2, call_cnt);
+    TEST_ASSERT_EQUAL_UINT32(10, call_order[0]);
+    TEST_ASSERT_EQUAL_UINT32(20, call_order[1]);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(3, call_cnt);
+    TEST_ASSERT_EQUAL_UINT32(11, call_order[2]);
+}
+
+void test_async_call_cancel(void)
+{
+    lv_async_call(record_cb, (void *)1);
+    lv_async_call(record_cb, (void *)2);
+    lv_async_call(record_cb, (void *)1);
+    lv_async_call_from_thread(record_cb, (void *)1);
+    lv_async_call_from_thread(record_cb, (void *)3);
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_async_call_cancel(record_cb, (void *)1));
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_async_call_cancel(record_cb, (void *)1));
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_async_call_cancel(requeue_cb, (void *)2));
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2, call_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2, call_order[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, call_order[1]);
+}
+
+void test_async_call_from_thread(void)
+{
+    /*The calls of the LVGL thread run first*/
+    uint32_t i;
+    for(i = 0; i < LV_ASYNC_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_async_call_from_thread(record_cb, (void *)(lv_uintptr_t)(i + 1000)));
+    }
+    lv_async_call(record_cb, (void *)1);
+
+    /*The queue is full*/
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, lv_async_call_from_thread(record_cb, (void *)2000));
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(LV_ASYNC_QUEUE_SIZE + 1, call_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, call_order[0]);
+    for(i = 0; i < LV_ASYNC_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i + 1000, call_order[i + 1]);
+    }
+
+    /*The slots can be used again*/
+    for(i = 0; i < LV_ASYNC_QUEUE_SIZE; i++) {
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_async_call_from_thread(record_cb, (void *)(lv_uintptr_t)i));
+    }
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(2 * LV_ASYNC_QUEUE_SIZE + 1, call_cnt);
+}
+
+void test_async_obj_delete(void)
+{
+    lv_obj_t * obj1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * obj2 = lv_obj_create(lv_screen_active());
+    lv_obj_delete_async(obj1);
+    lv_obj_delete_async(obj2);
+
+    /*Deleting the object cancels its pending delete*/
+    lv_obj_delete(obj2);
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(0, lv_obj_get_child_count(lv_screen_active()));
+}
+
+#endif
@@ -42,4 +42,49 @@ void test_event_should_not_memory_lean(void)
     TEST_ASSERT_LESS_OR_EQUAL_CHAR(initial_free_size, m2.free_size);
 }
 
+static uint32_t draw_main_begin_cnt;
+
+static void draw_main_begin_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    draw_main_begin_cnt++;
+}
+
+/* The draw events which are not handled by anyone shouldn't be sent */
+void test_event_skip_draw_events(void)
+{
+    lv_obj_clean(lv_screen_active());
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    uint32_t skipped_screen = lv_display_get_skipped_draw_event_count(NULL);
+
+    /*DRAW_MAIN_BEGIN/END and DRAW_POST_BEGIN/END are skipped for a plain object*/
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_refr_now(NULL);
+    uint32_t skipped_ori = lv_display_get_skipped_draw_event_count(NULL);
+    TEST_ASSERT_EQUAL(skipped_screen + 4, skipped_ori);
+
+    /*The events with handlers need to be sent*/
+    draw_main_begin_cnt = 0;
+    lv_obj_add_event_cb(obj, draw_main_begin_cb, LV_EVENT_DRAW_MAIN_BEGIN, NULL);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(skipped_ori - 1, lv_display_get_skipped_draw_event_count(NULL));
+    TEST_ASSERT_EQUAL(1, draw_main_begin_cnt);
+
+    lv_obj_remove_event_cb(obj, draw_main_begin_cb);
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(skipped_ori, lv_display_get_skipped_draw_event_count(NULL));
+    TEST_ASSERT_EQUAL(1, draw_main_begin_cnt);
+
+    /*Widgets with custom event handlers might use any events*/
+    lv_obj_class_create_obj(&event_object_deletion_class, lv_screen_active());
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(skipped_ori, lv_display_get_skipped_draw_event_count(NULL));
+
+    lv_obj_clean(lv_screen_active());
+}
+
 #endif
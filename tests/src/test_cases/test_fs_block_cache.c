@@ -0,0 +1,262 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+#include <string.h>
+
+#define BLOCK_SIZE LV_FS_BLOCK_CACHE_BLOCK_SIZE
+#define FILE_NAME "Z:src/test_files/fs_block_cache.bin"
+#define FILE_NAME_2 "Z:src/test_files/fs_block_cache_2.bin"
+#define FILE_SIZE 1000  /*Not a multiple of the block size*/
+
+/*A driver which counts the reads and seeks of the POSIX driver*/
+static lv_fs_drv_t counter_drv;
+static uint32_t read_cnt;
+static uint32_t seek_cnt;
+
+static lv_fs_res_t counter_read_cb(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_drv_t * base = drv->user_data;
+    read_cnt++;
+    return base->read_cb(base, file_p, buf, btr, br);
+}
+
+static lv_fs_res_t counter_seek_cb(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    lv_fs_drv_t * base = drv->user_data;
+    seek_cnt++;
+    return base->seek_cb(base, file_p, pos, whence);
+}
+
+static void write_file_path(const char * path, uint8_t first_value)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR));
+
+    uint8_t buf[FILE_SIZE];
+    uint32_t i;
+    for(i = 0; i < FILE_SIZE; i++) buf[i] = (uint8_t)(i + first_value);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, buf, FILE_SIZE, NULL));
+    lv_fs_close(&f);
+}
+
+static void write_file(uint8_t first_value)
+{
+    write_file_path(FILE_NAME, first_value);
+}
+
+static void check_read(lv_fs_file_t * f, uint32_t len, uint8_t first_value)
+{
+    uint32_t pos;
+    lv_fs_tell(f, &pos);
+
+    uint8_t buf[FILE_SIZE];
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(f, buf, len, &br));
+    TEST_ASSERT_EQUAL_UINT32(pos < FILE_SIZE ? LV_MIN(len, FILE_SIZE - pos) : 0, br);
+
+    uint32_t i;
+    for(i = 0; i < br; i++) {
+        TEST_ASSERT_EQUAL_UINT8((uint8_t)(pos + i + first_value), buf[i]);
+    }
+}
+
+void setUp(void)
+{
+    if(lv_fs_get_drv('Z') == NULL) {
+        lv_fs_drv_t * posix_drv = lv_fs_get_drv('B');
+        counter_drv = *posix_drv;
+        counter_drv.letter = 'Z';
+        counter_drv.cache_size = 0;
+        counter_drv.read_cb = counter_read_cb;
+        counter_drv.seek_cb = counter_seek_cb;
+        counter_drv.user_data = posix_drv;
+        lv_fs_drv_register(&counter_drv);
+    }
+
+    write_file(0);
+
+    lv_fs_block_cache_resize(8);
+    read_cnt = 0;
+    seek_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_fs_block_cache_resize(0);
+}
+
+void test_fs_block_cache_reopen(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    lv_fs_seek(&f, 3 * BLOCK_SIZE + 10, LV_FS_SEEK_SET);
+    check_read(&f, BLOCK_SIZE, 0);
+    lv_fs_close(&f);
+
+    /*The 2 affected blocks were read and as the second was read sequentially the next blocks too*/
+    TEST_ASSERT_EQUAL_UINT32(2 + LV_FS_BLOCK_CACHE_READ_AHEAD, read_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, seek_cnt);
+
+    /*Reopen: the blocks are read from the cache*/
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    lv_fs_seek(&f, 3 * BLOCK_SIZE + 20, LV_FS_SEEK_SET);
+    check_read(&f, 2 * BLOCK_SIZE, 0);
+    lv_fs_close(&f);
+
+    TEST_ASSERT_EQUAL_UINT32(2 + LV_FS_BLOCK_CACHE_READ_AHEAD, read_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, seek_cnt);
+}
+
+void test_fs_block_cache_sequential_read_ahead(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+
+    /*Use an odd size to not be aligned with the blocks*/
+    uint32_t pos = 0;
+    while(pos < FILE_SIZE) {
+        check_read(&f, 37, 0);
+        pos += 37;
+    }
+
+    /*Check the end of the file*/
+    check_read(&f, 10, 0);
+
+    /*All the blocks were read without seeking, mostly in advance*/
+    TEST_ASSERT_EQUAL_UINT32(0, seek_cnt);
+    TEST_ASSERT_EQUAL_UINT32((FILE_SIZE + BLOCK_SIZE - 1) / BLOCK_SIZE, read_cnt);
+
+    lv_fs_close(&f);
+}
+
+void test_fs_block_cache_random_read(void)
+{
+    lv_fs_file_t f1;
+    lv_fs_file_t f2;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f1, FILE_NAME, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f2, FILE_NAME, LV_FS_MODE_RD));
+
+    uint32_t i;
+    for(i = 0; i < 200; i++) {
+        uint32_t pos = (i * 7919) % (FILE_SIZE + 20);
+        uint32_t len = (i * 104729) % 300;
+        lv_fs_file_t * f = i % 2 ? &f1 : &f2;
+        lv_fs_seek(f, pos, LV_FS_SEEK_SET);
+        check_read(f, len, 0);
+    }
+
+    /*Read more than the whole cache at once*/
+    lv_fs_seek(&f1, 10, LV_FS_SEEK_SET);
+    check_read(&f1, FILE_SIZE, 0);
+
+    /*Seek to the end*/
+    lv_fs_seek(&f2, 0, LV_FS_SEEK_END);
+    uint32_t pos;
+    lv_fs_tell(&f2, &pos);
+    TEST_ASSERT_EQUAL_UINT32(FILE_SIZE, pos);
+    check_read(&f2, 100, 0);
+
+    lv_fs_seek(&f2, FILE_SIZE - 100, LV_FS_SEEK_SET);
+    check_read(&f2, 100, 0);
+
+    lv_fs_close(&f1);
+    lv_fs_close(&f2);
+}
+
+void test_fs_block_cache_write_drops_blocks(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    check_read(&f, 200, 0);
+    lv_fs_close(&f);
+
+    write_file(100);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    check_read(&f, 200, 100);
+    lv_fs_close(&f);
+}
+
+/*Only the written blocks of the written file are dropped*/
+void test_fs_block_cache_write_drops_own_blocks(void)
+{
+    lv_fs_block_cache_resize(2 * FILE_SIZE / BLOCK_SIZE + 2);
+    write_file_path(FILE_NAME_2, 50);
+
+    lv_fs_file_t f;
+    lv_fs_file_t f2;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f2, FILE_NAME_2, LV_FS_MODE_RD));
+    check_read(&f, FILE_SIZE, 0);
+    check_read(&f2, FILE_SIZE, 50);
+
+    /*Overwrite a byte in the second block*/
+    lv_fs_file_t fw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fw, FILE_NAME, LV_FS_MODE_RD | LV_FS_MODE_WR));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fw, BLOCK_SIZE + 10, LV_FS_SEEK_SET));
+    uint8_t v = 0xAA;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&fw, &v, 1, NULL));
+    lv_fs_close(&fw);
+
+    read_cnt = 0;
+    lv_fs_seek(&f2, 0, LV_FS_SEEK_SET);
+    check_read(&f2, FILE_SIZE, 50);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    check_read(&f, BLOCK_SIZE, 0);
+    TEST_ASSERT_EQUAL_UINT32(0, read_cnt);
+
+    /*The second block is read again*/
+    uint8_t buf[BLOCK_SIZE];
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, BLOCK_SIZE, NULL));
+    TEST_ASSERT_EQUAL_UINT8(0xAA, buf[10]);
+    TEST_ASSERT_EQUAL_UINT8((uint8_t)(BLOCK_SIZE + 11), buf[11]);
+    TEST_ASSERT_EQUAL_UINT32(1, read_cnt);
+
+    lv_fs_close(&f);
+    lv_fs_close(&f2);
+}
+
+/*The files with cached blocks are tracked until their last block is freed*/
+void test_fs_block_cache_no_leak(void)
+{
+    lv_fs_block_cache_resize(0);
+    size_t mem_before = lv_test_get_free_mem();
+    lv_fs_block_cache_resize(2 * FILE_SIZE / BLOCK_SIZE + 2);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    check_read(&f, FILE_SIZE, 0);
+    lv_fs_close(&f);
+
+    /*Drops all the blocks of the file*/
+    write_file(0);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    check_read(&f, FILE_SIZE, 0);
+    lv_fs_close(&f);
+
+    lv_fs_block_cache_resize(0);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_fs_block_cache_disabled(void)
+{
+    lv_fs_block_cache_resize(0);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    check_read(&f, 200, 0);
+    lv_fs_close(&f);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, FILE_NAME, LV_FS_MODE_RD));
+    check_read(&f, 200, 0);
+    lv_fs_close(&f);
+
+    /*Each read goes to the driver*/
+    TEST_ASSERT_EQUAL_UINT32(2, read_cnt);
+}
+
+#endif
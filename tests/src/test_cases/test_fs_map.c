@@ -0,0 +1,195 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#define IMAGE_PATH "test_images/stride_align1/UNCOMPRESSED/test_%s.bin"
+
+static lv_draw_buf_align_cb align_pointer_cb_ori;
+
+/*The test config uses an odd alignment which a mapped file never has*/
+static void * align_pointer_no_op(void * buf, lv_color_format_t color_format)
+{
+    LV_UNUSED(color_format);
+    return buf;
+}
+
+static void read_file(const char * path, uint32_t pos, void * buf, uint32_t len)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    lv_fs_seek(&f, pos, LV_FS_SEEK_SET);
+
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, len, &br));
+    TEST_ASSERT_EQUAL_UINT32(len, br);
+    lv_fs_close(&f);
+}
+
+static void check_mapped_image(const char * cf_name)
+{
+    char path[128];
+    lv_snprintf(path, sizeof(path), "B:" IMAGE_PATH, cf_name);
+
+    const lv_image_decoder_args_t args = {
+        .no_cache = true,
+        .premultiply = false,
+        .stride_align = false,
+        .use_indexed = true,
+    };
+
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, path, &args));
+    TEST_ASSERT_NOT_NULL(dsc.decoded);
+
+    /*The mapped data can't be modified*/
+    TEST_ASSERT_FALSE(lv_draw_buf_has_flag((lv_draw_buf_t *)dsc.decoded, LV_IMAGE_FLAGS_MODIFIABLE));
+
+    uint32_t len = dsc.decoded->data_size;
+    uint8_t * expected = lv_malloc(len);
+    read_file(path, sizeof(lv_image_header_t), expected, len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, dsc.decoded->data, len);
+    lv_free(expected);
+
+    lv_image_decoder_close(&dsc);
+}
+
+void setUp(void)
+{
+    lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    align_pointer_cb_ori = handlers->align_pointer_cb;
+    handlers->align_pointer_cb = align_pointer_no_op;
+}
+
+void tearDown(void)
+{
+    lv_draw_buf_get_handlers()->align_pointer_cb = align_pointer_cb_ori;
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_fs_map_posix(void)
+{
+    const char * path = "B:src/test_files/readtest.txt";
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+
+    uint32_t size;
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+
+    /*Not page aligned position*/
+    char buf[64];
+    uint32_t len = LV_MIN(size - 3, sizeof(buf));
+    read_file(path, 3, buf, len);
+
+    const void * mapped = lv_fs_map(&f, 3, len);
+    TEST_ASSERT_NOT_NULL(mapped);
+    TEST_ASSERT_EQUAL_MEMORY(buf, mapped, len);
+    lv_fs_unmap(&f, mapped, len);
+
+    /*The region needs to be in the file*/
+    TEST_ASSERT_NULL(lv_fs_map(&f, 0, size + 1));
+    TEST_ASSERT_NULL(lv_fs_map(&f, size, 1));
+
+    lv_fs_close(&f);
+}
+
+void test_fs_map_memfs(void)
+{
+    static const uint8_t data[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    lv_fs_path_ex_t path;
+    lv_fs_make_path_from_buffer(&path, LV_FS_MEMFS_LETTER, data, sizeof(data));
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, (const char *)&path, LV_FS_MODE_RD));
+
+    /*The buffer is returned directly*/
+    TEST_ASSERT_EQUAL_PTR(&data[2], lv_fs_map(&f, 2, 8));
+    TEST_ASSERT_NULL(lv_fs_map(&f, 2, 9));
+    lv_fs_unmap(&f, &data[2], 8);
+
+    lv_fs_close(&f);
+}
+
+void test_fs_map_not_supported(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, "A:src/test_files/readtest.txt", LV_FS_MODE_RD));
+    TEST_ASSERT_NULL(lv_fs_map(&f, 0, 1));
+    lv_fs_close(&f);
+}
+
+void test_fs_map_bin_decoder(void)
+{
+    check_mapped_image("ARGB8888");
+    check_mapped_image("XRGB8888");
+    check_mapped_image("RGB888");
+    check_mapped_image("RGB565");
+    check_mapped_image("RGB565A8");
+}
+
+void test_fs_map_bin_decoder_premultiply(void)
+{
+    const char * path = "B:test_images/stride_align1/UNCOMPRESSED/test_ARGB8888.bin";
+    const lv_image_decoder_args_t args = {
+        .no_cache = true,
+        .premultiply = true,
+    };
+
+    /*The mapped data is copied to premultiply it*/
+    lv_image_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc, path, &args));
+    TEST_ASSERT_TRUE(lv_draw_buf_has_flag((lv_draw_buf_t *)dsc.decoded, LV_IMAGE_FLAGS_PREMULTIPLIED));
+    TEST_ASSERT_TRUE(lv_draw_buf_has_flag((lv_draw_buf_t *)dsc.decoded, LV_IMAGE_FLAGS_MODIFIABLE));
+    lv_image_decoder_close(&dsc);
+}
+
+void test_fs_map_bin_decoder_cached(void)
+{
+    const char * path = "B:test_images/stride_align1/UNCOMPRESSED/test_ARGB8888.bin";
+    const lv_image_decoder_args_t args = {
+        .no_cache = false,
+        .premultiply = false,
+        .stride_align = false,
+        .use_indexed = true,
+    };
+
+    lv_image_cache_drop(path);
+    size_t mem_before = lv_test_get_free_mem();
+
+    lv_image_decoder_dsc_t dsc1;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc1, path, &args));
+    TEST_ASSERT_NOT_NULL(dsc1.cache_entry);
+    TEST_ASSERT_FALSE(lv_draw_buf_has_flag((lv_draw_buf_t *)dsc1.decoded, LV_IMAGE_FLAGS_MODIFIABLE));
+
+    /*The mapping is reused from the cache, even after closing the first session*/
+    lv_image_decoder_dsc_t dsc2;
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc2, path, &args));
+    TEST_ASSERT_EQUAL_PTR(dsc1.decoded, dsc2.decoded);
+    lv_image_decoder_close(&dsc1);
+    lv_image_decoder_close(&dsc2);
+
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_image_decoder_open(&dsc1, path, &args));
+    TEST_ASSERT_EQUAL_PTR(dsc2.decoded->data, dsc1.decoded->data);
+    lv_image_decoder_close(&dsc1);
+
+    /*Dropping the entry unmaps and closes the file*/
+    lv_image_cache_drop(path);
+    TEST_ASSERT_MEM_LEAK_LESS_THAN(mem_before, 0);
+}
+
+void test_fs_map_draw(void)
+{
+    lv_obj_t * img = lv_image_create(lv_screen_active());
+    lv_image_set_src(img, "B:test_images/stride_align1/UNCOMPRESSED/test_RGB565A8.bin");
+    lv_obj_center(img);
+    lv_refr_now(NULL);
+
+    lv_image_set_src(img, "B:test_images/stride_align1/UNCOMPRESSED/test_ARGB8888.bin");
+    lv_refr_now(NULL);
+}
+
+#endif
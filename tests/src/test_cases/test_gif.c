@@ -0,0 +1,117 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#if LV_USE_OS
+    #include <unistd.h>
+#endif
+
+#define GIF_SRC "A:../examples/libs/gif/bulb.gif"
+
+static lv_obj_t * gif;
+
+static uint32_t frame_hash(void)
+{
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    const uint8_t * data = gifobj->imgdsc.data;
+    uint32_t size = gifobj->imgdsc.header.w * gifobj->imgdsc.header.h * 4;
+
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*Wait max. 5 seconds of animation for a different frame*/
+static bool wait_next_frame(void)
+{
+    uint32_t hash = frame_hash();
+    uint32_t i;
+    for(i = 0; i < 500; i++) {
+        lv_test_wait(10);
+        if(frame_hash() != hash) return true;
+#if LV_USE_OS
+        /*Let the decoder thread run*/
+        usleep(1000);
+#endif
+    }
+    return false;
+}
+
+void setUp(void)
+{
+    gif = lv_gif_create(lv_screen_active());
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_gif_show_frames(void)
+{
+    lv_gif_set_src(gif, GIF_SRC);
+
+    lv_gif_t * gifobj = (lv_gif_t *)gif;
+    TEST_ASSERT_NOT_NULL(gifobj->gif);
+    TEST_ASSERT_NOT_NULL(gifobj->imgdsc.data);
+    lv_obj_update_layout(gif);
+    TEST_ASSERT_EQUAL_INT32(gifobj->gif->width, lv_obj_get_width(gif));
+
+    /*The first frame is shown right away*/
+    uint8_t * data = (uint8_t *)gifobj->imgdsc.data;
+    bool has_opa = false;
+    uint32_t i;
+    for(i = 3; i < gifobj->gif->width * gifobj->gif->height * 4; i += 4) {
+        if(data[i]) has_opa = true;
+    }
+    TEST_ASSERT_TRUE(has_opa);
+
+    TEST_ASSERT_TRUE(wait_next_frame());
+    TEST_ASSERT_TRUE(wait_next_frame());
+    TEST_ASSERT_TRUE(wait_next_frame());
+}
+
+void test_gif_pause_resume_restart(void)
+{
+    lv_gif_set_src(gif, GIF_SRC);
+    TEST_ASSERT_TRUE(wait_next_frame());
+
+    lv_gif_pause(gif);
+    uint32_t hash = frame_hash();
+    uint32_t i;
+    for(i = 0; i < 100; i++) {
+        lv_test_wait(10);
+    }
+    TEST_ASSERT_EQUAL_UINT32(hash, frame_hash());
+
+    lv_gif_resume(gif);
+    TEST_ASSERT_TRUE(wait_next_frame());
+
+    lv_gif_restart(gif);
+    TEST_ASSERT_TRUE(wait_next_frame());
+    TEST_ASSERT_TRUE(wait_next_frame());
+}
+
+void test_gif_change_src_and_delete(void)
+{
+    lv_gif_set_src(gif, GIF_SRC);
+    lv_test_wait(10);
+
+    /*Stop the decoding of the previous source*/
+    lv_gif_set_src(gif, GIF_SRC);
+    TEST_ASSERT_TRUE(wait_next_frame());
+
+    lv_obj_delete(gif);
+
+    /*Delete while the decoder might be working*/
+    gif = lv_gif_create(lv_screen_active());
+    lv_gif_set_src(gif, GIF_SRC);
+    lv_obj_delete(gif);
+}
+
+#endif
@@ -0,0 +1,161 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_indev.h"
+
+extern lv_indev_t * lv_test_mouse_indev;
+
+/*Each read reports `samples_per_read` samples with `step` movement along the y axis.*/
+static uint32_t samples_per_read;
+static bool use_timestamps;
+static bool same_timestamps;
+static int32_t step_x;
+static int32_t step_y;
+static uint32_t move_reads;
+
+static uint32_t read_cnt;
+static uint32_t sample_cnt;
+static lv_point_t act_point;
+
+static void batch_read_cb(lv_indev_t * indev, lv_indev_data_t * data)
+{
+    LV_UNUSED(indev);
+
+    if(read_cnt == 0) {
+        /*Release at the start point first to have a valid previous sample*/
+        data->state = LV_INDEV_STATE_RELEASED;
+        read_cnt++;
+    }
+    else if(read_cnt == 1) {
+        data->state = LV_INDEV_STATE_PRESSED;
+        read_cnt++;
+    }
+    else if(read_cnt < move_reads + 2) {
+        data->state = LV_INDEV_STATE_PRESSED;
+        act_point.x += step_x;
+        act_point.y += step_y;
+        sample_cnt++;
+
+        /*Distribute the samples evenly in the read period*/
+        uint32_t remaining = samples_per_read - sample_cnt;
+        if(use_timestamps) {
+            data->timestamp = lv_tick_get();
+            if(!same_timestamps) data->timestamp -= remaining * (LV_DEF_REFR_PERIOD / samples_per_read);
+            data->timestamp_valid = true;
+        }
+
+        if(remaining > 0) {
+            data->continue_reading = true;
+        }
+        else {
+            sample_cnt = 0;
+            read_cnt++;
+        }
+    }
+    else {
+        data->state = LV_INDEV_STATE_RELEASED;
+    }
+
+    data->point = act_point;
+    if(use_timestamps && !data->timestamp_valid) {
+        data->timestamp = lv_tick_get();
+        data->timestamp_valid = true;
+    }
+}
+
+static void start_drag(uint32_t samples, bool timestamps, int32_t dist_x, int32_t dist_y, uint32_t reads)
+{
+    samples_per_read = samples;
+    use_timestamps = timestamps;
+    same_timestamps = false;
+    step_x = dist_x / (int32_t)samples;
+    step_y = dist_y / (int32_t)samples;
+    move_reads = reads;
+    read_cnt = 0;
+    sample_cnt = 0;
+    act_point.x = 100;
+    act_point.y = 150;
+}
+
+static int32_t throw_scroll(uint32_t samples, bool timestamps, bool same)
+{
+    lv_obj_t * cont = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(cont, 200, 200);
+    lv_obj_t * content = lv_obj_create(cont);
+    lv_obj_set_size(content, 150, 5000);
+
+    start_drag(samples, timestamps, 0, -24, 6);
+    same_timestamps = same;
+    lv_test_indev_wait(2000);
+
+    int32_t scroll_y = lv_obj_get_scroll_y(cont);
+    lv_obj_delete(cont);
+    return scroll_y;
+}
+
+static void gesture_event_cb(lv_event_t * e)
+{
+    lv_dir_t * dir = lv_event_get_user_data(e);
+    *dir = lv_indev_get_gesture_dir(lv_indev_active());
+}
+
+void setUp(void)
+{
+    lv_indev_set_read_cb(lv_test_mouse_indev, batch_read_cb);
+    start_drag(1, false, 0, 0, 0);
+    lv_test_indev_wait(100);
+}
+
+void tearDown(void)
+{
+    lv_indev_set_read_cb(lv_test_mouse_indev, lv_test_mouse_read_cb);
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_indev_timestamp_scroll_throw_independent_of_batching(void)
+{
+    int32_t legacy = throw_scroll(1, false, false);
+    int32_t single = throw_scroll(1, true, false);
+    int32_t batched = throw_scroll(3, true, false);
+
+    /*With a sample in every read period the timestamps shouldn't change anything*/
+    TEST_ASSERT_GREATER_THAN(6 * 24, legacy);
+    TEST_ASSERT_EQUAL_INT32(legacy, single);
+
+    /*The same movement in 3 samples per read should be thrown similarly*/
+    TEST_ASSERT_INT32_WITHIN(legacy / 10, single, batched);
+}
+
+void test_indev_timestamp_same_time_no_spike(void)
+{
+    int32_t single = throw_scroll(1, true, false);
+
+    /*All samples of a read have the same time, so the movement can be measured only in the next read.
+     *It shouldn't be amplified as if the samples were taken very quickly after each other.*/
+    int32_t same = throw_scroll(3, true, true);
+    TEST_ASSERT_INT32_WITHIN(single / 4, single, same);
+}
+
+void test_indev_timestamp_gesture_with_batched_samples(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_screen_active());
+    lv_obj_set_size(obj, lv_pct(100), lv_pct(100));
+    lv_obj_remove_flag(obj, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_GESTURE_BUBBLE);
+
+    lv_dir_t dir = LV_DIR_NONE;
+    lv_obj_add_event_cb(obj, gesture_event_cb, LV_EVENT_GESTURE, &dir);
+
+    /*2 px per sample is slower than the default minimum gesture velocity
+     *only if the samples are not scaled by their time*/
+    start_drag(4, true, 8, 0, 10);
+    lv_test_indev_wait(1000);
+    TEST_ASSERT_EQUAL(LV_DIR_RIGHT, dir);
+
+    dir = LV_DIR_NONE;
+    start_drag(4, false, 8, 0, 10);
+    lv_test_indev_wait(1000);
+    TEST_ASSERT_EQUAL(LV_DIR_NONE, dir);
+}
+
+#endif
@@ -0,0 +1,172 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "fake_drm/lv_fake_drm.h"
+
+#if LV_USE_LINUX_DRM && LV_COLOR_DEPTH == 32
+
+#define HOR_RES LV_FAKE_DRM_HOR_RES
+#define VER_RES LV_FAKE_DRM_VER_RES
+
+static lv_display_t * drm_disp;
+static lv_draw_buf_align_cb align_pointer_cb_ori;
+
+/*The DUMB buffers are mapped to page boundaries which satisfies any real `LV_DRAW_BUF_ALIGN`,
+ *but not the unusual alignment used by the tests*/
+static void * align_page_aligned_cb(void * buf, lv_color_format_t cf)
+{
+    if(((lv_uintptr_t)buf & 0xfff) == 0) return buf;
+    return align_pointer_cb_ori(buf, cf);
+}
+
+void setUp(void)
+{
+    lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    align_pointer_cb_ori = handlers->align_pointer_cb;
+    handlers->align_pointer_cb = align_page_aligned_cb;
+
+    const char * path = lv_fake_drm_init();
+    TEST_ASSERT_NOT_NULL(path);
+
+    drm_disp = lv_linux_drm_create();
+    lv_linux_drm_set_file(drm_disp, path, -1);
+}
+
+void tearDown(void)
+{
+    /*The driver doesn't free its data*/
+    void * drm_dev = lv_display_get_driver_data(drm_disp);
+    lv_display_delete(drm_disp);
+    lv_free(drm_dev);
+
+    lv_fake_drm_deinit();
+
+    lv_draw_buf_get_handlers()->align_pointer_cb = align_pointer_cb_ori;
+}
+
+/**
+ * Check if the committed buffer has the whole frame: a white screen with a red square.
+ */
+static void check_content(const lv_fake_drm_commit_t * commit, const lv_area_t * square)
+{
+    const uint32_t * px = lv_fake_drm_get_buf(commit->buf_idx);
+    for(int32_t y = 0; y < VER_RES; y++) {
+        for(int32_t x = 0; x < HOR_RES; x++) {
+            lv_point_t p = {x, y};
+            uint32_t expected = _lv_area_is_point_on(square, &p, 0) ? 0xff0000 : 0xffffff;
+            if((px[y * HOR_RES + x] & 0xffffff) != expected) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "Wrong pixel at %d;%d: 0x%06x", (int)x, (int)y,
+                            (unsigned int)(px[y * HOR_RES + x] & 0xffffff));
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+/**
+ * Check if the damage clips of a commit are on the screen and cover an area.
+ */
+static void check_damage_covers(const lv_fake_drm_commit_t * commit, const lv_area_t * area)
+{
+    TEST_ASSERT_GREATER_THAN(0, commit->damage_cnt);
+
+    lv_area_t screen = {0, 0, HOR_RES - 1, VER_RES - 1};
+    for(uint32_t i = 0; i < commit->damage_cnt; i++) {
+        TEST_ASSERT_TRUE(_lv_area_is_in(&commit->damage[i], &screen, 0));
+    }
+
+    for(int32_t y = area->y1; y <= area->y2; y++) {
+        for(int32_t x = area->x1; x <= area->x2; x++) {
+            lv_point_t p = {x, y};
+            bool covered = false;
+            for(uint32_t i = 0; i < commit->damage_cnt; i++) {
+                if(_lv_area_is_point_on(&commit->damage[i], &p, 0)) covered = true;
+            }
+            TEST_ASSERT_TRUE_MESSAGE(covered, "A changed pixel is not in the damage clips");
+        }
+    }
+}
+
+void test_linux_drm_rotate_buffers_and_report_damage(void)
+{
+    TEST_ASSERT_EQUAL(LV_LINUX_DRM_BUFFER_COUNT, lv_fake_drm_get_buf_cnt());
+    TEST_ASSERT_EQUAL(HOR_RES, lv_display_get_horizontal_resolution(drm_disp));
+    TEST_ASSERT_EQUAL(VER_RES, lv_display_get_vertical_resolution(drm_disp));
+
+    lv_obj_t * scr = lv_display_get_screen_active(drm_disp);
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    lv_obj_t * square = lv_obj_create(scr);
+    lv_obj_remove_style_all(square);
+    lv_obj_set_style_bg_color(square, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_bg_opa(square, LV_OPA_COVER, 0);
+    lv_obj_set_size(square, 8, 8);
+
+    lv_area_t prev_area;
+    for(uint32_t i = 0; i < 10; i++) {
+        lv_area_t area;
+        lv_area_set(&area, i * 5, i * 2, i * 5 + 7, i * 2 + 7);
+        lv_obj_set_pos(square, area.x1, area.y1);
+
+        lv_refr_now(drm_disp);
+        TEST_ASSERT_EQUAL(i + 1, lv_fake_drm_get_commit_cnt());
+        const lv_fake_drm_commit_t * commit = lv_fake_drm_get_commit(i);
+
+        /*Only one commit can be pending, and the buffer on the screen or waiting for the flip
+         *must not be rendered into*/
+        TEST_ASSERT_FALSE(commit->flip_was_pending);
+        TEST_ASSERT_FALSE(commit->prev_buf_modified);
+
+        /*Each frame has to be complete, including the areas changed in the earlier frames*/
+        check_content(commit, &area);
+
+        if(i == 0) {
+            lv_area_t screen = {0, 0, HOR_RES - 1, VER_RES - 1};
+            check_damage_covers(commit, &screen);
+        }
+        else {
+            check_damage_covers(commit, &area);
+            check_damage_covers(commit, &prev_area);
+
+            /*Only the changed areas are reported*/
+            uint32_t damaged_size = 0;
+            for(uint32_t d = 0; d < commit->damage_cnt; d++) {
+                damaged_size += lv_area_get_size(&commit->damage[d]);
+            }
+            TEST_ASSERT_LESS_THAN(HOR_RES * VER_RES / 2, damaged_size);
+
+            /*The buffers are used in turns*/
+            TEST_ASSERT_NOT_EQUAL(lv_fake_drm_get_commit(i - 1)->buf_idx, commit->buf_idx);
+#if LV_LINUX_DRM_BUFFER_COUNT == 3
+            if(i >= 2) {
+                TEST_ASSERT_NOT_EQUAL(lv_fake_drm_get_commit(i - 2)->buf_idx, commit->buf_idx);
+            }
+#endif
+        }
+
+        prev_area = area;
+    }
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_linux_drm_rotate_buffers_and_report_damage(void)
+{
+}
+
+#endif
+
+#endif
@@ -0,0 +1,163 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#include "fake_fbdev/lv_fake_fbdev.h"
+
+#if LV_USE_LINUX_FBDEV && !LV_LINUX_FBDEV_BSD && LV_LINUX_FBDEV_PAN_FLIP
+
+#define HOR_RES LV_FAKE_FBDEV_HOR_RES
+#define VER_RES LV_FAKE_FBDEV_VER_RES
+
+static lv_draw_buf_align_cb align_pointer_cb_ori;
+
+/*The pages are mapped to page boundaries which satisfies any real `LV_DRAW_BUF_ALIGN`,
+ *but not the unusual alignment used by the tests*/
+static void * align_page_aligned_cb(void * buf, lv_color_format_t cf)
+{
+    if(((lv_uintptr_t)buf & 0xfff) == 0) return buf;
+    return align_pointer_cb_ori(buf, cf);
+}
+
+void setUp(void)
+{
+    lv_draw_buf_handlers_t * handlers = lv_draw_buf_get_handlers();
+    align_pointer_cb_ori = handlers->align_pointer_cb;
+    handlers->align_pointer_cb = align_page_aligned_cb;
+}
+
+void tearDown(void)
+{
+    lv_fake_fbdev_deinit();
+
+    lv_draw_buf_get_handlers()->align_pointer_cb = align_pointer_cb_ori;
+}
+
+/**
+ * Create a display on a fake framebuffer with a white screen and a red square.
+ * The driver can't be deleted, so the display is kept until the end of the test.
+ */
+static lv_display_t * create_display(bool vsync_supported, lv_obj_t ** square)
+{
+    const char * path = lv_fake_fbdev_init(vsync_supported);
+    TEST_ASSERT_NOT_NULL(path);
+
+    lv_display_t * disp = lv_linux_fbdev_create();
+    lv_linux_fbdev_set_file(disp, path);
+
+    TEST_ASSERT_EQUAL(HOR_RES, lv_display_get_horizontal_resolution(disp));
+    TEST_ASSERT_EQUAL(VER_RES, lv_display_get_vertical_resolution(disp));
+
+    lv_obj_t * scr = lv_display_get_screen_active(disp);
+    lv_obj_remove_style_all(scr);
+    lv_obj_set_style_bg_color(scr, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(scr, LV_OPA_COVER, 0);
+
+    *square = lv_obj_create(scr);
+    lv_obj_remove_style_all(*square);
+    lv_obj_set_style_bg_color(*square, lv_color_hex(0xff0000), 0);
+    lv_obj_set_style_bg_opa(*square, LV_OPA_COVER, 0);
+    lv_obj_set_size(*square, 8, 8);
+
+    return disp;
+}
+
+/**
+ * Check if a page has the whole frame: a white screen with a red square.
+ */
+static void check_content(uint32_t page_idx, const lv_area_t * square)
+{
+    const uint32_t * px = lv_fake_fbdev_get_page(page_idx);
+    for(int32_t y = 0; y < VER_RES; y++) {
+        for(int32_t x = 0; x < HOR_RES; x++) {
+            lv_point_t p = {x, y};
+            uint32_t expected = _lv_area_is_point_on(square, &p, 0) ? 0xff0000 : 0xffffff;
+            if((px[y * HOR_RES + x] & 0xffffff) != expected) {
+                char msg[64];
+                lv_snprintf(msg, sizeof(msg), "Wrong pixel at %d;%d: 0x%06x", (int)x, (int)y,
+                            (unsigned int)(px[y * HOR_RES + x] & 0xffffff));
+                TEST_FAIL_MESSAGE(msg);
+            }
+        }
+    }
+}
+
+/**
+ * Move the square in some frames and check the pages which are panned to.
+ */
+static void check_frames(lv_display_t * disp, lv_obj_t * square, bool vsync_supported)
+{
+    /*The virtual screen was enlarged to 2 pages and the first page is shown*/
+    TEST_ASSERT_EQUAL(VER_RES * 2, lv_fake_fbdev_get_yres_virtual());
+    TEST_ASSERT_EQUAL(1, lv_fake_fbdev_get_pan_cnt());
+    TEST_ASSERT_EQUAL(0, lv_fake_fbdev_get_pan(0)->yoffset);
+
+    for(uint32_t i = 0; i < 10; i++) {
+        lv_area_t area;
+        lv_area_set(&area, i * 5, i * 2, i * 5 + 7, i * 2 + 7);
+        lv_obj_set_pos(square, area.x1, area.y1);
+
+        lv_refr_now(disp);
+        TEST_ASSERT_EQUAL(i + 2, lv_fake_fbdev_get_pan_cnt());
+        const lv_fake_fbdev_pan_t * pan = lv_fake_fbdev_get_pan(i + 1);
+
+        /*LVGL starts rendering into the second page and the pages are shown in turns*/
+        uint32_t page_idx = (i + 1) % 2;
+        TEST_ASSERT_EQUAL(0, pan->xoffset);
+        TEST_ASSERT_EQUAL(page_idx * VER_RES, pan->yoffset);
+
+        /*The shown page must not be rendered into*/
+        TEST_ASSERT_FALSE(pan->shown_page_modified);
+
+        /*The previous pan has to be completed before rendering into the other page*/
+        if(i > 0 && vsync_supported) TEST_ASSERT_TRUE(pan->vsync_waited);
+
+        /*Each frame has to be complete, including the areas changed in the earlier frames*/
+        check_content(page_idx, &area);
+    }
+}
+
+void test_linux_fbdev_pan_flip_pages(void)
+{
+    lv_obj_t * square;
+    lv_display_t * disp = create_display(true, &square);
+
+    check_frames(disp, square, true);
+
+    /*Waited once after the pan of each frame*/
+    TEST_ASSERT_EQUAL(10, lv_fake_fbdev_get_vsync_wait_cnt());
+}
+
+void test_linux_fbdev_pan_flip_pages_without_vsync(void)
+{
+    lv_obj_t * square;
+    lv_display_t * disp = create_display(false, &square);
+
+    check_frames(disp, square, false);
+
+    /*Not tried again after the first failure*/
+    TEST_ASSERT_EQUAL(1, lv_fake_fbdev_get_vsync_wait_cnt());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_linux_fbdev_pan_flip_pages(void)
+{
+}
+
+void test_linux_fbdev_pan_flip_pages_without_vsync(void)
+{
+}
+
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #include "../lvgl.h"
 
 #include "unity/unity.h"
+#include "lv_test_helpers.h"
 
 void setUp(void)
 {
@@ -23,4 +24,68 @@ void test_mem_buf_realloc(void)
 #endif
 }
 
+void test_mem_slab(void)
+{
+#if defined(LVGL_CI_USING_DEF_HEAP) && LV_MEM_USE_SLAB
+    lv_mem_monitor_t mon_start;
+    lv_mem_monitor(&mon_start);
+
+    /*Allocate enough small objects to fill more than one slab per size class*/
+    static uint8_t * bufs[1024];
+    uint32_t i;
+    for(i = 0; i < 1024; i++) {
+        size_t size = (i % LV_MEM_SLAB_MAX_SIZE) + 1;
+        bufs[i] = lv_malloc(size);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        lv_memset(bufs[i], (uint8_t)i, size);
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_EQUAL_UINT32(mon_start.slab_alloc_cnt + 1024, mon.slab_alloc_cnt);
+    TEST_ASSERT_GREATER_THAN(mon_start.slab_size, mon.slab_size);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+
+    /*Move the objects between size classes and to the heap keeping their content*/
+    for(i = 0; i < 1024; i++) {
+        size_t size = (i % LV_MEM_SLAB_MAX_SIZE) + 1;
+        size_t new_size = i % 2 ? size + 8 : size + LV_MEM_SLAB_MAX_SIZE;
+        bufs[i] = lv_realloc(bufs[i], new_size);
+        TEST_ASSERT_NOT_NULL(bufs[i]);
+        TEST_ASSERT_EACH_EQUAL_UINT8((uint8_t)i, bufs[i], size);
+    }
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+
+    for(i = 0; i < 1024; i++) {
+        lv_free(bufs[i]);
+    }
+
+    /*Only one empty slab per size class is kept*/
+    lv_mem_monitor(&mon);
+    TEST_ASSERT_LESS_OR_EQUAL(mon_start.slab_size + LV_MEM_SLAB_CLASS_CNT * LV_MEM_SLAB_SIZE, mon.slab_size);
+    TEST_ASSERT_EQUAL(LV_RESULT_OK, lv_mem_test());
+#endif
+}
+
+void test_mem_slab_leak_check(void)
+{
+#if defined(LVGL_CI_USING_DEF_HEAP) && LV_MEM_USE_SLAB
+    /*Have a partly used slab*/
+    void * used = lv_malloc(16);
+    size_t free_start = lv_test_get_free_mem();
+
+    /*A leaked object in it is visible*/
+    void * leaked = lv_malloc(16);
+    TEST_ASSERT_LESS_THAN(free_start, lv_test_get_free_mem());
+
+    /*The reserve slab is not a leak*/
+    lv_free(leaked);
+    void * large = lv_malloc(LV_MEM_SLAB_MAX_SIZE);
+    lv_free(large);
+    TEST_ASSERT_EQUAL(free_start, lv_test_get_free_mem());
+
+    lv_free(used);
+#endif
+}
+
 #endif
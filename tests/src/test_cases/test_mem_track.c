@@ -0,0 +1,144 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_MEM_TRACK
+
+typedef struct {
+    const char * file;
+    uint32_t line;
+    const char * tag;
+    lv_mem_track_site_t site;
+    lv_mem_track_tag_t tag_stat;
+    bool found;
+} find_dsc_t;
+
+static void find_site_cb(const lv_mem_track_site_t * site, void * user_data)
+{
+    find_dsc_t * dsc = user_data;
+    if(site->file && lv_strcmp(site->file, dsc->file) == 0 && site->line == dsc->line) {
+        dsc->site = *site;
+        dsc->found = true;
+    }
+}
+
+static void find_tag_cb(const lv_mem_track_tag_t * tag, void * user_data)
+{
+    find_dsc_t * dsc = user_data;
+    if(tag->name == dsc->tag) {
+        dsc->tag_stat = *tag;
+        dsc->found = true;
+    }
+}
+
+static find_dsc_t find_site(uint32_t line)
+{
+    find_dsc_t dsc;
+    lv_memzero(&dsc, sizeof(dsc));
+    dsc.file = __FILE__;
+    dsc.line = line;
+    lv_mem_track_for_each_site(find_site_cb, &dsc);
+    return dsc;
+}
+
+static find_dsc_t find_tag(const char * tag)
+{
+    find_dsc_t dsc;
+    lv_memzero(&dsc, sizeof(dsc));
+    dsc.tag = tag;
+    lv_mem_track_for_each_tag(find_tag_cb, &dsc);
+    return dsc;
+}
+
+#endif
+
+void setUp(void)
+{
+    /* Function run before every test */
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    lv_obj_clean(lv_screen_active());
+}
+
+void test_mem_track_call_site(void)
+{
+#if LV_USE_MEM_TRACK
+    uint32_t mark = lv_mem_track_mark();
+
+    uint32_t line_malloc = __LINE__ + 1;
+    uint8_t * p = lv_malloc(100);
+    TEST_ASSERT_EQUAL(100, lv_mem_track_get_live_size(mark));
+
+    find_dsc_t dsc = find_site(line_malloc);
+    TEST_ASSERT_TRUE(dsc.found);
+    TEST_ASSERT_EQUAL(1, dsc.site.live_cnt);
+    TEST_ASSERT_EQUAL(100, dsc.site.live_size);
+
+    /*Reallocating moves the memory to the new call site*/
+    uint32_t line_realloc = __LINE__ + 1;
+    p = lv_realloc(p, 300);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL(300, lv_mem_track_get_live_size(mark));
+
+    dsc = find_site(line_malloc);
+    TEST_ASSERT_EQUAL(0, dsc.site.live_cnt);
+    TEST_ASSERT_EQUAL(0, dsc.site.live_size);
+    TEST_ASSERT_EQUAL(100, dsc.site.peak_size);
+    TEST_ASSERT_EQUAL(1, dsc.site.free_cnt);
+
+    dsc = find_site(line_realloc);
+    TEST_ASSERT_TRUE(dsc.found);
+    TEST_ASSERT_EQUAL(1, dsc.site.live_cnt);
+    TEST_ASSERT_EQUAL(300, dsc.site.live_size);
+
+    lv_free(p);
+    TEST_ASSERT_EQUAL(0, lv_mem_track_get_live_size(mark));
+
+    dsc = find_site(line_realloc);
+    TEST_ASSERT_EQUAL(0, dsc.site.live_cnt);
+    TEST_ASSERT_EQUAL(1, dsc.site.free_cnt);
+#endif
+}
+
+void test_mem_track_function_pointer(void)
+{
+#if LV_USE_MEM_TRACK
+    /*Calls without the macros are tracked too, only the call site is unknown*/
+    void * (*malloc_cb)(size_t) = lv_malloc;
+    void (*free_cb)(void *) = lv_free;
+
+    uint32_t mark = lv_mem_track_mark();
+    void * p = malloc_cb(64);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_EQUAL(64, lv_mem_track_get_live_size(mark));
+    free_cb(p);
+    TEST_ASSERT_EQUAL(0, lv_mem_track_get_live_size(mark));
+#endif
+}
+
+void test_mem_track_widget_class(void)
+{
+#if LV_USE_MEM_TRACK
+    size_t live_start = find_tag(lv_button_class.name).tag_stat.live_size;
+
+    uint32_t mark = lv_mem_track_mark();
+    lv_obj_t * btn = lv_button_create(lv_screen_active());
+    TEST_ASSERT_NOT_EQUAL(0, lv_mem_track_get_live_size(mark));
+
+    find_dsc_t dsc = find_tag(lv_button_class.name);
+    TEST_ASSERT_TRUE(dsc.found);
+    TEST_ASSERT_GREATER_OR_EQUAL(live_start + sizeof(lv_button_t), dsc.tag_stat.live_size);
+
+    lv_mem_track_dump(mark);
+
+    lv_obj_delete(btn);
+    dsc = find_tag(lv_button_class.name);
+    TEST_ASSERT_EQUAL(live_start, dsc.tag_stat.live_size);
+#endif
+}
+
+#endif
@@ -504,4 +504,124 @@ void test_observer_dropdown_value(void)
     TEST_ASSERT_EQUAL(0, lv_subject_get_int(&subject));
 }
 
+static uint32_t notify_cnt;
+
+static void observer_int_count(lv_observer_t * observer, lv_subject_t * subject)
+{
+    observer_int(observer, subject);
+    notify_cnt++;
+}
+
+void test_observer_deferred(void)
+{
+    static lv_subject_t subject;
+    lv_subject_init_int(&subject, 5);
+    lv_subject_set_deferred(&subject, true);
+
+    lv_obj_t * label = lv_label_create(lv_screen_active());
+    lv_label_bind_text(label, &subject, "%d");
+    lv_subject_add_observer(&subject, observer_int_count, NULL);
+    notify_cnt = 0;
+
+    /*Only the value changes, the observers are notified once before refreshing*/
+    int32_t i;
+    for(i = 10; i <= 100; i++) {
+        lv_subject_set_int(&subject, i);
+    }
+    TEST_ASSERT_EQUAL(100, lv_subject_get_int(&subject));
+    TEST_ASSERT_EQUAL(0, notify_cnt);
+    TEST_ASSERT_EQUAL_STRING("5", lv_label_get_text(label));
+
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL(1, notify_cnt);
+    TEST_ASSERT_EQUAL(100, current_v);
+    TEST_ASSERT_EQUAL(5, prev_v);
+    TEST_ASSERT_EQUAL_STRING("100", lv_label_get_text(label));
+
+    /*The refresh timer is resumed even if nothing else has changed*/
+    lv_subject_set_int(&subject, 110);
+    lv_test_indev_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL(2, notify_cnt);
+    TEST_ASSERT_EQUAL(110, current_v);
+    TEST_ASSERT_EQUAL(100, prev_v);
+
+    /*The pending notification is sent when disabling*/
+    lv_subject_set_int(&subject, 120);
+    lv_subject_set_deferred(&subject, false);
+    TEST_ASSERT_EQUAL(3, notify_cnt);
+    TEST_ASSERT_EQUAL(120, current_v);
+
+    lv_subject_set_int(&subject, 130);
+    TEST_ASSERT_EQUAL(4, notify_cnt);
+    TEST_ASSERT_EQUAL(130, current_v);
+    TEST_ASSERT_EQUAL(120, prev_v);
+}
+
+void test_observer_post(void)
+{
+    static lv_subject_t subject;
+    lv_subject_init_int(&subject, 5);
+    lv_subject_add_observer(&subject, observer_int_count, NULL);
+    notify_cnt = 0;
+
+    /*Posting is possible only with deferred notifications*/
+    lv_subject_post_int(&subject, 10);
+    lv_test_indev_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL(5, lv_subject_get_int(&subject));
+    TEST_ASSERT_EQUAL(0, notify_cnt);
+
+    /*No timer is needed to check the posted values*/
+    uint32_t timer_cnt = 0;
+    lv_timer_t * timer;
+    for(timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer)) timer_cnt++;
+    lv_subject_set_deferred(&subject, true);
+    for(timer = lv_timer_get_next(NULL); timer; timer = lv_timer_get_next(timer)) timer_cnt--;
+    TEST_ASSERT_EQUAL(0, timer_cnt);
+
+    lv_subject_post_int(&subject, 10);
+    lv_subject_post_int(&subject, 20);
+    lv_subject_post_pointer(&subject, NULL);    /*Ignore incorrect types*/
+    TEST_ASSERT_EQUAL(5, lv_subject_get_int(&subject));
+
+    /*Posting wakes up the timer handler which takes the value right away*/
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_until_next());
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(20, lv_subject_get_int(&subject));
+
+    lv_test_indev_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL(1, notify_cnt);
+    TEST_ASSERT_EQUAL(20, current_v);
+    TEST_ASSERT_EQUAL(5, prev_v);
+
+    /*Nothing new was posted*/
+    lv_test_indev_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL(1, notify_cnt);
+
+    lv_subject_set_deferred(&subject, false);
+}
+
+/*Initializing a deferred subject again stops deferring it*/
+void test_observer_deferred_reinit(void)
+{
+    static lv_subject_t subject;
+    lv_subject_init_int(&subject, 5);
+    size_t mem_before = lv_test_get_free_mem();
+
+    lv_subject_set_deferred(&subject, true);
+    lv_subject_set_int(&subject, 10);
+    lv_subject_init_int(&subject, 20);
+    TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+
+    lv_subject_add_observer(&subject, observer_int_count, NULL);
+    notify_cnt = 0;
+    lv_subject_set_int(&subject, 30);
+    TEST_ASSERT_EQUAL(1, notify_cnt);
+    TEST_ASSERT_EQUAL(30, current_v);
+
+    /*Posting is ignored again*/
+    lv_subject_post_int(&subject, 40);
+    lv_test_indev_wait(LV_DEF_REFR_PERIOD * 2);
+    TEST_ASSERT_EQUAL(30, lv_subject_get_int(&subject));
+}
+
 #endif
@@ -140,4 +140,103 @@ void test_style_has_prop(void)
     lv_style_reset(&style);
 }
 
+void test_style_many_props(void)
+{
+    /*Set the properties in a mixed order to test keeping them sorted*/
+    lv_style_t style;
+    lv_style_init(&style);
+
+    uint32_t i;
+    for(i = 0; i < 40; i++) {
+        lv_style_prop_t prop = (lv_style_prop_t)(1 + (i * 37) % 120);
+        lv_style_value_t v = { .num = prop * 10 };
+        lv_style_set_prop(&style, prop, v);
+    }
+    TEST_ASSERT_EQUAL(40, style.prop_cnt);
+
+    /*Overwrite a few values. The number of properties shouldn't change*/
+    lv_style_value_t v = { .num = -1 };
+    lv_style_set_prop(&style, 1, v);
+    lv_style_set_prop(&style, 38, v);
+    TEST_ASSERT_EQUAL(40, style.prop_cnt);
+
+    TEST_ASSERT_TRUE(lv_style_remove_prop(&style, 75));
+    TEST_ASSERT_FALSE(lv_style_remove_prop(&style, 75));
+
+    lv_style_prop_t prop;
+    for(prop = 1; prop <= 120; prop++) {
+        bool set = false;
+        for(i = 0; i < 40; i++) {
+            if(prop == 1 + (i * 37) % 120) set = true;
+        }
+        if(prop == 75) set = false;
+
+        lv_style_res_t res = lv_style_get_prop(&style, prop, &v);
+        TEST_ASSERT_EQUAL(set ? LV_STYLE_RES_FOUND : LV_STYLE_RES_NOT_FOUND, res);
+        if(set) TEST_ASSERT_EQUAL((prop == 1 || prop == 38) ? -1 : prop * 10, v.num);
+    }
+
+    lv_style_reset(&style);
+}
+
+void test_style_get_prop_after_changes(void)
+{
+    /*The resolved values might be cached, so be sure they are updated on every kind of change*/
+    lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_bg_color(&style, lv_color_hex(0xff0000));
+
+    lv_style_t style_pr;
+    lv_style_init(&style_pr);
+    lv_style_set_bg_color(&style_pr, lv_color_hex(0x00ff00));
+
+    lv_obj_t * parent1 = lv_obj_create(lv_screen_active());
+    lv_obj_t * parent2 = lv_obj_create(lv_screen_active());
+    lv_obj_t * obj = lv_obj_create(parent1);
+    lv_obj_remove_style_all(obj);
+    lv_obj_t * child = lv_obj_create(obj);
+    lv_obj_remove_style_all(child);
+
+    /*Adding a style*/
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xffffff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_add_style(obj, &style, LV_PART_MAIN);
+    lv_obj_add_style(obj, &style_pr, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xff0000), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Modifying and reporting a style*/
+    lv_style_set_bg_color(&style, lv_color_hex(0x0000ff));
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Changing the state*/
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x00ff00), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_remove_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Local styles*/
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0x123456), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x123456), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_remove_local_style_prop(obj, LV_STYLE_BG_COLOR, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x0000ff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Removing the style*/
+    lv_obj_remove_style(obj, &style, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0xffffff), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+
+    /*Inherited properties of the parents*/
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x111111), LV_PART_MAIN);
+    lv_obj_set_style_text_color(parent2, lv_color_hex(0x222222), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x111111), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+    lv_obj_set_style_text_color(parent1, lv_color_hex(0x333333), LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x333333), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    lv_obj_set_parent(obj, parent2);
+    TEST_ASSERT_EQUAL_COLOR(lv_color_hex(0x222222), lv_obj_get_style_text_color(child, LV_PART_MAIN));
+
+    lv_obj_clean(lv_screen_active());
+    lv_style_reset(&style);
+    lv_style_reset(&style_pr);
+}
+
 #endif
@@ -0,0 +1,261 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define TIMER_CNT   1000
+
+static lv_timer_t * timers[TIMER_CNT];
+static uint32_t run_cnt[TIMER_CNT];
+
+void setUp(void)
+{
+    /* Function run before every test */
+    lv_memzero(timers, sizeof(timers));
+    lv_memzero(run_cnt, sizeof(run_cnt));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+    uint32_t i;
+    for(i = 0; i < TIMER_CNT; i++) {
+        if(timers[i]) lv_timer_delete(timers[i]);
+    }
+}
+
+static void wait(uint32_t ms)
+{
+    uint32_t i;
+    for(i = 0; i < ms; i++) {
+        lv_tick_inc(1);
+        lv_timer_handler();
+    }
+}
+
+static void count_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = lv_timer_get_user_data(timer);
+    (*cnt)++;
+}
+
+static void delete_other_cb(lv_timer_t * timer)
+{
+    uint32_t * cnt = lv_timer_get_user_data(timer);
+    (*cnt)++;
+
+    /*Delete the other timer which is also ready*/
+    uint32_t other = timer == timers[0] ? 1 : 0;
+    lv_timer_delete(timers[other]);
+    timers[other] = NULL;
+}
+
+static void create_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    timers[1] = lv_timer_create(count_cb, 0, &run_cnt[1]);
+    lv_timer_set_repeat_count(timers[1], 1);
+}
+
+static void resume_handler_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    /*As if an other thread requested to run the handler while it's running*/
+    _lv_timer_handler_resume();
+}
+
+static uint32_t exec_order[TIMER_CNT];
+static uint32_t exec_cnt;
+
+static void order_cb(lv_timer_t * timer)
+{
+    uint32_t * id = lv_timer_get_user_data(timer);
+    exec_order[exec_cnt] = *id;
+    exec_cnt++;
+}
+
+void test_timer_period(void)
+{
+    timers[0] = lv_timer_create(count_cb, 10, &run_cnt[0]);
+    timers[1] = lv_timer_create(count_cb, 25, &run_cnt[1]);
+
+    wait(100);
+    TEST_ASSERT_EQUAL(10, run_cnt[0]);
+    TEST_ASSERT_EQUAL(4, run_cnt[1]);
+
+    /*Not ready yet, but made ready*/
+    wait(5);
+    lv_timer_ready(timers[1]);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(5, run_cnt[1]);
+
+    lv_timer_set_period(timers[0], 2);
+    wait(10);
+    TEST_ASSERT_EQUAL(15, run_cnt[0]);
+}
+
+void test_timer_pause_resume(void)
+{
+    timers[0] = lv_timer_create(count_cb, 10, &run_cnt[0]);
+
+    wait(30);
+    lv_timer_pause(timers[0]);
+    wait(30);
+    TEST_ASSERT_EQUAL(3, run_cnt[0]);
+
+    /*Resumed with the elapsed time it was paused for*/
+    lv_timer_resume(timers[0]);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(4, run_cnt[0]);
+
+    lv_timer_reset(timers[0]);
+    wait(9);
+    TEST_ASSERT_EQUAL(4, run_cnt[0]);
+    wait(1);
+    TEST_ASSERT_EQUAL(5, run_cnt[0]);
+}
+
+void test_timer_repeat_count(void)
+{
+    timers[0] = lv_timer_create(count_cb, 10, &run_cnt[0]);
+    lv_timer_set_repeat_count(timers[0], 3);
+    lv_timer_set_auto_delete(timers[0], false);
+
+    timers[1] = lv_timer_create(count_cb, 10, &run_cnt[1]);
+    lv_timer_set_repeat_count(timers[1], 2);
+
+    wait(100);
+    TEST_ASSERT_EQUAL(3, run_cnt[0]);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(timers[0]));
+    TEST_ASSERT_EQUAL(2, run_cnt[1]);
+
+    /*The second timer was deleted*/
+    lv_timer_t * t = lv_timer_get_next(NULL);
+    while(t) {
+        TEST_ASSERT_NOT_EQUAL(timers[1], t);
+        t = lv_timer_get_next(t);
+    }
+    timers[1] = NULL;
+
+    /*Stopped without running once more*/
+    lv_timer_set_repeat_count(timers[0], 2);
+    lv_timer_resume(timers[0]);
+    wait(10);
+    TEST_ASSERT_EQUAL(4, run_cnt[0]);
+    lv_timer_set_repeat_count(timers[0], 0);
+    wait(100);
+    TEST_ASSERT_EQUAL(4, run_cnt[0]);
+    TEST_ASSERT_TRUE(lv_timer_get_paused(timers[0]));
+}
+
+void test_timer_delete_in_callback(void)
+{
+    timers[0] = lv_timer_create(delete_other_cb, 10, &run_cnt[0]);
+    timers[1] = lv_timer_create(delete_other_cb, 10, &run_cnt[1]);
+
+    /*Both are ready in the same call but only the first one can run*/
+    wait(10);
+    TEST_ASSERT_EQUAL(1, run_cnt[0] + run_cnt[1]);
+}
+
+void test_timer_create_in_callback(void)
+{
+    timers[0] = lv_timer_create(create_cb, 10, NULL);
+    lv_timer_set_repeat_count(timers[0], 1);
+
+    /*The new timer is ready immediately so it runs in the same call*/
+    wait(10);
+    TEST_ASSERT_EQUAL(1, run_cnt[1]);
+    timers[0] = NULL;
+    timers[1] = NULL;
+}
+
+void test_timer_same_tick_order(void)
+{
+    static const uint32_t periods[] = {20, 5, 10, 4, 20, 2, 1, 10, 5, 20, 4, 2};
+    const uint32_t cnt = sizeof(periods) / sizeof(periods[0]);
+    static uint32_t ids[sizeof(periods) / sizeof(periods[0])];
+
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        ids[i] = i;
+        timers[i] = lv_timer_create(order_cb, periods[i], &ids[i]);
+    }
+
+    /*Change some timers without changing when they are ready*/
+    lv_timer_pause(timers[3]);
+    lv_timer_resume(timers[3]);
+    lv_timer_set_period(timers[8], 5);
+
+    /*All of them are ready in the same tick: they run from the newest to the oldest,
+     *e.g. an input device created after its display is read before the display is refreshed*/
+    lv_tick_inc(20);
+    exec_cnt = 0;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(cnt, exec_cnt);
+    for(i = 0; i < cnt; i++) {
+        TEST_ASSERT_EQUAL_UINT32(cnt - 1 - i, exec_order[i]);
+    }
+
+    /*The same order every time*/
+    lv_tick_inc(20);
+    exec_cnt = 0;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(cnt, exec_cnt);
+    for(i = 0; i < cnt; i++) {
+        TEST_ASSERT_EQUAL_UINT32(cnt - 1 - i, exec_order[i]);
+    }
+}
+
+void test_timer_many(void)
+{
+    uint32_t i;
+    for(i = 0; i < TIMER_CNT; i++) {
+        timers[i] = lv_timer_create(count_cb, i % 97 + 1, &run_cnt[i]);
+    }
+
+    wait(500);
+    for(i = 0; i < TIMER_CNT; i++) {
+        TEST_ASSERT_EQUAL(500 / (i % 97 + 1), run_cnt[i]);
+    }
+
+    /*Delete every second and pause every third timer*/
+    for(i = 0; i < TIMER_CNT; i++) {
+        run_cnt[i] = 0;
+        if(i % 2 == 0) {
+            lv_timer_delete(timers[i]);
+            timers[i] = NULL;
+        }
+        else if(i % 3 == 0) {
+            lv_timer_pause(timers[i]);
+        }
+        else {
+            lv_timer_reset(timers[i]);
+        }
+    }
+
+    wait(500);
+    for(i = 0; i < TIMER_CNT; i++) {
+        if(i % 2 == 0 || i % 3 == 0) TEST_ASSERT_EQUAL(0, run_cnt[i]);
+        else TEST_ASSERT_EQUAL(500 / (i % 97 + 1), run_cnt[i]);
+    }
+}
+
+void test_timer_resume_while_running(void)
+{
+    timers[0] = lv_timer_create(resume_handler_cb, 100, NULL);
+
+    /*Run it once*/
+    wait(100);
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_until_next());
+
+    /*The resume is consumed by the next call*/
+    TEST_ASSERT_NOT_EQUAL(0, lv_timer_handler());
+    TEST_ASSERT_NOT_EQUAL(0, lv_timer_get_time_until_next());
+
+    _lv_timer_handler_resume();
+    TEST_ASSERT_EQUAL(0, lv_timer_get_time_until_next());
+    TEST_ASSERT_NOT_EQUAL(0, lv_timer_handler());
+}
+
+#endif
@@ -0,0 +1,502 @@
+/**
+* @file lv_fake_drm.c
+*
+*/
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fake_drm.h"
+
+#if LV_USE_LINUX_DRM
+
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <xf86drm.h>
+#include <xf86drmMode.h>
+#include <drm_fourcc.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define BUF_SIZE        (LV_FAKE_DRM_HOR_RES * LV_FAKE_DRM_VER_RES * 4)
+#define MAX_BUF_CNT     4
+#define MAX_COMMITS     32
+
+#define CONN_ID         10
+#define ENC_ID          20
+#define CRTC_ID         30
+#define PLANE_ID        40
+#define FB_ID_FIRST     51
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    PROP_PLANE_FB_ID = 101,
+    PROP_PLANE_CRTC_ID,
+    PROP_PLANE_SRC_X,
+    PROP_PLANE_SRC_Y,
+    PROP_PLANE_SRC_W,
+    PROP_PLANE_SRC_H,
+    PROP_PLANE_CRTC_X,
+    PROP_PLANE_CRTC_Y,
+    PROP_PLANE_CRTC_W,
+    PROP_PLANE_CRTC_H,
+    PROP_PLANE_FB_DAMAGE_CLIPS,
+    PROP_CRTC_MODE_ID = 201,
+    PROP_CRTC_ACTIVE,
+    PROP_CONN_CRTC_ID = 301,
+} prop_id_t;
+
+struct _drmModeAtomicReq {
+    bool used;
+    uint32_t cnt;
+    struct {
+        uint32_t obj_id;
+        uint32_t prop_id;
+        uint64_t value;
+    } props[32];
+};
+
+typedef struct {
+    uint32_t id;
+    size_t size;
+    uint8_t data[1024];
+} blob_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static blob_t * blob_find(uint32_t id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/*Static objects are returned to the driver so nothing leaks if it doesn't free them*/
+static drmModeModeInfo fake_mode;
+static uint32_t fake_conn_ids[] = {CONN_ID};
+static uint32_t fake_enc_ids[] = {ENC_ID};
+static uint32_t fake_crtc_ids[] = {CRTC_ID};
+static uint32_t fake_plane_ids[] = {PLANE_ID};
+static uint32_t fake_formats[] = {DRM_FORMAT_XRGB8888};
+static drmModeRes fake_res;
+static drmModeConnector fake_conn;
+static drmModeEncoder fake_enc;
+static drmModeCrtc fake_crtc;
+static drmModePlaneRes fake_plane_res;
+static drmModePlane fake_plane;
+
+static uint32_t fake_plane_prop_ids[] = {
+    PROP_PLANE_FB_ID, PROP_PLANE_CRTC_ID, PROP_PLANE_SRC_X, PROP_PLANE_SRC_Y, PROP_PLANE_SRC_W, PROP_PLANE_SRC_H,
+    PROP_PLANE_CRTC_X, PROP_PLANE_CRTC_Y, PROP_PLANE_CRTC_W, PROP_PLANE_CRTC_H, PROP_PLANE_FB_DAMAGE_CLIPS
+};
+static uint32_t fake_crtc_prop_ids[] = {PROP_CRTC_MODE_ID, PROP_CRTC_ACTIVE};
+static uint32_t fake_conn_prop_ids[] = {PROP_CONN_CRTC_ID};
+static drmModeObjectProperties fake_obj_props;
+static drmModePropertyRes fake_props[16];
+
+static struct _drmModeAtomicReq fake_reqs[4];
+static blob_t fake_blobs[8];
+static uint32_t fake_blob_id_next = 1000;
+
+static char dev_path[64];
+static uint8_t * dev_map;
+static uint32_t dumb_cnt;
+
+static bool flip_pending;
+static void * flip_user_data;
+
+static lv_fake_drm_commit_t commits[MAX_COMMITS];
+static uint32_t commit_cnt;
+
+/*The content of the last committed buffer when it was committed*/
+static uint8_t prev_committed_content[BUF_SIZE];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const char * lv_fake_drm_init(void)
+{
+    lv_snprintf(dev_path, sizeof(dev_path), "/tmp/lv_fake_drm_XXXXXX");
+    int fd = mkstemp(dev_path);
+    if(fd < 0) return NULL;
+
+    if(ftruncate(fd, MAX_BUF_CNT * BUF_SIZE) != 0) {
+        close(fd);
+        unlink(dev_path);
+        return NULL;
+    }
+
+    dev_map = mmap(NULL, MAX_BUF_CNT * BUF_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(dev_map == MAP_FAILED) {
+        dev_map = NULL;
+        unlink(dev_path);
+        return NULL;
+    }
+
+    dumb_cnt = 0;
+    flip_pending = false;
+    commit_cnt = 0;
+
+    return dev_path;
+}
+
+void lv_fake_drm_deinit(void)
+{
+    if(dev_map == NULL) return;
+
+    munmap(dev_map, MAX_BUF_CNT * BUF_SIZE);
+    dev_map = NULL;
+    unlink(dev_path);
+}
+
+uint32_t lv_fake_drm_get_buf_cnt(void)
+{
+    return dumb_cnt;
+}
+
+const uint32_t * lv_fake_drm_get_buf(uint32_t buf_idx)
+{
+    return (const uint32_t *)(dev_map + buf_idx * BUF_SIZE);
+}
+
+uint32_t lv_fake_drm_get_commit_cnt(void)
+{
+    return commit_cnt;
+}
+
+const lv_fake_drm_commit_t * lv_fake_drm_get_commit(uint32_t idx)
+{
+    return &commits[idx];
+}
+
+/*The libdrm functions used by the driver*/
+
+int drmGetCap(int fd, uint64_t capability, uint64_t * value)
+{
+    LV_UNUSED(fd);
+    *value = capability == DRM_CAP_DUMB_BUFFER ? 1 : 0;
+    return 0;
+}
+
+int drmSetClientCap(int fd, uint64_t capability, uint64_t value)
+{
+    LV_UNUSED(fd);
+    LV_UNUSED(capability);
+    LV_UNUSED(value);
+    return 0;
+}
+
+int drmIoctl(int fd, unsigned long request, void * arg)
+{
+    LV_UNUSED(fd);
+    if(request == DRM_IOCTL_MODE_CREATE_DUMB) {
+        struct drm_mode_create_dumb * creq = arg;
+        if(dumb_cnt >= MAX_BUF_CNT) return -1;
+        creq->handle = ++dumb_cnt;
+        creq->pitch = creq->width * creq->bpp / 8;
+        creq->size = (uint64_t)creq->pitch * creq->height;
+        return 0;
+    }
+    else if(request == DRM_IOCTL_MODE_MAP_DUMB) {
+        struct drm_mode_map_dumb * mreq = arg;
+        mreq->offset = (uint64_t)(mreq->handle - 1) * BUF_SIZE;
+        return 0;
+    }
+
+    return -1;
+}
+
+int drmHandleEvent(int fd, drmEventContextPtr evctx)
+{
+    if(flip_pending) {
+        flip_pending = false;
+        evctx->page_flip_handler(fd, 0, 0, 0, flip_user_data);
+    }
+    return 0;
+}
+
+int drmModeAddFB2(int fd, uint32_t width, uint32_t height, uint32_t pixel_format, const uint32_t bo_handles[4],
+                  const uint32_t pitches[4], const uint32_t offsets[4], uint32_t * buf_id, uint32_t flags)
+{
+    LV_UNUSED(fd);
+    LV_UNUSED(width);
+    LV_UNUSED(height);
+    LV_UNUSED(pixel_format);
+    LV_UNUSED(pitches);
+    LV_UNUSED(offsets);
+    LV_UNUSED(flags);
+    *buf_id = FB_ID_FIRST + bo_handles[0] - 1;
+    return 0;
+}
+
+drmModeAtomicReqPtr drmModeAtomicAlloc(void)
+{
+    for(uint32_t i = 0; i < sizeof(fake_reqs) / sizeof(fake_reqs[0]); i++) {
+        if(!fake_reqs[i].used) {
+            lv_memzero(&fake_reqs[i], sizeof(fake_reqs[i]));
+            fake_reqs[i].used = true;
+            return &fake_reqs[i];
+        }
+    }
+    return NULL;
+}
+
+void drmModeAtomicFree(drmModeAtomicReqPtr req)
+{
+    if(req) req->used = false;
+}
+
+int drmModeAtomicAddProperty(drmModeAtomicReqPtr req, uint32_t object_id, uint32_t property_id, uint64_t value)
+{
+    if(req->cnt >= sizeof(req->props) / sizeof(req->props[0])) return -1;
+    req->props[req->cnt].obj_id = object_id;
+    req->props[req->cnt].prop_id = property_id;
+    req->props[req->cnt].value = value;
+    req->cnt++;
+    return (int)req->cnt;
+}
+
+int drmModeCreatePropertyBlob(int fd, const void * data, size_t size, uint32_t * id)
+{
+    LV_UNUSED(fd);
+    blob_t * blob = blob_find(0);
+    if(blob == NULL || size > sizeof(blob->data)) return -1;
+    blob->id = fake_blob_id_next++;
+    blob->size = size;
+    lv_memcpy(blob->data, data, size);
+    *id = blob->id;
+    return 0;
+}
+
+int drmModeDestroyPropertyBlob(int fd, uint32_t id)
+{
+    LV_UNUSED(fd);
+    blob_t * blob = blob_find(id);
+    if(blob == NULL) return -1;
+    blob->id = 0;
+    return 0;
+}
+
+int drmModeAtomicCommit(int fd, drmModeAtomicReqPtr req, uint32_t flags, void * user_data)
+{
+    LV_UNUSED(fd);
+    LV_UNUSED(flags);
+    if(commit_cnt >= MAX_COMMITS) return -1;
+
+    lv_fake_drm_commit_t * commit = &commits[commit_cnt];
+    lv_memzero(commit, sizeof(lv_fake_drm_commit_t));
+    commit->flip_was_pending = flip_pending;
+
+    uint32_t fb_id = 0;
+    for(uint32_t i = 0; i < req->cnt; i++) {
+        if(req->props[i].obj_id != PLANE_ID) continue;
+        if(req->props[i].prop_id == PROP_PLANE_FB_ID) {
+            fb_id = (uint32_t)req->props[i].value;
+        }
+        else if(req->props[i].prop_id == PROP_PLANE_FB_DAMAGE_CLIPS) {
+            blob_t * blob = blob_find((uint32_t)req->props[i].value);
+            if(blob == NULL) return -1;
+            const struct drm_mode_rect * rects = (const struct drm_mode_rect *)blob->data;
+            commit->damage_cnt = blob->size / sizeof(struct drm_mode_rect);
+            for(uint32_t r = 0; r < commit->damage_cnt; r++) {
+                /*The rectangles of DRM are exclusive on the bottom right side*/
+                lv_area_set(&commit->damage[r], rects[r].x1, rects[r].y1, rects[r].x2 - 1, rects[r].y2 - 1);
+            }
+        }
+    }
+
+    if(fb_id < FB_ID_FIRST || fb_id >= FB_ID_FIRST + dumb_cnt) return -1;
+    commit->buf_idx = fb_id - FB_ID_FIRST;
+
+    /*Check if the buffer committed before this one was rendered into*/
+    if(commit_cnt > 0) {
+        commit->prev_buf_modified = lv_memcmp(prev_committed_content, dev_map + commits[commit_cnt - 1].buf_idx * BUF_SIZE,
+                                              BUF_SIZE) != 0;
+    }
+    lv_memcpy(prev_committed_content, dev_map + commit->buf_idx * BUF_SIZE, BUF_SIZE);
+
+    commit_cnt++;
+    flip_pending = true;
+    flip_user_data = user_data;
+    return 0;
+}
+
+drmModeResPtr drmModeGetResources(int fd)
+{
+    LV_UNUSED(fd);
+    lv_memzero(&fake_res, sizeof(fake_res));
+    fake_res.count_connectors = 1;
+    fake_res.connectors = fake_conn_ids;
+    fake_res.count_encoders = 1;
+    fake_res.encoders = fake_enc_ids;
+    fake_res.count_crtcs = 1;
+    fake_res.crtcs = fake_crtc_ids;
+    return &fake_res;
+}
+
+void drmModeFreeResources(drmModeResPtr ptr)
+{
+    LV_UNUSED(ptr);
+}
+
+drmModeConnectorPtr drmModeGetConnector(int fd, uint32_t connector_id)
+{
+    LV_UNUSED(fd);
+    if(connector_id != CONN_ID) return NULL;
+    lv_memzero(&fake_mode, sizeof(fake_mode));
+    fake_mode.hdisplay = LV_FAKE_DRM_HOR_RES;
+    fake_mode.vdisplay = LV_FAKE_DRM_VER_RES;
+    fake_mode.vrefresh = 60;
+    lv_memzero(&fake_conn, sizeof(fake_conn));
+    fake_conn.connector_id = CONN_ID;
+    fake_conn.encoder_id = ENC_ID;
+    fake_conn.connection = DRM_MODE_CONNECTED;
+    fake_conn.count_modes = 1;
+    fake_conn.modes = &fake_mode;
+    fake_conn.count_encoders = 1;
+    fake_conn.encoders = fake_enc_ids;
+    return &fake_conn;
+}
+
+void drmModeFreeConnector(drmModeConnectorPtr ptr)
+{
+    LV_UNUSED(ptr);
+}
+
+drmModeEncoderPtr drmModeGetEncoder(int fd, uint32_t encoder_id)
+{
+    LV_UNUSED(fd);
+    if(encoder_id != ENC_ID) return NULL;
+    lv_memzero(&fake_enc, sizeof(fake_enc));
+    fake_enc.encoder_id = ENC_ID;
+    fake_enc.crtc_id = CRTC_ID;
+    fake_enc.possible_crtcs = 1;
+    return &fake_enc;
+}
+
+void drmModeFreeEncoder(drmModeEncoderPtr ptr)
+{
+    LV_UNUSED(ptr);
+}
+
+drmModeCrtcPtr drmModeGetCrtc(int fd, uint32_t crtc_id)
+{
+    LV_UNUSED(fd);
+    if(crtc_id != CRTC_ID) return NULL;
+    lv_memzero(&fake_crtc, sizeof(fake_crtc));
+    fake_crtc.crtc_id = CRTC_ID;
+    return &fake_crtc;
+}
+
+drmModePlaneResPtr drmModeGetPlaneResources(int fd)
+{
+    LV_UNUSED(fd);
+    fake_plane_res.count_planes = 1;
+    fake_plane_res.planes = fake_plane_ids;
+    return &fake_plane_res;
+}
+
+void drmModeFreePlaneResources(drmModePlaneResPtr ptr)
+{
+    LV_UNUSED(ptr);
+}
+
+drmModePlanePtr drmModeGetPlane(int fd, uint32_t plane_id)
+{
+    LV_UNUSED(fd);
+    if(plane_id != PLANE_ID) return NULL;
+    lv_memzero(&fake_plane, sizeof(fake_plane));
+    fake_plane.plane_id = PLANE_ID;
+    fake_plane.possible_crtcs = 1;
+    fake_plane.count_formats = 1;
+    fake_plane.formats = fake_formats;
+    return &fake_plane;
+}
+
+void drmModeFreePlane(drmModePlanePtr ptr)
+{
+    LV_UNUSED(ptr);
+}
+
+drmModeObjectPropertiesPtr drmModeObjectGetProperties(int fd, uint32_t object_id, uint32_t object_type)
+{
+    LV_UNUSED(fd);
+    lv_memzero(&fake_obj_props, sizeof(fake_obj_props));
+    if(object_type == DRM_MODE_OBJECT_PLANE && object_id == PLANE_ID) {
+        fake_obj_props.count_props = sizeof(fake_plane_prop_ids) / sizeof(fake_plane_prop_ids[0]);
+        fake_obj_props.props = fake_plane_prop_ids;
+    }
+    else if(object_type == DRM_MODE_OBJECT_CRTC && object_id == CRTC_ID) {
+        fake_obj_props.count_props = sizeof(fake_crtc_prop_ids) / sizeof(fake_crtc_prop_ids[0]);
+        fake_obj_props.props = fake_crtc_prop_ids;
+    }
+    else if(object_type == DRM_MODE_OBJECT_CONNECTOR && object_id == CONN_ID) {
+        fake_obj_props.count_props = sizeof(fake_conn_prop_ids) / sizeof(fake_conn_prop_ids[0]);
+        fake_obj_props.props = fake_conn_prop_ids;
+    }
+    else {
+        return NULL;
+    }
+    return &fake_obj_props;
+}
+
+void drmModeFreeObjectProperties(drmModeObjectPropertiesPtr ptr)
+{
+    LV_UNUSED(ptr);
+}
+
+drmModePropertyPtr drmModeGetProperty(int fd, uint32_t property_id)
+{
+    LV_UNUSED(fd);
+    static const struct {
+        uint32_t id;
+        const char * name;
+    } names[] = {
+        {PROP_PLANE_FB_ID, "FB_ID"}, {PROP_PLANE_CRTC_ID, "CRTC_ID"},
+        {PROP_PLANE_SRC_X, "SRC_X"}, {PROP_PLANE_SRC_Y, "SRC_Y"}, {PROP_PLANE_SRC_W, "SRC_W"}, {PROP_PLANE_SRC_H, "SRC_H"},
+        {PROP_PLANE_CRTC_X, "CRTC_X"}, {PROP_PLANE_CRTC_Y, "CRTC_Y"},
+        {PROP_PLANE_CRTC_W, "CRTC_W"}, {PROP_PLANE_CRTC_H, "CRTC_H"},
+        {PROP_PLANE_FB_DAMAGE_CLIPS, "FB_DAMAGE_CLIPS"},
+        {PROP_CRTC_MODE_ID, "MODE_ID"}, {PROP_CRTC_ACTIVE, "ACTIVE"},
+        {PROP_CONN_CRTC_ID, "CRTC_ID"},
+    };
+
+    for(uint32_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        if(names[i].id != property_id) continue;
+        drmModePropertyRes * prop = &fake_props[i];
+        lv_memzero(prop, sizeof(drmModePropertyRes));
+        prop->prop_id = property_id;
+        lv_strncpy(prop->name, names[i].name, sizeof(prop->name) - 1);
+        return prop;
+    }
+
+    return NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static blob_t * blob_find(uint32_t id)
+{
+    for(uint32_t i = 0; i < sizeof(fake_blobs) / sizeof(fake_blobs[0]); i++) {
+        if(fake_blobs[i].id == id) return &fake_blobs[i];
+    }
+    return NULL;
+}
+
+#endif /*LV_USE_LINUX_DRM*/
@@ -0,0 +1,94 @@
+/**
+* @file lv_fake_drm.h
+*
+*/
+
+#ifndef LV_FAKE_DRM_H
+#define LV_FAKE_DRM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lvgl.h"
+
+#if LV_USE_LINUX_DRM
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_FAKE_DRM_HOR_RES         64
+#define LV_FAKE_DRM_VER_RES         32
+#define LV_FAKE_DRM_MAX_DAMAGE      64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t buf_idx;           /**< Index of the committed DUMB buffer in the order of creation*/
+    uint32_t damage_cnt;        /**< Number of FB_DAMAGE_CLIPS rectangles. 0: FB_DAMAGE_CLIPS was not set*/
+    lv_area_t damage[LV_FAKE_DRM_MAX_DAMAGE];  /**< The FB_DAMAGE_CLIPS converted to LVGL areas*/
+    bool flip_was_pending;      /**< The previous commit's page flip hasn't completed yet*/
+    bool prev_buf_modified;     /**< The previously committed buffer was written since it was committed*/
+} lv_fake_drm_commit_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Implement the libdrm functions used by the DRM driver to emulate a device with one connector,
+ * encoder, CRTC and plane of `LV_FAKE_DRM_HOR_RES` x `LV_FAKE_DRM_VER_RES` XRGB8888 pixels.
+ * The DUMB buffers are mapped from a temporary file which can be opened by the driver as the device.
+ * A page flip completes when the driver handles the events of the device.
+ * @return the path of the device to pass to `lv_linux_drm_set_file()`
+ */
+const char * lv_fake_drm_init(void);
+
+/**
+ * Remove the device file
+ */
+void lv_fake_drm_deinit(void);
+
+/**
+ * Get the number of DUMB buffers created by the driver
+ * @return the number of buffers
+ */
+uint32_t lv_fake_drm_get_buf_cnt(void);
+
+/**
+ * Get the pixels of a DUMB buffer
+ * @param buf_idx   index of the buffer in the order of creation
+ * @return          pointer to the XRGB8888 pixels without padding between the lines
+ */
+const uint32_t * lv_fake_drm_get_buf(uint32_t buf_idx);
+
+/**
+ * Get the number of atomic commits of the driver
+ * @return the number of commits
+ */
+uint32_t lv_fake_drm_get_commit_cnt(void);
+
+/**
+ * Get a recorded atomic commit
+ * @param idx   index of the commit
+ * @return      the data of the commit
+ */
+const lv_fake_drm_commit_t * lv_fake_drm_get_commit(uint32_t idx);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_LINUX_DRM*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FAKE_DRM_H*/
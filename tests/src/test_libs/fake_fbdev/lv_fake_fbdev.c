@@ -0,0 +1,243 @@
+/**
+* @file lv_fake_fbdev.c
+*
+*/
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fake_fbdev.h"
+
+#if LV_USE_LINUX_FBDEV && !LV_LINUX_FBDEV_BSD
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/fb.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LINE_LENGTH     (LV_FAKE_FBDEV_HOR_RES * 4)
+#define PAGE_SIZE       (LINE_LENGTH * LV_FAKE_FBDEV_VER_RES)
+#define MEM_SIZE        (PAGE_SIZE * 2)
+#define MAX_PANS        32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+
+static bool is_fake_fd(int fd);
+static int fake_ioctl(unsigned long request, void * arg);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+static char dev_path[64];
+static dev_t dev_dev;
+static ino_t dev_ino;
+static uint8_t * dev_map;
+static bool vsync_ok;
+
+static struct fb_var_screeninfo fake_vinfo;
+static struct fb_fix_screeninfo fake_finfo;
+
+static lv_fake_fbdev_pan_t pans[MAX_PANS];
+static uint32_t pan_cnt;
+static uint32_t vsync_wait_cnt;
+static bool vsync_waited;
+
+/*The content of the last panned page when it was panned to*/
+static uint8_t shown_page_content[PAGE_SIZE];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const char * lv_fake_fbdev_init(bool vsync_supported)
+{
+    lv_snprintf(dev_path, sizeof(dev_path), "/tmp/lv_fake_fbdev_XXXXXX");
+    int fd = mkstemp(dev_path);
+    if(fd < 0) return NULL;
+
+    struct stat st;
+    if(ftruncate(fd, MEM_SIZE) != 0 || fstat(fd, &st) != 0) {
+        close(fd);
+        unlink(dev_path);
+        return NULL;
+    }
+
+    dev_map = mmap(NULL, MEM_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(dev_map == MAP_FAILED) {
+        dev_map = NULL;
+        unlink(dev_path);
+        return NULL;
+    }
+
+    dev_dev = st.st_dev;
+    dev_ino = st.st_ino;
+    vsync_ok = vsync_supported;
+
+    /*The memory is large enough for 2 pages, but the virtual screen has to be enlarged to use them*/
+    lv_memzero(&fake_vinfo, sizeof(fake_vinfo));
+    fake_vinfo.xres = LV_FAKE_FBDEV_HOR_RES;
+    fake_vinfo.yres = LV_FAKE_FBDEV_VER_RES;
+    fake_vinfo.xres_virtual = LV_FAKE_FBDEV_HOR_RES;
+    fake_vinfo.yres_virtual = LV_FAKE_FBDEV_VER_RES;
+    fake_vinfo.bits_per_pixel = 32;
+
+    lv_memzero(&fake_finfo, sizeof(fake_finfo));
+    fake_finfo.smem_len = MEM_SIZE;
+    fake_finfo.line_length = LINE_LENGTH;
+    fake_finfo.ypanstep = 1;
+
+    pan_cnt = 0;
+    vsync_wait_cnt = 0;
+    vsync_waited = false;
+
+    return dev_path;
+}
+
+void lv_fake_fbdev_deinit(void)
+{
+    if(dev_map == NULL) return;
+
+    munmap(dev_map, MEM_SIZE);
+    dev_map = NULL;
+    unlink(dev_path);
+}
+
+uint32_t lv_fake_fbdev_get_yres_virtual(void)
+{
+    return fake_vinfo.yres_virtual;
+}
+
+const uint32_t * lv_fake_fbdev_get_page(uint32_t page_idx)
+{
+    return (const uint32_t *)(dev_map + page_idx * PAGE_SIZE);
+}
+
+uint32_t lv_fake_fbdev_get_pan_cnt(void)
+{
+    return pan_cnt;
+}
+
+const lv_fake_fbdev_pan_t * lv_fake_fbdev_get_pan(uint32_t idx)
+{
+    return &pans[idx];
+}
+
+uint32_t lv_fake_fbdev_get_vsync_wait_cnt(void)
+{
+    return vsync_wait_cnt;
+}
+
+/*Replaces the ioctl() of the C library*/
+int ioctl(int fd, unsigned long request, ...)
+{
+    va_list args;
+    va_start(args, request);
+    void * arg = va_arg(args, void *);
+    va_end(args);
+
+    if(!is_fake_fd(fd)) return (int)syscall(SYS_ioctl, fd, request, arg);
+
+    return fake_ioctl(request, arg);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static bool is_fake_fd(int fd)
+{
+    if(dev_map == NULL) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0) return false;
+
+    return st.st_dev == dev_dev && st.st_ino == dev_ino;
+}
+
+static int fake_ioctl(unsigned long request, void * arg)
+{
+    switch(request) {
+        case FBIOBLANK:
+            return 0;
+        case FBIOGET_FSCREENINFO:
+            lv_memcpy(arg, &fake_finfo, sizeof(fake_finfo));
+            return 0;
+        case FBIOGET_VSCREENINFO:
+            lv_memcpy(arg, &fake_vinfo, sizeof(fake_vinfo));
+            return 0;
+        case FBIOPUT_VSCREENINFO: {
+                const struct fb_var_screeninfo * vinfo = arg;
+                if(vinfo->xres != fake_vinfo.xres || vinfo->yres != fake_vinfo.yres ||
+                   vinfo->yres_virtual < vinfo->yres || vinfo->yres_virtual * LINE_LENGTH > MEM_SIZE) {
+                    errno = EINVAL;
+                    return -1;
+                }
+                fake_vinfo.yres_virtual = vinfo->yres_virtual;
+                return 0;
+            }
+        case FBIOPAN_DISPLAY: {
+                const struct fb_var_screeninfo * vinfo = arg;
+                if(pan_cnt >= MAX_PANS || vinfo->xoffset != 0 ||
+                   vinfo->yoffset + fake_vinfo.yres > fake_vinfo.yres_virtual) {
+                    errno = EINVAL;
+                    return -1;
+                }
+
+                lv_fake_fbdev_pan_t * pan = &pans[pan_cnt];
+                pan->xoffset = vinfo->xoffset;
+                pan->yoffset = vinfo->yoffset;
+                pan->vsync_waited = vsync_waited;
+
+                /*Check if the page shown until now was rendered into*/
+                uint8_t * page = dev_map + vinfo->yoffset * LINE_LENGTH;
+                if(pan_cnt > 0) {
+                    const uint8_t * shown_page = dev_map + fake_vinfo.yoffset * LINE_LENGTH;
+                    pan->shown_page_modified = lv_memcmp(shown_page_content, shown_page, PAGE_SIZE) != 0;
+                }
+                else {
+                    pan->shown_page_modified = false;
+                }
+                lv_memcpy(shown_page_content, page, PAGE_SIZE);
+
+                fake_vinfo.xoffset = vinfo->xoffset;
+                fake_vinfo.yoffset = vinfo->yoffset;
+                pan_cnt++;
+                vsync_waited = false;
+                return 0;
+            }
+        case FBIO_WAITFORVSYNC:
+            vsync_wait_cnt++;
+            if(!vsync_ok) {
+                errno = ENOTTY;
+                return -1;
+            }
+            vsync_waited = true;
+            return 0;
+        default:
+            errno = ENOTTY;
+            return -1;
+    }
+}
+
+#endif /*LV_USE_LINUX_FBDEV && !LV_LINUX_FBDEV_BSD*/
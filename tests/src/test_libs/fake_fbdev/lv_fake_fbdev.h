@@ -0,0 +1,98 @@
+/**
+* @file lv_fake_fbdev.h
+*
+*/
+
+#ifndef LV_FAKE_FBDEV_H
+#define LV_FAKE_FBDEV_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lvgl.h"
+
+#if LV_USE_LINUX_FBDEV && !LV_LINUX_FBDEV_BSD
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#define LV_FAKE_FBDEV_HOR_RES       64
+#define LV_FAKE_FBDEV_VER_RES       32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t xoffset;           /**< The `xoffset` passed to FBIOPAN_DISPLAY*/
+    uint32_t yoffset;           /**< The `yoffset` passed to FBIOPAN_DISPLAY*/
+    bool vsync_waited;          /**< FBIO_WAITFORVSYNC was called since the previous pan*/
+    bool shown_page_modified;   /**< The page shown by the previous pan was written since it was panned to*/
+} lv_fake_fbdev_pan_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Emulate a framebuffer device of `LV_FAKE_FBDEV_HOR_RES` x `LV_FAKE_FBDEV_VER_RES` 32 bit pixels
+ * whose memory can hold 2 pages, but the virtual screen has only one page initially.
+ * The `ioctl()` calls on a temporary file are handled by the fake, other calls are passed to the kernel.
+ * @param vsync_supported   false: FBIO_WAITFORVSYNC fails
+ * @return                  the path of the device to pass to `lv_linux_fbdev_set_file()`
+ */
+const char * lv_fake_fbdev_init(bool vsync_supported);
+
+/**
+ * Remove the device file
+ */
+void lv_fake_fbdev_deinit(void);
+
+/**
+ * Get the current height of the virtual screen
+ * @return the `yres_virtual` of the device
+ */
+uint32_t lv_fake_fbdev_get_yres_virtual(void);
+
+/**
+ * Get the pixels of a page of the framebuffer
+ * @param page_idx  index of the page
+ * @return          pointer to the XRGB8888 pixels without padding between the lines
+ */
+const uint32_t * lv_fake_fbdev_get_page(uint32_t page_idx);
+
+/**
+ * Get the number of FBIOPAN_DISPLAY calls
+ * @return the number of pans
+ */
+uint32_t lv_fake_fbdev_get_pan_cnt(void);
+
+/**
+ * Get a recorded FBIOPAN_DISPLAY call
+ * @param idx   index of the pan
+ * @return      the data of the pan
+ */
+const lv_fake_fbdev_pan_t * lv_fake_fbdev_get_pan(uint32_t idx);
+
+/**
+ * Get the number of FBIO_WAITFORVSYNC calls, including the failed ones
+ * @return the number of calls
+ */
+uint32_t lv_fake_fbdev_get_vsync_wait_cnt(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_LINUX_FBDEV && !LV_LINUX_FBDEV_BSD*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FAKE_FBDEV_H*/